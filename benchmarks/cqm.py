@@ -12,10 +12,64 @@
 #    See the License for the specific language governing permissions and
 #    limitations under the License.
 
+import functools
+import typing
+
 import numpy as np
 
 import dimod
 
+# the number of variables in each constraint
+CONSTRAINT_SIZE = 100
+
+# the scales, as number of variables, that the benchmarks are run at
+SCALES = [1_000, 10_000, 100_000, 1_000_000]
+
+
+def random_constraints(num_variables: int, quadratic: bool = False, seed: int = 42
+                       ) -> typing.List[dimod.BinaryQuadraticModel]:
+    """Left-hand sides of ``num_variables // CONSTRAINT_SIZE`` constraints over
+    disjoint sets of variables.
+
+    If ``quadratic`` is True, each constraint also has a chain of interactions
+    between its variables.
+    """
+    rng = np.random.default_rng(seed)
+
+    constraints = []
+    for start in range(0, num_variables - CONSTRAINT_SIZE + 1, CONSTRAINT_SIZE):
+        linear = rng.uniform(-1, 1, size=CONSTRAINT_SIZE)
+        if quadratic:
+            irow = np.arange(CONSTRAINT_SIZE - 1)
+            quad = (irow, irow + 1, rng.uniform(-1, 1, size=CONSTRAINT_SIZE - 1))
+        else:
+            quad = ([], [], [])
+        constraints.append(dimod.BQM.from_numpy_vectors(
+            linear, quad, 0, 'BINARY', variable_order=range(start, start + CONSTRAINT_SIZE)))
+    return constraints
+
+
+@functools.lru_cache(maxsize=None)
+def random_cqm(num_variables: int, quadratic: bool = False, seed: int = 42
+               ) -> dimod.ConstrainedQuadraticModel:
+    """A CQM with a linear objective and the constraints from
+    :func:`random_constraints`.
+
+    Cached so the larger models are only constructed once per process. Callers
+    must not modify the returned model.
+    """
+    rng = np.random.default_rng(seed)
+
+    cqm = dimod.ConstrainedQuadraticModel()
+    cqm.add_variables('BINARY', num_variables)
+    cqm.set_objective(dimod.BQM.from_numpy_vectors(
+        rng.uniform(-1, 1, size=num_variables), ([], [], []), 0, 'BINARY'))
+
+    for lhs in random_constraints(num_variables, quadratic, seed):
+        cqm.add_constraint_from_model(lhs, '<=', CONSTRAINT_SIZE / 4, copy=False)
+
+    return cqm
+
 
 class TimeSetObjective:
     def setUp(self):
@@ -23,3 +77,92 @@ class TimeSetObjective:
 
     def time_qm(self):
         dimod.CQM().set_objective(self.qm)
+
+
+class TimeAddConstraint:
+    params = (SCALES, [False, True])
+    param_names = ['num_variables', 'quadratic']
+    timeout = 300
+
+    # the benchmarks add to self.cqm, so each sample needs a fresh one from
+    # setup() rather than several iterations over a growing model
+    number = 1
+
+    def setup(self, num_variables, quadratic):
+        self.constraints = random_constraints(num_variables, quadratic)
+
+        self.cqm = dimod.ConstrainedQuadraticModel()
+        self.cqm.add_variables('BINARY', num_variables)
+
+    def time_add_constraint_from_model(self, *args):
+        cqm = self.cqm
+        for lhs in self.constraints:
+            cqm.add_constraint_from_model(lhs, '<=', 1)
+
+    def time_add_constraint_from_model_nocopy(self, *args):
+        cqm = self.cqm
+        for lhs in self.constraints:
+            cqm.add_constraint_from_model(lhs, '<=', 1, copy=False)
+
+    def peakmem_add_constraint_from_model(self, *args):
+        cqm = self.cqm
+        for lhs in self.constraints:
+            cqm.add_constraint_from_model(lhs, '<=', 1)
+
+
+class TimeCheckFeasible:
+    params = (SCALES, [False, True])
+    param_names = ['num_variables', 'quadratic']
+    timeout = 300
+
+    def setup(self, num_variables, quadratic):
+        self.cqm = random_cqm(num_variables, quadratic)
+        self.sample = np.zeros(num_variables, dtype=np.int8), range(num_variables)
+
+    def time_check_feasible(self, *args):
+        self.cqm.check_feasible(self.sample)
+
+
+class TimeFixVariables:
+    params = (SCALES, [False, True])
+    param_names = ['num_variables', 'quadratic']
+    timeout = 300
+
+    def setup(self, num_variables, quadratic):
+        self.cqm = random_cqm(num_variables, quadratic)
+
+        # fix every 10th variable
+        self.fixed = {v: 1 for v in range(0, num_variables, 10)}
+
+    def time_fix_variables(self, *args):
+        self.cqm.fix_variables(self.fixed, inplace=False)
+
+    def peakmem_fix_variables(self, *args):
+        self.cqm.fix_variables(self.fixed, inplace=False)
+
+
+class TimeSerialization:
+    params = (SCALES, [False, True])
+    param_names = ['num_variables', 'quadratic']
+    timeout = 300
+
+    def setup(self, num_variables, quadratic):
+        self.cqm = random_cqm(num_variables, quadratic)
+        self.fp = self.cqm.to_file()
+
+    def teardown(self, *args):
+        self.fp.close()
+
+    def time_to_file(self, *args):
+        self.cqm.to_file().close()
+
+    def time_from_file(self, *args):
+        self.fp.seek(0)
+        dimod.CQM.from_file(self.fp)
+
+    def peakmem_to_file(self, *args):
+        self.cqm.to_file().close()
+
+    def peakmem_from_file(self, *args):
+        self.fp.seek(0)
+        dimod.CQM.from_file(self.fp)
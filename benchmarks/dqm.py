@@ -0,0 +1,90 @@
+# Copyright 2022 D-Wave Systems Inc.
+#
+#    Licensed under the Apache License, Version 2.0 (the "License");
+#    you may not use this file except in compliance with the License.
+#    You may obtain a copy of the License at
+#
+#        http://www.apache.org/licenses/LICENSE-2.0
+#
+#    Unless required by applicable law or agreed to in writing, software
+#    distributed under the License is distributed on an "AS IS" BASIS,
+#    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+#    See the License for the specific language governing permissions and
+#    limitations under the License.
+
+import numpy as np
+
+import dimod
+
+
+def random_dqm(num_variables: int, num_cases: int, degree: int, seed: int = 42
+               ) -> dimod.DiscreteQuadraticModel:
+    """A DQM where each variable has ``num_cases`` cases and, on average,
+    ``degree`` neighbors.
+
+    Every pair of cases of neighboring variables interacts.
+    """
+    rng = np.random.default_rng(seed)
+
+    case_starts = np.arange(num_variables) * num_cases
+    linear = rng.uniform(-1, 1, size=num_variables * num_cases)
+
+    num_interactions = num_variables * degree // 2
+    u = rng.integers(num_variables, size=num_interactions)
+    v = rng.integers(num_variables, size=num_interactions)
+    u, v = u[u != v], v[u != v]
+
+    # every case pair of each (u, v)
+    cu, cv = np.meshgrid(np.arange(num_cases), np.arange(num_cases))
+    irow = (case_starts[u][:, np.newaxis] + cu.ravel()).ravel()
+    icol = (case_starts[v][:, np.newaxis] + cv.ravel()).ravel()
+
+    # remove duplicate interactions, keeping u < v
+    irow, icol = np.minimum(irow, icol), np.maximum(irow, icol)
+    irow, icol = np.unique(np.stack((irow, icol)), axis=1)
+
+    quadratic = irow, icol, rng.uniform(-1, 1, size=len(irow))
+
+    return dimod.DQM.from_numpy_vectors(case_starts, linear, quadratic)
+
+
+class TimeEnergies:
+    params = ([1_000, 10_000, 100_000], [2, 10])
+    param_names = ['num_variables', 'num_cases']
+    timeout = 300
+
+    def setup(self, num_variables, num_cases):
+        self.dqm = random_dqm(num_variables, num_cases, 4)
+
+        rng = np.random.default_rng(42)
+        self.samples = rng.integers(num_cases, size=(100, num_variables))
+
+    def time_energies(self, *args):
+        self.dqm.energies((self.samples, range(self.dqm.num_variables())))
+
+    def peakmem_energies(self, *args):
+        self.dqm.energies((self.samples, range(self.dqm.num_variables())))
+
+
+class TimeSerialization:
+    params = ([1_000, 10_000, 100_000], [2, 10])
+    param_names = ['num_variables', 'num_cases']
+    timeout = 300
+
+    def setup(self, num_variables, num_cases):
+        self.dqm = random_dqm(num_variables, num_cases, 4)
+        self.fp = self.dqm.to_file()
+
+    def teardown(self, *args):
+        self.fp.close()
+
+    def time_to_file(self, *args):
+        self.dqm.to_file().close()
+
+    def time_from_file(self, *args):
+        self.fp.seek(0)
+        dimod.DQM.from_file(self.fp)
+
+    def peakmem_from_file(self, *args):
+        self.fp.seek(0)
+        dimod.DQM.from_file(self.fp)
@@ -0,0 +1,46 @@
+# Copyright 2022 D-Wave Systems Inc.
+#
+#    Licensed under the Apache License, Version 2.0 (the "License");
+#    you may not use this file except in compliance with the License.
+#    You may obtain a copy of the License at
+#
+#        http://www.apache.org/licenses/LICENSE-2.0
+#
+#    Unless required by applicable law or agreed to in writing, software
+#    distributed under the License is distributed on an "AS IS" BASIS,
+#    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+#    See the License for the specific language governing permissions and
+#    limitations under the License.
+
+import dimod
+
+from benchmarks.cqm import random_cqm
+
+
+class TimeLoad:
+    params = ([1_000, 10_000, 100_000], [False, True])
+    param_names = ['num_variables', 'quadratic']
+    timeout = 300
+
+    def setup(self, num_variables, quadratic):
+        cqm = random_cqm(num_variables, quadratic)
+        self.lp = dimod.lp.dumps(cqm.relabel_variables({v: f'x{v}' for v in cqm.variables}, inplace=False))
+
+    def time_loads(self, *args):
+        dimod.lp.loads(self.lp)
+
+    def peakmem_loads(self, *args):
+        dimod.lp.loads(self.lp)
+
+
+class TimeDump:
+    params = ([1_000, 10_000, 100_000], [False, True])
+    param_names = ['num_variables', 'quadratic']
+    timeout = 300
+
+    def setup(self, num_variables, quadratic):
+        cqm = random_cqm(num_variables, quadratic)
+        self.cqm = cqm.relabel_variables({v: f'x{v}' for v in cqm.variables}, inplace=False)
+
+    def time_dumps(self, *args):
+        dimod.lp.dumps(self.cqm)
@@ -0,0 +1,37 @@
+// Copyright 2023 D-Wave Systems Inc.
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+
+#include "benchmark/benchmark.h"
+
+/*
+The purpose of this file is to include Google Benchmark's main(). Benchmarks can be found
+inside the benchmarks directory.
+
+Some examples:
+
+eg) Run all benchmarks
+>>> make
+>>> ./benchmark_main
+
+eg) Run all benchmarks whose name contains "energy"
+>>> ./benchmark_main --benchmark_filter=energy
+
+eg) Save the results as JSON for comparison between versions
+>>> make json
+
+For more command line options, see: https://github.com/google/benchmark/blob/main/docs/user_guide.md
+
+*/
+
+BENCHMARK_MAIN();
@@ -0,0 +1,135 @@
+// Copyright 2023 D-Wave Systems Inc.
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+
+#include <algorithm>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "dimod/binary_quadratic_model.h"
+#include "generators.h"
+
+namespace dimod {
+namespace benchmarks {
+
+static void BM_BQM_add_quadratic_coo(benchmark::State& state) {
+    const int num_variables = state.range(0);
+    auto coo = random_coo(num_variables, state.range(1));
+
+    for (auto _ : state) {
+        auto bqm = BinaryQuadraticModel<double>(num_variables, Vartype::BINARY);
+        bqm.add_quadratic(coo.row.begin(), coo.col.begin(), coo.bias.begin(), coo.row.size());
+        benchmark::DoNotOptimize(bqm.num_interactions());
+    }
+    state.SetItemsProcessed(state.iterations() * coo.row.size());
+}
+BENCHMARK(BM_BQM_add_quadratic_coo)->DIMOD_BENCHMARK_SHAPES;
+
+static void BM_BQM_add_quadratic_from_dense(benchmark::State& state) {
+    const int num_variables = state.range(0);
+    auto coo = random_coo(num_variables, num_variables - 1);
+
+    std::vector<double> dense(static_cast<std::size_t>(num_variables) * num_variables, 0);
+    for (std::size_t i = 0; i < coo.row.size(); ++i) {
+        dense[coo.row[i] * num_variables + coo.col[i]] = coo.bias[i];
+    }
+
+    for (auto _ : state) {
+        auto bqm = BinaryQuadraticModel<double>(dense.data(), num_variables, Vartype::BINARY);
+        benchmark::DoNotOptimize(bqm.num_interactions());
+    }
+    state.SetItemsProcessed(state.iterations() * dense.size());
+}
+BENCHMARK(BM_BQM_add_quadratic_from_dense)->Arg(100)->Arg(1000)->Arg(2000);
+
+static void BM_BQM_energy(benchmark::State& state) {
+    auto bqm = random_bqm<double>(state.range(0), state.range(1));
+    auto sample = random_samples(state.range(0));
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(bqm.energy(sample.begin()));
+    }
+    state.SetItemsProcessed(state.iterations() * bqm.num_interactions());
+}
+BENCHMARK(BM_BQM_energy)->DIMOD_BENCHMARK_SHAPES;
+
+static void BM_BQM_change_vartype(benchmark::State& state) {
+    auto bqm = random_bqm<double>(state.range(0), state.range(1));
+
+    for (auto _ : state) {
+        bqm.change_vartype(Vartype::SPIN);
+        bqm.change_vartype(Vartype::BINARY);
+    }
+    benchmark::DoNotOptimize(bqm.offset());
+}
+BENCHMARK(BM_BQM_change_vartype)->DIMOD_BENCHMARK_SHAPES;
+
+static void BM_BQM_fix_variable(benchmark::State& state) {
+    // fix 10% of the variables, one at a time
+    const int num_variables = state.range(0);
+    auto base = random_bqm<double>(num_variables, state.range(1));
+    auto variables = random_variables(num_variables, num_variables / 10);
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto bqm = base;
+        std::vector<int> remaining(num_variables);
+        for (int v = 0; v < num_variables; ++v) remaining[v] = v;
+        state.ResumeTiming();
+
+        // track labels so we always fix the same variables
+        for (const auto& v : variables) {
+            auto it = std::lower_bound(remaining.begin(), remaining.end(), v);
+            bqm.fix_variable(it - remaining.begin(), 1);
+            remaining.erase(it);
+        }
+        benchmark::DoNotOptimize(bqm.offset());
+    }
+}
+BENCHMARK(BM_BQM_fix_variable)->Args({1000, 4})->Args({1000, 999})->Args({10000, 4});
+
+static void BM_BQM_remove_variables(benchmark::State& state) {
+    // remove 10% of the variables in one pass
+    const int num_variables = state.range(0);
+    auto base = random_bqm<double>(num_variables, state.range(1));
+    auto variables = random_variables(num_variables, num_variables / 10);
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto bqm = base;
+        state.ResumeTiming();
+
+        bqm.remove_variables(variables);
+        benchmark::DoNotOptimize(bqm.num_variables());
+    }
+}
+BENCHMARK(BM_BQM_remove_variables)->DIMOD_BENCHMARK_SHAPES;
+
+static void BM_BQM_quadratic(benchmark::State& state) {
+    // look up every interaction in the model
+    auto coo = random_coo(state.range(0), state.range(1));
+    auto bqm = random_bqm<double>(state.range(0), state.range(1));
+
+    for (auto _ : state) {
+        double total = 0;
+        for (std::size_t i = 0; i < coo.row.size(); ++i) {
+            total += bqm.quadratic(coo.row[i], coo.col[i]);
+        }
+        benchmark::DoNotOptimize(total);
+    }
+    state.SetItemsProcessed(state.iterations() * coo.row.size());
+}
+BENCHMARK(BM_BQM_quadratic)->DIMOD_BENCHMARK_SHAPES;
+
+}  // namespace benchmarks
+}  // namespace dimod
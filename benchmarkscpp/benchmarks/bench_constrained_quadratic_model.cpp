@@ -0,0 +1,106 @@
+// Copyright 2023 D-Wave Systems Inc.
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "dimod/constrained_quadratic_model.h"
+#include "generators.h"
+
+namespace dimod {
+namespace benchmarks {
+
+/// A CQM with a random objective and `num_constraints` random constraints, each
+/// over `constraint_size` variables.
+static ConstrainedQuadraticModel<double> random_cqm(int num_variables, int degree,
+                                                    int num_constraints, int constraint_size) {
+    ConstrainedQuadraticModel<double> cqm;
+    cqm.add_variables(Vartype::BINARY, num_variables);
+    cqm.set_objective(random_bqm<double>(num_variables, degree));
+
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<double> bias(-1, 1);
+    for (int c = 0; c < num_constraints; ++c) {
+        auto& constraint = cqm.constraint_ref(cqm.add_constraint());
+        for (const auto& v : random_variables(num_variables, constraint_size, c)) {
+            constraint.add_linear(v, bias(rng));
+        }
+        constraint.set_sense(Sense::LE);
+        constraint.set_rhs(1);
+    }
+
+    return cqm;
+}
+
+static void BM_CQM_fix_variables(benchmark::State& state) {
+    // fix 10% of the variables at once
+    const int num_variables = state.range(0);
+    auto cqm = random_cqm(num_variables, 4, state.range(1), 100);
+    auto variables = random_variables(num_variables, num_variables / 10);
+    std::vector<int> assignments(variables.size(), 1);
+
+    for (auto _ : state) {
+        auto fixed = cqm.fix_variables(variables.begin(), variables.end(), assignments.begin());
+        benchmark::DoNotOptimize(fixed.num_variables());
+    }
+}
+BENCHMARK(BM_CQM_fix_variables)->Args({1000, 10})->Args({10000, 100})->Args({10000, 1000});
+
+static void BM_CQM_change_vartype(benchmark::State& state) {
+    const int num_variables = state.range(0);
+    auto cqm = random_cqm(num_variables, 4, state.range(1), 100);
+
+    for (auto _ : state) {
+        for (int v = 0; v < num_variables; ++v) cqm.change_vartype(Vartype::SPIN, v);
+        for (int v = 0; v < num_variables; ++v) cqm.change_vartype(Vartype::BINARY, v);
+    }
+}
+BENCHMARK(BM_CQM_change_vartype)->Args({1000, 10})->Args({1000, 100});
+
+static void BM_Expression_linear(benchmark::State& state) {
+    // look up the linear bias of every variable in a constraint, most of
+    // which are not in the constraint
+    const int num_variables = state.range(0);
+    auto cqm = random_cqm(num_variables, 4, 1, state.range(1));
+    const auto& constraint = cqm.constraint_ref(0);
+
+    for (auto _ : state) {
+        double total = 0;
+        for (int v = 0; v < num_variables; ++v) total += constraint.linear(v);
+        benchmark::DoNotOptimize(total);
+    }
+    state.SetItemsProcessed(state.iterations() * num_variables);
+}
+BENCHMARK(BM_Expression_linear)->Args({1000, 10})->Args({1000, 1000})->Args({100000, 100});
+
+static void BM_Expression_quadratic(benchmark::State& state) {
+    // look up every interaction in the objective
+    auto coo = random_coo(state.range(0), state.range(1));
+    ConstrainedQuadraticModel<double> cqm;
+    cqm.add_variables(Vartype::BINARY, state.range(0));
+    cqm.set_objective(random_bqm<double>(state.range(0), state.range(1)));
+
+    for (auto _ : state) {
+        double total = 0;
+        for (std::size_t i = 0; i < coo.row.size(); ++i) {
+            total += cqm.objective.quadratic(coo.row[i], coo.col[i]);
+        }
+        benchmark::DoNotOptimize(total);
+    }
+    state.SetItemsProcessed(state.iterations() * coo.row.size());
+}
+BENCHMARK(BM_Expression_quadratic)->Args({1000, 4})->Args({1000, 999})->Args({100000, 4});
+
+}  // namespace benchmarks
+}  // namespace dimod
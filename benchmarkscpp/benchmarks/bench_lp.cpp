@@ -0,0 +1,79 @@
+// Copyright 2023 D-Wave Systems Inc.
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <string>
+
+#include "benchmark/benchmark.h"
+#include "filereaderlp/reader.hpp"
+
+namespace dimod {
+namespace benchmarks {
+
+/// Write an LP file with `num_variables` binary variables and `num_constraints`
+/// dense linear constraints and return its name.
+static std::string write_lp(int num_variables, int num_constraints) {
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> bias(1, 10);
+    std::bernoulli_distribution negative(.5);
+
+    // write a signed coefficient, e.g. " - 3"
+    auto term = [&](std::ofstream& f) { f << (negative(rng) ? " - " : " + ") << bias(rng); };
+
+    std::string filename = "benchmark_" + std::to_string(num_variables) + "_" +
+                           std::to_string(num_constraints) + ".lp";
+    std::ofstream f(filename);
+
+    f << "minimize\n obj: ";
+    for (int v = 0; v < num_variables; ++v) {
+        term(f);
+        f << " x" << v;
+    }
+    f << " + [";
+    for (int v = 1; v < num_variables; ++v) {
+        term(f);
+        f << " x" << v - 1 << " * x" << v;
+    }
+    f << " ] / 2\nsubject to\n";
+    for (int c = 0; c < num_constraints; ++c) {
+        f << " c" << c << ": ";
+        for (int v = 0; v < num_variables; ++v) {
+            term(f);
+            f << " x" << v;
+        }
+        f << " <= " << bias(rng) << "\n";
+    }
+    f << "binary\n";
+    for (int v = 0; v < num_variables; ++v) f << " x" << v << "\n";
+    f << "end\n";
+
+    return filename;
+}
+
+static void BM_LP_readinstance(benchmark::State& state) {
+    auto filename = write_lp(state.range(0), state.range(1));
+
+    for (auto _ : state) {
+        auto model = readinstance(filename);
+        benchmark::DoNotOptimize(model.constraints.size());
+    }
+
+    std::remove(filename.c_str());
+}
+BENCHMARK(BM_LP_readinstance)->Args({100, 10})->Args({1000, 10})->Args({1000, 100});
+
+}  // namespace benchmarks
+}  // namespace dimod
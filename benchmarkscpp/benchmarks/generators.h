@@ -0,0 +1,126 @@
+// Copyright 2023 D-Wave Systems Inc.
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+
+#pragma once
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "dimod/binary_quadratic_model.h"
+
+namespace dimod {
+namespace benchmarks {
+
+// Shapes shared by the benchmarks, as {num_variables, degree}. A degree of
+// num_variables - 1 is a fully-connected model.
+#define DIMOD_BENCHMARK_SHAPES \
+    Args({100, 99})->Args({1000, 999})->Args({1000, 4})->Args({100000, 4})->Args({100000, 32})
+
+/// COO-formatted interactions.
+struct COO {
+    std::vector<int> row;
+    std::vector<int> col;
+    std::vector<double> bias;
+};
+
+/// Interactions of a random graph with `num_variables` nodes where each
+/// node has (on average) `degree` neighbors.
+/// Fully-connected if `degree >= num_variables - 1`.
+inline COO random_coo(int num_variables, int degree, unsigned int seed = 42) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> bias(-1, 1);
+
+    COO coo;
+
+    if (degree >= num_variables - 1) {
+        for (int u = 0; u < num_variables; ++u) {
+            for (int v = u + 1; v < num_variables; ++v) {
+                coo.row.push_back(u);
+                coo.col.push_back(v);
+                coo.bias.push_back(bias(rng));
+            }
+        }
+        return coo;
+    }
+
+    std::uniform_int_distribution<int> variable(0, num_variables - 1);
+
+    std::size_t num_interactions = static_cast<std::size_t>(num_variables) * degree / 2;
+    while (coo.row.size() < num_interactions) {
+        int u = variable(rng);
+        int v = variable(rng);
+        if (u == v) continue;
+        coo.row.push_back(u);
+        coo.col.push_back(v);
+        coo.bias.push_back(bias(rng));
+    }
+
+    // put the interactions in a random order so we don't benefit from
+    // appending
+    std::vector<std::size_t> order(num_interactions);
+    for (std::size_t i = 0; i < order.size(); ++i) order[i] = i;
+    std::shuffle(order.begin(), order.end(), rng);
+
+    COO shuffled;
+    for (const auto& i : order) {
+        shuffled.row.push_back(coo.row[i]);
+        shuffled.col.push_back(coo.col[i]);
+        shuffled.bias.push_back(coo.bias[i]);
+    }
+    return shuffled;
+}
+
+/// A random BQM with the given shape.
+template <class Bias>
+BinaryQuadraticModel<Bias> random_bqm(int num_variables, int degree,
+                                      Vartype vartype = Vartype::BINARY,
+                                      unsigned int seed = 42) {
+    auto coo = random_coo(num_variables, degree, seed);
+
+    auto bqm = BinaryQuadraticModel<Bias>(num_variables, vartype);
+    bqm.add_quadratic(coo.row.begin(), coo.col.begin(), coo.bias.begin(), coo.row.size());
+
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> bias(-1, 1);
+    for (int v = 0; v < num_variables; ++v) {
+        bqm.set_linear(v, bias(rng));
+    }
+
+    return bqm;
+}
+
+/// `num_samples` random binary-valued samples of length `num_variables`, concatenated.
+inline std::vector<int> random_samples(int num_variables, int num_samples = 1,
+                                       unsigned int seed = 42) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> value(0, 1);
+
+    std::vector<int> samples(static_cast<std::size_t>(num_variables) * num_samples);
+    for (auto& val : samples) val = value(rng);
+    return samples;
+}
+
+/// `k` distinct random variables in [0, num_variables).
+inline std::vector<int> random_variables(int num_variables, int k, unsigned int seed = 42) {
+    std::mt19937 rng(seed);
+    std::vector<int> variables(num_variables);
+    for (int v = 0; v < num_variables; ++v) variables[v] = v;
+    std::shuffle(variables.begin(), variables.end(), rng);
+    variables.resize(k);
+    return variables;
+}
+
+}  // namespace benchmarks
+}  // namespace dimod
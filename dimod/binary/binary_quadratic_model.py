@@ -57,11 +57,13 @@ from dimod.binary.vartypeview import VartypeView
 from dimod.decorators import forwarding_method, unique_variable_labels
 from dimod.quadratic import QuadraticModel, QM
 from dimod.quadratic.quadratic_model import _VariableArray
+from dimod.serialization.delta import apply_delta_biases, read_delta, write_delta
 from dimod.serialization.fileview import SpooledTemporaryFile, _BytesIO, VariablesSection
 from dimod.serialization.fileview import load, read_header, write_header
 from dimod.sym import Eq, Ge, Le
 from dimod.typing import (Bias, BQMVectors, LabelledBQMVectors, QuadraticVectors,
                           Variable, VartypeLike)
+from dimod.utilities import asintegerarrays, asnumericarrays
 from dimod.variables import Variables, iter_deserialize_variables
 from dimod.vartypes import as_vartype, Vartype
 from dimod.views.quadratic import QuadraticViewsMixin
@@ -942,6 +944,81 @@ class BinaryQuadraticModel(QuadraticViewsMixin):
 
         self.data.add_quadratic_from_dense(quadratic)
 
+    def add_quadratic_from_csr(self, matrix) -> None:
+        """Add quadratic biases from a sparse matrix in CSR format.
+
+        The variables are labelled by row/column index. The interaction
+        between ``u`` and ``v`` gets the sum of all of the entries at
+        ``(u, v)`` and at ``(v, u)``, so the matrix can be upper-triangular
+        or symmetric and can contain duplicate entries. Values on the diagonal
+        are added to the linear biases for binary-valued models and to the
+        offset for spin-valued models.
+
+        For index-labelled binary quadratic models with a numeric dtype the
+        matrix is read directly, without conversion to COO format.
+
+        Args:
+            matrix:
+                A :class:`scipy.sparse.csr_matrix` or :class:`scipy.sparse.csr_array`,
+                or any object with ``data``, ``indices`` and ``indptr``
+                attributes. CSC matrices describe the same biases and are also
+                accepted without conversion. Other sparse formats are
+                converted with their ``tocsr()`` method. A ``(data, indices, indptr)``
+                3-tuple, as accepted by the SciPy constructors, can also be given.
+
+        Examples:
+            >>> bqm = dimod.BinaryQuadraticModel("BINARY")
+            >>> bqm.add_quadratic_from_csr(([1, -2, 3], [0, 1, 2], [0, 2, 3, 3]))
+            >>> print(bqm)
+            BinaryQuadraticModel({0: 1.0, 1: 0.0, 2: 0.0}, {(1, 0): -2.0, (2, 1): 3.0}, 0.0, 'BINARY')
+
+        """
+        if getattr(matrix, 'format', None) not in (None, 'csr', 'csc'):
+            matrix = matrix.tocsr()
+
+        if hasattr(matrix, 'indptr'):
+            data, indices, indptr = matrix.data, matrix.indices, matrix.indptr
+        else:
+            try:
+                data, indices, indptr = matrix
+            except ValueError:
+                raise ValueError("matrix should be a CSR matrix or a "
+                                 "(data, indices, indptr) 3-tuple")
+
+        indptr, indices = asintegerarrays(indptr, indices, min_itemsize=4, requirements='C')
+        if self.dtype == np.dtype('O'):
+            data = np.asarray(data)
+        else:
+            data = asnumericarrays(data, min_itemsize=4, requirements='C')
+
+        if indptr.ndim != 1 or not len(indptr):
+            raise ValueError("indptr must be a non-empty 1d array")
+        if indices.shape != data.shape:
+            raise ValueError("indices and data should be equal length")
+        if indptr[0] < 0 or indptr[-1] > len(indices) or (np.diff(indptr) < 0).any():
+            raise ValueError("indptr must be non-decreasing and match the length of indices")
+        if (indices < 0).any():
+            raise ValueError("indices must be non-negative")
+
+        try:
+            self.data.add_quadratic_from_csr(indptr, indices, data)
+            return
+        except NotImplementedError:
+            # methods can defer this
+            pass
+
+        vartype = self.vartype
+        for u in range(len(indptr) - 1):
+            self.add_variable(u)
+            for k in range(indptr[u], indptr[u + 1]):
+                v = int(indices[k])
+                if u != v:
+                    self.add_quadratic(u, v, data[k])
+                elif vartype is Vartype.SPIN:
+                    self.offset += data[k]
+                else:
+                    self.add_linear(u, data[k])
+
     @forwarding_method
     def add_variable(self, v: Optional[Variable] = None, bias: Bias = 0):
         """Add a variable to a binary quadratic model.
@@ -953,6 +1030,51 @@ class BinaryQuadraticModel(QuadraticViewsMixin):
         """
         return self.data.add_variable
 
+    def apply_delta(self, fp: Union[BinaryIO, ByteString]) -> None:
+        """Apply changes serialized by :meth:`to_delta`.
+
+        The binary quadratic model must be the same as the model the delta
+        was made from, as it was at its last :meth:`checkpoint`. After the
+        delta is applied, it is the same as the model when the delta was made.
+
+        Args:
+            fp: Bytes-like object or readable file-like object, as returned
+                by :meth:`to_delta`.
+
+        Raises:
+            ValueError: If the delta was made from a model of a different
+                type or vartype, or with a different number of variables at
+                its checkpoint, or if it adds variables that are already in
+                the model.
+            TypeError: If :attr:`.dtype` is :class:`object`.
+
+        See :meth:`to_delta` for an example.
+
+        """
+        delta = read_delta(fp)
+
+        if delta.type != type(self).__name__:
+            raise ValueError(f"cannot apply a delta of a {delta.type} "
+                             f"to a {type(self).__name__}")
+        if delta.vartype != self.vartype.name:
+            raise ValueError(f"cannot apply a delta of a {delta.vartype} model "
+                             f"to a {self.vartype.name} model")
+        if delta.base_num_variables != self.num_variables:
+            raise ValueError(f"the delta was made from a model with "
+                             f"{delta.base_num_variables} variables, this model "
+                             f"has {self.num_variables}")
+        if self.dtype == np.dtype('O'):
+            raise TypeError(
+                "cannot apply a delta to a binary quadratic model with object dtype")
+        for v in delta.variables:
+            if v in self.variables:
+                raise ValueError(f"variable {v!r} is already in the model")
+
+        for v in delta.variables:
+            self.add_variable(v)
+
+        apply_delta_biases(self.data, delta)
+
     def change_vartype(self, vartype: Vartype,
                        inplace: bool = True) -> 'BinaryQuadraticModel':
         """Return a binary quadratic model with the specified vartype.
@@ -976,10 +1098,65 @@ class BinaryQuadraticModel(QuadraticViewsMixin):
         self.data.change_vartype(vartype)
         return self
 
+    def checkpoint(self) -> None:
+        """Start recording the changes made to the binary quadratic model.
+
+        The changes made after the checkpoint can be serialized by
+        :meth:`to_delta` and applied to a copy of the model as it was at the
+        checkpoint by :meth:`apply_delta`. Calling this method again moves the
+        checkpoint to the current state of the model. The checkpoint is not
+        copied with the model.
+
+        Changes to individual biases, and adding variables, are recorded.
+        Changes that reindex or rewrite the whole model, such as removing or
+        relabeling variables, changing the vartype or scaling the model,
+        cannot be expressed as a delta; after one of those, the model must be
+        sent in full and a new checkpoint made.
+
+        Raises:
+            TypeError: If :attr:`.dtype` is :class:`object`.
+
+        """
+        self.data.checkpoint()
+
     def clear(self) -> None:
         """Remove the offset and all variables and interactions from the model."""
         self.data.clear()
 
+    def content_hash(self, *, num_threads: int = 1) -> int:
+        """Return a 128-bit fingerprint of the content of the binary quadratic model.
+
+        The hash covers the offset, the linear and quadratic biases, and the
+        vartype of the variables. Models with the same content have the
+        same hash regardless of the order of their variables and
+        interactions, or of their :attr:`.dtype`. Models with different
+        content have different hashes with very high probability, so the
+        hash can be used as a cache key. Note that an interaction with a
+        bias of 0 counts as content.
+
+        Args:
+            num_threads:
+                Number of threads the variables are divided between.
+                If 0, uses one thread per core.
+
+        Returns:
+            A non-negative integer less than ``2**128``.
+
+        Raises:
+            TypeError: If :attr:`.dtype` is :class:`object`.
+
+        Examples:
+            >>> bqm0 = dimod.BinaryQuadraticModel({'a': 1, 'b': -1}, {'ab': 2}, 0, 'SPIN')
+            >>> bqm1 = dimod.BinaryQuadraticModel({'b': -1, 'a': 1}, {'ba': 2}, 0, 'SPIN')
+            >>> bqm0.content_hash() == bqm1.content_hash()
+            True
+            >>> bqm1.set_linear('a', 1.5)
+            >>> bqm0.content_hash() == bqm1.content_hash()
+            False
+
+        """
+        return self.data.content_hash(num_threads=num_threads)
+
     def contract_variables(self, u: Variable, v: Variable):
         """Enforce u, v being the same variable in a binary quadratic model.
 
@@ -1158,6 +1335,31 @@ class BinaryQuadraticModel(QuadraticViewsMixin):
                    + sum(abs(bias) for u, bias in self.iter_neighborhood(v))
                    for v in self.variables) * scale
 
+    def fix_variables(self,
+                      fixed: Union[Mapping[Variable, float], Iterable[Tuple[Variable, float]]]):
+        """Fix the value of the variables and remove them.
+
+        The variables are removed together, so the model is reindexed once
+        rather than once per variable as with :meth:`.fix_variable`.
+
+        Args:
+            fixed: A dictionary or an iterable of 2-tuples of variable
+                assignments. If a variable is assigned more than once, the
+                last assignment is used.
+
+        Raises:
+            ValueError: If any of the variables is not in the model.
+
+        Examples:
+            >>> bqm = dimod.BinaryQuadraticModel({'a': 1, 'b': 2, 'c': 3},
+            ...                                  {'ab': -1, 'bc': 1}, 0, 'BINARY')
+            >>> bqm.fix_variables({'a': 1, 'c': 0})
+            >>> bqm.linear
+            {'b': 1.0}
+
+        """
+        self.data.fix_variables(fixed)
+
     def flip_variable(self, v: Variable):
         """Flip the specified variable in a binary quadratic model."""
         if self.vartype is Vartype.SPIN:
@@ -1208,6 +1410,47 @@ class BinaryQuadraticModel(QuadraticViewsMixin):
 
         return coo.load(obj, cls=cls, vartype=vartype)
 
+    @classmethod
+    def from_csr(cls, matrix, vartype: VartypeLike, *,
+                 dtype: DTypeLike = np.float64) -> 'BinaryQuadraticModel':
+        """Create a binary quadratic model from a sparse matrix in CSR format.
+
+        See :meth:`add_quadratic_from_csr` for how the matrix is interpreted.
+
+        Args:
+            matrix:
+                A :class:`scipy.sparse.csr_matrix` or a ``(data, indices, indptr)``
+                3-tuple.
+
+            vartype:
+                Variable type for the binary quadratic model. Accepted input
+                values:
+
+                * :class:`~dimod.Vartype.SPIN`, ``'SPIN'``, ``{-1, 1}``
+                * :class:`~dimod.Vartype.BINARY`, ``'BINARY'``, ``{0, 1}``
+
+            dtype: Data type for the returned binary quadratic model.
+
+        Returns:
+            A binary quadratic model.
+
+        Examples:
+            This example builds a QUBO from a matrix in CSR format, with the
+            linear biases on the diagonal.
+
+            >>> data = [-1, 2, -1, 2, -1]
+            >>> indices = [0, 1, 1, 2, 2]
+            >>> indptr = [0, 2, 4, 5]
+            >>> bqm = dimod.BQM.from_csr((data, indices, indptr), "BINARY")
+            >>> bqm.quadratic[0, 1]
+            2.0
+            >>> bqm.linear[2]
+            -1.0
+        """
+        bqm = cls(vartype, dtype=dtype)
+        bqm.add_quadratic_from_csr(matrix)
+        return bqm
+
     @classmethod
     def from_file(cls, fp: Union[BinaryIO, ByteString]):
         """Construct a binary quadratic model from a file-like object.
@@ -1707,6 +1950,36 @@ class BinaryQuadraticModel(QuadraticViewsMixin):
         """
         return self.data.get_quadratic
 
+    def local_fields(self, samples_like, *, num_threads: int = 1) -> np.ndarray:
+        """Determine the local fields of the variables for the given samples-like.
+
+        The local field of variable :math:`v` in sample :math:`s` is the
+        change in energy per unit change in :math:`s_v`,
+        :math:`h_v + \\sum_u J_{u,v} s_u`.
+
+        Args:
+            samples_like (samples_like):
+                Raw samples. `samples_like` is an extension of
+                NumPy's `array_like`_ structure. See :func:`.as_samples`.
+
+            num_threads:
+                Number of threads the variables are divided between.
+                If 0, uses one thread per core.
+
+        Returns:
+            Array of shape ``(num_samples, num_variables)``, with the columns
+            in the order of :attr:`.variables`.
+
+        Examples:
+            >>> bqm = dimod.BinaryQuadraticModel({'a': 1}, {'ab': -1, 'bc': 2}, 0, 'SPIN')
+            >>> bqm.local_fields([{'a': 1, 'b': -1, 'c': 1}])
+            array([[ 2.,  1., -2.]])
+
+        .. _`array_like`:  https://numpy.org/doc/stable/user/basics.creation.html
+
+        """
+        return self.data.local_fields(samples_like, num_threads=num_threads)
+
     def nbytes(self, capacity: bool = False) -> int:
         """Get the total bytes consumed by the biases and indices.
 
@@ -1961,6 +2234,82 @@ class BinaryQuadraticModel(QuadraticViewsMixin):
         for v in variables:
             self.remove_variable(v)
 
+    @forwarding_method
+    def reorder_variables(self, order: Union[str, Sequence[Variable]] = 'rcm') -> np.ndarray:
+        """Reorder the variables of the binary quadratic model in-place.
+
+        Reordering the variables does not change the binary quadratic model,
+        only the order of its variables and therefore how they are stored.
+        Orderings that place interacting variables near each other
+        improve the memory locality of methods that iterate over the
+        interactions, such as :meth:`.energies`.
+
+        Args:
+            order: Either the variables of the binary quadratic model in their new
+                order, or the name of an ordering to generate:
+
+                * ``'rcm'``: reverse Cuthill-McKee, which reduces the bandwidth
+                  of the interaction matrix.
+                * ``'degree'``: variables sorted by increasing degree.
+
+        Returns:
+            Array ``indices`` such that the variable at index ``i`` was at
+            index ``indices[i]`` before the reordering. For example, the
+            columns of a samples array can be reordered to match
+            with ``samples[:, indices]``.
+
+        Examples:
+            >>> bqm = dimod.BinaryQuadraticModel({'a': 1, 'b': 2, 'c': 3}, {'ab': -1}, 0, 'SPIN')
+            >>> bqm.reorder_variables(['c', 'a', 'b'])
+            array([2, 0, 1])
+            >>> list(bqm.variables)
+            ['c', 'a', 'b']
+
+        """
+        return self.data.reorder_variables
+
+    @forwarding_method
+    def reserve(self, num_variables: int, num_interactions_hint: int = 0):
+        """Reserve memory for the given number of variables and interactions.
+
+        Reserving memory in advance avoids repeated reallocation as variables
+        and interactions are added. This does not change the model.
+
+        Args:
+            num_variables: Number of variables to reserve memory for.
+            num_interactions_hint: Total number of interactions the model is
+                expected to have. Memory is reserved in the neighborhood of each
+                variable currently in the model, assuming the interactions are
+                evenly distributed over ``num_variables`` variables.
+                Use :meth:`.reserve_interactions` when the degree of each
+                variable is known.
+
+        Examples:
+            >>> bqm = dimod.BinaryQuadraticModel(100, 'BINARY')
+            >>> bqm.reserve(100, 1000)
+            >>> bqm.nbytes(capacity=True) > bqm.nbytes()
+            True
+
+        """
+        return self.data.reserve
+
+    @forwarding_method
+    def reserve_interactions(self, degrees: ArrayLike):
+        """Reserve memory for the interactions of each variable.
+
+        Args:
+            degrees: Expected number of neighbors of each variable, given in
+                the order of :attr:`.variables`. May be shorter than the number
+                of variables.
+
+        Examples:
+            >>> bqm = dimod.BinaryQuadraticModel(3, 'SPIN')
+            >>> bqm.reserve_interactions([2, 1, 1])
+            >>> bqm.add_quadratic_from({(0, 1): 1, (0, 2): 1})
+
+        """
+        return self.data.reserve_interactions
+
     @forwarding_method
     def resize(self, n: int):
         """Resize a binary quadratic model to the specified number of variables.
@@ -2066,6 +2415,14 @@ class BinaryQuadraticModel(QuadraticViewsMixin):
         """
         return self.data.set_quadratic
 
+    @forwarding_method
+    def shrink_to_fit(self):
+        """Release any memory reserved beyond what is needed by the model.
+
+        See also :meth:`.reserve` and :meth:`.reserve_interactions`.
+        """
+        return self.data.shrink_to_fit
+
     def to_coo(self, fp=None, vartype_header: bool = False):
         """Serialize the binary quadratic model to a COOrdinate format encoding.
 
@@ -2089,6 +2446,89 @@ class BinaryQuadraticModel(QuadraticViewsMixin):
         else:
             coo.dump(self, fp, vartype_header)
 
+    def to_csr(self) -> Tuple[np.ndarray, np.ndarray, np.ndarray]:
+        """Return the quadratic biases as an upper-triangular sparse matrix.
+
+        Rows and columns are indexed by the position of the variables in
+        :attr:`variables`. Linear biases are not included.
+
+        Returns:
+            A ``(data, indices, indptr)`` 3-tuple of NumPy arrays in CSR format.
+            The column indices of each row are sorted.
+
+        Examples:
+            >>> bqm = dimod.BQM({'a': 1}, {'ab': -1, 'bc': 2, 'ac': .5}, 0, 'SPIN')
+            >>> data, indices, indptr = bqm.to_csr()
+            >>> list(bqm.variables)
+            ['a', 'b', 'c']
+            >>> indptr.tolist(), indices.tolist(), data.tolist()
+            ([0, 2, 3, 3], [1, 2, 2], [-1.0, 0.5, 2.0])
+
+            The arrays can be passed directly to SciPy, e.g.
+            ``scipy.sparse.csr_array(bqm.to_csr(), shape=(bqm.num_variables,)*2)``.
+        """
+        try:
+            return self.data.to_csr()
+        except NotImplementedError:
+            # methods can defer this
+            pass
+
+        index = {v: i for i, v in enumerate(self.variables)}
+
+        rows = [[] for _ in range(self.num_variables)]
+        for u, v, bias in self.iter_quadratic():
+            ui, vi = sorted((index[u], index[v]))
+            rows[ui].append((vi, bias))
+
+        indptr = [0]
+        indices = []
+        data = []
+        for row in rows:
+            row.sort(key=operator.itemgetter(0))
+            indices.extend(vi for vi, _ in row)
+            data.extend(bias for _, bias in row)
+            indptr.append(len(indices))
+
+        return (np.asarray(data, dtype=self.dtype),
+                np.asarray(indices, dtype=np.int64),
+                np.asarray(indptr, dtype=np.int64))
+
+    def to_delta(self, *, spool_size: int = int(1e9)) -> tempfile.SpooledTemporaryFile:
+        """Serialize the changes made since the last :meth:`checkpoint`.
+
+        A delta holds the current values of the biases that changed since the
+        checkpoint and the labels of the added variables, so it is typically
+        much smaller than the output of :meth:`to_file`.
+        See :mod:`dimod.serialization.delta` for the format.
+
+        Args:
+            spool_size: Defines the ``max_size`` passed to the constructor of
+                :class:`tempfile.SpooledTemporaryFile`. Determines whether
+                the returned file-like's contents is kept on disk or in
+                memory.
+
+        Returns:
+            A file-like object that can be passed to :meth:`apply_delta`.
+
+        Raises:
+            ValueError: If the model has no checkpoint, or if it was changed
+                in a way that cannot be expressed as a delta, see
+                :meth:`checkpoint`.
+
+        Examples:
+            >>> bqm = dimod.BinaryQuadraticModel({'a': 1, 'b': -1}, {'ab': 2}, 0, 'SPIN')
+            >>> remote = bqm.copy()
+            >>> bqm.checkpoint()
+            >>> bqm.set_linear('a', 1.5)
+            >>> bqm.add_quadratic('b', 'c', -1)
+            >>> remote.apply_delta(bqm.to_delta())
+            >>> remote.is_equal(bqm)
+            True
+            >>> bqm.checkpoint()  # the next delta starts from here
+
+        """
+        return write_delta(self, vartype=self.vartype, spool_size=spool_size)
+
     def to_file(self, *,
                 ignore_labels: bool = False,
                 spool_size: int = int(1e9),
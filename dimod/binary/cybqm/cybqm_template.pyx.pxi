@@ -31,7 +31,6 @@ from libcpp.vector cimport vector
 
 from dimod.binary.cybqm cimport cyBQM
 from dimod.cyutilities cimport as_numpy_float, ConstInteger
-from dimod.cyutilities import coo_sort
 from dimod.libcpp.vartypes cimport Vartype as cppVartype
 from dimod.sampleset import as_samples
 from dimod.typing import BQMVectors, LabelledBQMVectors, QuadraticVectors
@@ -241,6 +240,44 @@ cdef class cyBQM_template(cyQMBase):
         else:
             raise NotImplementedError
 
+    @cython.boundscheck(False)
+    @cython.wraparound(False)
+    def add_quadratic_from_csr(self,
+                               ConstInteger[::1] indptr,
+                               ConstInteger[::1] indices,
+                               ConstNumeric[::1] data):
+        if indptr.shape[0] < 1:
+            raise ValueError("indptr must have at least one entry")
+        if indices.shape[0] != data.shape[0]:
+            raise ValueError("indices and data should be equal length")
+
+        cdef Py_ssize_t num_rows = indptr.shape[0] - 1
+        if indptr[0] < 0 or <Py_ssize_t>indptr[num_rows] > indices.shape[0]:
+            raise ValueError("indptr does not match the length of indices")
+
+        cdef Py_ssize_t ui
+        for ui in range(num_rows):
+            if indptr[ui] > indptr[ui + 1]:
+                raise ValueError("indptr must be non-decreasing")
+
+        cdef Py_ssize_t num_variables = num_rows
+        cdef Py_ssize_t k
+        for k in range(<Py_ssize_t>indptr[0], <Py_ssize_t>indptr[num_rows]):
+            if indices[k] < 0:
+                raise ValueError("indices must be non-negative")
+            if <Py_ssize_t>indices[k] >= num_variables:
+                num_variables = indices[k] + 1
+
+        if not self.variables._is_range():
+            # let the caller handle the labels
+            raise NotImplementedError
+
+        if num_variables > self.num_variables():
+            self.resize(num_variables)
+
+        if indptr[0] < indptr[num_rows]:
+            self.cppbqm.add_quadratic_from_csr(&indptr[0], &indices[0], &data[0], num_rows)
+
     def add_variable(self, v=None, bias_type bias=0):
         v = self.variables._append(v, permissive=True)
 
@@ -381,44 +418,42 @@ cdef class cyBQM_template(cyQMBase):
         cdef Py_ssize_t vi = self._index(v, permissive=True)
         self.cppbqm.set_quadratic(ui, vi, bias)
 
-    def to_numpy_vectors(self, variable_order=None, *,
-                         sort_indices=False, sort_labels=True,
-                         return_labels=False):
-
+    def to_csr(self):
         cdef Py_ssize_t num_variables = self.cppbqm.num_variables()
         cdef Py_ssize_t num_interactions = self.cppbqm.num_interactions()
 
-        # numpy arrays, we will return these
-        ldata = np.empty(num_variables, dtype=self.dtype)
-        irow = np.empty(num_interactions, dtype=self.index_dtype)
-        icol = np.empty(num_interactions, dtype=self.index_dtype)
-        qdata = np.empty(num_interactions, dtype=self.dtype)
+        data = np.empty(num_interactions, dtype=self.dtype)
+        indices = np.empty(num_interactions, dtype=self.index_dtype)
+        indptr = np.zeros(num_variables + 1, dtype=self.index_dtype)
 
-        # views into the numpy arrays for faster cython access
-        cdef bias_type[:] ldata_view = ldata
-        cdef index_type[:] irow_view = irow
-        cdef index_type[:] icol_view = icol
-        cdef bias_type[:] qdata_view = qdata
+        cdef bias_type[::1] data_view = data
+        cdef index_type[::1] indices_view = indices
+        cdef index_type[::1] indptr_view = indptr
 
-        cdef Py_ssize_t vi
-        cdef Py_ssize_t qi = 0  # index in the quadratic arrays
-        for vi in range(num_variables):
-            span = self.cppbqm.neighborhood(vi)
+        if num_interactions:
+            self.cppbqm.to_csr(&indptr_view[0], &indices_view[0], &data_view[0])
+
+        return data, indices, indptr
+
+    def to_numpy_vectors(self, variable_order=None, *,
+                         sort_indices=False, sort_labels=True,
+                         return_labels=False):
 
-            while span.first != span.second and deref(span.first).first < vi:
-                irow_view[qi] = vi
-                icol_view[qi] = deref(span.first).first
-                qdata_view[qi] = deref(span.first).second
+        cdef Py_ssize_t num_variables = self.cppbqm.num_variables()
+        cdef Py_ssize_t num_interactions = self.cppbqm.num_interactions()
 
-                qi += 1
-                inc(span.first)
+        # if the arrays need to be in label-order rather than index-order, we
+        # write them through the permutation from index-order to label-order.
+        # That way they come out in order without being reindexed and sorted
+        cdef vector[index_type] permutation
+        cdef vector[index_type] inverse
 
-        # at this point we have the arrays but they are index-order, NOT the
-        # label-order. So we need to do some fiddling
         cdef bint is_range = self.variables._is_range()
+        cdef bint reindexed = False
 
-        cdef Py_ssize_t[:] reindex
+        cdef Py_ssize_t vi
         cdef Py_ssize_t ri
+        cdef Py_ssize_t ui
         if variable_order is not None or (sort_labels and not is_range):
             if variable_order is None:
                 variable_order = list(self.variables)
@@ -429,31 +464,95 @@ cdef class cyBQM_template(cyQMBase):
                         # can't sort unlike types in py3
                         pass
 
-            # ok, using the variable_order, calculate the re-index
-            reindex = np.full(num_variables, -1, dtype=np.intp)
+            if len(variable_order) != num_variables:
+                raise ValueError("variable_order does not match the number of variables")
+
+            permutation.resize(num_variables, -1)
+            inverse.resize(num_variables)
             for ri, v in enumerate(variable_order):
                 vi = self.variables.index(v)
-                reindex[vi] = ri
-
-                ldata_view[ri] = self.cppbqm.linear(vi)
-
-            for qi in range(num_interactions):
-                irow_view[qi] = reindex[irow_view[qi]]
-                icol_view[qi] = reindex[icol_view[qi]]
+                if permutation[vi] >= 0:
+                    raise ValueError(f"{v!r} appears more than once in variable_order")
+                permutation[vi] = ri
+                inverse[ri] = vi
 
+            reindexed = True
             labels = variable_order
-
         else:
-            # the fast case! We don't need to do anything except construct the
-            # linear
+            permutation.resize(num_variables)
+            inverse.resize(num_variables)
             for vi in range(num_variables):
-                ldata_view[vi] = self.cppbqm.linear(vi)
+                permutation[vi] = vi
+                inverse[vi] = vi
 
             if return_labels:
                 labels = list(self.variables)
 
+        # numpy arrays, we will return these
+        ldata = np.empty(num_variables, dtype=self.dtype)
+        irow = np.empty(num_interactions, dtype=self.index_dtype)
+        icol = np.empty(num_interactions, dtype=self.index_dtype)
+        qdata = np.empty(num_interactions, dtype=self.dtype)
+
+        # views into the numpy arrays for faster cython access
+        cdef bias_type[:] ldata_view = ldata
+        cdef index_type[:] irow_view = irow
+        cdef index_type[:] icol_view = icol
+        cdef bias_type[:] qdata_view = qdata
+
+        for ri in range(num_variables):
+            ldata_view[ri] = self.cppbqm.linear(inverse[ri])
+
+        cdef Py_ssize_t qi = 0  # index in the quadratic arrays
+        cdef vector[Py_ssize_t] row_next
+
         if sort_indices:
-            coo_sort(irow, icol, qdata)
+            # a counting sort of the upper triangle. First find where each
+            # row starts
+            row_next.resize(num_variables + 1, 0)
+            for vi in range(num_variables):
+                ri = permutation[vi]
+                it = self.cppbqm.cbegin_neighborhood(vi)
+                end = self.cppbqm.cend_neighborhood(vi)
+                while it != end:
+                    if permutation[deref(it).v] >= ri:
+                        row_next[ri + 1] += 1
+                    inc(it)
+            for ri in range(num_variables):
+                row_next[ri + 1] += row_next[ri]
+
+            # then visit the columns in order, so each row is filled in
+            # sorted order
+            for ri in range(num_variables):
+                vi = inverse[ri]
+                it = self.cppbqm.cbegin_neighborhood(vi)
+                end = self.cppbqm.cend_neighborhood(vi)
+                while it != end:
+                    ui = permutation[deref(it).v]
+                    if ui <= ri:
+                        qi = row_next[ui]
+                        irow_view[qi] = ui
+                        icol_view[qi] = ri
+                        qdata_view[qi] = deref(it).bias
+                        row_next[ui] += 1
+                    inc(it)
+        else:
+            for ri in range(num_variables):
+                vi = inverse[ri]
+                it = self.cppbqm.cbegin_neighborhood(vi)
+                end = self.cppbqm.cend_neighborhood(vi)
+                while it != end:
+                    ui = permutation[deref(it).v]
+                    if ui < ri:
+                        irow_view[qi] = ri
+                        icol_view[qi] = ui
+                        qdata_view[qi] = deref(it).bias
+                        qi += 1
+                    elif not reindexed:
+                        # the neighborhood is sorted, so the rest of it is in
+                        # the upper triangle
+                        break
+                    inc(it)
 
         if return_labels:
             return LabelledBQMVectors(ldata, QuadraticVectors(irow, icol, qdata), self.offset, labels)
@@ -461,17 +560,22 @@ cdef class cyBQM_template(cyQMBase):
             return BQMVectors(ldata, QuadraticVectors(irow, icol, qdata), self.offset)
 
     def _update(self, cyBQM other):
+        if self.cppbqm.vartype() != other.cppbqm.vartype():
+            # let the caller handle the vartype conversion
+            raise NotImplementedError
+
         # get the reindexing
-        cdef vector[Py_ssize_t] mapping
+        cdef vector[index_type] mapping
         mapping.reserve(other.num_variables())
         for v in other.variables:
             mapping.push_back(self.variables.index(v, permissive=True))
 
-        raise NotImplementedError
+        if self.variables.size() > self.cppbqm.num_variables():
+            self.cppbqm.resize(self.variables.size())
 
-        # self.cppbqm.add_bqm(other.cppbqm, mapping)
+        self.cppbqm.add_model(deref(other.base), mapping)
 
-        # assert self.variables.size() == self.cppbqm.num_variables()
+        assert self.variables.size() == self.cppbqm.num_variables()
 
     def update(self, other):
         try:
@@ -116,6 +116,9 @@ class pyBQM:
         else:
             raise RuntimeError("unexpected vartype")
 
+    def add_quadratic_from_csr(self, *args, **kwargs):
+        raise NotImplementedError  # defer to the caller
+
     def add_variable(self, v: Optional[Variable] = None,
                      bias: Any = 0) -> Variable:
         if v is None:
@@ -173,10 +176,22 @@ class pyBQM:
 
         return self
 
+    def checkpoint(self) -> typing.NoReturn:
+        raise TypeError(
+            "cannot record the changes to a binary quadratic model with object dtype")
+
     def clear(self) -> None:
         self._adj.clear()
         self.offset = 0
 
+    def content_hash(self, *args, **kwargs) -> typing.NoReturn:
+        raise TypeError(
+            "cannot hash the content of a binary quadratic model with object dtype")
+
+    def _idelta(self) -> typing.NoReturn:
+        raise TypeError(
+            "cannot record the changes to a binary quadratic model with object dtype")
+
     def degree(self, v: Variable) -> int:
         try:
             return len(self._adj[v]) - 1
@@ -215,6 +230,22 @@ class pyBQM:
 
         return np.asarray(energies, dtype=dtype)
 
+    def fix_variables(self, fixed):
+        # later assignments of a repeated variable win
+        if not isinstance(fixed, Mapping):
+            fixed = dict(fixed)
+
+        # check them all before changing anything
+        for v in fixed:
+            if v not in self._adj:
+                raise ValueError(f"unknown variable {v!r}")
+
+        for v, value in fixed.items():
+            for u, bias in self.iter_neighborhood(v):
+                self.add_linear(u, value*bias)
+            self.offset += value*self.get_linear(v)
+            self.remove_variable(v)
+
     def get_linear(self, v: Variable) -> Any:
         try:
             return self._adj[v][v]
@@ -254,6 +285,25 @@ class pyBQM:
                 if v not in seen:
                     yield u, v, bias
 
+    def local_fields(self, samples_like, *, num_threads: int = 1) -> np.ndarray:
+        samples, labels = as_samples(samples_like)
+
+        bqm_to_sample = dict((v, i) for i, v in enumerate(labels))
+
+        if not bqm_to_sample.keys() >= self._adj.keys():
+            raise ValueError(
+                f"missing variable {(self._adj.keys() - bqm_to_sample.keys()).pop()!r} in sample(s)"
+                )
+
+        fields = np.empty((samples.shape[0], self.num_variables()), dtype=object)
+        for vi, v in enumerate(self.variables):
+            fields[:, vi] = self.get_linear(v)
+            for u, bias in self.iter_neighborhood(v):
+                fields[:, vi] += bias * samples[:, bqm_to_sample[u]]
+
+        # let numpy find the narrowest dtype that holds the biases
+        return np.asarray(fields.tolist()).reshape(fields.shape)
+
     def nbytes(self, *args, **kwargs) -> typing.NoReturn:
         raise TypeError(
             "cannot return the number of bytes for a binary quadratic model with object dtype")
@@ -341,6 +391,46 @@ class pyBQM:
 
         return v
 
+    def reorder_variables(self, order='rcm') -> np.ndarray:
+        variables = list(self._adj)
+
+        if isinstance(order, str):
+            if order == 'degree':
+                labels = sorted(variables, key=self.degree)
+            elif order == 'rcm':
+                # reverse Cuthill-McKee, see dimod/include/dimod/orderings.h
+                visited = set()
+                labels = []
+                for start in sorted(variables, key=self.degree):
+                    if start in visited:
+                        continue
+                    visited.add(start)
+                    labels.append(start)
+
+                    head = len(labels) - 1
+                    while head < len(labels):
+                        new = [v for v in self._adj[labels[head]] if v not in visited]
+                        visited.update(new)
+                        labels.extend(sorted(new, key=self.degree))
+                        head += 1
+                labels.reverse()
+            else:
+                raise ValueError(f"unknown ordering {order!r}, expected 'rcm' or 'degree'")
+        else:
+            labels = list(order)
+            if len(labels) != len(variables) or set(labels) != self._adj.keys():
+                raise ValueError("order must contain every variable in the model exactly once")
+
+        index = {v: i for i, v in enumerate(variables)}
+        self._adj = {v: self._adj[v] for v in labels}
+        return np.fromiter((index[v] for v in labels), dtype=np.intp, count=len(labels))
+
+    def reserve(self, num_variables: int, num_interactions_hint: int = 0):
+        pass  # dicts cannot reserve capacity
+
+    def reserve_interactions(self, degrees):
+        pass  # dicts cannot reserve capacity
+
     def resize(self, n: int):
         while n > self.num_variables():
             self.add_variable()
@@ -357,6 +447,12 @@ class pyBQM:
         self.add_variable(v)
         self._adj[u][v] = self._adj[v][u] = bias
 
+    def shrink_to_fit(self):
+        pass
+
+    def to_csr(self, *args, **kwargs):
+        raise NotImplementedError  # defer to the caller
+
     def to_numpy_vectors(self, *args, **kwargs):
         raise NotImplementedError  # defer to the caller
 
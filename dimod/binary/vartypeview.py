@@ -130,6 +130,9 @@ class VartypeView:
             self.data.add_linear(v, -2*bias)
             self.data.offset += bias
 
+    def add_quadratic_from_csr(self, *args, **kwargs):
+        raise NotImplementedError  # defer to the caller
+
     def add_variable(self, v: Optional[Variable] = None,
                      bias: Bias = 0) -> Variable:
         v = self.data.add_variable(v)
@@ -139,9 +142,27 @@ class VartypeView:
     def change_vartype(self, vartype: VartypeLike):
         self._vartype = as_vartype(vartype)
 
+    @view_method
+    def checkpoint(self):
+        # the changes are recorded with the vartype of the underlying data
+        raise TypeError("cannot record the changes to a view with a different vartype")
+
     def clear(self) -> None:
         return self.data.clear()
 
+    @view_method
+    def content_hash(self, *, num_threads: int = 1) -> int:
+        # the hash covers the biases, so hash a copy with our vartype
+        return copy.copy(self).content_hash(num_threads=num_threads)
+
+    @view_method
+    def _iapply_delta(self, *args, **kwargs):
+        raise TypeError("cannot apply a delta to a view with a different vartype")
+
+    @view_method
+    def _idelta(self):
+        raise TypeError("cannot record the changes to a view with a different vartype")
+
     def degree(self, v: Variable):
         return self.data.degree(v)
 
@@ -158,6 +179,20 @@ class VartypeView:
 
         return self.data.energies((samples, labels), dtype=dtype)
 
+    @view_method
+    def fix_variables(self, fixed):
+        if isinstance(fixed, Mapping):
+            fixed = fixed.items()
+
+        # fixing a variable of the view fixes the underlying variable to the
+        # corresponding value
+        if self._vartype is BINARY:  # binary -> spin
+            fixed = ((v, 2 * value - 1) for v, value in fixed)
+        else:  # spin -> binary
+            fixed = ((v, (value + 1) / 2) for v, value in fixed)
+
+        self.data.fix_variables(fixed)
+
     @view_method
     def get_linear(self, v: Variable) -> Bias:
         if self._vartype is BINARY:  # binary <- spin
@@ -205,6 +240,22 @@ class VartypeView:
             for u, v, bias in self.data.iter_quadratic():
                 yield u, v, bias / 4
 
+    @view_method
+    def local_fields(self, samples_like, *, num_threads: int = 1) -> np.ndarray:
+        samples, labels = as_samples(samples_like, copy=True)
+
+        # the local fields are derivatives, so they scale with the change of variables
+        if self._vartype is BINARY:  # binary -> spin
+            samples *= 2
+            samples -= 1
+            scale = 2
+        else:  # spin -> binary
+            samples += 1
+            samples //= 2
+            scale = .5
+
+        return scale * self.data.local_fields((samples, labels), num_threads=num_threads)
+
     def nbytes(self, capacity: bool = False) -> int:
         return self.data.nbytes(capacity=capacity)
 
@@ -260,6 +311,15 @@ class VartypeView:
     def relabel_variables(self, mapping: Mapping[Variable, Variable]):
         self.data.relabel_variables(mapping)
 
+    def reorder_variables(self, order='rcm'):
+        return self.data.reorder_variables(order)
+
+    def reserve(self, num_variables: int, num_interactions_hint: int = 0):
+        self.data.reserve(num_variables, num_interactions_hint)
+
+    def reserve_interactions(self, degrees):
+        self.data.reserve_interactions(degrees)
+
     def relabel_variables_as_integers(self) -> Mapping[int, Variable]:
         return self.data.relabel_variables_as_integers()
 
@@ -275,6 +335,12 @@ class VartypeView:
         self.add_quadratic(u, v, 0)  # make sure it exists
         self.add_quadratic(u, v, bias - self.get_quadratic(u, v))
 
+    def shrink_to_fit(self):
+        self.data.shrink_to_fit()
+
+    def to_csr(self, *args, **kwargs):
+        raise NotImplementedError  # defer to the caller
+
     def to_numpy_vectors(self, *args, **kwargs):
         raise NotImplementedError  # defer to the caller
 
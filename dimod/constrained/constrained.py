@@ -47,6 +47,7 @@ from __future__ import annotations
 import collections.abc
 import copy
 import io
+import itertools
 import json
 import os.path
 import re
@@ -58,7 +59,7 @@ import zipfile
 from io import StringIO
 from numbers import Number
 from typing import Hashable, Optional, Union, BinaryIO, ByteString, Iterable, Collection, Dict
-from typing import Callable, MutableMapping, Iterator, Tuple, Mapping, Any, NamedTuple
+from typing import Callable, MutableMapping, Iterator, Tuple, Mapping, Any, NamedTuple, List
 
 import numpy as np
 
@@ -66,14 +67,17 @@ from dimod.binary.binary_quadratic_model import BinaryQuadraticModel, Binary
 from dimod.constrained.cyconstrained import cyConstrainedQuadraticModel, ConstraintView, ObjectiveView
 from dimod.quadratic.quadratic_model import QuadraticModel
 from dimod.sampleset import as_samples
+from dimod.serialization.delta import DELTA_MAGIC_PREFIX, DELTA_SERIALIZATION_VERSION
+from dimod.serialization.delta import VarinfoDeltaSection, _varinfo_dtype
+from dimod.serialization.delta import apply_delta_biases, read_delta, write_expression_delta
 from dimod.serialization.fileview import (
     _BytesIO, SpooledTemporaryFile,
     load, read_header, write_header,
     VartypesSection,
     )
 from dimod.sym import Comparison, Sense
-from dimod.typing import Bias, Variable, SamplesLike
-from dimod.utilities import new_variable_label
+from dimod.typing import ArrayLike, Bias, Variable, SamplesLike
+from dimod.utilities import asintegerarrays, new_variable_label
 from dimod.variables import serialize_variable, deserialize_variable, Variables
 from dimod.vartypes import as_vartype, Vartype, VartypeLike
 
@@ -84,6 +88,46 @@ CQM_MAGIC_PREFIX = b'DIMODCQM'
 CQM_SERIALIZATION_VERSION = (2, 0)
 
 
+def _read_constraint_attributes(zf: zipfile.ZipFile, lstr: str
+                                ) -> Tuple[str, float, Optional[float], Optional[str], bool]:
+    """Read the sense, rhs, weight, penalty and discrete marker of a constraint."""
+    rhs = np.frombuffer(zf.read(f"constraints/{lstr}/rhs"), np.float64)[0]
+    sense = zf.read(f"constraints/{lstr}/sense").decode('ascii')
+
+    try:
+        weight = np.frombuffer(zf.read(f"constraints/{lstr}/weight"), np.float64)[0]
+        penalty = zf.read(f"constraints/{lstr}/penalty").decode('ascii')
+    except KeyError:
+        weight = None
+        penalty = None
+
+    try:
+        discrete = any(zf.read(f"constraints/{lstr}/discrete"))
+    except KeyError:
+        discrete = False
+
+    return sense, rhs, weight, penalty, discrete
+
+
+def _write_constraint_attributes(zf: zipfile.ZipFile, lstr: str, constraint: Comparison):
+    """Write the rhs, sense, discrete marker, weight and penalty of a constraint."""
+    rhs = np.float64(constraint.rhs).tobytes()
+    zf.writestr(f'constraints/{lstr}/rhs', rhs)
+
+    sense = bytes(constraint.sense.value, 'ascii')
+    zf.writestr(f'constraints/{lstr}/sense', sense)
+
+    if constraint.lhs.is_discrete():
+        zf.writestr(f'constraints/{lstr}/discrete', bytes((True,)))
+
+    # soft constraints
+    if constraint.lhs.is_soft():
+        weight = np.float64(constraint.lhs.weight()).tobytes()
+        penalty = bytes(constraint.lhs.penalty(), 'ascii')
+        zf.writestr(f'constraints/{lstr}/weight', weight)
+        zf.writestr(f'constraints/{lstr}/penalty', penalty)
+
+
 class ConstraintData(NamedTuple):
     label: Hashable
     lhs_energy: float
@@ -443,6 +487,142 @@ class ConstrainedQuadraticModel(cyConstrainedQuadraticModel):
 
         return super().add_constraint_from_iterable(iterable, sense, rhs, label, weight, penalty)
 
+    def add_linear_constraints_from_arrays(self,
+                                           indptr: ArrayLike,
+                                           indices: ArrayLike,
+                                           coefficients: ArrayLike,
+                                           senses: Union[Sense, str, Collection[Union[Sense, str]]],
+                                           rhs: ArrayLike,
+                                           labels: Optional[Collection[Hashable]] = None,
+                                           ) -> List[Hashable]:
+        """Add many linear constraints given in Compressed Sparse Row format.
+
+        Constraint ``c`` is
+        ``sum(coefficients[k] * variables[indices[k]]) senses[c] rhs[c]`` over
+        ``k`` in ``range(indptr[c], indptr[c+1])``. The constraints are all
+        added in a single call, which is much faster than adding them one at
+        a time.
+
+        Args:
+            indptr: Array of length ``num_constraints + 1``. The terms of
+                constraint ``c`` are at positions ``indptr[c]`` to
+                ``indptr[c+1]`` of ``indices`` and ``coefficients``.
+
+            indices: Indices of the variables in each constraint, as in
+                ``cqm.variables``. The variables must have already been added
+                to the model. Repeated variables within a constraint are summed.
+
+            coefficients: Linear coefficient of each term.
+
+            senses: One of `<=`, `>=`, `==` for every constraint, or a single
+                sense for all of them.
+
+            rhs: Right-hand side of each constraint.
+
+            labels: Labels for the constraints. Must be unique. If not
+                provided, labels are generated using :mod:`uuid`.
+
+        Returns:
+            Labels of the added constraints.
+
+        Examples:
+            >>> from dimod import ConstrainedQuadraticModel
+            >>> cqm = ConstrainedQuadraticModel()
+            >>> cqm.add_variables('BINARY', 'xyz')
+            >>> labels = cqm.add_linear_constraints_from_arrays(
+            ...     [0, 2, 5], [0, 1, 0, 1, 2], [1, 2, 1, 1, 1], ['<=', '=='], [2, 1],
+            ...     labels=['c0', 'c1'])
+            >>> print(cqm.constraints['c0'].to_polystring())
+            x + 2*y <= 2.0
+            >>> print(cqm.constraints['c1'].to_polystring())
+            x + y + z == 1.0
+
+        """
+        indptr, indices = asintegerarrays(indptr, indices, min_itemsize=4, requirements='C')
+        coefficients = np.ascontiguousarray(coefficients, dtype=self.dtype)
+        rhs = np.ascontiguousarray(rhs, dtype=self.dtype)
+
+        senses = self._as_senses(senses, rhs.shape[0])
+        labels = self._as_new_constraint_labels(labels, rhs.shape[0])
+
+        super().add_linear_constraints_from_arrays(
+            indptr, indices, coefficients, senses, rhs, labels)
+
+        return labels
+
+    def add_quadratic_constraints_from_arrays(self,
+                                              indptr: ArrayLike,
+                                              indices: ArrayLike,
+                                              coefficients: ArrayLike,
+                                              qindptr: ArrayLike,
+                                              qrow: ArrayLike,
+                                              qcol: ArrayLike,
+                                              qcoefficients: ArrayLike,
+                                              senses: Union[Sense, str, Collection[Union[Sense, str]]],
+                                              rhs: ArrayLike,
+                                              labels: Optional[Collection[Hashable]] = None,
+                                              ) -> List[Hashable]:
+        """Add many quadratic constraints given as arrays.
+
+        The linear terms are given in Compressed Sparse Row format, as in
+        :meth:`add_linear_constraints_from_arrays`. The quadratic terms of
+        constraint ``c`` are
+        ``qcoefficients[k] * variables[qrow[k]] * variables[qcol[k]]`` over
+        ``k`` in ``range(qindptr[c], qindptr[c+1])``.
+
+        Args:
+            indptr: Array of length ``num_constraints + 1`` delimiting the
+                linear terms of each constraint.
+
+            indices: Indices of the variables of the linear terms.
+
+            coefficients: Coefficient of each linear term.
+
+            qindptr: Array of length ``num_constraints + 1`` delimiting the
+                quadratic terms of each constraint.
+
+            qrow: Index of the first variable of each quadratic term.
+
+            qcol: Index of the second variable of each quadratic term.
+
+            qcoefficients: Coefficient of each quadratic term.
+
+            senses: One of `<=`, `>=`, `==` for every constraint, or a single
+                sense for all of them.
+
+            rhs: Right-hand side of each constraint.
+
+            labels: Labels for the constraints. Must be unique. If not
+                provided, labels are generated using :mod:`uuid`.
+
+        Returns:
+            Labels of the added constraints.
+
+        Examples:
+            >>> from dimod import ConstrainedQuadraticModel
+            >>> cqm = ConstrainedQuadraticModel()
+            >>> cqm.add_variables('INTEGER', 'ij')
+            >>> labels = cqm.add_quadratic_constraints_from_arrays(
+            ...     [0, 1], [0], [2], [0, 1], [0], [1], [3], '<=', [5], labels=['c'])
+            >>> print(cqm.constraints['c'].to_polystring())
+            2*i + 3*i*j <= 5.0
+
+        """
+        indptr, indices, qindptr, qrow, qcol = asintegerarrays(
+            indptr, indices, qindptr, qrow, qcol, min_itemsize=4, requirements='C')
+        coefficients = np.ascontiguousarray(coefficients, dtype=self.dtype)
+        qcoefficients = np.ascontiguousarray(qcoefficients, dtype=self.dtype)
+        rhs = np.ascontiguousarray(rhs, dtype=self.dtype)
+
+        senses = self._as_senses(senses, rhs.shape[0])
+        labels = self._as_new_constraint_labels(labels, rhs.shape[0])
+
+        super().add_quadratic_constraints_from_arrays(
+            indptr, indices, coefficients, qindptr, qrow, qcol, qcoefficients,
+            senses, rhs, labels)
+
+        return labels
+
     def add_discrete(self, data, *args, **kwargs) -> Hashable:
         """A convenience wrapper for other methods that add one-hot constraints.
 
@@ -760,6 +940,99 @@ class ConstrainedQuadraticModel(cyConstrainedQuadraticModel):
         super().add_variables(vartype, (v,), lower_bound=lower_bound, upper_bound=upper_bound)
         return self.variables[-1] if v is None else v
 
+    def apply_delta(self, fp: Union[BinaryIO, ByteString]) -> None:
+        """Apply changes serialized by :meth:`to_delta`.
+
+        The constrained quadratic model must be the same as the model the
+        delta was made from, as it was at its last :meth:`checkpoint`. After
+        the delta is applied, it is the same as the model when the delta was
+        made.
+
+        Args:
+            fp: Bytes-like object or readable file-like object, as returned
+                by :meth:`to_delta`.
+
+        Raises:
+            ValueError: If the delta was made from a model of a different
+                type, or with a different number of variables or constraints
+                at its checkpoint, or if it adds variables that are already
+                in the model.
+
+        See :meth:`to_delta` for an example.
+
+        """
+        if isinstance(fp, ByteString):
+            file_like: BinaryIO = _BytesIO(fp)  # type: ignore[assignment]
+        else:
+            file_like = fp
+
+        header_info = read_header(file_like, DELTA_MAGIC_PREFIX)
+
+        if header_info.version > DELTA_SERIALIZATION_VERSION:
+            raise ValueError("cannot load a delta serialized with version "
+                             f"{header_info.version!r}, try upgrading your dimod version")
+
+        data = header_info.data
+
+        if data['type'] != type(self).__name__:
+            raise ValueError(f"cannot apply a delta of a {data['type']} "
+                             f"to a {type(self).__name__}")
+        if data['base_num_variables'] != len(self.variables):
+            raise ValueError(f"the delta was made from a model with "
+                             f"{data['base_num_variables']} variables, this model "
+                             f"has {len(self.variables)}")
+        if data['base_num_constraints'] != len(self.constraints):
+            raise ValueError(f"the delta was made from a model with "
+                             f"{data['base_num_constraints']} constraints, this model "
+                             f"has {len(self.constraints)}")
+
+        with zipfile.ZipFile(file_like, mode='r') as zf:
+            with zf.open("varinfo") as f:
+                varinfo = VarinfoDeltaSection.load(
+                    f,
+                    dtype=_varinfo_dtype(np.dtype(data['dtype']), np.dtype(data['itype'])),
+                    count=data['num_varinfo'])
+
+            variables = list(map(deserialize_variable,
+                                 json.loads(zf.read("variable_labels.json"))))
+            if len(variables) != data['num_variables'] - data['base_num_variables']:
+                raise ValueError("the number of added variables does not match the header")
+
+            # checks the labels before making any changes
+            self._ivarinfo_update(varinfo, variables)
+
+            def load_expression(expression, path):
+                try:
+                    with zf.open(path) as f:
+                        expression._iclear()
+                        expression._from_file(f)
+                except KeyError:
+                    with zf.open(f"{path}_delta") as f:
+                        apply_delta_biases(expression, read_delta(f))
+
+            names = zf.namelist()
+
+            if "objective" in names or "objective_delta" in names:
+                load_expression(self.objective, "objective")
+
+            # the changed constraints followed by the added ones, in order
+            constraints = dict.fromkeys(
+                match.group(1) for match in map(re.compile("constraints/([^/]+)/").match, names)
+                if match is not None)
+
+            for constraint in constraints:
+                label = deserialize_variable(json.loads(constraint))
+
+                sense, rhs, weight, penalty, discrete = _read_constraint_attributes(zf, constraint)
+
+                if not self.constraint_labels.count(label):
+                    self.add_constraint_from_iterable([], sense, rhs, label=label,
+                                                      weight=weight, penalty=penalty)
+
+                load_expression(self.constraints[label].lhs, f"constraints/{constraint}/lhs")
+
+                self._iset_constraint(label, sense, rhs, weight, penalty, discrete)
+
     def check_feasible(self, sample_like: SamplesLike, rtol: float = 1e-6, atol: float = 1e-8) -> bool:
         r"""Return the feasibility of the given sample.
 
@@ -1093,15 +1366,7 @@ class ConstrainedQuadraticModel(cyConstrainedQuadraticModel):
             for constraint in constraint_labels:                
                 label = deserialize_variable(json.loads(constraint))
 
-                rhs = np.frombuffer(zf.read(f"constraints/{constraint}/rhs"), np.float64)[0]
-                sense = zf.read(f"constraints/{constraint}/sense").decode('ascii')
-
-                try:
-                    weight = np.frombuffer(zf.read(f"constraints/{constraint}/weight"), np.float64)[0]
-                    penalty = zf.read(f"constraints/{constraint}/penalty").decode('ascii')
-                except KeyError:
-                    weight = None
-                    penalty = None
+                sense, rhs, weight, penalty, discrete = _read_constraint_attributes(zf, constraint)
 
                 # add the constraint with everything except the lhs
                 cqm.add_constraint_from_iterable([], sense, rhs, label=label,
@@ -1112,11 +1377,8 @@ class ConstrainedQuadraticModel(cyConstrainedQuadraticModel):
                 with zf.open(f"constraints/{constraint}/lhs") as f:
                     comp.lhs._from_file(f)
 
-                try:
-                    if any(zf.read(f"constraints/{constraint}/discrete")):
-                        comp.lhs.mark_discrete(True)
-                except KeyError:
-                    pass
+                if discrete:
+                    comp.lhs.mark_discrete(True)
 
             # relabel the variables if needed
             try:  # This is the only way to test whether a file exists
@@ -1340,6 +1602,35 @@ class ConstrainedQuadraticModel(cyConstrainedQuadraticModel):
         return (self.objective.is_linear() and
                 all(comp.lhs.is_linear() for comp in self.constraints.values()))
 
+    def _as_new_constraint_labels(self, labels: Optional[Collection[Hashable]],
+                                  num_constraints: int) -> List[Hashable]:
+        # check or generate the labels for num_constraints new constraints
+        if labels is None:
+            labels = []
+            generated = set()
+            while len(labels) < num_constraints:
+                label = self._new_constraint_label()
+                if label not in generated:
+                    generated.add(label)
+                    labels.append(label)
+            return labels
+
+        labels = list(labels)
+        if len(labels) != num_constraints:
+            raise ValueError("labels must have one label for each constraint")
+        if len(set(labels)) != len(labels):
+            raise ValueError("labels must be unique")
+        if any(label in self.constraint_labels for label in labels):
+            raise ValueError("a constraint with that label already exists")
+        return labels
+
+    @staticmethod
+    def _as_senses(senses: Union[Sense, str, Collection[Union[Sense, str]]],
+                   num_constraints: int) -> List[Sense]:
+        if isinstance(senses, (Sense, str)):
+            return [Sense(senses)] * num_constraints
+        return [Sense(sense) for sense in senses]
+
     def _new_constraint_label(self) -> str:
         # we support up to 100k constraints and :6 gives us 16777216
         # possible so pretty safe
@@ -1478,6 +1769,7 @@ class ConstrainedQuadraticModel(cyConstrainedQuadraticModel):
         """
         discrete_indices = [self.constraint_labels.index(c) for c in self.discrete]
         self.constraint_labels._relabel(mapping)
+        self._invalidate_journal()  # the delta would need the old labels
         self.discrete.clear()
         self.discrete |= (self.constraint_labels[i] for i in discrete_indices)
 
@@ -1501,6 +1793,7 @@ class ConstrainedQuadraticModel(cyConstrainedQuadraticModel):
             return copy.deepcopy(self).relabel_variables(mapping, inplace=True)
 
         self.variables._relabel(mapping)
+        self._invalidate_journal()  # the delta would need the old labels
 
         return self
 
@@ -1566,9 +1859,8 @@ class ConstrainedQuadraticModel(cyConstrainedQuadraticModel):
         if not inplace:
             return copy.deepcopy(self).spin_to_binary(inplace=True)
 
-        for v in self.variables:
-            if self.vartype(v) is Vartype.SPIN:
-                self.change_vartype(Vartype.BINARY, v)
+        self.change_vartypes(Vartype.BINARY,
+                             [v for v in self.variables if self.vartype(v) is Vartype.SPIN])
 
         return self
 
@@ -1644,6 +1936,160 @@ class ConstrainedQuadraticModel(cyConstrainedQuadraticModel):
 
         return mapping
 
+    def to_delta(self, *,
+                 spool_size: int = int(1e9),
+                 compress: bool = False,
+                 ) -> tempfile.SpooledTemporaryFile:
+        """Serialize the changes made since the last :meth:`checkpoint`.
+
+        A delta holds the variable types and bounds that changed since the
+        checkpoint, the labels of the added variables, and the objective and
+        constraints that changed or were added. An expression whose changes
+        are known is sent as the current values of the changed biases, and
+        otherwise in full, so the delta is typically much smaller than the
+        output of :meth:`to_file`.
+
+        Args:
+            spool_size: Defines the ``max_size`` passed to the constructor of
+                :class:`tempfile.SpooledTemporaryFile`. Determines whether
+                the returned file-like's contents is kept on disk or in
+                memory.
+
+            compress: If True, the data will be compressed with
+                :class:`zipfile.ZIP_DEFLATED`.
+
+        Returns:
+            A file-like object that can be passed to :meth:`apply_delta`.
+
+        Raises:
+            ValueError: If the model has no checkpoint, or if it was changed
+                in a way that cannot be expressed as a delta, see
+                :meth:`checkpoint`.
+
+        Format Specification (Version 1.0):
+
+            The header is the same as the one described in
+            :mod:`dimod.serialization.delta`, with a ``"DIMODDELTA"`` magic
+            string. The header data is exactly:
+
+            .. code-block:: python
+
+                dict(type=type(cqm).__name__,
+                     dtype=cqm.dtype.name,
+                     itype=cqm.index_dtype.name,
+                     base_num_variables=num_variables_at_checkpoint,
+                     num_variables=len(cqm.variables),
+                     base_num_constraints=num_constraints_at_checkpoint,
+                     num_constraints=len(cqm.constraints),
+                     num_varinfo=len(varinfo),
+                     )
+
+            The changes come after the header. They are encoded as a zip file
+            with the following structure
+
+            .. code-block:: bash
+
+                constraints/
+                    <label>/
+                        lhs | lhs_delta
+                        rhs
+                        sense
+                        [discrete]
+                        [penalty]
+                        [weight]
+                    ...
+                [objective | objective_delta]
+                varinfo
+                variable_labels.json
+
+            The ``varinfo`` file encodes the variable type and bounds of the
+            changed variables followed by the added ones, as the ``DVAR``
+            section of :mod:`dimod.serialization.delta`. The labels of the
+            added variables are encoded as a json-formatted string in
+            ``variable_labels.json``.
+
+            Only the objective and constraints that may have changed are
+            included, the constraints in index order. An ``objective`` or
+            ``lhs`` file encodes the expression in full, as in
+            :meth:`to_file`. An ``objective_delta`` or ``lhs_delta`` file
+            encodes the changes to the expression as a delta, with the
+            variables indexed as they are in the model. The other constraint
+            files are as in :meth:`to_file`.
+
+        Examples:
+            >>> import copy
+            >>> x, y, z = dimod.Binaries(['x', 'y', 'z'])
+            >>> cqm = dimod.ConstrainedQuadraticModel()
+            >>> cqm.set_objective(x + 2*y)
+            >>> cqm.add_constraint(x + y <= 1, label='c0')
+            'c0'
+            >>> remote = copy.deepcopy(cqm)
+            >>> cqm.checkpoint()
+            >>> cqm.objective.set_linear('y', 3)
+            >>> cqm.add_constraint(y + z == 1, label='c1')
+            'c1'
+            >>> remote.apply_delta(cqm.to_delta())
+            >>> remote.is_equal(cqm)
+            True
+
+        """
+        delta = self._idelta()
+        if delta is None:
+            raise ValueError(
+                "the model has no checkpoint, or was changed in a way that cannot "
+                "be expressed as a delta (for instance by removing or relabeling "
+                "variables or constraints), call checkpoint() and send the full "
+                "model instead")
+
+        base_num_variables = delta['num_variables']
+        base_num_constraints = delta['num_constraints']
+
+        file = SpooledTemporaryFile(max_size=spool_size)
+
+        data = dict(type=type(self).__name__,
+                    dtype=np.dtype(self.dtype).name,
+                    itype=np.dtype(self.index_dtype).name,
+                    base_num_variables=base_num_variables,
+                    num_variables=len(self.variables),
+                    base_num_constraints=base_num_constraints,
+                    num_constraints=len(self.constraints),
+                    num_varinfo=len(delta['varinfo']),
+                    )
+
+        write_header(file, DELTA_MAGIC_PREFIX, data, version=DELTA_SERIALIZATION_VERSION)
+
+        def dump_expression(zf, expression, path):
+            expression_delta = expression._idelta()
+            if expression_delta is None:
+                with zf.open(path, "w", force_zip64=True) as fdst:
+                    expression._into_file(fdst)
+            else:
+                with zf.open(f"{path}_delta", "w", force_zip64=True) as fdst:
+                    write_expression_delta(fdst, expression, expression_delta)
+
+        kwargs = dict(compression=zipfile.ZIP_DEFLATED) if compress else dict()
+        with zipfile.ZipFile(file, mode='a', **kwargs) as zf:
+            zf.writestr("varinfo", VarinfoDeltaSection(delta['varinfo']).dumps())
+            zf.writestr("variable_labels.json", json.dumps(
+                [serialize_variable(v) for v in self.variables[base_num_variables:]]))
+
+            if delta['objective_changed']:
+                dump_expression(zf, self.objective, "objective")
+
+            changed = itertools.chain(delta['constraints'],
+                                      range(base_num_constraints, len(self.constraints)))
+            for ci in changed:
+                label = self.constraint_labels[ci]
+                constraint = self.constraints[label]
+                lstr = json.dumps(serialize_variable(label))
+
+                dump_expression(zf, constraint.lhs, f'constraints/{lstr}/lhs')
+
+                _write_constraint_attributes(zf, lstr, constraint)
+
+        file.seek(0)
+        return file
+
     def to_file(self, *,
                 spool_size: int = int(1e9),
                 compress: bool = False,
@@ -1804,21 +2250,7 @@ class ConstrainedQuadraticModel(cyConstrainedQuadraticModel):
                 with zf.open(f'constraints/{lstr}/lhs', "w", force_zip64=True) as fdst:
                     constraint.lhs._into_file(fdst)
 
-                rhs = np.float64(constraint.rhs).tobytes()
-                zf.writestr(f'constraints/{lstr}/rhs', rhs)
-
-                sense = bytes(constraint.sense.value, 'ascii')
-                zf.writestr(f'constraints/{lstr}/sense', sense)
-
-                if constraint.lhs.is_discrete():
-                    zf.writestr(f'constraints/{lstr}/discrete', bytes((True,)))
-
-                # soft constraints
-                if constraint.lhs.is_soft():
-                    weight = np.float64(constraint.lhs.weight()).tobytes()
-                    penalty = bytes(constraint.lhs.penalty(), 'ascii')
-                    zf.writestr(f'constraints/{lstr}/weight', weight)
-                    zf.writestr(f'constraints/{lstr}/penalty', penalty)
+                _write_constraint_attributes(zf, lstr, constraint)
 
         file.seek(0)
         return file
@@ -26,6 +26,7 @@ cimport numpy as np
 
 from cython.operator cimport preincrement as inc, dereference as deref
 from libc.math cimport ceil, floor
+from libc.stdint cimport uint64_t
 from libcpp.cast cimport reinterpret_cast
 from libcpp.unordered_set cimport unordered_set
 from libcpp.utility cimport move
@@ -37,11 +38,15 @@ from dimod.binary import BinaryQuadraticModel
 from dimod.constrained.expression import ObjectiveView, ConstraintView
 from dimod.cyqmbase cimport cyQMBase
 from dimod.cyqmbase.cyqmbase_float64 import BIAS_DTYPE, INDEX_DTYPE
-from dimod.cyutilities cimport as_numpy_float
+from dimod.cyutilities cimport as_numpy_float, ConstInteger
 from dimod.cyutilities cimport cppvartype
+from dimod.cyutilities cimport content_hash_to_int, label_keys
+from dimod.cyutilities cimport stats_to_dict
 from dimod.discrete.cydiscrete_quadratic_model cimport cyDiscreteQuadraticModel
 from dimod.libcpp.abc cimport QuadraticModelBase as cppQuadraticModelBase
 from dimod.libcpp.constrained_quadratic_model cimport Sense as cppSense, Penalty as cppPenalty, Constraint as cppConstraint
+from dimod.libcpp.content_hash cimport ContentHash as cppContentHash
+from dimod.libcpp.journal cimport Journal as cppJournal
 from dimod.libcpp.vartypes cimport Vartype as cppVartype, vartype_info as cppvartype_info
 
 from dimod.sym import Sense, Eq, Ge, Le
@@ -65,6 +70,36 @@ cdef cppSense cppsense(object sense) except? cppSense.GE:
         raise RuntimeError(f"unexpected sense: {sense!r}")
 
 
+cdef vector[cppSense] _as_cppsenses(object senses, Py_ssize_t num_constraints) except *:
+    if len(senses) != num_constraints:
+        raise ValueError("senses must have one sense for each constraint")
+
+    cdef vector[cppSense] cppsenses
+    cppsenses.reserve(num_constraints)
+    for sense in senses:
+        cppsenses.push_back(cppsense(sense))
+    return cppsenses
+
+
+def _check_csr(indptr, indices, Py_ssize_t num_data, Py_ssize_t num_rows, Py_ssize_t num_variables):
+    # check that the arrays describe num_rows rows of existing variables
+    indptr = np.asarray(indptr)
+    indices = np.asarray(indices)
+
+    if indptr.shape[0] != num_rows + 1:
+        raise ValueError("indptr must have one more entry than there are constraints")
+    if indices.shape[0] != num_data:
+        raise ValueError("indices and coefficients should be equal length")
+    if indptr[0] != 0 or indptr[num_rows] > indices.shape[0]:
+        raise ValueError("indptr does not match the length of indices")
+    if (indptr[1:] < indptr[:-1]).any():
+        raise ValueError("indptr must be non-decreasing")
+
+    indices = indices[:indptr[num_rows]]
+    if indices.shape[0] and (indices.min() < 0 or indices.max() >= num_variables):
+        raise ValueError("indices must be the indices of variables in the model")
+
+
 cdef class cyConstraintsView:
     cdef cyConstrainedQuadraticModel parent
 
@@ -225,6 +260,64 @@ cdef class cyConstrainedQuadraticModel:
 
         return label
 
+    def add_linear_constraints_from_arrays(self,
+                                           ConstInteger[::1] indptr,
+                                           ConstInteger[::1] indices,
+                                           const bias_type[::1] coefficients,
+                                           senses,
+                                           const bias_type[::1] rhs,
+                                           labels):
+        cdef Py_ssize_t num_constraints = rhs.shape[0]
+        _check_csr(indptr, indices, coefficients.shape[0], num_constraints, self.num_variables())
+
+        cdef vector[cppSense] cppsenses = _as_cppsenses(senses, num_constraints)
+
+        if len(labels) != num_constraints:
+            raise ValueError("labels must have one label for each constraint")
+
+        if num_constraints:
+            self.cppcqm.add_linear_constraints_from_arrays(
+                num_constraints, &indptr[0],
+                &indices[0] if indices.shape[0] else NULL,
+                &coefficients[0] if coefficients.shape[0] else NULL,
+                cppsenses.data(), &rhs[0])
+        self.constraint_labels._extend(labels)
+        assert(self.cppcqm.num_constraints() == self.constraint_labels.size())
+
+    def add_quadratic_constraints_from_arrays(self,
+                                              ConstInteger[::1] indptr,
+                                              ConstInteger[::1] indices,
+                                              const bias_type[::1] coefficients,
+                                              ConstInteger[::1] qindptr,
+                                              ConstInteger[::1] qrow,
+                                              ConstInteger[::1] qcol,
+                                              const bias_type[::1] qcoefficients,
+                                              senses,
+                                              const bias_type[::1] rhs,
+                                              labels):
+        cdef Py_ssize_t num_constraints = rhs.shape[0]
+        _check_csr(indptr, indices, coefficients.shape[0], num_constraints, self.num_variables())
+        _check_csr(qindptr, qrow, qcoefficients.shape[0], num_constraints, self.num_variables())
+        _check_csr(qindptr, qcol, qcoefficients.shape[0], num_constraints, self.num_variables())
+
+        cdef vector[cppSense] cppsenses = _as_cppsenses(senses, num_constraints)
+
+        if len(labels) != num_constraints:
+            raise ValueError("labels must have one label for each constraint")
+
+        if num_constraints:
+            self.cppcqm.add_quadratic_constraints_from_arrays(
+                num_constraints, &indptr[0],
+                &indices[0] if indices.shape[0] else NULL,
+                &coefficients[0] if coefficients.shape[0] else NULL,
+                &qindptr[0],
+                &qrow[0] if qrow.shape[0] else NULL,
+                &qcol[0] if qcol.shape[0] else NULL,
+                &qcoefficients[0] if qcoefficients.shape[0] else NULL,
+                cppsenses.data(), &rhs[0])
+        self.constraint_labels._extend(labels)
+        assert(self.cppcqm.num_constraints() == self.constraint_labels.size())
+
     def add_variables(self, vartype, variables, *, lower_bound=None, upper_bound=None):
         """Add variables to the model.
 
@@ -328,11 +421,120 @@ cdef class cyConstrainedQuadraticModel:
             raise TypeError(f"cannot change vartype {self.vartype(v).name!r} "
                             f"to {vartype.name!r}") from None
 
+    def change_vartypes(self, vartype, variables):
+        """Change the variable type of the given variables, updating the biases.
+
+        The objective and each constraint are updated in a single pass, so
+        this is much faster than calling :meth:`.change_vartype` for each
+        variable.
+
+        Args:
+            vartype: Variable type. One of:
+
+                * :class:`~dimod.Vartype.SPIN`, ``'SPIN'``, ``{-1, 1}``
+                * :class:`~dimod.Vartype.BINARY`, ``'BINARY'``, ``{0, 1}``
+                * :class:`~dimod.Vartype.INTEGER`, ``'INTEGER'``
+                * :class:`~dimod.Vartype.REAL`, ``'REAL'``
+
+            variables: Variables to change to the specified ``vartype``.
+
+        Raises:
+            TypeError: If any of the vartype changes are not supported. In this
+                case the model is not changed.
+
+        Examples:
+            >>> cqm = dimod.ConstrainedQuadraticModel()
+            >>> cqm.set_objective(dimod.Spin('a') + 2 * dimod.Spin('b'))
+            >>> cqm.add_constraint(dimod.Spin('a') - dimod.Spin('b') <= 0, label='c0')
+            'c0'
+            >>> cqm.change_vartypes('BINARY', ['a', 'b'])
+            >>> print(cqm.objective.linear, cqm.objective.offset)
+            {'a': 2.0, 'b': 4.0} -3.0
+
+        """
+        vartype = as_vartype(vartype, extended=True)
+        cdef cppVartype vt = cppvartype(vartype)
+
+        cdef vector[index_type] indices
+        for v in variables:
+            indices.push_back(self.variables.index(v))
+
+        try:
+            self.cppcqm.change_vartypes(vt, indices)
+        except RuntimeError:
+            # c++ logic_error, in which case the model is unchanged
+            raise TypeError("cannot change the vartypes of the given variables "
+                            f"to {vartype.name!r}") from None
+
+    def checkpoint(self):
+        """Start recording the changes made to the constrained quadratic model.
+
+        The changes made after the checkpoint can be serialized by
+        :meth:`to_delta` and applied to a copy of the model as it was at the
+        checkpoint by :meth:`apply_delta`. Calling this method again moves the
+        checkpoint to the current state of the model. The checkpoint is not
+        copied with the model.
+
+        Changes to the variable types and bounds, to the biases of the
+        objective and constraints, and to the attributes of the constraints
+        are recorded, as are added variables and constraints. Removing or
+        relabeling variables or constraints cannot be expressed as a delta;
+        after one of those, the model must be sent in full and a new
+        checkpoint made.
+
+        """
+        self.cppcqm.start_journal()
+
     def clear(self):
         self.variables._clear()
         self.constraint_labels._clear()
         self.cppcqm.clear()
 
+    def content_hash(self, *, Py_ssize_t num_threads = 1):
+        """Return a 128-bit fingerprint of the content of the model.
+
+        The hash covers the variables with their types and bounds, the
+        objective, and the constraints with their senses, right-hand sides,
+        weights and penalties. Models with the same content have the same
+        hash regardless of the order of their variables and constraints, and
+        of the labels of their constraints. Models with different content have
+        different hashes with very high probability, so the hash can be used
+        as a cache key.
+
+        Args:
+            num_threads:
+                The number of threads used to hash each expression.
+                If 0, the number of hardware threads is used.
+
+        Returns:
+            A non-negative integer less than ``2**128``.
+
+        Examples:
+            >>> x, y = dimod.Binaries('xy')
+            >>> cqm0 = dimod.ConstrainedQuadraticModel()
+            >>> cqm0.set_objective(x + 2*y)
+            >>> cqm0.add_constraint(x + y <= 1, label='c0')
+            'c0'
+            >>> cqm1 = dimod.ConstrainedQuadraticModel()
+            >>> cqm1.set_objective(2*y + x)
+            >>> cqm1.add_constraint(y + x <= 1, label='other')
+            'other'
+            >>> cqm0.content_hash() == cqm1.content_hash()
+            True
+
+        """
+        if num_threads < 0:
+            raise ValueError("num_threads must be non-negative")
+
+        cdef np.uint64_t[::1] keys = label_keys(self.variables)
+        cdef const uint64_t* keys_ptr = <const uint64_t*>&keys[0] if keys.shape[0] else NULL
+        cdef cppContentHash hash
+
+        with nogil:
+            hash = self.cppcqm.content_hash(keys_ptr, num_threads)
+
+        return content_hash_to_int(hash)
+
     def fix_variable(self, v, bias_type assignment):
         cdef Py_ssize_t vi = self.variables.index(v)
 
@@ -433,6 +635,82 @@ cdef class cyConstrainedQuadraticModel:
 
         return cqm
 
+    @cython.boundscheck(False)
+    @cython.wraparound(False)
+    def _idelta(self):
+        """Return the changes to the variables since :meth:`checkpoint`.
+
+        Returns a dict with the number of variables and constraints at the
+        checkpoint, the variable type and bounds of the changed and added
+        variables, whether the objective may have changed, and the indices
+        of the constraints present at the checkpoint that may have changed.
+        The changes to the expressions themselves are given by their own
+        ``_idelta()``. Returns ``None`` if there is no checkpoint or if the
+        changes can no longer be determined.
+        """
+        cdef cppJournal[index_type]* journal = self.cppcqm.journal()
+        if journal is NULL or not journal.valid():
+            return None
+
+        cdef Py_ssize_t base_num_variables = journal.num_variables()
+        cdef Py_ssize_t base_num_constraints = journal.num_constraints()
+        cdef Py_ssize_t num_variables = self.cppcqm.num_variables()
+        cdef Py_ssize_t i, n, vi
+
+        cdef vector[index_type] variables = journal.variables()
+        n = 0
+        while n < <Py_ssize_t>variables.size() and variables[n] < base_num_variables:
+            n += 1
+        varinfo = np.empty(n + num_variables - base_num_variables,
+                           dtype=np.dtype([('v', self.index_dtype), ('vartype', np.int8),
+                                           ('lb', self.dtype), ('ub', self.dtype)], align=False))
+        cdef index_type[:] varinfo_v = varinfo['v']
+        cdef np.int8_t[:] vartype_view = varinfo['vartype']
+        cdef bias_type[:] lb_view = varinfo['lb']
+        cdef bias_type[:] ub_view = varinfo['ub']
+        for i in range(varinfo.shape[0]):
+            vi = variables[i] if i < n else base_num_variables + i - n
+            varinfo_v[i] = vi
+            vartype_view[i] = self.cppcqm.vartype(vi)
+            lb_view[i] = self.cppcqm.lower_bound(vi)
+            ub_view[i] = self.cppcqm.upper_bound(vi)
+
+        # an expression without a journal was replaced as a whole
+        cdef cppJournal[index_type]* expression_journal = self.cppcqm.objective.journal()
+        objective_changed = expression_journal is NULL or expression_journal.changed()
+
+        constraints = []
+        for i in range(base_num_constraints):
+            expression_journal = self.cppcqm.constraint_ref(i).journal()
+            if expression_journal is NULL or expression_journal.changed():
+                constraints.append(i)
+
+        return dict(num_variables=base_num_variables,
+                    num_constraints=base_num_constraints,
+                    varinfo=varinfo,
+                    objective_changed=objective_changed,
+                    constraints=constraints,
+                    )
+
+    def _invalidate_journal(self):
+        """Discard the changes recorded since :meth:`checkpoint`, if any."""
+        cdef cppJournal[index_type]* journal = self.cppcqm.journal()
+        if journal is not NULL:
+            journal.invalidate()
+
+    def _iset_constraint(self, label, sense, bias_type rhs, weight, penalty, bint discrete):
+        """Set the attributes of an existing constraint, other than its left-hand side."""
+        cdef Py_ssize_t ci = self.constraint_labels.index(label)
+        cdef cppSense cppsense_ = cppsense(sense)
+
+        # set_weight() checks the weight and penalty, so it goes first
+        ConstraintView(self, label).set_weight(weight, 'linear' if penalty is None else penalty)
+
+        constraint = &self.cppcqm.constraint_ref(ci)
+        constraint.set_sense(cppsense_)
+        constraint.set_rhs(rhs)
+        constraint.mark_discrete(discrete)
+
     @cython.boundscheck(False)
     @cython.wraparound(False)
     def _ivarinfo(self):
@@ -477,6 +755,52 @@ cdef class cyConstrainedQuadraticModel:
 
         self.variables._extend(range(num_variables))
 
+    @cython.boundscheck(False)
+    @cython.wraparound(False)
+    def _ivarinfo_update(self, varinfo, labels=()):
+        """Set the vartype and bounds of variables, adding the new ones.
+
+        Args:
+            varinfo: A NumPy structured array with fields ``'v'``,
+                ``'vartype'``, ``'lb'`` and ``'ub'``, as returned by
+                :meth:`_idelta`. The records of the variables that are not
+                yet in the model must come last, in index order.
+            labels: The labels of the variables to add.
+
+        """
+        cdef const index_type[:] v_view = np.asarray(varinfo['v'], dtype=self.index_dtype)
+        cdef const np.int8_t[:] vartype_view = np.asarray(varinfo['vartype'], dtype=np.int8)
+        cdef const bias_type[:] lb_view = np.asarray(varinfo['lb'], dtype=self.dtype)
+        cdef const bias_type[:] ub_view = np.asarray(varinfo['ub'], dtype=self.dtype)
+
+        labels = list(labels)
+
+        # check everything before making any changes
+        cdef Py_ssize_t num_variables = self.cppcqm.num_variables()
+        cdef Py_ssize_t num_existing = v_view.shape[0] - len(labels)
+        cdef Py_ssize_t i
+        if num_existing < 0:
+            raise ValueError("there must be a record for each added variable")
+        for i in range(v_view.shape[0]):
+            if i < num_existing and not 0 <= v_view[i] < num_variables:
+                raise ValueError("varinfo refers to variables that are not in the model")
+            if i >= num_existing and v_view[i] != num_variables + i - num_existing:
+                raise ValueError("the added variables must be given in index order")
+            if not 0 <= vartype_view[i] <= <np.int8_t>cppVartype.REAL:
+                raise ValueError(f"unknown vartype: {vartype_view[i]}")
+        for v in labels:
+            if self.variables.count(v):
+                raise ValueError(f"variable {v!r} is already in the model")
+
+        for i in range(num_existing):
+            self.cppcqm.set_vartype(v_view[i], <cppVartype>(vartype_view[i]))
+            self.cppcqm.set_lower_bound(v_view[i], lb_view[i])
+            self.cppcqm.set_upper_bound(v_view[i], ub_view[i])
+
+        for i in range(num_existing, v_view.shape[0]):
+            self.cppcqm.add_variable(<cppVartype>(vartype_view[i]), lb_view[i], ub_view[i])
+            self.variables._append(labels[i - num_existing])
+
     def lower_bound(self, v):
         """Return the lower bound on the specified variable.
 
@@ -518,6 +842,34 @@ cdef class cyConstrainedQuadraticModel:
         self.cppcqm.remove_variable(vi)
         self.variables._remove(v)
 
+    def reserve_constraints(self, Py_ssize_t num_constraints):
+        """Reserve memory for the given number of constraints.
+
+        Reserving memory in advance avoids repeated reallocation as constraints
+        are added. This does not change the model.
+
+        Args:
+            num_constraints: Number of constraints to reserve memory for.
+
+        """
+        if num_constraints < 0:
+            raise ValueError("num_constraints must be non-negative")
+        self.cppcqm.reserve_constraints(num_constraints)
+
+    def reserve_variables(self, Py_ssize_t num_variables):
+        """Reserve memory for the given number of variables.
+
+        Reserving memory in advance avoids repeated reallocation as variables
+        are added. This does not change the model.
+
+        Args:
+            num_variables: Number of variables to reserve memory for.
+
+        """
+        if num_variables < 0:
+            raise ValueError("num_variables must be non-negative")
+        self.cppcqm.reserve_variables(num_variables)
+
     def set_lower_bound(self, v, bias_type lb):
         """Set the lower bound for a variable.
 
@@ -701,6 +1053,37 @@ cdef class cyConstrainedQuadraticModel:
 
         self.cppcqm.set_upper_bound(vi, ub)
 
+    def shrink_to_fit(self):
+        """Release any memory reserved beyond what is needed by the model,
+        its objective and its constraints.
+        """
+        self.cppcqm.shrink_to_fit()
+
+    def stats(self, *, bint reset = False):
+        """Return the counts of the hot-path events performed by the objective
+        and constraints.
+
+        The counts are only collected when dimod is compiled with
+        ``DIMOD_INSTRUMENTATION`` defined, otherwise they are all zero.
+
+        Args:
+            reset: If True, set the counts to zero after reading them.
+
+        Returns:
+            A dict with keys ``'binary_searches'``, ``'mid_inserts'``,
+            ``'reallocations'`` and ``'hash_lookups'``.
+
+        Examples:
+            >>> cqm = dimod.ConstrainedQuadraticModel()
+            >>> sorted(cqm.stats())
+            ['binary_searches', 'hash_lookups', 'mid_inserts', 'reallocations']
+
+        """
+        stats = stats_to_dict(self.cppcqm.stats())
+        if reset:
+            self.cppcqm.reset_stats()
+        return stats
+
     def upper_bound(self, v):
         """Return the upper bound on the specified variable.
 
@@ -22,6 +22,8 @@ import numpy as np
 from cython.operator cimport preincrement as inc, dereference as deref
 from libcpp.algorithm cimport lower_bound as cpplower_bound
 from libcpp.unordered_map cimport unordered_map
+from libcpp.utility cimport pair
+from libcpp.vector cimport vector
 
 import dimod
 
@@ -31,6 +33,7 @@ from dimod.cyutilities cimport ConstNumeric
 from dimod.cyvariables cimport cyVariables
 from dimod.libcpp.abc cimport QuadraticModelBase as cppQuadraticModelBase
 from dimod.libcpp.constrained_quadratic_model cimport Penalty as cppPenalty
+from dimod.libcpp.journal cimport Journal as cppJournal
 from dimod.libcpp.vartypes cimport Vartype as cppVartype
 from dimod.sampleset import as_samples
 from dimod.serialization.fileview import (
@@ -176,6 +179,115 @@ cdef class _cyExpression:
         # Not implemented. To be overwritten by subclasses.
         raise NotImplementedError
 
+    @cython.boundscheck(False)
+    @cython.wraparound(False)
+    def _iapply_delta(self,
+                      const index_type[::1] linear_v, const bias_type[::1] linear_bias,
+                      const index_type[::1] quadratic_u, const index_type[::1] quadratic_v,
+                      const bias_type[::1] quadratic_bias,
+                      const index_type[::1] removed_u, const index_type[::1] removed_v,
+                      offset=None):
+        """Set the biases given by a delta, see :meth:`_idelta`.
+
+        Variables are indexed as they are in the parent model. Variables that
+        are not yet in the expression are added to it.
+        """
+        expression = self.expression()
+
+        cdef Py_ssize_t num_variables = self.parent.num_variables()
+
+        # check everything before making any changes
+        for indices in map(np.asarray, [linear_v, quadratic_u, quadratic_v, removed_u, removed_v]):
+            if indices.shape[0] and not (0 <= np.min(indices) and np.max(indices) < num_variables):
+                raise ValueError("delta refers to variables that are not in the model")
+        if linear_v.shape[0] != linear_bias.shape[0]:
+            raise ValueError("linear_v and linear_bias must have the same length")
+        if not quadratic_u.shape[0] == quadratic_v.shape[0] == quadratic_bias.shape[0]:
+            raise ValueError("quadratic_u, quadratic_v and quadratic_bias must have the same length")
+        if removed_u.shape[0] != removed_v.shape[0]:
+            raise ValueError("removed_u and removed_v must have the same length")
+
+        cdef Py_ssize_t i
+        for i in range(linear_v.shape[0]):
+            expression.set_linear(linear_v[i], linear_bias[i])
+        for i in range(removed_u.shape[0]):
+            expression.remove_interaction(removed_u[i], removed_v[i])
+        for i in range(quadratic_u.shape[0]):
+            expression.set_quadratic(quadratic_u[i], quadratic_v[i], quadratic_bias[i])
+        if offset is not None:
+            expression.set_offset(offset)
+
+    def _iclear(self):
+        """Remove the variables, interactions and offset of the expression."""
+        self.expression().clear()
+
+    @cython.boundscheck(False)
+    @cython.wraparound(False)
+    def _idelta(self):
+        """Return the changes since the parent model's checkpoint as NumPy arrays.
+
+        Returns a dict with the current biases of the changed variables and
+        interactions, the interactions that were removed, and whether the
+        offset or the other attributes of the expression changed. Variables
+        are indexed as they are in the parent model. Returns ``None`` if
+        there is no checkpoint or if the changes can no longer be determined.
+        """
+        expression = self.expression()
+
+        cdef cppJournal[index_type]* journal = expression.journal()
+        if journal is NULL or not journal.valid():
+            return None
+
+        # the journal uses the expression's own indices
+        indices = &expression.variables()
+        cdef Py_ssize_t i, ui, vi
+
+        cdef vector[index_type] changed = journal.linear()
+        linear = np.empty(changed.size(),
+                          dtype=np.dtype([('v', self.index_dtype), ('bias', self.dtype)], align=False))
+        cdef index_type[:] linear_v = linear['v']
+        cdef bias_type[:] linear_bias = linear['bias']
+        for i in range(changed.size()):
+            linear_v[i] = deref(indices)[changed[i]]
+            linear_bias[i] = expression.linear(linear_v[i])
+
+        cdef vector[pair[index_type, index_type]] interactions = journal.quadratic()
+        quadratic = np.empty(interactions.size(),
+                             dtype=np.dtype([('u', self.index_dtype), ('v', self.index_dtype),
+                                             ('bias', self.dtype)], align=False))
+        removed = np.empty(interactions.size(),
+                           dtype=np.dtype([('u', self.index_dtype), ('v', self.index_dtype)],
+                                          align=False))
+        cdef index_type[:] quadratic_u = quadratic['u']
+        cdef index_type[:] quadratic_v = quadratic['v']
+        cdef bias_type[:] quadratic_bias = quadratic['bias']
+        cdef index_type[:] removed_u = removed['u']
+        cdef index_type[:] removed_v = removed['v']
+        cdef Py_ssize_t num_quadratic = 0
+        cdef Py_ssize_t num_removed = 0
+        for i in range(interactions.size()):
+            ui = deref(indices)[interactions[i].first]
+            vi = deref(indices)[interactions[i].second]
+            if vi < ui:
+                ui, vi = vi, ui
+
+            if expression.has_interaction(ui, vi):
+                quadratic_u[num_quadratic] = ui
+                quadratic_v[num_quadratic] = vi
+                quadratic_bias[num_quadratic] = expression.quadratic(ui, vi)
+                num_quadratic += 1
+            else:
+                removed_u[num_removed] = ui
+                removed_v[num_removed] = vi
+                num_removed += 1
+
+        return dict(linear=linear,
+                    quadratic=quadratic[:num_quadratic],
+                    removed=removed[:num_removed],
+                    offset_changed=journal.offset_changed(),
+                    attributes_changed=journal.attributes_changed(),
+                    )
+
     @cython.boundscheck(False)
     @cython.wraparound(False)
     def _iindices(self):
@@ -27,6 +27,8 @@ cdef class cyQMBase_template:
     cdef readonly object dtype
     cdef readonly object index_dtype
 
+    cdef void _invalidate_journal(self)
+
     cpdef bint is_linear(self)
     cpdef Py_ssize_t num_interactions(self)
     cpdef Py_ssize_t num_variables(self)
@@ -12,17 +12,28 @@
 #    See the License for the specific language governing permissions and
 #    limitations under the License.
 
+import collections.abc
 import operator
 
 cimport cython
 
 from cython.operator cimport preincrement as inc, dereference as deref
+from libc.stdint cimport uint64_t
 from libcpp.algorithm cimport lower_bound as cpplower_bound
+from libcpp.utility cimport pair
+from libcpp.vector cimport vector
 
+from dimod.libcpp.content_hash cimport ContentHash as cppContentHash
+from dimod.libcpp.journal cimport Journal as cppJournal
+from dimod.libcpp.orderings cimport degree_order as cppdegree_order
+from dimod.libcpp.orderings cimport reverse_cuthill_mckee as cppreverse_cuthill_mckee
 from dimod.libcpp.vartypes cimport Vartype as cppVartype
 
 from dimod.cyutilities cimport as_numpy_float
+from dimod.cyutilities cimport content_hash_to_int
 from dimod.cyutilities cimport ConstNumeric
+from dimod.cyutilities cimport label_keys
+from dimod.cyutilities cimport stats_to_dict
 from dimod.sampleset import as_samples
 from dimod.variables import Variables
 from dimod.vartypes import Vartype
@@ -52,6 +63,11 @@ cdef class cyQMBase_template:
         if self.base is NULL:
             raise TypeError(f"Can't instantiate abstract class {type(self).__name__}")
 
+    cdef void _invalidate_journal(self):
+        cdef cppJournal[index_type]* journal = self.base.journal()
+        if journal is not NULL:
+            journal.invalidate()
+
     @property
     def offset(self):
         return as_numpy_float(self.base.offset())
@@ -60,10 +76,26 @@ cdef class cyQMBase_template:
     def offset(self, bias_type offset):
         self.base.set_offset(offset)
 
+    def checkpoint(self):
+        self.base.start_journal()
+
     def clear(self):
         self.base.clear()
         self.variables._clear()
 
+    def content_hash(self, *, Py_ssize_t num_threads = 1):
+        if num_threads < 0:
+            raise ValueError("num_threads must be non-negative")
+
+        cdef np.uint64_t[::1] keys = label_keys(self.variables)
+        cdef const uint64_t* keys_ptr = <const uint64_t*>&keys[0] if keys.shape[0] else NULL
+        cdef cppContentHash hash
+
+        with nogil:
+            hash = self.base.content_hash(keys_ptr, num_threads)
+
+        return content_hash_to_int(hash)
+
     def degree(self, v):
         cdef Py_ssize_t vi = self.variables.index(v)
         return self.base.degree(vi)
@@ -129,9 +161,79 @@ cdef class cyQMBase_template:
                 raise err
             raise ValueError(f"unsupported sample dtype: {samples.dtype.name}")
 
+    def fix_variables(self, fixed):
+        # later assignments of a repeated variable win
+        if not isinstance(fixed, collections.abc.Mapping):
+            fixed = dict(fixed)
+
+        cdef vector[index_type] variables
+        cdef vector[bias_type] assignments
+        variables.reserve(len(fixed))
+        assignments.reserve(len(fixed))
+        for v, value in fixed.items():
+            variables.push_back(self.variables.index(v))
+            assignments.push_back(value)
+
+        if variables.empty():
+            return
+
+        # the biases are folded in and the model reindexed once, so we
+        # rebuild the labels once as well
+        cdef Py_ssize_t num_variables = self.num_variables()
+        cdef np.uint8_t[::1] is_fixed = np.zeros(num_variables, dtype=np.uint8)
+        cdef Py_ssize_t vi
+        for vi in variables:
+            is_fixed[vi] = True
+        remaining = [self.variables.at(vi) for vi in range(num_variables) if not is_fixed[vi]]
+
+        self.base.fix_variables(variables, assignments)
+
+        self.variables._clear()
+        self.variables._extend(remaining)
+
     def get_linear(self, v):
         return as_numpy_float(self.base.linear(self.variables.index(v)))
 
+    @cython.boundscheck(False)
+    @cython.wraparound(False)
+    def _local_fields(self, ConstNumeric[:, ::1] samples, Py_ssize_t num_threads):
+        # the columns of the samples must already be in the order of the variables
+        cdef Py_ssize_t num_samples = samples.shape[0]
+        cdef Py_ssize_t num_variables = samples.shape[1]
+
+        if num_variables != self.num_variables():
+            raise RuntimeError("samples and variables have inconsistent sizes")
+
+        cdef np.float64_t[:, ::1] fields = np.empty((num_samples, num_variables), dtype=np.float64)
+
+        if num_samples and num_variables:
+            with nogil:
+                self.base.local_fields(&samples[0, 0], num_samples, &fields[0, 0], num_threads)
+
+        return fields
+
+    def local_fields(self, samples_like, *, Py_ssize_t num_threads = 1):
+        if num_threads < 0:
+            raise ValueError("num_threads must be non-negative")
+
+        samples, labels = as_samples(samples_like, labels_type=Variables)
+
+        # put the columns in the order of the model's variables
+        if labels != self.variables:
+            samples = samples[:, [labels.index(v) for v in self.variables]]
+
+        samples = np.ascontiguousarray(
+                samples,
+                dtype=f'i{samples.dtype.itemsize}' if np.issubdtype(samples.dtype, np.unsignedinteger) else None,
+                )
+
+        try:
+            return np.asarray(self._local_fields(samples, num_threads))
+        except TypeError as err:
+            if np.issubdtype(samples.dtype, np.floating) or np.issubdtype(samples.dtype, np.signedinteger):
+                raise err
+            raise ValueError(f"unsupported sample dtype: {samples.dtype.name}")
+
     def get_quadratic(self, u, v, default=None):
         cdef Py_ssize_t ui = self.variables.index(u)
         cdef Py_ssize_t vi = self.variables.index(v)
@@ -155,6 +257,129 @@ cdef class cyQMBase_template:
             bias = default
         return as_numpy_float(bias)
 
+    @cython.boundscheck(False)
+    @cython.wraparound(False)
+    def _iapply_delta(self,
+                      const index_type[::1] linear_v, const bias_type[::1] linear_bias,
+                      const index_type[::1] quadratic_u, const index_type[::1] quadratic_v,
+                      const bias_type[::1] quadratic_bias,
+                      const index_type[::1] removed_u, const index_type[::1] removed_v,
+                      offset=None):
+        """Set the biases given by a delta, see :meth:`_idelta`."""
+        cdef Py_ssize_t num_variables = self.num_variables()
+
+        # check everything before making any changes
+        for indices in map(np.asarray, [linear_v, quadratic_u, quadratic_v, removed_u, removed_v]):
+            if indices.shape[0] and not (0 <= np.min(indices) and np.max(indices) < num_variables):
+                raise ValueError("delta refers to variables that are not in the model")
+        if linear_v.shape[0] != linear_bias.shape[0]:
+            raise ValueError("linear_v and linear_bias must have the same length")
+        if not quadratic_u.shape[0] == quadratic_v.shape[0] == quadratic_bias.shape[0]:
+            raise ValueError("quadratic_u, quadratic_v and quadratic_bias must have the same length")
+        if removed_u.shape[0] != removed_v.shape[0]:
+            raise ValueError("removed_u and removed_v must have the same length")
+
+        cdef Py_ssize_t i
+        for i in range(linear_v.shape[0]):
+            self.base.set_linear(linear_v[i], linear_bias[i])
+        for i in range(removed_u.shape[0]):
+            self.base.remove_interaction(removed_u[i], removed_v[i])
+        for i in range(quadratic_u.shape[0]):
+            self.base.set_quadratic(quadratic_u[i], quadratic_v[i], quadratic_bias[i])
+        if offset is not None:
+            self.base.set_offset(offset)
+
+    @cython.boundscheck(False)
+    @cython.wraparound(False)
+    def _idelta(self):
+        """Return the changes since :meth:`checkpoint` as NumPy arrays.
+
+        Returns a dict with the number of variables at the checkpoint, the
+        current biases of the changed variables and interactions, the
+        interactions that were removed, the variable type and bounds of the
+        changed and added variables, and whether the offset changed. Returns
+        ``None`` if there is no checkpoint or if the changes can no longer be
+        determined.
+        """
+        cdef cppJournal[index_type]* journal = self.base.journal()
+        if journal is NULL or not journal.valid():
+            return None
+
+        cdef Py_ssize_t base_num_variables = journal.num_variables()
+        cdef Py_ssize_t num_variables = self.num_variables()
+        cdef Py_ssize_t i, n, ui, vi
+
+        # linear biases
+        cdef vector[index_type] changed = journal.linear()
+        linear = np.empty(changed.size(),
+                          dtype=np.dtype([('v', self.index_dtype), ('bias', self.dtype)], align=False))
+        cdef index_type[:] linear_v = linear['v']
+        cdef bias_type[:] linear_bias = linear['bias']
+        for i in range(changed.size()):
+            linear_v[i] = changed[i]
+            linear_bias[i] = self.base.linear(changed[i])
+
+        # quadratic biases, split between the interactions that are present
+        # and the ones that were removed
+        cdef vector[pair[index_type, index_type]] interactions = journal.quadratic()
+        quadratic = np.empty(interactions.size(),
+                             dtype=np.dtype([('u', self.index_dtype), ('v', self.index_dtype),
+                                             ('bias', self.dtype)], align=False))
+        removed = np.empty(interactions.size(),
+                           dtype=np.dtype([('u', self.index_dtype), ('v', self.index_dtype)],
+                                          align=False))
+        cdef index_type[:] quadratic_u = quadratic['u']
+        cdef index_type[:] quadratic_v = quadratic['v']
+        cdef bias_type[:] quadratic_bias = quadratic['bias']
+        cdef index_type[:] removed_u = removed['u']
+        cdef index_type[:] removed_v = removed['v']
+        cdef Py_ssize_t num_quadratic = 0
+        cdef Py_ssize_t num_removed = 0
+        for i in range(interactions.size()):
+            ui = interactions[i].first
+            vi = interactions[i].second
+
+            it = cpplower_bound(self.base.cbegin_neighborhood(ui),
+                                self.base.cend_neighborhood(ui),
+                                vi)
+            if it != self.base.cend_neighborhood(ui) and deref(it).v == vi:
+                quadratic_u[num_quadratic] = ui
+                quadratic_v[num_quadratic] = vi
+                quadratic_bias[num_quadratic] = deref(it).bias
+                num_quadratic += 1
+            else:
+                removed_u[num_removed] = ui
+                removed_v[num_removed] = vi
+                num_removed += 1
+
+        # the variables whose vartype or bounds changed, followed by the ones
+        # that were added
+        cdef vector[index_type] variables = journal.variables()
+        n = 0
+        while n < <Py_ssize_t>variables.size() and variables[n] < base_num_variables:
+            n += 1
+        varinfo = np.empty(n + num_variables - base_num_variables,
+                           dtype=np.dtype([('v', self.index_dtype), ('vartype', np.int8),
+                                           ('lb', self.dtype), ('ub', self.dtype)], align=False))
+        cdef index_type[:] varinfo_v = varinfo['v']
+        cdef np.int8_t[:] vartype_view = varinfo['vartype']
+        cdef bias_type[:] lb_view = varinfo['lb']
+        cdef bias_type[:] ub_view = varinfo['ub']
+        for i in range(varinfo.shape[0]):
+            vi = variables[i] if i < n else base_num_variables + i - n
+            varinfo_v[i] = vi
+            vartype_view[i] = self.base.vartype(vi)
+            lb_view[i] = self.base.lower_bound(vi)
+            ub_view[i] = self.base.upper_bound(vi)
+
+        return dict(num_variables=base_num_variables,
+                    linear=linear,
+                    quadratic=quadratic[:num_quadratic],
+                    removed=removed[:num_removed],
+                    varinfo=varinfo,
+                    offset_changed=journal.offset_changed(),
+                    )
+
     @cython.boundscheck(False)
     @cython.wraparound(False)
     def _ilinear(self):
@@ -381,9 +606,11 @@ cdef class cyQMBase_template:
         return as_numpy_float(value)
 
     def relabel_variables(self, mapping):
+        self._invalidate_journal()  # the delta would need the old labels
         self.variables._relabel(mapping)
 
     def relabel_variables_as_integers(self):
+        self._invalidate_journal()
         return self.variables._relabel_as_integers()
 
     def remove_interaction(self, u, v):
@@ -405,9 +632,78 @@ cdef class cyQMBase_template:
 
         return v
 
+    def reorder_variables(self, order='rcm'):
+        cdef vector[index_type] cpporder
+        cdef Py_ssize_t num_variables = self.num_variables()
+
+        if isinstance(order, str):
+            if order == 'rcm':
+                cpporder = cppreverse_cuthill_mckee(self.base[0])
+            elif order == 'degree':
+                cpporder = cppdegree_order(self.base[0], False)
+            else:
+                raise ValueError(f"unknown ordering {order!r}, expected 'rcm' or 'degree'")
+        else:
+            cpporder.reserve(num_variables)
+            for v in order:
+                cpporder.push_back(self.variables.index(v))
+
+            if (<Py_ssize_t>cpporder.size() != num_variables
+                    or len(set(cpporder)) != num_variables):
+                raise ValueError("order must contain every variable in the model exactly once")
+
+        labels = [self.variables.at(vi) for vi in cpporder]
+
+        self.base.reorder(cpporder)
+
+        self.variables._clear()
+        self.variables._extend(labels)
+
+        return np.asarray(cpporder, dtype=np.intp)
+
+    def reserve(self, Py_ssize_t num_variables, Py_ssize_t num_interactions_hint = 0):
+        if num_variables < 0 or num_interactions_hint < 0:
+            raise ValueError("num_variables and num_interactions_hint must be non-negative")
+        self.base.reserve(num_variables, num_interactions_hint)
+
+    def reserve_interactions(self, degrees):
+        cdef Py_ssize_t[::1] degrees_view = np.ascontiguousarray(degrees, dtype=np.intp)
+        cdef Py_ssize_t length = degrees_view.shape[0]
+
+        if length > self.num_variables():
+            raise ValueError(f"degrees has length {length} but the model only has "
+                             f"{self.num_variables()} variables")
+        if length and np.min(degrees_view) < 0:
+            raise ValueError("degrees must be non-negative")
+
+        if length:
+            self.base.reserve_interactions(&degrees_view[0], length)
+
     def scale(self, bias_type scalar):
         self.base.scale(scalar)
 
+    def shrink_to_fit(self):
+        self.base.shrink_to_fit()
+
+    def stats(self, *, bint reset = False):
+        """Return the counts of the hot-path events performed by the model.
+
+        The counts are only collected when dimod is compiled with
+        ``DIMOD_INSTRUMENTATION`` defined, otherwise they are all zero.
+
+        Args:
+            reset: If True, set the counts to zero after reading them.
+
+        Returns:
+            A dict with keys ``'binary_searches'``, ``'mid_inserts'``,
+            ``'reallocations'`` and ``'hash_lookups'``.
+
+        """
+        stats = stats_to_dict(self.base.stats())
+        if reset:
+            self.base.reset_stats()
+        return stats
+
     def upper_bound(self, v):
         cdef Py_ssize_t vi = self.variables.index(v)
         return as_numpy_float(self.base.upper_bound(vi))
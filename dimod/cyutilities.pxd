@@ -18,6 +18,8 @@
 cimport cython
 cimport numpy as np
 
+from dimod.libcpp.content_hash cimport ContentHash as cppContentHash
+from dimod.libcpp.stats cimport Stats as cppStats
 from dimod.libcpp.vartypes cimport Vartype as cppVartype
 
 __all__ = [
@@ -73,3 +75,9 @@ cdef object as_numpy_float(cython.floating)
 cpdef Py_ssize_t coo_sort(Integer[:], Integer[:], cython.floating[:]) except -1
 
 cdef cppVartype cppvartype(object) except? cppVartype.SPIN
+
+cdef dict stats_to_dict(const cppStats&)
+
+cdef object content_hash_to_int(const cppContentHash&)
+
+cdef np.uint64_t[::1] label_keys(object)
@@ -12,6 +12,7 @@
 #    See the License for the specific language governing permissions and
 #    limitations under the License.
 
+import hashlib
 import typing
 
 cimport cython
@@ -132,6 +133,33 @@ cdef cppVartype cppvartype(vartype) except? cppVartype.SPIN:
         raise TypeError(f"unexpected vartype {vartype!r}")
 
 
+cdef dict stats_to_dict(const cppStats& stats):
+    return dict(
+        binary_searches=stats.binary_searches,
+        mid_inserts=stats.mid_inserts,
+        reallocations=stats.reallocations,
+        hash_lookups=stats.hash_lookups,
+        )
+
+
+cdef object content_hash_to_int(const cppContentHash& hash):
+    return (<object>hash.high << 64) | <object>hash.low
+
+
+cdef np.uint64_t[::1] label_keys(object variables):
+    # A stable 64-bit key for each variable label, so that content hashes
+    # agree between processes and do not depend on the order of the variables.
+    # Numeric labels that compare equal get the same key.
+    cdef np.uint64_t[::1] keys = np.empty(len(variables), dtype=np.uint64)
+    cdef Py_ssize_t i
+    for i, v in enumerate(variables):
+        if isinstance(v, (int, np.integer)) or (isinstance(v, float) and v.is_integer()):
+            v = int(v)
+        digest = hashlib.blake2b(repr(v).encode(), digest_size=8).digest()
+        keys[i] = int.from_bytes(digest, 'little')
+    return keys
+
+
 # todo: type annotations, fix docs. This needs a followup PR
 def vartype_info(vartype, dtype=np.float64):
     """Information about the variable bounds by variable type.
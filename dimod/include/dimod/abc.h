@@ -15,13 +15,24 @@
 #pragma once
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <functional>
 #include <iostream>
 #include <limits>
 #include <memory>
+#include <stdexcept>
+#include <thread>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
+#include "dimod/content_hash.h"
+#include "dimod/journal.h"
+#include "dimod/neighborhood_index.h"
+#include "dimod/precision.h"
+#include "dimod/stats.h"
+#include "dimod/transaction.h"
 #include "dimod/utils.h"
 #include "dimod/vartypes.h"
 
@@ -165,15 +176,32 @@ class QuadraticModelBase {
 
     QuadraticModelBase(const QuadraticModelBase&);
 
-    QuadraticModelBase(QuadraticModelBase&&) = default;
+    QuadraticModelBase(QuadraticModelBase&&) noexcept;
 
     QuadraticModelBase& operator=(const QuadraticModelBase&);
 
-    QuadraticModelBase& operator=(QuadraticModelBase&&) = default;
+    QuadraticModelBase& operator=(QuadraticModelBase&&) noexcept;
 
     /// Add linear bias to variable ``v``.
     void add_linear(index_type v, bias_type bias);
 
+    /**
+     * Add the biases and offset of another quadratic model.
+     *
+     * `mapping` must be of length `other.num_variables()` and map each variable
+     * in `other` to a distinct variable in this model.
+     *
+     * The neighborhoods are merged row by row. When `mapping` is monotonically
+     * increasing, the neighborhoods of `other` remain sorted and are merged
+     * directly; otherwise each row is sorted before merging.
+     *
+     * # Exceptions
+     * The behavior of this method is undefined when any value in `mapping` is
+     * not a variable of this model or when `mapping` is not injective.
+     */
+    template <class B, class I>
+    void add_model(const QuadraticModelBase<B, I>& other, const std::vector<index_type>& mapping);
+
     /// Add offset.
     void add_offset(bias_type bias);
 
@@ -219,6 +247,49 @@ class QuadraticModelBase {
     template <class T>
     void add_quadratic_from_dense(const T dense[], index_type num_variables);
 
+    /*
+     * Add quadratic biases from a sparse matrix in Compressed Sparse Row format.
+     *
+     * `indptr` must be an array of length `num_rows + 1`. The entries of row
+     * `u` are `indices[indptr[u]:indptr[u + 1]]` with values
+     * `data[indptr[u]:indptr[u + 1]]`.
+     *
+     * Like `add_quadratic_from_dense()`, the interaction between `u` and `v`
+     * gets the sum of all of the entries at `(u, v)` and at `(v, u)`, so the
+     * matrix may be upper-triangular or symmetric and may contain duplicate
+     * entries. Because of this a matrix in Compressed Sparse Column format
+     * can be passed in the same way. Values on the diagonal are treated
+     * differently depending on the variable type.
+     *
+     * When the model has no interactions, the neighborhoods are built directly
+     * and each is sorted once, rather than inserting the entries one at a time.
+     *
+     * # Exceptions
+     * The behavior of this method is undefined when the model has fewer than
+     * `num_rows` variables or when any of the `indices` is not a variable of
+     * the model.
+     */
+    template <class Ptr, class Ind, class T>
+    void add_quadratic_from_csr(const Ptr indptr[], const Ind indices[], const T data[],
+                                index_type num_rows);
+
+    /**
+     * Start a transaction. The changes made to the model from now on can be
+     * undone with `rollback()` or kept with `commit()`.
+     *
+     * The transaction keeps an undo log. The linear bias and the neighborhood
+     * of a variable are saved before they are first changed, so the cost is
+     * proportional to the part of the model that changes. Changes that
+     * reindex or rewrite the whole model, like removing a variable or scaling
+     * the model, save it in full, which costs about as much as the change.
+     *
+     * The transaction is not copied with the model.
+     *
+     * # Exceptions
+     * Throws a `std::logic_error` if a transaction is already in progress.
+     */
+    virtual void begin_transaction();
+
     /// Return an iterator to the beginning of the neighborhood of `v`.
     const_neighborhood_iterator cbegin_neighborhood(index_type v) const;
 
@@ -234,6 +305,31 @@ class QuadraticModelBase {
     /// Remove the offset and all variables and interactions from the model.
     void clear();
 
+    /**
+     * Keep the changes made since `begin_transaction()` and end the transaction.
+     *
+     * # Exceptions
+     * Throws a `std::logic_error` if there is no transaction in progress.
+     */
+    virtual void commit();
+
+    /**
+     * Return a 128-bit fingerprint of the content of the model.
+     *
+     * The hash covers the offset, the linear and quadratic biases, and the
+     * variable type and bounds of each variable. Each variable is identified
+     * by `keys[v]`, or by its index if `keys` is null, so models with the
+     * same variables in a different order have the same hash when they are
+     * given the same key per variable. A bias of 0 hashes differently from
+     * a missing interaction, see `ContentHash`.
+     *
+     * The variables are divided between `num_threads` threads, or
+     * `std::thread::hardware_concurrency()` threads if `num_threads` is 0.
+     * The model must not be modified until this method returns.
+     */
+    virtual ContentHash content_hash(const std::uint64_t keys[] = nullptr,
+                                     size_type num_threads = 1) const;
+
     /**
      * Return the energy of the given sample.
      *
@@ -242,6 +338,9 @@ class QuadraticModelBase {
      *
      * The behavior of this function is undefined when the sample is not
      * `num_variables()` long.
+     *
+     * The energy is accumulated in `accumulator_t<bias_type>`, see
+     * dimod/precision.h.
      */
     template <class Iter>  // todo: allow different return types
     bias_type energy(Iter sample_start) const;
@@ -255,19 +354,86 @@ class QuadraticModelBase {
     template <class T>
     void fix_variable(index_type v, T assignment);
 
+    /**
+     * Remove several variables from the model by fixing `variables[i]` to
+     * `assignments[i]`.
+     *
+     * The fixed variables are folded into the remaining biases and the
+     * offset in one pass, and the remaining variables are reindexed once,
+     * so the cost is O(num_variables() + num_interactions()) however many
+     * variables are fixed. Calling `fix_variable()` once per variable
+     * reindexes the model each time.
+     *
+     * The remaining variables keep their relative order. If a variable
+     * appears more than once, its last assignment is used.
+     *
+     * # Exceptions
+     * Throws a `std::invalid_argument` if `variables` and `assignments` are
+     * not the same length. The behavior of this method is undefined when
+     * any of `variables` is not a variable of the model.
+     */
+    virtual void fix_variables(const std::vector<index_type>& variables,
+                               const std::vector<bias_type>& assignments);
+
     /// Check whether `u` and `v` have an interaction.
     bool has_interaction(index_type u, index_type v) const;
 
+    /// Return true if a transaction is in progress, see `begin_transaction()`.
+    bool in_transaction() const;
+
+    /**
+     * Index the neighborhoods of the variables with many neighbors, so that
+     * `quadratic()`, `quadratic_at()` and `has_interaction()` find their
+     * interactions without a binary search.
+     *
+     * Neighborhoods that grow one interaction at a time are indexed as they
+     * go. Call this before a read-heavy phase if the model was built in bulk,
+     * or if interactions have been inserted into or removed from the middle of
+     * large neighborhoods since they were indexed.
+     */
+    void index_neighborhoods();
+
     /// Test whether two quadratic models are equal.
     template <class B, class I>
     bool is_equal(const QuadraticModelBase<B, I>& other) const;
 
-    /// Test whether the model has no quadratic biases.
+    /// Test whether the model has no quadratic biases. Takes constant time.
     bool is_linear() const;
 
+    /**
+     * Return the journal of the changes made to the model since
+     * `start_journal()`, or `nullptr` if the model is not keeping one.
+     *
+     * See `Journal` for what is recorded. Clearing, permuting, scaling,
+     * shrinking or removing variables from the model invalidates the journal.
+     */
+    Journal<index_type>* journal();
+
+    /// @copydoc QuadraticModelBase::journal()
+    const Journal<index_type>* journal() const;
+
     /// The linear bias of variable `v`.
     bias_type linear(index_type v) const;
 
+    /**
+     * Compute the local fields of a batch of samples.
+     *
+     * `samples` must be a row-major array of `num_samples` samples, each
+     * `num_variables()` long, and `out` must be an array of the same shape.
+     * The local field of `v` in a sample `x` is the derivative of the energy
+     * with respect to `x[v]`,
+     * `linear(v) + sum_u quadratic(u, v) * x[u] + 2 * quadratic(v, v) * x[v]`
+     * where the sum is over the neighbors `u != v`. For a binary quadratic
+     * model this is the familiar `h[v] + sum_u J[u, v] * x[u]`.
+     *
+     * The variables are divided between `num_threads` threads, or
+     * `std::thread::hardware_concurrency()` threads if `num_threads` is 0.
+     * The model must not be modified until this method returns.
+     */
+    template <class T, class Out>
+    void local_fields(const T samples[], size_type num_samples, Out out[],
+                      size_type num_threads = 1) const;
+
     /// Return the lower bound on variable ``v``.
     virtual bias_type lower_bound(index_type v) const = 0;
 
@@ -294,7 +460,12 @@ class QuadraticModelBase {
      */
     virtual size_type nbytes(bool capacity = false) const;
 
-    /// Return the number of interactions in the quadratic model.
+    /**
+     * Return the number of interactions in the quadratic model.
+     *
+     * The count is maintained by the methods that add or remove interactions,
+     * so this takes constant time.
+     */
     size_type num_interactions() const;
 
     /// Return the number of other variables that `v` interacts with.
@@ -306,6 +477,20 @@ class QuadraticModelBase {
     /// Return the offset
     bias_type offset() const;
 
+    /**
+     * Permute the variables of the model so that variable `v` becomes
+     * variable `permutation[v]`.
+     *
+     * This takes O(num_variables() + num_interactions()) time, plus the cost
+     * of sorting any neighborhood whose relative order is changed by the
+     * permutation.
+     *
+     * # Exceptions
+     * If `permutation` is not a permutation of `0, ..., num_variables() - 1`
+     * then the behavior of this method is undefined.
+     */
+    virtual void permute(const std::vector<index_type>& permutation);
+
     /**
      * Return the quadratic bias associated with `u` and `v`.
      *
@@ -314,6 +499,8 @@ class QuadraticModelBase {
      * Note that this function does not return a reference because
      * each quadratic bias is stored twice.
      *
+     * When `u` has many neighbors, the lookup uses a hash index of its
+     * neighborhood rather than a binary search. See `index_neighborhoods()`.
      */
     bias_type quadratic(index_type u, index_type v) const;
 
@@ -342,6 +529,62 @@ class QuadraticModelBase {
     /// Remove multiple variables from the model and reindex accordingly.
     virtual void remove_variables(const std::vector<index_type>& variables);
 
+    /**
+     * Reorder the variables of the model so that variable `order[i]` becomes
+     * variable `i`.
+     *
+     * This is the inverse formulation of `permute()`. Orderings that improve
+     * memory locality can be generated with the functions in
+     * dimod/orderings.h.
+     *
+     * # Exceptions
+     * If `order` is not a permutation of `0, ..., num_variables() - 1` then
+     * the behavior of this method is undefined.
+     */
+    void reorder(const std::vector<index_type>& order);
+
+    /**
+     * Reserve capacity for at least `num_variables` variables.
+     *
+     * If `num_interactions_hint` is positive, the adjacency is also created and
+     * the neighborhood of each variable currently in the model reserves capacity
+     * for its share of `num_interactions_hint` interactions, assuming they
+     * are evenly distributed over `num_variables` variables.
+     * Use `reserve_interactions()` when the degree of each variable is known.
+     *
+     * Like `std::vector::reserve()`, this does not change the size of the model.
+     */
+    virtual void reserve(index_type num_variables, size_type num_interactions_hint = 0);
+
+    /**
+     * Reserve capacity in the neighborhood of each of the first `num_variables`
+     * variables for `degrees[v]` interactions, so that adding them does not
+     * reallocate.
+     *
+     * `degrees` must be an array of length `num_variables`.
+     *
+     * # Exceptions
+     * The behavior of this method is undefined when the model has fewer than
+     * `num_variables` variables.
+     */
+    template <class T>
+    void reserve_interactions(const T degrees[], index_type num_variables);
+
+    /// Set all of the counts returned by `stats()` to zero.
+    void reset_stats();
+
+    /**
+     * Undo the changes made since `begin_transaction()` and end the transaction.
+     *
+     * Variables added during the transaction are removed. If the model is
+     * keeping a journal that was started during the transaction, the journal
+     * is invalidated.
+     *
+     * # Exceptions
+     * Throws a `std::logic_error` if there is no transaction in progress.
+     */
+    virtual void rollback();
+
     /// Multiply all biases by the value of `scalar`.
     void scale(bias_type scalar);
 
@@ -357,10 +600,54 @@ class QuadraticModelBase {
     /// Set the quadratic bias between variables `u` and `v`.
     void set_quadratic(index_type u, index_type v, bias_type bias);
 
+    /// Release any capacity reserved beyond the current size of the model.
+    virtual void shrink_to_fit();
+
+    /**
+     * Start recording the changes made to the model, discarding any previous
+     * journal. See `journal()`.
+     *
+     * The journal is not copied with the model.
+     */
+    void start_journal();
+
+    /**
+     * Return the counts of the events performed by the model since it was
+     * constructed or since the last call to `reset_stats()`.
+     *
+     * All counts are zero unless dimod is compiled with DIMOD_INSTRUMENTATION
+     * defined.
+     */
+    Stats stats() const;
+
+    /// Stop recording the changes made to the model and discard the journal.
+    void stop_journal();
+
     void substitute_variable(index_type v, bias_type multiplier, bias_type offset);
 
     void substitute_variables(bias_type multiplier, bias_type offset);
 
+    /**
+     * Substitute each variable `v` with `multipliers[v] * v + offsets[v]`.
+     *
+     * All of the substitutions are applied in a single pass over the model.
+     * Use a multiplier of 1 and an offset of 0 to leave a variable unchanged.
+     * The new biases are accumulated in `accumulator_t<bias_type>`.
+     */
+    void substitute_variables(const std::vector<bias_type>& multipliers,
+                              const std::vector<bias_type>& offsets);
+
+    /**
+     * Write the upper triangle of the quadratic biases, including any
+     * self-loops, in Compressed Sparse Row format.
+     *
+     * `indptr` must be an array of length `num_variables() + 1`. `indices`
+     * and `data` must be arrays of length `num_interactions()`. The indices
+     * of each row are sorted.
+     */
+    template <class Ptr, class Ind, class T>
+    void to_csr(Ptr indptr[], Ind indices[], T data[]) const;
+
     /// Return the upper bound on variable ``v``.
     virtual bias_type upper_bound(index_type v) const = 0;
 
@@ -369,13 +656,18 @@ class QuadraticModelBase {
 
  protected:
     explicit QuadraticModelBase(std::vector<bias_type>&& linear_biases)
-            : linear_biases_(linear_biases), adj_ptr_(), offset_(0) {}
+            : linear_biases_(linear_biases), adj_ptr_(), num_interactions_(0), offset_(0) {}
 
-    explicit QuadraticModelBase(index_type n) : linear_biases_(n), adj_ptr_(), offset_(0) {}
+    explicit QuadraticModelBase(index_type n)
+            : linear_biases_(n), adj_ptr_(), num_interactions_(0), offset_(0) {}
 
     /// Increase the size of the model by one. Returns the index of the new variable.
     index_type add_variable();
 
+    /// Return the hash of the offset, linear biases and quadratic biases,
+    /// with `keys` indexed by the local variable indices. See `content_hash()`.
+    ContentHash biases_content_hash(const std::uint64_t keys[], size_type num_threads) const;
+
     /// Increase the size of the model by `n`. Returns the index of the first variable added.
     index_type add_variables(index_type n);
 
@@ -393,13 +685,174 @@ class QuadraticModelBase {
     /// By default they are the same.
     virtual Vartype vartype_(index_type v) const { return vartype(v); }
 
+#ifdef DIMOD_INSTRUMENTATION
+    /// Event counters, see `stats()`. Not copied with the model.
+    mutable StatsCounters stats_;
+
+    /// Record an insertion of `n` neighbors into `neighborhood` at `pos`.
+    template <class Neighborhood, class Iter>
+    void count_insert(const Neighborhood& neighborhood, Iter pos, size_type n = 1) const {
+        if (pos != neighborhood.end()) {
+            stats_.mid_inserts.fetch_add(n, std::memory_order_relaxed);
+        }
+        if (neighborhood.size() + n > neighborhood.capacity()) {
+            DIMOD_STATS_INCREMENT(stats_, reallocations);
+        }
+    }
+#else
+    template <class Neighborhood, class Iter>
+    void count_insert(const Neighborhood&, Iter, size_type = 1) const {}
+#endif
+
  private:
     std::vector<bias_type> linear_biases_;
 
     std::unique_ptr<std::vector<std::vector<OneVarTerm<bias_type, index_type>>>> adj_ptr_;
 
+    // The number of interactions. Each is counted by its term (u, v) with
+    // u <= v, which is stored exactly once
+    size_type num_interactions_;
+
     bias_type offset_;
 
+    // Neighborhoods with at least this many neighbors are indexed, so that
+    // their interactions can be found without a binary search.
+    static constexpr size_type NEIGHBORHOOD_INDEX_DEGREE = 256;
+
+    // The number of updates of existing interactions that a neighborhood's
+    // index can fail to answer before asymmetric_quadratic_ref() rebuilds it.
+    // Inserting a neighbor shifts the positions after it, so we don't want to
+    // rebuild after every insertion.
+    static constexpr size_type NEIGHBORHOOD_INDEX_MISSES = 8;
+
+    using neighborhood_indices_type = std::unordered_map<index_type, NeighborhoodIndex<index_type>>;
+
+    // The indices of the high-degree neighborhoods, keyed by variable, or null
+    // if there are none. Appends keep them up to date, other changes make them
+    // stale, see NeighborhoodIndex. Not copied with the model.
+    std::unique_ptr<neighborhood_indices_type> neighborhood_indices_ptr_;
+
+    // Return the index of the neighborhood of `u`, or null if it has none.
+    NeighborhoodIndex<index_type>* neighborhood_index(index_type u) const {
+        if (!neighborhood_indices_ptr_) return nullptr;
+        auto it = neighborhood_indices_ptr_->find(u);
+        return it == neighborhood_indices_ptr_->end() ? nullptr : &it->second;
+    }
+
+    // Return the index of the neighborhood of `u`, adding an empty one if needed.
+    NeighborhoodIndex<index_type>& enforce_neighborhood_index(index_type u) {
+        if (!neighborhood_indices_ptr_) neighborhood_indices_ptr_.reset(new neighborhood_indices_type());
+        return (*neighborhood_indices_ptr_)[u];
+    }
+
+    // Update the index of the neighborhood of `u` after a neighbor was
+    // inserted at `pos`. Assumes adj exists!
+    void index_inserted(index_type u, size_type pos) {
+        const auto& neighborhood = (*adj_ptr_)[u];
+        if (neighborhood.size() < NEIGHBORHOOD_INDEX_DEGREE) return;
+
+        if (neighborhood.size() == NEIGHBORHOOD_INDEX_DEGREE) {
+            // it just became large enough to index
+            enforce_neighborhood_index(u).build(neighborhood);
+        } else if (auto index = neighborhood_index(u)) {
+            if (pos + 1 == neighborhood.size()) {
+                index->insert(neighborhood[pos].v, pos);
+            } else {
+                index->clear();  // the positions after pos have shifted
+            }
+        }
+    }
+
+    // Discard the index of the neighborhood of `u`, if it has one, because
+    // its positions have shifted.
+    void index_invalidate(index_type u) {
+        if (auto index = neighborhood_index(u)) index->clear();
+    }
+
+    // Update the index of the neighborhood of `u` after the neighbors from
+    // position `first` on were appended. Assumes adj exists!
+    void index_appended(index_type u, size_type first) {
+        const auto& neighborhood = (*adj_ptr_)[u];
+        auto index = neighborhood_index(u);
+        if (index && !index->empty()) {
+            for (size_type pos = first; pos < neighborhood.size(); ++pos) {
+                index->insert(neighborhood[pos].v, pos);
+            }
+        } else {
+            index_rewritten(u);
+        }
+    }
+
+    // Rebuild the index of the neighborhood of `u` after the neighborhood was
+    // rewritten as a whole, or discard it if the neighborhood is too small to
+    // be indexed. Assumes adj exists!
+    void index_rewritten(index_type u) {
+        const auto& neighborhood = (*adj_ptr_)[u];
+        if (neighborhood.size() >= NEIGHBORHOOD_INDEX_DEGREE) {
+            enforce_neighborhood_index(u).build(neighborhood);
+        } else {
+            index_invalidate(u);
+        }
+    }
+
+    // The changes since start_journal(), or null. Not copied with the model.
+    std::unique_ptr<Journal<index_type>> journal_ptr_;
+
+    // Record changes in the journal, if there is one.
+    void journal_invalidate() {
+        if (journal_ptr_) journal_ptr_->invalidate();
+    }
+    void journal_linear(index_type v) {
+        if (journal_ptr_) journal_ptr_->record_linear(v);
+    }
+    void journal_offset() {
+        if (journal_ptr_) journal_ptr_->record_offset();
+    }
+    void journal_quadratic(index_type u, index_type v) {
+        if (journal_ptr_) journal_ptr_->record_quadratic(u, v);
+    }
+
+    // The undo log of a transaction, see begin_transaction(). The offset and
+    // the number of interactions are small enough to save at the start.
+    struct transaction_type {
+        UndoLog<bias_type, index_type> linear;
+        UndoLog<std::vector<OneVarTerm<bias_type, index_type>>, index_type> adj;
+
+        // if there was no adjacency at the start, there is nothing to save
+        bool had_adj;
+
+        size_type num_interactions;
+        bias_type offset;
+
+        // whether start_journal() was called during the transaction
+        bool journal_started;
+
+        transaction_type(const QuadraticModelBase& model)
+                : linear(model.num_variables()),
+                  adj(model.num_variables()),
+                  had_adj(model.has_adj()),
+                  num_interactions(model.num_interactions_),
+                  offset(model.offset_),
+                  journal_started(false) {}
+    };
+
+    // The transaction in progress, or null. Not copied with the model.
+    std::unique_ptr<transaction_type> transaction_ptr_;
+
+    // Save the parts of the model that are about to change, if there is a
+    // transaction in progress.
+    void undo_all() {
+        if (!transaction_ptr_) return;
+        transaction_ptr_->linear.save_all(linear_biases_);
+        if (transaction_ptr_->had_adj && has_adj()) transaction_ptr_->adj.save_all(*adj_ptr_);
+    }
+    void undo_linear(index_type v) {
+        if (transaction_ptr_) transaction_ptr_->linear.save(linear_biases_, v);
+    }
+    void undo_neighborhood(index_type v) {
+        if (transaction_ptr_ && transaction_ptr_->had_adj) transaction_ptr_->adj.save(*adj_ptr_, v);
+    }
+
     // Assumes adj exists!
     // Creates the bias if it doesn't already exist
     bias_type& asymmetric_quadratic_ref(index_type u, index_type v) {
@@ -407,16 +860,115 @@ class QuadraticModelBase {
         assert(0 <= v && static_cast<size_type>(v) < num_variables());
         assert(has_adj());
 
+        undo_neighborhood(u);
         auto& neighborhood = (*adj_ptr_)[u];
+
+        // neighborhoods are usually built in order, in which case v is new
+        // and there is nothing to look up
+        if (neighborhood.empty() || neighborhood.back().v < v) {
+            count_insert(neighborhood, neighborhood.end());
+            neighborhood.emplace_back(v, 0);
+            if (u <= v) ++num_interactions_;
+            index_inserted(u, neighborhood.size() - 1);
+            return neighborhood.back().bias;
+        }
+
+        const bool large = neighborhood.size() >= NEIGHBORHOOD_INDEX_DEGREE;
+        if (large) {
+            auto index = neighborhood_index(u);
+            if (index && !index->empty()) {
+                size_type pos = index->find(v);
+                DIMOD_STATS_INCREMENT(stats_, hash_lookups);
+                if (pos < neighborhood.size() && neighborhood[pos].v == v) {
+                    return neighborhood[pos].bias;
+                }
+            }
+        }
+
         auto it = std::lower_bound(neighborhood.begin(), neighborhood.end(), v);
+        DIMOD_STATS_INCREMENT(stats_, binary_searches);
         if (it == neighborhood.end() || it->v != v) {
             // we could make a bunch individual functions to avoid needing to
             // default to 0, but this is a lot simpler.
+            count_insert(neighborhood, it);
             it = neighborhood.emplace(it, v, 0);
+            if (u <= v) ++num_interactions_;
+            index_inserted(u, it - neighborhood.begin());
+        } else if (large) {
+            // the index is missing or stale
+            auto& index = enforce_neighborhood_index(u);
+            if (index.miss() >= NEIGHBORHOOD_INDEX_MISSES) index.build(neighborhood);
         }
         return it->bias;
     }
 
+    // Return the position of `v` in the neighborhood of `u`, or the position
+    // at which it would be inserted. Assumes adj exists!
+    size_type find_neighbor(index_type u, index_type v) const {
+        assert(0 <= u && static_cast<size_type>(u) < num_variables());
+        assert(has_adj());
+
+        const auto& neighborhood = (*adj_ptr_)[u];
+
+        if (neighborhood.size() >= NEIGHBORHOOD_INDEX_DEGREE) {
+            auto index = neighborhood_index(u);
+            if (index && !index->empty()) {
+                size_type pos = index->find(v);
+                DIMOD_STATS_INCREMENT(stats_, hash_lookups);
+                if (pos < neighborhood.size() && neighborhood[pos].v == v) return pos;
+            }
+        }
+
+        DIMOD_STATS_INCREMENT(stats_, binary_searches);
+        return std::lower_bound(neighborhood.cbegin(), neighborhood.cend(), v) -
+               neighborhood.cbegin();
+    }
+
+    /// Count the interactions by scanning the neighborhoods.
+    size_type count_interactions() const {
+        size_type count = 0;
+        if (has_adj()) {
+            index_type u = 0;
+            for (const auto& n : *adj_ptr_) {
+                count += n.cend() - std::lower_bound(n.cbegin(), n.cend(), u);
+                ++u;
+            }
+        }
+        return count;
+    }
+
+    // Call f(block, first, last) for each block of variables [first, last)
+    // on num_threads threads. Blocks are handed out dynamically because the
+    // degrees can vary a lot.
+    template <class F>
+    void for_each_block(size_type num_threads, F f) const {
+        const size_type n = num_variables();
+        const size_type num_blocks = (n + VARIABLE_BLOCK_SIZE - 1) / VARIABLE_BLOCK_SIZE;
+
+        if (!num_threads) num_threads = std::max<size_type>(std::thread::hardware_concurrency(), 1);
+        num_threads = std::min(num_threads, num_blocks);
+
+        std::atomic<size_type> next(0);
+        auto worker = [&]() {
+            for (size_type b = next++; b < num_blocks; b = next++) {
+                f(b, b * VARIABLE_BLOCK_SIZE, std::min((b + 1) * VARIABLE_BLOCK_SIZE, n));
+            }
+        };
+
+        std::vector<std::thread> threads;
+        if (num_threads > 1) threads.reserve(num_threads - 1);
+        for (size_type t = 1; t < num_threads; ++t) {
+            threads.emplace_back(worker);
+        }
+        worker();  // the calling thread does its share
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    }
+
+    // The number of variables per block of work in for_each_block().
+    static constexpr size_type VARIABLE_BLOCK_SIZE = 256;
+
     /// Create the adjacency structure if it doesn't already exist.
     void enforce_adj() {
         if (!adj_ptr_) {
@@ -432,11 +984,15 @@ class QuadraticModelBase {
 
 template <class bias_type, class index_type>
 QuadraticModelBase<bias_type, index_type>::QuadraticModelBase()
-        : linear_biases_(), adj_ptr_(), offset_(0) {}
+        : linear_biases_(), adj_ptr_(), num_interactions_(0), offset_(0) {}
 
 template <class bias_type, class index_type>
 QuadraticModelBase<bias_type, index_type>::QuadraticModelBase(const QuadraticModelBase& other)
-        : linear_biases_(other.linear_biases_), adj_ptr_(), offset_(other.offset_) {
+        : linear_biases_(other.linear_biases_),
+          adj_ptr_(),
+          num_interactions_(other.num_interactions_),
+          offset_(other.offset_),
+          neighborhood_indices_ptr_() {
     // need to handle the adj if present
     if (!other.is_linear()) {
         adj_ptr_ = std::unique_ptr<std::vector<std::vector<OneVarTerm<bias_type, index_type>>>>(
@@ -448,6 +1004,8 @@ template <class bias_type, class index_type>
 QuadraticModelBase<bias_type, index_type>& QuadraticModelBase<bias_type, index_type>::operator=(
         const QuadraticModelBase& other) {
     if (this != &other) {
+        undo_all();  // every bias may change
+
         linear_biases_ = other.linear_biases_;
         if (!other.is_linear()) {
             adj_ptr_ = std::unique_ptr<std::vector<std::vector<OneVarTerm<bias_type, index_type>>>>(
@@ -456,7 +1014,40 @@ QuadraticModelBase<bias_type, index_type>& QuadraticModelBase<bias_type, index_t
         } else {
             adj_ptr_.reset(nullptr);
         }
+        num_interactions_ = other.num_interactions_;
+        offset_ = other.offset_;
+        neighborhood_indices_ptr_.reset();
+        journal_invalidate();  // every bias may have changed
+    }
+    return *this;
+}
+
+template <class bias_type, class index_type>
+QuadraticModelBase<bias_type, index_type>::QuadraticModelBase(QuadraticModelBase&& other) noexcept
+        : linear_biases_(std::move(other.linear_biases_)),
+          adj_ptr_(std::move(other.adj_ptr_)),
+          num_interactions_(other.num_interactions_),
+          offset_(other.offset_),
+          neighborhood_indices_ptr_(std::move(other.neighborhood_indices_ptr_)),
+          journal_ptr_(std::move(other.journal_ptr_)),
+          transaction_ptr_(std::move(other.transaction_ptr_)) {
+    // the moved-from model has no adjacency left
+    other.num_interactions_ = 0;
+}
+
+template <class bias_type, class index_type>
+QuadraticModelBase<bias_type, index_type>& QuadraticModelBase<bias_type, index_type>::operator=(
+        QuadraticModelBase&& other) noexcept {
+    if (this != &other) {
+        linear_biases_ = std::move(other.linear_biases_);
+        adj_ptr_ = std::move(other.adj_ptr_);
+        num_interactions_ = other.num_interactions_;
         offset_ = other.offset_;
+        neighborhood_indices_ptr_ = std::move(other.neighborhood_indices_ptr_);
+        journal_ptr_ = std::move(other.journal_ptr_);
+        transaction_ptr_ = std::move(other.transaction_ptr_);
+
+        other.num_interactions_ = 0;
     }
     return *this;
 }
@@ -464,12 +1055,130 @@ QuadraticModelBase<bias_type, index_type>& QuadraticModelBase<bias_type, index_t
 template <class bias_type, class index_type>
 void QuadraticModelBase<bias_type, index_type>::add_linear(index_type v, bias_type bias) {
     assert(v >= 0 && static_cast<size_type>(v) < num_variables());
+    undo_linear(v);
     linear_biases_[v] += bias;
+    journal_linear(v);
+}
+
+template <class bias_type, class index_type>
+template <class B, class I>
+void QuadraticModelBase<bias_type, index_type>::add_model(const QuadraticModelBase<B, I>& other,
+                                                          const std::vector<index_type>& mapping) {
+    assert(mapping.size() == other.num_variables());
+
+    // offset and linear biases
+    add_offset(other.offset());
+    for (size_type i = 0; i < other.num_variables(); ++i) {
+        add_linear(mapping[i], other.linear(i));
+    }
+
+    if (other.is_linear()) return;
+
+    enforce_adj();
+
+    // if the mapping preserves the order then we don't need to sort the
+    // incoming neighborhoods
+    const bool monotonic =
+            std::adjacent_find(mapping.begin(), mapping.end(),
+                               std::greater_equal<index_type>()) == mapping.end();
+
+    // buffers, reused between rows to avoid reallocation
+    std::vector<OneVarTerm<bias_type, index_type>> incoming;
+    std::vector<OneVarTerm<bias_type, index_type>> merged;
+
+    for (size_type i = 0; i < other.num_variables(); ++i) {
+        const index_type u = mapping[i];
+        assert(0 <= u && static_cast<size_type>(u) < num_variables());
+
+        incoming.clear();
+        for (auto it = other.cbegin_neighborhood(i), end = other.cend_neighborhood(i); it != end;
+             ++it) {
+            const index_type v = mapping[it->v];
+
+            if (u == v) {
+                // self-loops are handled according to our vartype, same as
+                // add_quadratic()
+                switch (this->vartype_(u)) {
+                    case Vartype::BINARY: {
+                        undo_linear(u);
+                        linear_biases_[u] += it->bias;
+                        journal_linear(u);
+                        continue;
+                    }
+                    case Vartype::SPIN: {
+                        offset_ += it->bias;
+                        journal_offset();
+                        continue;
+                    }
+                    default: {
+                        break;
+                    }
+                }
+            }
+
+            incoming.emplace_back(v, it->bias);
+            if (u <= v) journal_quadratic(u, v);
+        }
+
+        if (incoming.empty()) continue;
+
+        if (!monotonic) {
+            std::sort(incoming.begin(), incoming.end());
+        }
+
+        undo_neighborhood(u);
+        auto& neighborhood = (*adj_ptr_)[u];
+
+        if (neighborhood.empty() || neighborhood.back().v < incoming.front().v) {
+            // fast path, everything goes at the end
+            num_interactions_ += incoming.cend() - std::lower_bound(incoming.cbegin(),
+                                                                    incoming.cend(), u);
+            const size_type first = neighborhood.size();
+            count_insert(neighborhood, neighborhood.end(), incoming.size());
+            neighborhood.insert(neighborhood.end(), incoming.begin(), incoming.end());
+            index_appended(u, first);
+            continue;
+        }
+
+        // two-pointer merge of the existing and incoming neighborhoods. The
+        // merged neighborhood reallocates if the buffer is too small
+        merged.clear();
+        count_insert(merged, merged.end(), neighborhood.size() + incoming.size());
+        merged.reserve(neighborhood.size() + incoming.size());
+
+        auto nit = neighborhood.cbegin();
+        auto iit = incoming.cbegin();
+        while (nit != neighborhood.cend() && iit != incoming.cend()) {
+            if (nit->v < iit->v) {
+                merged.push_back(*nit);
+                ++nit;
+            } else if (iit->v < nit->v) {
+                if (u <= iit->v) ++num_interactions_;
+                DIMOD_STATS_INCREMENT(stats_, mid_inserts);
+                merged.push_back(*iit);
+                ++iit;
+            } else {
+                merged.emplace_back(nit->v, nit->bias + iit->bias);
+                ++nit;
+                ++iit;
+            }
+        }
+        merged.insert(merged.end(), nit, neighborhood.cend());
+        for (auto it = iit; it != incoming.cend(); ++it) {
+            if (u <= it->v) ++num_interactions_;
+        }
+        merged.insert(merged.end(), iit, incoming.cend());
+
+        // keep the old neighborhood's memory around as the next buffer
+        neighborhood.swap(merged);
+        index_rewritten(u);
+    }
 }
 
 template <class bias_type, class index_type>
 void QuadraticModelBase<bias_type, index_type>::add_offset(bias_type bias) {
     offset_ += bias;
+    journal_offset();
 }
 
 template <class bias_type, class index_type>
@@ -484,23 +1193,28 @@ void QuadraticModelBase<bias_type, index_type>::add_quadratic(index_type u, inde
         switch (this->vartype_(u)) {
             case Vartype::BINARY: {
                 // 1*1 == 1 and 0*0 == 0 so this is linear
+                undo_linear(u);
                 linear_biases_[u] += bias;
+                journal_linear(u);
                 break;
             }
             case Vartype::SPIN: {
                 // -1*-1 == +1*+1 == 1 so this is a constant offset
                 offset_ += bias;
+                journal_offset();
                 break;
             }
             default: {
                 // self-loop
                 asymmetric_quadratic_ref(u, u) += bias;
+                journal_quadratic(u, u);
                 break;
             }
         }
     } else {
         asymmetric_quadratic_ref(u, v) += bias;
         asymmetric_quadratic_ref(v, u) += bias;
+        journal_quadratic(u, v);
     }
 }
 
@@ -550,17 +1264,31 @@ void QuadraticModelBase<bias_type, index_type>::add_quadratic_back(index_type u,
             case Vartype::SPIN: {
                 // -1*-1 == +1*+1 == 1 so this is a constant offset
                 offset_ += bias;
+                journal_offset();
                 break;
             }
             default: {
                 // self-loop
+                undo_neighborhood(u);
+                count_insert((*adj_ptr_)[u], (*adj_ptr_)[u].end());
                 (*adj_ptr_)[u].emplace_back(v, bias);
+                index_inserted(u, (*adj_ptr_)[u].size() - 1);
+                ++num_interactions_;
+                journal_quadratic(u, v);
                 break;
             }
         }
     } else {
+        undo_neighborhood(u);
+        undo_neighborhood(v);
+        count_insert((*adj_ptr_)[u], (*adj_ptr_)[u].end());
         (*adj_ptr_)[u].emplace_back(v, bias);
+        index_inserted(u, (*adj_ptr_)[u].size() - 1);
+        count_insert((*adj_ptr_)[v], (*adj_ptr_)[v].end());
         (*adj_ptr_)[v].emplace_back(u, bias);
+        index_inserted(v, (*adj_ptr_)[v].size() - 1);
+        ++num_interactions_;
+        journal_quadratic(u, v);
     }
 }
 
@@ -581,7 +1309,9 @@ void QuadraticModelBase<bias_type, index_type>::add_quadratic_from_dense(const T
 
             // off-diagonal
             for (index_type v = u + 1; v < num_variables; ++v) {
-                bias_type qbias = dense[u * num_variables + v] + dense[v * num_variables + u];
+                bias_type qbias =
+                        static_cast<accumulator_t<bias_type>>(dense[u * num_variables + v]) +
+                        dense[v * num_variables + u];
 
                 if (qbias) {
                     add_quadratic_back(u, v, qbias);
@@ -596,7 +1326,9 @@ void QuadraticModelBase<bias_type, index_type>::add_quadratic_from_dense(const T
 
             // off-diagonal
             for (index_type v = u + 1; v < num_variables; ++v) {
-                bias_type qbias = dense[u * num_variables + v] + dense[v * num_variables + u];
+                bias_type qbias =
+                        static_cast<accumulator_t<bias_type>>(dense[u * num_variables + v]) +
+                        dense[v * num_variables + u];
 
                 if (qbias) {
                     add_quadratic(u, v, qbias);
@@ -606,6 +1338,114 @@ void QuadraticModelBase<bias_type, index_type>::add_quadratic_from_dense(const T
     }
 }
 
+template <class bias_type, class index_type>
+template <class Ptr, class Ind, class T>
+void QuadraticModelBase<bias_type, index_type>::add_quadratic_from_csr(const Ptr indptr[],
+                                                                       const Ind indices[],
+                                                                       const T data[],
+                                                                       index_type num_rows) {
+    static_assert(std::is_integral<Ptr>::value, "Ptr must be an integer type");
+    static_assert(std::is_integral<Ind>::value, "Ind must be an integer type");
+    static_assert(std::is_arithmetic<T>::value, "T must be numeric");
+    assert(0 <= num_rows);
+    assert(static_cast<size_type>(num_rows) <= this->num_variables());
+
+    if (!num_rows || indptr[0] == indptr[num_rows]) return;
+
+    if (!is_linear()) {
+        // we cannot rely on the ordering
+        for (index_type u = 0; u < num_rows; ++u) {
+            for (Ptr k = indptr[u]; k < indptr[u + 1]; ++k) {
+                add_quadratic(u, indices[k], data[k]);
+            }
+        }
+        return;
+    }
+
+    enforce_adj();
+    auto& adj = *adj_ptr_;
+
+    // count the degrees first so each neighborhood is only allocated once
+    std::vector<size_type> degrees(this->num_variables(), 0);
+    for (index_type u = 0; u < num_rows; ++u) {
+        for (Ptr k = indptr[u]; k < indptr[u + 1]; ++k) {
+            index_type v = indices[k];
+            assert(0 <= v && static_cast<size_type>(v) < this->num_variables());
+            ++degrees[u];
+            if (u != v) ++degrees[v];
+        }
+    }
+    for (size_type v = 0; v < degrees.size(); ++v) {
+        if (!degrees[v]) continue;
+        count_insert(adj[v], adj[v].end(), degrees[v]);
+        adj[v].reserve(degrees[v]);
+    }
+
+    for (index_type u = 0; u < num_rows; ++u) {
+        for (Ptr k = indptr[u]; k < indptr[u + 1]; ++k) {
+            index_type v = indices[k];
+            bias_type bias = data[k];
+
+            if (u == v) {
+                switch (this->vartype_(u)) {
+                    case Vartype::BINARY: {
+                        // 1*1 == 1 and 0*0 == 0 so this is linear
+                        undo_linear(u);
+                        linear_biases_[u] += bias;
+                        journal_linear(u);
+                        break;
+                    }
+                    case Vartype::SPIN: {
+                        // -1*-1 == +1*+1 == 1 so this is a constant offset
+                        offset_ += bias;
+                        journal_offset();
+                        break;
+                    }
+                    default: {
+                        // self-loop
+                        undo_neighborhood(u);
+                        adj[u].emplace_back(v, bias);
+                        journal_quadratic(u, v);
+                        break;
+                    }
+                }
+            } else {
+                undo_neighborhood(u);
+                undo_neighborhood(v);
+                adj[u].emplace_back(v, bias);
+                adj[v].emplace_back(u, bias);
+                journal_quadratic(u, v);
+            }
+        }
+    }
+
+    // sort each neighborhood and sum the duplicates. For an upper-triangular
+    // matrix with sorted indices the neighborhoods are already sorted
+    for (auto& neighborhood : adj) {
+        if (neighborhood.size() < 2) continue;
+
+        if (!std::is_sorted(neighborhood.begin(), neighborhood.end())) {
+            std::sort(neighborhood.begin(), neighborhood.end());
+        }
+
+        auto out = neighborhood.begin();
+        for (auto it = neighborhood.begin() + 1; it != neighborhood.end(); ++it) {
+            if (it->v == out->v) {
+                out->bias += it->bias;
+            } else {
+                *(++out) = *it;
+            }
+        }
+        neighborhood.erase(out + 1, neighborhood.end());
+    }
+
+    for (index_type v = 0; v < static_cast<index_type>(this->num_variables()); ++v) {
+        index_rewritten(v);
+    }
+
+    num_interactions_ = count_interactions();
+}
+
 template <class bias_type, class index_type>
 index_type QuadraticModelBase<bias_type, index_type>::add_variable() {
     return add_variables(1);
@@ -624,6 +1464,12 @@ index_type QuadraticModelBase<bias_type, index_type>::add_variables(index_type n
     return size;
 }
 
+template <class bias_type, class index_type>
+void QuadraticModelBase<bias_type, index_type>::begin_transaction() {
+    if (transaction_ptr_) throw std::logic_error("a transaction is already in progress");
+    transaction_ptr_.reset(new transaction_type(*this));
+}
+
 template <class bias_type, class index_type>
 typename QuadraticModelBase<bias_type, index_type>::const_neighborhood_iterator
 QuadraticModelBase<bias_type, index_type>::cbegin_neighborhood(index_type v) const {
@@ -660,9 +1506,69 @@ QuadraticModelBase<bias_type, index_type>::cend_quadratic() const {
 
 template <class bias_type, class index_type>
 void QuadraticModelBase<bias_type, index_type>::clear() {
+    undo_all();
     adj_ptr_.reset(nullptr);
+    num_interactions_ = 0;
+    neighborhood_indices_ptr_.reset();
     linear_biases_.clear();
     offset_ = 0;
+    journal_invalidate();
+}
+
+template <class bias_type, class index_type>
+void QuadraticModelBase<bias_type, index_type>::commit() {
+    if (!transaction_ptr_) throw std::logic_error("no transaction in progress");
+    transaction_ptr_.reset();
+}
+
+template <class bias_type, class index_type>
+ContentHash QuadraticModelBase<bias_type, index_type>::content_hash(const std::uint64_t keys[],
+                                                                   size_type num_threads) const {
+    ContentHash hash = biases_content_hash(keys, num_threads);
+
+    for (size_type v = 0; v < num_variables(); ++v) {
+        std::uint64_t key = keys ? keys[v] : hashing::key(v);
+        hash += hashing::hash(hashing::VARIABLE, key, vartype(v), hashing::bits(lower_bound(v)),
+                              hashing::bits(upper_bound(v)));
+    }
+
+    return hash;
+}
+
+template <class bias_type, class index_type>
+ContentHash QuadraticModelBase<bias_type, index_type>::biases_content_hash(
+        const std::uint64_t keys[], size_type num_threads) const {
+    auto key = [keys](size_type v) { return keys ? keys[v] : hashing::key(v); };
+
+    // the sum of the term hashes does not depend on the order of the terms,
+    // so each block of variables is hashed separately and the blocks summed
+    std::vector<ContentHash> blocks((num_variables() + VARIABLE_BLOCK_SIZE - 1) /
+                                    VARIABLE_BLOCK_SIZE);
+    for_each_block(num_threads, [&](size_type block, size_type first, size_type last) {
+        ContentHash hash;
+        for (size_type u = first; u < last; ++u) {
+            std::uint64_t ku = key(u);
+            hash += hashing::hash(hashing::LINEAR, ku, hashing::bits(linear_biases_[u]));
+
+            if (!has_adj()) continue;
+
+            // each interaction is hashed once, by its term (u, v) with u <= v
+            const auto& neighborhood = (*adj_ptr_)[u];
+            for (auto it = std::lower_bound(neighborhood.cbegin(), neighborhood.cend(),
+                                            static_cast<index_type>(u));
+                 it != neighborhood.cend(); ++it) {
+                hash += hashing::hash_interaction(hashing::QUADRATIC, ku, key(it->v),
+                                                  hashing::bits(it->bias));
+            }
+        }
+        blocks[block] = hash;
+    });
+
+    ContentHash hash = hashing::hash(hashing::OFFSET, hashing::bits(offset_));
+    for (const auto& block : blocks) {
+        hash += block;
+    }
+    return hash;
 }
 
 template <class bias_type, class index_type>
@@ -672,11 +1578,13 @@ bias_type QuadraticModelBase<bias_type, index_type>::energy(Iter sample_start) c
                                typename std::iterator_traits<Iter>::iterator_category>::value,
                   "iterators must be random access");
 
-    bias_type en = offset();
+    using accumulator_type = accumulator_t<bias_type>;
+
+    accumulator_type en = offset();
 
     if (has_adj()) {
         for (index_type u = 0; static_cast<size_type>(u) < num_variables(); ++u) {
-            auto u_val = *(sample_start + u);
+            accumulator_type u_val = *(sample_start + u);
 
             en += u_val * linear(u);
 
@@ -687,7 +1595,7 @@ bias_type QuadraticModelBase<bias_type, index_type>::energy(Iter sample_start) c
         }
     } else {
         for (auto it = linear_biases_.begin(); it != linear_biases_.end(); ++it, ++sample_start) {
-            en += *sample_start * *it;
+            en += static_cast<accumulator_type>(*sample_start) * *it;
         }
     }
 
@@ -714,6 +1622,85 @@ void QuadraticModelBase<bias_type, index_type>::fix_variable(index_type v, T ass
     QuadraticModelBase<bias_type, index_type>::remove_variable(v);
 }
 
+template <class bias_type, class index_type>
+void QuadraticModelBase<bias_type, index_type>::fix_variables(
+        const std::vector<index_type>& variables, const std::vector<bias_type>& assignments) {
+    if (variables.size() != assignments.size()) {
+        throw std::invalid_argument("variables and assignments must be the same length");
+    }
+    if (!variables.size()) return;  // shortcut
+
+    using accumulator_type = accumulator_t<bias_type>;
+
+    // the new label of each variable, or -1 if it is fixed, and the values
+    // of the fixed ones
+    std::vector<index_type> reindex(num_variables(), 0);
+    std::vector<bias_type> values(num_variables(), 0);
+    for (size_type i = 0; i < variables.size(); ++i) {
+        assert(variables[i] >= 0 && static_cast<size_type>(variables[i]) < num_variables());
+        reindex[variables[i]] = -1;
+        values[variables[i]] = assignments[i];
+    }
+    index_type label = 0;
+    for (auto& v : reindex) {
+        if (v == -1) continue;  // the fixed variables
+        v = label;
+        ++label;
+    }
+
+    journal_invalidate();  // the remaining variables are relabeled
+    undo_all();
+
+    accumulator_type offset = offset_;
+
+    // Fold the fixed variables in and compact the biases and neighborhoods
+    // towards the front. Slot reindex[v] <= v, so it has already been read.
+    for (size_type v = 0; v < reindex.size(); ++v) {
+        if (reindex[v] == -1) {
+            // the linear bias, and each interaction with another fixed
+            // variable once, get added to the offset
+            accumulator_type value = values[v];
+            offset += value * linear_biases_[v];
+            if (has_adj()) {
+                for (const auto& term : (*adj_ptr_)[v]) {
+                    if (term.v < static_cast<index_type>(v) || reindex[term.v] != -1) continue;
+                    offset += value * values[term.v] * term.bias;
+                }
+            }
+            continue;
+        }
+
+        // interactions with fixed variables become linear
+        accumulator_type lbias = linear_biases_[v];
+        if (has_adj()) {
+            auto& neighborhood = (*adj_ptr_)[v];
+            auto pred = [&](OneVarTerm<bias_type, index_type>& term) {
+                if (reindex[term.v] == -1) {
+                    lbias += static_cast<accumulator_type>(values[term.v]) * term.bias;
+                    return true;  // remove
+                }
+                // the reindexing is monotonic, so the neighborhood stays sorted
+                term.v = reindex[term.v];
+                return false;
+            };
+            neighborhood.erase(std::remove_if(neighborhood.begin(), neighborhood.end(), pred),
+                               neighborhood.end());
+            if (reindex[v] != static_cast<index_type>(v)) {
+                (*adj_ptr_)[reindex[v]].swap(neighborhood);
+            }
+        }
+        linear_biases_[reindex[v]] = lbias;
+    }
+
+    linear_biases_.resize(label);
+    offset_ = offset;
+    if (has_adj()) {
+        adj_ptr_->resize(label);
+        num_interactions_ = count_interactions();
+        neighborhood_indices_ptr_.reset();
+    }
+}
+
 template <class bias_type, class index_type>
 bool QuadraticModelBase<bias_type, index_type>::has_interaction(index_type u, index_type v) const {
     assert(0 <= u && static_cast<size_type>(u) < num_variables());
@@ -724,12 +1711,26 @@ bool QuadraticModelBase<bias_type, index_type>::has_interaction(index_type u, in
     }
 
     const auto& n = (*adj_ptr_)[u];
-    auto it = std::lower_bound(n.cbegin(), n.cend(), v);
-    if (it == n.cend() || it->v != v) {
-        return false;
+    size_type pos = find_neighbor(u, v);
+    return pos < n.size() && n[pos].v == v;
+}
+
+template <class bias_type, class index_type>
+void QuadraticModelBase<bias_type, index_type>::index_neighborhoods() {
+    neighborhood_indices_ptr_.reset();
+    if (!has_adj()) return;
+
+    for (size_type u = 0; u < num_variables(); ++u) {
+        const auto& neighborhood = (*adj_ptr_)[u];
+        if (neighborhood.size() >= NEIGHBORHOOD_INDEX_DEGREE) {
+            enforce_neighborhood_index(u).build(neighborhood);
+        }
     }
+}
 
-    return true;
+template <class bias_type, class index_type>
+bool QuadraticModelBase<bias_type, index_type>::in_transaction() const {
+    return static_cast<bool>(transaction_ptr_);
 }
 
 template <class bias_type, class index_type>
@@ -769,12 +1770,59 @@ bool QuadraticModelBase<bias_type, index_type>::is_equal(
 
 template <class bias_type, class index_type>
 bool QuadraticModelBase<bias_type, index_type>::is_linear() const {
-    if (has_adj()) {
-        for (const auto& n : *adj_ptr_) {
-            if (n.size()) return false;
+    return !num_interactions();
+}
+
+template <class bias_type, class index_type>
+Journal<index_type>* QuadraticModelBase<bias_type, index_type>::journal() {
+    return journal_ptr_.get();
+}
+
+template <class bias_type, class index_type>
+const Journal<index_type>* QuadraticModelBase<bias_type, index_type>::journal() const {
+    return journal_ptr_.get();
+}
+
+template <class bias_type, class index_type>
+template <class T, class Out>
+void QuadraticModelBase<bias_type, index_type>::local_fields(const T samples[],
+                                                             size_type num_samples, Out out[],
+                                                             size_type num_threads) const {
+    static_assert(std::is_arithmetic<T>::value, "T must be numeric");
+    static_assert(std::is_arithmetic<Out>::value, "Out must be numeric");
+
+    using accumulator_type = accumulator_t<bias_type>;
+
+    const size_type n = num_variables();
+
+    // the neighborhoods are the rows of a sparse matrix, so this is a sparse
+    // matrix times the dense matrix of samples. Each call handles a block of
+    // rows for every sample, so each neighborhood is read once per block
+    auto rows = [&](size_type first, size_type last) {
+        for (size_type s = 0; s < num_samples; ++s) {
+            const T* x = samples + s * n;
+            Out* fields = out + s * n;
+
+            for (size_type u = first; u < last; ++u) {
+                accumulator_type field = linear_biases_[u];
+                if (has_adj()) {
+                    for (const auto& term : (*adj_ptr_)[u]) {
+                        accumulator_type contribution =
+                                term.bias * static_cast<accumulator_type>(x[term.v]);
+
+                        // self-loops are stored once but x[u]^2 contributes twice
+                        field += (static_cast<size_type>(term.v) == u) ? 2 * contribution
+                                                                       : contribution;
+                    }
+                }
+                fields[u] = field;
+            }
         }
-    }
-    return true;
+    };
+
+    for_each_block(num_threads, [&rows](size_type, size_type first, size_type last) {
+        rows(first, last);
+    });
 }
 
 template <class bias_type, class index_type>
@@ -802,27 +1850,17 @@ std::size_t QuadraticModelBase<bias_type, index_type>::nbytes(bool capacity) con
             }
         }
     }
+    if (neighborhood_indices_ptr_) {
+        for (const auto& index : *neighborhood_indices_ptr_) {
+            count += index.second.nbytes(capacity);
+        }
+    }
     return count;
 }
 
 template <class bias_type, class index_type>
 std::size_t QuadraticModelBase<bias_type, index_type>::num_interactions() const {
-    size_type count = 0;
-    if (has_adj()) {
-        index_type v = 0;
-        for (auto& n : *(adj_ptr_)) {
-            count += n.size();
-
-            // account for self-loops
-            auto lb = std::lower_bound(n.cbegin(), n.cend(), v);
-            if (lb != n.cend() && lb->v == v) {
-                count += 1;
-            }
-
-            ++v;
-        }
-    }
-    return count / 2;
+    return num_interactions_;
 }
 
 template <class bias_type, class index_type>
@@ -839,6 +1877,43 @@ bias_type QuadraticModelBase<bias_type, index_type>::offset() const {
     return offset_;
 }
 
+template <class bias_type, class index_type>
+void QuadraticModelBase<bias_type, index_type>::permute(
+        const std::vector<index_type>& permutation) {
+    assert(permutation.size() == num_variables());
+
+    journal_invalidate();  // the variables are relabeled
+    undo_all();
+
+    std::vector<bias_type> linear_biases(permutation.size());
+    for (size_type v = 0; v < permutation.size(); ++v) {
+        assert(0 <= permutation[v] && static_cast<size_type>(permutation[v]) < num_variables());
+        linear_biases[permutation[v]] = linear_biases_[v];
+    }
+    linear_biases_.swap(linear_biases);
+
+    if (!has_adj()) return;
+
+    // move rather than copy the neighborhoods
+    std::vector<std::vector<OneVarTerm<bias_type, index_type>>> adj(permutation.size());
+    for (size_type v = 0; v < permutation.size(); ++v) {
+        auto& neighborhood = adj[permutation[v]];
+        neighborhood.swap((*adj_ptr_)[v]);
+
+        for (auto& term : neighborhood) {
+            term.v = permutation[term.v];
+        }
+
+        // permutations that preserve the relative order of the neighbors are
+        // common enough to be worth checking for
+        if (!std::is_sorted(neighborhood.begin(), neighborhood.end())) {
+            std::sort(neighborhood.begin(), neighborhood.end());
+        }
+    }
+    adj_ptr_->swap(adj);
+    neighborhood_indices_ptr_.reset();  // the variables have been relabeled
+}
+
 template <class bias_type, class index_type>
 bias_type QuadraticModelBase<bias_type, index_type>::quadratic(index_type u, index_type v) const {
     if (!adj_ptr_) {
@@ -846,12 +1921,12 @@ bias_type QuadraticModelBase<bias_type, index_type>::quadratic(index_type u, ind
     }
 
     const auto& n = (*adj_ptr_)[u];
-    auto it = std::lower_bound(n.cbegin(), n.cend(), v);
-    if (it == n.cend() || it->v != v) {
+    size_type pos = find_neighbor(u, v);
+    if (pos == n.size() || n[pos].v != v) {
         return 0;
     }
 
-    return it->bias;
+    return n[pos].bias;
 }
 
 template <class bias_type, class index_type>
@@ -862,12 +1937,12 @@ bias_type QuadraticModelBase<bias_type, index_type>::quadratic_at(index_type u,
     }
 
     const auto& n = (*adj_ptr_)[u];
-    auto it = std::lower_bound(n.cbegin(), n.cend(), v);
-    if (it == n.cend() || it->v != v) {
+    size_type pos = find_neighbor(u, v);
+    if (pos == n.size() || n[pos].v != v) {
         throw std::out_of_range("given variables have no interaction");
     }
 
-    return it->bias;
+    return n[pos].bias;
 }
 
 template <class bias_type, class index_type>
@@ -875,14 +1950,20 @@ bool QuadraticModelBase<bias_type, index_type>::remove_interaction(index_type u,
     if (!has_adj()) return false;  // no quadratic to remove
 
     auto& Nu = (*adj_ptr_)[u];
-    auto it = std::lower_bound(Nu.begin(), Nu.end(), v);  // find v in the neighborhood of u
+    auto it = Nu.begin() + find_neighbor(u, v);  // find v in the neighborhood of u
     if (it != Nu.end() && it->v == v) {
         // u and v have an interaction
+        undo_neighborhood(u);
+        undo_neighborhood(v);
         Nu.erase(it);
+        index_invalidate(u);
+        --num_interactions_;
+        journal_quadratic(u, v);
 
         if (u != v) {
             auto& Nv = (*adj_ptr_)[v];
-            Nv.erase(std::lower_bound(Nv.begin(), Nv.end(), u));  // guaranteed to be present
+            Nv.erase(Nv.begin() + find_neighbor(v, u));  // guaranteed to be present
+            index_invalidate(v);
         }
         return true;
     }
@@ -893,11 +1974,16 @@ template <class bias_type, class index_type>
 void QuadraticModelBase<bias_type, index_type>::remove_variable(index_type v) {
     assert(0 <= v && static_cast<size_type>(v) < num_variables());
 
+    journal_invalidate();  // the variables above v are relabeled
+    undo_all();
+
     linear_biases_.erase(linear_biases_.cbegin() + v);
 
     if (has_adj()) {
-        // remove v's neighborhood
+        // remove v's neighborhood, which has each of v's interactions once
+        num_interactions_ -= (*adj_ptr_)[v].size();
         adj_ptr_->erase(adj_ptr_->cbegin() + v);
+        neighborhood_indices_ptr_.reset();  // the variables have been relabeled
 
         for (auto& n : *adj_ptr_) {
             // work backwards through each neighborhood, decrementing the indices above v
@@ -935,6 +2021,9 @@ void QuadraticModelBase<bias_type, index_type>::remove_variables(
         return;
     }
 
+    journal_invalidate();  // the remaining variables are relabeled
+    undo_all();
+
     linear_biases_.erase(utils::remove_by_index(linear_biases_.begin(), linear_biases_.end(),
                                                 variables.begin(), variables.end()),
                          linear_biases_.end());
@@ -971,6 +2060,9 @@ void QuadraticModelBase<bias_type, index_type>::remove_variables(
             // we modify the indices and remove the variables we need to remove
             n.erase(std::remove_if(n.begin(), n.end(), pred), n.end());
         }
+
+        num_interactions_ = count_interactions();
+        neighborhood_indices_ptr_.reset();
     }
 }
 
@@ -978,6 +2070,11 @@ template <class bias_type, class index_type>
 void QuadraticModelBase<bias_type, index_type>::resize(index_type n) {
     assert(n >= 0);
 
+    if (static_cast<size_type>(n) < num_variables()) {
+        journal_invalidate();
+        undo_all();
+    }
+
     if (has_adj()) {
         if (static_cast<size_type>(n) < num_variables()) {
             // Clean out any of the to-be-deleted variables from the
@@ -989,8 +2086,12 @@ void QuadraticModelBase<bias_type, index_type>::resize(index_type n) {
                 neighborhood.erase(std::lower_bound(neighborhood.begin(), neighborhood.end(), n),
                                    neighborhood.end());
             }
+            adj_ptr_->resize(n);
+            num_interactions_ = count_interactions();
+            neighborhood_indices_ptr_.reset();
+        } else {
+            adj_ptr_->resize(n);
         }
-        adj_ptr_->resize(n);
     }
 
     linear_biases_.resize(n);
@@ -998,8 +2099,95 @@ void QuadraticModelBase<bias_type, index_type>::resize(index_type n) {
     assert(!has_adj() || linear_biases_.size() == adj_ptr_->size());
 }
 
+template <class bias_type, class index_type>
+void QuadraticModelBase<bias_type, index_type>::reorder(const std::vector<index_type>& order) {
+    assert(order.size() == num_variables());
+
+    std::vector<index_type> permutation(order.size());
+    for (size_type i = 0; i < order.size(); ++i) {
+        assert(0 <= order[i] && static_cast<size_type>(order[i]) < num_variables());
+        permutation[order[i]] = i;
+    }
+
+    permute(permutation);
+}
+
+template <class bias_type, class index_type>
+void QuadraticModelBase<bias_type, index_type>::reserve(index_type num_variables,
+                                                        size_type num_interactions_hint) {
+    assert(num_variables >= 0);
+
+    linear_biases_.reserve(num_variables);
+
+    if (num_interactions_hint) {
+        enforce_adj();
+        adj_ptr_->reserve(num_variables);
+
+        // each interaction is stored in two neighborhoods
+        size_type degree = 2 * num_interactions_hint / std::max<size_type>(num_variables, 1);
+        for (auto& n : (*adj_ptr_)) {
+            n.reserve(degree);
+        }
+    } else if (has_adj()) {
+        adj_ptr_->reserve(num_variables);
+    }
+}
+
+template <class bias_type, class index_type>
+template <class T>
+void QuadraticModelBase<bias_type, index_type>::reserve_interactions(const T degrees[],
+                                                                     index_type num_variables) {
+    static_assert(std::is_integral<T>::value, "T must be an integer");
+    assert(0 <= num_variables);
+    assert(static_cast<size_type>(num_variables) <= this->num_variables());
+
+    enforce_adj();
+
+    for (index_type v = 0; v < num_variables; ++v) {
+        assert(degrees[v] >= 0);
+        (*adj_ptr_)[v].reserve(degrees[v]);
+    }
+}
+
+template <class bias_type, class index_type>
+void QuadraticModelBase<bias_type, index_type>::reset_stats() {
+#ifdef DIMOD_INSTRUMENTATION
+    stats_.reset();
+#endif
+}
+
+template <class bias_type, class index_type>
+void QuadraticModelBase<bias_type, index_type>::rollback() {
+    if (!transaction_ptr_) throw std::logic_error("no transaction in progress");
+    transaction_type& transaction = *transaction_ptr_;
+
+    const size_type num_variables = this->num_variables();
+
+    transaction.linear.restore(linear_biases_);
+    if (transaction.had_adj) {
+        enforce_adj();  // in case the model was cleared
+        transaction.adj.restore(*adj_ptr_);
+    } else {
+        adj_ptr_.reset(nullptr);
+    }
+    num_interactions_ = transaction.num_interactions;
+    offset_ = transaction.offset;
+    neighborhood_indices_ptr_.reset();
+
+    // the journal recorded every change we just undid, unless it was started
+    // part way through. Variables added and then removed are not recorded
+    if (transaction.journal_started || this->num_variables() < num_variables) {
+        journal_invalidate();
+    }
+
+    transaction_ptr_.reset();
+}
+
 template <class bias_type, class index_type>
 void QuadraticModelBase<bias_type, index_type>::scale(bias_type scalar) {
+    journal_invalidate();  // every bias changes
+    undo_all();
+
     offset_ *= scalar;
 
     // linear biases
@@ -1017,10 +2205,31 @@ void QuadraticModelBase<bias_type, index_type>::scale(bias_type scalar) {
     }
 }
 
+template <class bias_type, class index_type>
+template <class Ptr, class Ind, class T>
+void QuadraticModelBase<bias_type, index_type>::to_csr(Ptr indptr[], Ind indices[],
+                                                       T data[]) const {
+    Ptr k = 0;
+    indptr[0] = k;
+    for (index_type u = 0; static_cast<size_type>(u) < num_variables(); ++u) {
+        if (has_adj()) {
+            const auto& neighborhood = (*adj_ptr_)[u];
+            auto it = std::lower_bound(neighborhood.begin(), neighborhood.end(), u);
+            for (; it != neighborhood.end(); ++it, ++k) {
+                indices[k] = it->v;
+                data[k] = it->bias;
+            }
+        }
+        indptr[u + 1] = k;
+    }
+}
+
 template <class bias_type, class index_type>
 void QuadraticModelBase<bias_type, index_type>::set_linear(index_type v, bias_type bias) {
     assert(v >= 0 && static_cast<size_type>(v) < num_variables());
+    undo_linear(v);
     linear_biases_[v] = bias;
+    journal_linear(v);
 }
 
 template <class bias_type, class index_type>
@@ -1029,7 +2238,9 @@ void QuadraticModelBase<bias_type, index_type>::set_linear(
     assert(v >= 0 && static_cast<size_type>(v) < num_variables());
     assert(biases.size() + v <= num_variables());
     for (const bias_type& b : biases) {
+        undo_linear(v);
         linear_biases_[v] = b;
+        journal_linear(v);
         ++v;
     }
 }
@@ -1037,6 +2248,7 @@ void QuadraticModelBase<bias_type, index_type>::set_linear(
 template <class bias_type, class index_type>
 void QuadraticModelBase<bias_type, index_type>::set_offset(bias_type offset) {
     offset_ = offset;
+    journal_offset();
 }
 
 template <class bias_type, class index_type>
@@ -1067,6 +2279,38 @@ void QuadraticModelBase<bias_type, index_type>::set_quadratic(index_type u, inde
         asymmetric_quadratic_ref(u, v) = bias;
         asymmetric_quadratic_ref(v, u) = bias;
     }
+    journal_quadratic(u, v);
+}
+
+template <class bias_type, class index_type>
+void QuadraticModelBase<bias_type, index_type>::shrink_to_fit() {
+    linear_biases_.shrink_to_fit();
+    if (has_adj()) {
+        adj_ptr_->shrink_to_fit();
+        for (auto& n : (*adj_ptr_)) {
+            n.shrink_to_fit();
+        }
+    }
+}
+
+template <class bias_type, class index_type>
+void QuadraticModelBase<bias_type, index_type>::start_journal() {
+    journal_ptr_.reset(new Journal<index_type>(num_variables()));
+    if (transaction_ptr_) transaction_ptr_->journal_started = true;
+}
+
+template <class bias_type, class index_type>
+Stats QuadraticModelBase<bias_type, index_type>::stats() const {
+#ifdef DIMOD_INSTRUMENTATION
+    return stats_.load();
+#else
+    return Stats();
+#endif
+}
+
+template <class bias_type, class index_type>
+void QuadraticModelBase<bias_type, index_type>::stop_journal() {
+    journal_ptr_.reset();
 }
 
 // todo: version the accepts rational numbers
@@ -1074,16 +2318,26 @@ template <class bias_type, class index_type>
 void QuadraticModelBase<bias_type, index_type>::substitute_variable(index_type v,
                                                                     bias_type multiplier,
                                                                     bias_type offset) {
-    offset_ += linear_biases_[v] * offset;
+    using accumulator_type = accumulator_t<bias_type>;
+
+    undo_linear(v);
+    offset_ += static_cast<accumulator_type>(linear_biases_[v]) * offset;
     linear_biases_[v] *= multiplier;
+    journal_offset();
+    journal_linear(v);
 
     if (has_adj()) {
+        undo_neighborhood(v);
         for (auto& term : (*adj_ptr_)[v]) {
-            linear_biases_[term.v] += term.bias * offset;
+            undo_linear(term.v);
+            linear_biases_[term.v] += static_cast<accumulator_type>(term.bias) * offset;
 
             // the quadratic interactions
             asymmetric_quadratic_ref(term.v, v) *= multiplier;
             term.bias *= multiplier;
+
+            journal_linear(term.v);
+            journal_quadratic(v, term.v);
         }
     }
 }
@@ -1092,24 +2346,72 @@ void QuadraticModelBase<bias_type, index_type>::substitute_variable(index_type v
 template <class bias_type, class index_type>
 void QuadraticModelBase<bias_type, index_type>::substitute_variables(bias_type multiplier,
                                                                      bias_type offset) {
-    bias_type quad_mp = multiplier * multiplier;
-    bias_type lin_quad_mp = multiplier * offset;
-    bias_type quad_offset_mp = offset * offset / 2;  // we do this twice so divide by two
+    using accumulator_type = accumulator_t<bias_type>;
+
+    journal_invalidate();  // every bias changes
+    undo_all();
+
+    accumulator_type quad_mp = static_cast<accumulator_type>(multiplier) * multiplier;
+    accumulator_type lin_quad_mp = static_cast<accumulator_type>(multiplier) * offset;
+    // we do this twice so divide by two
+    accumulator_type quad_offset_mp = static_cast<accumulator_type>(offset) * offset / 2;
+
+    accumulator_type new_offset = offset_;
 
     for (size_type v = 0; v < num_variables(); ++v) {
-        offset_ += linear_biases_[v] * offset;
-        linear_biases_[v] *= multiplier;
-    }
+        new_offset += static_cast<accumulator_type>(linear_biases_[v]) * offset;
 
-    if (has_adj()) {
-        for (size_type v = 0; v < num_variables(); ++v) {
+        accumulator_type lbias = static_cast<accumulator_type>(linear_biases_[v]) * multiplier;
+        if (has_adj()) {
             for (auto& term : (*adj_ptr_)[v]) {
-                offset_ += quad_offset_mp * term.bias;
-                linear_biases_[v] += lin_quad_mp * term.bias;
+                new_offset += quad_offset_mp * term.bias;
+                lbias += lin_quad_mp * term.bias;
                 term.bias *= quad_mp;
             }
         }
+        linear_biases_[v] = lbias;
     }
+
+    offset_ = new_offset;
+}
+
+template <class bias_type, class index_type>
+void QuadraticModelBase<bias_type, index_type>::substitute_variables(
+        const std::vector<bias_type>& multipliers, const std::vector<bias_type>& offsets) {
+    assert(multipliers.size() == num_variables());
+    assert(offsets.size() == num_variables());
+
+    journal_invalidate();  // every bias can change
+    undo_all();
+
+    using accumulator_type = accumulator_t<bias_type>;
+
+    accumulator_type new_offset = offset_;
+
+    for (size_type v = 0; v < num_variables(); ++v) {
+        new_offset += static_cast<accumulator_type>(linear_biases_[v]) * offsets[v];
+
+        accumulator_type lbias = static_cast<accumulator_type>(linear_biases_[v]) * multipliers[v];
+        if (has_adj()) {
+            // each interaction is stored twice, so each copy contributes half of
+            // the offset and one of the two linear terms
+            for (auto& term : (*adj_ptr_)[v]) {
+                accumulator_type qbias = term.bias;
+                if (static_cast<size_type>(term.v) == v) {
+                    // self-loops are only stored once
+                    new_offset += qbias * offsets[v] * offsets[v];
+                    lbias += 2 * qbias * offsets[v] * multipliers[v];
+                } else {
+                    new_offset += qbias * offsets[v] * offsets[term.v] / 2;
+                    lbias += qbias * offsets[term.v] * multipliers[v];
+                }
+                term.bias = qbias * multipliers[v] * multipliers[term.v];
+            }
+        }
+        linear_biases_[v] = lbias;
+    }
+
+    offset_ = new_offset;
 }
 
 }  // namespace abc
@@ -0,0 +1,401 @@
+// Copyright 2023 D-Wave Systems Inc.
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "dimod/abc.h"
+#include "dimod/precision.h"
+#include "dimod/quadratic_model.h"
+#include "dimod/vartypes.h"
+
+namespace dimod {
+
+/**
+ * Many variants of the biases of one quadratic model.
+ *
+ * Parameter sweeps evaluate many models that differ only in their biases.
+ * A bias batch stores the structure of a model once, that is its variables
+ * and the upper triangle of its interactions in Compressed Sparse Row format,
+ * and the biases of each variant contiguously. A variant can only set the
+ * biases of interactions in the structure; it cannot add new ones.
+ *
+ * The biases of variant `k` are laid out as the `num_variables()` linear
+ * biases, then the `num_interactions()` quadratic biases in row order, then
+ * the offset. So `energies()` computes the terms of each sample once and
+ * takes their dot product with the biases of each variant.
+ */
+template <class Bias, class Index = int>
+class BiasBatch {
+ public:
+    /// The first template parameter (`Bias`).
+    using bias_type = Bias;
+
+    /// The second template parameter (`Index`).
+    using index_type = Index;
+
+    /// Unsigned integer type that can represent non-negative values.
+    using size_type = std::size_t;
+
+    /// Construct a batch with the structure of `model` and `num_variants` copies of its biases.
+    template <class B, class I>
+    explicit BiasBatch(const abc::QuadraticModelBase<B, I>& model, size_type num_variants = 1);
+
+    /// Add a copy of variant `k` and return the index of the new variant.
+    size_type add_variant(size_type k = 0);
+
+    /// Return a pointer to the `num_biases()` biases of variant `k`.
+    bias_type* data(size_type k);
+
+    /// Return a pointer to the `num_biases()` biases of variant `k`.
+    const bias_type* data(size_type k) const;
+
+    /**
+     * Return the energy of the given sample for variant `k`.
+     *
+     * The `sample_start` must be a random access iterator pointing to the
+     * beginning of the sample.
+     *
+     * The behavior of this function is undefined when the sample is not
+     * `num_variables()` long.
+     */
+    template <class Iter>
+    bias_type energy(size_type k, Iter sample_start) const;
+
+    /**
+     * Compute the energy of each sample for each variant.
+     *
+     * `samples` must be a row-major array of `num_samples` samples, each
+     * `num_variables()` long. `out` must be a row-major array of shape
+     * `(num_variants(), num_samples)`.
+     */
+    template <class T, class Out>
+    void energies(const T samples[], size_type num_samples, Out out[]) const;
+
+    /// The linear bias of variable `v` in variant `k`.
+    bias_type linear(size_type k, index_type v) const;
+
+    /// Return the lower bound on variable ``v``.
+    bias_type lower_bound(index_type v) const;
+
+    /// Return the number of biases of each variant.
+    size_type num_biases() const;
+
+    /// Return the number of interactions in the structure.
+    size_type num_interactions() const;
+
+    /// Return the number of variants.
+    size_type num_variants() const;
+
+    /// Return the number of variables in the structure.
+    size_type num_variables() const;
+
+    /// Return the offset of variant `k`.
+    bias_type offset(size_type k) const;
+
+    /// Return the quadratic bias associated with `u` and `v` in variant `k`, or 0 if they have
+    /// no interaction.
+    bias_type quadratic(size_type k, index_type u, index_type v) const;
+
+    /// Remove the variants after the first `n`.
+    void resize(size_type n);
+
+    /// Set the linear bias of variable `v` in variant `k`.
+    void set_linear(size_type k, index_type v, bias_type bias);
+
+    /// Set the offset of variant `k`.
+    void set_offset(size_type k, bias_type offset);
+
+    /**
+     * Set the quadratic bias associated with `u` and `v` in variant `k`.
+     *
+     * Raises an `out_of_range` error if `u` and `v` have no interaction in the
+     * structure.
+     */
+    void set_quadratic(size_type k, index_type u, index_type v, bias_type bias);
+
+    /// Return a quadratic model with the structure and the biases of variant `k`.
+    QuadraticModel<bias_type, index_type> to_model(size_type k) const;
+
+    /// Return the upper bound on variable ``v``.
+    bias_type upper_bound(index_type v) const;
+
+    /// Return the variable type of variable ``v``.
+    Vartype vartype(index_type v) const;
+
+ private:
+    // Return the position of the interaction between `u` and `v` in the upper
+    // triangle, or `num_interactions()` if they don't have one
+    size_type find_interaction(index_type u, index_type v) const;
+
+    // the shared structure
+    std::vector<size_type> indptr_;
+    std::vector<index_type> indices_;  // the upper triangle, including the self-loops
+    std::vector<Vartype> vartypes_;
+    std::vector<bias_type> lower_bounds_;
+    std::vector<bias_type> upper_bounds_;
+
+    // num_variants() * num_biases() biases, see the class documentation
+    std::vector<bias_type> biases_;
+};
+
+template <class bias_type, class index_type>
+template <class B, class I>
+BiasBatch<bias_type, index_type>::BiasBatch(const abc::QuadraticModelBase<B, I>& model,
+                                            size_type num_variants)
+        : indptr_(), indices_(), vartypes_(), lower_bounds_(), upper_bounds_(), biases_() {
+    const size_type num_variables = model.num_variables();
+
+    vartypes_.reserve(num_variables);
+    lower_bounds_.reserve(num_variables);
+    upper_bounds_.reserve(num_variables);
+    for (size_type v = 0; v < num_variables; ++v) {
+        vartypes_.push_back(model.vartype(v));
+        lower_bounds_.push_back(model.lower_bound(v));
+        upper_bounds_.push_back(model.upper_bound(v));
+    }
+
+    // the first variant is built alongside the structure
+    std::vector<bias_type> variant(num_variables + model.num_interactions() + 1);
+    for (size_type v = 0; v < num_variables; ++v) {
+        variant[v] = model.linear(v);
+    }
+
+    indptr_.resize(num_variables + 1);
+    indices_.resize(model.num_interactions());
+    model.to_csr(indptr_.data(), indices_.data(), variant.data() + num_variables);
+
+    variant.back() = model.offset();
+
+    biases_.reserve(num_variants * variant.size());
+    for (size_type k = 0; k < num_variants; ++k) {
+        biases_.insert(biases_.end(), variant.begin(), variant.end());
+    }
+}
+
+template <class bias_type, class index_type>
+std::size_t BiasBatch<bias_type, index_type>::add_variant(size_type k) {
+    assert(k < num_variants());
+
+    const size_type n = num_biases();
+
+    // inserting a range of ourself is not allowed, so grow first
+    biases_.resize(biases_.size() + n);
+    std::copy(biases_.begin() + k * n, biases_.begin() + (k + 1) * n, biases_.end() - n);
+
+    return num_variants() - 1;
+}
+
+template <class bias_type, class index_type>
+bias_type* BiasBatch<bias_type, index_type>::data(size_type k) {
+    assert(k < num_variants());
+    return biases_.data() + k * num_biases();
+}
+
+template <class bias_type, class index_type>
+const bias_type* BiasBatch<bias_type, index_type>::data(size_type k) const {
+    assert(k < num_variants());
+    return biases_.data() + k * num_biases();
+}
+
+template <class bias_type, class index_type>
+template <class Iter>
+bias_type BiasBatch<bias_type, index_type>::energy(size_type k, Iter sample_start) const {
+    static_assert(std::is_same<std::random_access_iterator_tag,
+                               typename std::iterator_traits<Iter>::iterator_category>::value,
+                  "iterators must be random access");
+
+    using accumulator_type = accumulator_t<bias_type>;
+
+    const size_type n = num_variables();
+    const bias_type* biases = data(k);
+    const bias_type* qbiases = biases + n;
+
+    accumulator_type en = biases[num_biases() - 1];  // offset
+
+    for (size_type u = 0; u < n; ++u) {
+        accumulator_type u_val = *(sample_start + u);
+
+        en += u_val * biases[u];
+
+        for (size_type i = indptr_[u]; i < indptr_[u + 1]; ++i) {
+            en += qbiases[i] * u_val * *(sample_start + indices_[i]);
+        }
+    }
+
+    return en;
+}
+
+template <class bias_type, class index_type>
+template <class T, class Out>
+void BiasBatch<bias_type, index_type>::energies(const T samples[], size_type num_samples,
+                                                Out out[]) const {
+    static_assert(std::is_arithmetic<T>::value, "T must be numeric");
+    static_assert(std::is_arithmetic<Out>::value, "Out must be numeric");
+
+    using accumulator_type = accumulator_t<bias_type>;
+
+    const size_type n = num_variables();
+    const size_type num_biases = this->num_biases();
+    const size_type num_variants = this->num_variants();
+
+    // the terms of a sample, laid out like the biases of a variant
+    std::vector<accumulator_type> terms(num_biases);
+
+    for (size_type s = 0; s < num_samples; ++s) {
+        const T* x = samples + s * n;
+
+        for (size_type u = 0; u < n; ++u) {
+            terms[u] = x[u];
+            for (size_type i = indptr_[u]; i < indptr_[u + 1]; ++i) {
+                terms[n + i] = static_cast<accumulator_type>(x[u]) * x[indices_[i]];
+            }
+        }
+        terms[num_biases - 1] = 1;  // offset
+
+        for (size_type k = 0; k < num_variants; ++k) {
+            const bias_type* biases = data(k);
+
+            accumulator_type en = 0;
+            for (size_type i = 0; i < num_biases; ++i) {
+                en += biases[i] * terms[i];
+            }
+            out[k * num_samples + s] = en;
+        }
+    }
+}
+
+template <class bias_type, class index_type>
+std::size_t BiasBatch<bias_type, index_type>::find_interaction(index_type u,
+                                                                index_type v) const {
+    assert(0 <= u && static_cast<size_type>(u) < num_variables());
+    assert(0 <= v && static_cast<size_type>(v) < num_variables());
+
+    if (v < u) std::swap(u, v);
+
+    auto begin = indices_.begin() + indptr_[u];
+    auto end = indices_.begin() + indptr_[u + 1];
+    auto it = std::lower_bound(begin, end, v);
+    if (it == end || *it != v) return num_interactions();
+
+    return it - indices_.begin();
+}
+
+template <class bias_type, class index_type>
+bias_type BiasBatch<bias_type, index_type>::linear(size_type k, index_type v) const {
+    assert(0 <= v && static_cast<size_type>(v) < num_variables());
+    return data(k)[v];
+}
+
+template <class bias_type, class index_type>
+bias_type BiasBatch<bias_type, index_type>::lower_bound(index_type v) const {
+    assert(0 <= v && static_cast<size_type>(v) < num_variables());
+    return lower_bounds_[v];
+}
+
+template <class bias_type, class index_type>
+std::size_t BiasBatch<bias_type, index_type>::num_biases() const {
+    return num_variables() + num_interactions() + 1;
+}
+
+template <class bias_type, class index_type>
+std::size_t BiasBatch<bias_type, index_type>::num_interactions() const {
+    return indices_.size();
+}
+
+template <class bias_type, class index_type>
+std::size_t BiasBatch<bias_type, index_type>::num_variants() const {
+    return biases_.size() / num_biases();
+}
+
+template <class bias_type, class index_type>
+std::size_t BiasBatch<bias_type, index_type>::num_variables() const {
+    return vartypes_.size();
+}
+
+template <class bias_type, class index_type>
+bias_type BiasBatch<bias_type, index_type>::offset(size_type k) const {
+    return data(k)[num_biases() - 1];
+}
+
+template <class bias_type, class index_type>
+bias_type BiasBatch<bias_type, index_type>::quadratic(size_type k, index_type u,
+                                                      index_type v) const {
+    size_type i = find_interaction(u, v);
+    if (i == num_interactions()) return 0;
+    return data(k)[num_variables() + i];
+}
+
+template <class bias_type, class index_type>
+void BiasBatch<bias_type, index_type>::resize(size_type n) {
+    assert(n <= num_variants());
+    biases_.resize(n * num_biases());
+}
+
+template <class bias_type, class index_type>
+void BiasBatch<bias_type, index_type>::set_linear(size_type k, index_type v, bias_type bias) {
+    assert(0 <= v && static_cast<size_type>(v) < num_variables());
+    data(k)[v] = bias;
+}
+
+template <class bias_type, class index_type>
+void BiasBatch<bias_type, index_type>::set_offset(size_type k, bias_type offset) {
+    data(k)[num_biases() - 1] = offset;
+}
+
+template <class bias_type, class index_type>
+void BiasBatch<bias_type, index_type>::set_quadratic(size_type k, index_type u, index_type v,
+                                                     bias_type bias) {
+    size_type i = find_interaction(u, v);
+    if (i == num_interactions()) {
+        throw std::out_of_range("given variables have no interaction");
+    }
+    data(k)[num_variables() + i] = bias;
+}
+
+template <class bias_type, class index_type>
+QuadraticModel<bias_type, index_type> BiasBatch<bias_type, index_type>::to_model(
+        size_type k) const {
+    const size_type n = num_variables();
+    const bias_type* biases = data(k);
+
+    QuadraticModel<bias_type, index_type> qm;
+    for (size_type v = 0; v < n; ++v) {
+        qm.add_variable(vartypes_[v], lower_bounds_[v], upper_bounds_[v]);
+        qm.set_linear(v, biases[v]);
+    }
+    qm.set_offset(offset(k));
+    qm.add_quadratic_from_csr(indptr_.data(), indices_.data(), biases + n, n);
+    return qm;
+}
+
+template <class bias_type, class index_type>
+bias_type BiasBatch<bias_type, index_type>::upper_bound(index_type v) const {
+    assert(0 <= v && static_cast<size_type>(v) < num_variables());
+    return upper_bounds_[v];
+}
+
+template <class bias_type, class index_type>
+Vartype BiasBatch<bias_type, index_type>::vartype(index_type v) const {
+    assert(0 <= v && static_cast<size_type>(v) < num_variables());
+    return vartypes_[v];
+}
+
+}  // namespace dimod
@@ -83,6 +83,10 @@ class BinaryQuadraticModel : public abc::QuadraticModelBase<Bias, Index> {
     /// Add one (disconnected) variable to the BQM and return its index.
     index_type add_variable();
 
+    /// Start a transaction, see `QuadraticModelBase::begin_transaction()`.
+    /// The variable type of the BQM is saved along with the biases.
+    void begin_transaction();
+
     /// Change the variable type of the BQM.
     void change_vartype(Vartype vartype);
 
@@ -94,6 +98,10 @@ class BinaryQuadraticModel : public abc::QuadraticModelBase<Bias, Index> {
     // Resize the model to contain `n` variables.
     void resize(index_type n);
 
+    /// Undo the changes made since `begin_transaction()`, including any
+    /// change to the variable type.
+    void rollback();
+
     bias_type upper_bound() const;
 
     /// Return the upper bound on variable ``v``.
@@ -107,6 +115,9 @@ class BinaryQuadraticModel : public abc::QuadraticModelBase<Bias, Index> {
  private:
     // The vartype of the BQM
     Vartype vartype_;
+
+    // The vartype of the BQM at the start of the last transaction
+    Vartype transaction_vartype_;
 };
 
 template <class bias_type, class index_type>
@@ -115,11 +126,11 @@ BinaryQuadraticModel<bias_type, index_type>::BinaryQuadraticModel()
 
 template <class bias_type, class index_type>
 BinaryQuadraticModel<bias_type, index_type>::BinaryQuadraticModel(Vartype vartype)
-        : base_type(), vartype_(vartype) {}
+        : base_type(), vartype_(vartype), transaction_vartype_(vartype) {}
 
 template <class bias_type, class index_type>
 BinaryQuadraticModel<bias_type, index_type>::BinaryQuadraticModel(index_type n, Vartype vartype)
-        : base_type(n), vartype_(vartype) {}
+        : base_type(n), vartype_(vartype), transaction_vartype_(vartype) {}
 
 template <class bias_type, class index_type>
 template <class T>
@@ -153,6 +164,12 @@ index_type BinaryQuadraticModel<bias_type, index_type>::add_variable() {
     return base_type::add_variable();
 }
 
+template <class bias_type, class index_type>
+void BinaryQuadraticModel<bias_type, index_type>::begin_transaction() {
+    base_type::begin_transaction();
+    transaction_vartype_ = vartype_;
+}
+
 template <class bias_type, class index_type>
 void BinaryQuadraticModel<bias_type, index_type>::change_vartype(Vartype vartype) {
     if (vartype_ == vartype) {
@@ -184,6 +201,12 @@ void BinaryQuadraticModel<bias_type, index_type>::resize(index_type n) {
     base_type::resize(n);
 }
 
+template <class bias_type, class index_type>
+void BinaryQuadraticModel<bias_type, index_type>::rollback() {
+    base_type::rollback();
+    vartype_ = transaction_vartype_;
+}
+
 template <class bias_type, class index_type>
 bias_type BinaryQuadraticModel<bias_type, index_type>::upper_bound() const {
     return vartype_info<bias_type>::max(this->vartype_);
@@ -0,0 +1,436 @@
+// Copyright 2023 D-Wave Systems Inc.
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+#include "dimod/abc.h"
+#include "dimod/precision.h"
+#include "dimod/quadratic_model.h"
+#include "dimod/vartypes.h"
+
+namespace dimod {
+
+/**
+ * An immutable quadratic model that stores each interaction once.
+ *
+ * The models derived from `abc::QuadraticModelBase` store each interaction
+ * twice, once in the neighborhood of each of its variables, so that they can
+ * be modified and queried by either variable. A compressed quadratic model is
+ * built once from another model and stores only the upper triangle of the
+ * quadratic biases, including any self-loops, in Compressed Sparse Row
+ * format. This halves the memory used by the quadratic biases and the bytes
+ * read by `energy()`.
+ *
+ * Queries of the full neighborhood of a variable need the lower triangle as
+ * well. It is not built until `build_transpose()` is called, see
+ * `neighborhood()`. Like the other models, all of the const methods can be
+ * called concurrently.
+ */
+template <class Bias, class Index = int>
+class CompressedQuadraticModel {
+ public:
+    /// The first template parameter (`Bias`).
+    using bias_type = Bias;
+
+    /// The second template parameter (`Index`).
+    using index_type = Index;
+
+    /// Unsigned integer type that can represent non-negative values.
+    using size_type = std::size_t;
+
+    CompressedQuadraticModel();
+
+    /// Construct a compressed quadratic model with the biases, vartypes and bounds of `model`.
+    template <class B, class I>
+    explicit CompressedQuadraticModel(const abc::QuadraticModelBase<B, I>& model);
+
+    CompressedQuadraticModel(const CompressedQuadraticModel& other);
+    CompressedQuadraticModel(CompressedQuadraticModel&& other) noexcept = default;
+    ~CompressedQuadraticModel() = default;
+    CompressedQuadraticModel& operator=(CompressedQuadraticModel other);
+
+    /**
+     * Build the lower triangle of the quadratic biases, which is needed by
+     * `neighborhood()` and `num_interactions(v)`.
+     *
+     * Takes O(num_variables() + num_interactions()) time and as much memory
+     * as the upper triangle. Does nothing if it has already been built.
+     */
+    void build_transpose();
+
+    /**
+     * Return the energy of the given sample.
+     *
+     * The `sample_start` must be a random access iterator pointing to the
+     * beginning of the sample.
+     *
+     * The behavior of this function is undefined when the sample is not
+     * `num_variables()` long.
+     */
+    template <class Iter>
+    bias_type energy(Iter sample_start) const;
+
+    /// Return true if the lower triangle has been built by `build_transpose()`.
+    bool has_transpose() const;
+
+    /// Test whether the model has no quadratic biases.
+    bool is_linear() const;
+
+    /// The linear bias of variable `v`.
+    bias_type linear(index_type v) const;
+
+    /// Return the lower bound on variable ``v``.
+    bias_type lower_bound(index_type v) const;
+
+    /**
+     * Total bytes consumed by the biases, indices and variable information.
+     *
+     * If `capacity` is true, use the capacity of the underlying vectors rather
+     * than the size. Includes the lower triangle if it has been built.
+     */
+    size_type nbytes(bool capacity = false) const;
+
+    /**
+     * Return the neighborhood of `v`, sorted by neighbor.
+     *
+     * The behavior of this function is undefined unless `build_transpose()`
+     * has been called.
+     */
+    std::vector<abc::OneVarTerm<bias_type, index_type>> neighborhood(index_type v) const;
+
+    /// Return the number of interactions in the model.
+    size_type num_interactions() const;
+
+    /**
+     * Return the number of other variables that `v` interacts with.
+     *
+     * The behavior of this function is undefined unless `build_transpose()`
+     * has been called.
+     */
+    size_type num_interactions(index_type v) const;
+
+    /// Return the number of variables in the model.
+    size_type num_variables() const;
+
+    /// Return the offset.
+    bias_type offset() const;
+
+    /// Return the quadratic bias associated with `u` and `v`, or 0 if they have no interaction.
+    bias_type quadratic(index_type u, index_type v) const;
+
+    /// Return a quadratic model with the same biases, vartypes and bounds.
+    QuadraticModel<bias_type, index_type> to_model() const;
+
+    /// Return the upper bound on variable ``v``.
+    bias_type upper_bound(index_type v) const;
+
+    /// Return the variable type of variable ``v``.
+    Vartype vartype(index_type v) const;
+
+ private:
+    // a triangle of the quadratic biases in CSR format
+    struct Triangle {
+        std::vector<size_type> indptr;
+        std::vector<index_type> indices;
+        std::vector<bias_type> biases;
+    };
+
+    std::vector<bias_type> linear_biases_;
+
+    // upper triangle, including the self-loops
+    Triangle upper_;
+
+    // strict lower triangle, built by build_transpose()
+    std::unique_ptr<Triangle> lower_ptr_;
+
+    std::vector<Vartype> vartypes_;
+    std::vector<bias_type> lower_bounds_;
+    std::vector<bias_type> upper_bounds_;
+
+    bias_type offset_;
+};
+
+template <class bias_type, class index_type>
+CompressedQuadraticModel<bias_type, index_type>::CompressedQuadraticModel()
+        : linear_biases_(),
+          upper_{std::vector<size_type>(1, 0), {}, {}},
+          lower_ptr_(),
+          vartypes_(),
+          lower_bounds_(),
+          upper_bounds_(),
+          offset_(0) {}
+
+template <class bias_type, class index_type>
+template <class B, class I>
+CompressedQuadraticModel<bias_type, index_type>::CompressedQuadraticModel(
+        const abc::QuadraticModelBase<B, I>& model)
+        : linear_biases_(),
+          upper_(),
+          lower_ptr_(),
+          vartypes_(),
+          lower_bounds_(),
+          upper_bounds_(),
+          offset_(model.offset()) {
+    const size_type num_variables = model.num_variables();
+
+    linear_biases_.reserve(num_variables);
+    vartypes_.reserve(num_variables);
+    lower_bounds_.reserve(num_variables);
+    upper_bounds_.reserve(num_variables);
+    for (size_type v = 0; v < num_variables; ++v) {
+        linear_biases_.push_back(model.linear(v));
+        vartypes_.push_back(model.vartype(v));
+        lower_bounds_.push_back(model.lower_bound(v));
+        upper_bounds_.push_back(model.upper_bound(v));
+    }
+
+    upper_.indptr.resize(num_variables + 1);
+    upper_.indices.resize(model.num_interactions());
+    upper_.biases.resize(model.num_interactions());
+    model.to_csr(upper_.indptr.data(), upper_.indices.data(), upper_.biases.data());
+}
+
+template <class bias_type, class index_type>
+CompressedQuadraticModel<bias_type, index_type>::CompressedQuadraticModel(
+        const CompressedQuadraticModel& other)
+        : linear_biases_(other.linear_biases_),
+          upper_(other.upper_),
+          lower_ptr_(),
+          vartypes_(other.vartypes_),
+          lower_bounds_(other.lower_bounds_),
+          upper_bounds_(other.upper_bounds_),
+          offset_(other.offset_) {
+    // the lower triangle can be rebuilt, so we don't copy it
+}
+
+template <class bias_type, class index_type>
+CompressedQuadraticModel<bias_type, index_type>&
+CompressedQuadraticModel<bias_type, index_type>::operator=(CompressedQuadraticModel other) {
+    linear_biases_.swap(other.linear_biases_);
+    std::swap(upper_, other.upper_);
+    lower_ptr_.swap(other.lower_ptr_);
+    vartypes_.swap(other.vartypes_);
+    lower_bounds_.swap(other.lower_bounds_);
+    upper_bounds_.swap(other.upper_bounds_);
+    std::swap(offset_, other.offset_);
+    return *this;
+}
+
+template <class bias_type, class index_type>
+void CompressedQuadraticModel<bias_type, index_type>::build_transpose() {
+    if (lower_ptr_) return;
+
+    const size_type num_variables = this->num_variables();
+
+    std::unique_ptr<Triangle> lower(new Triangle());
+
+    // count the entries in each row of the strict lower triangle
+    lower->indptr.assign(num_variables + 1, 0);
+    for (size_type u = 0; u < num_variables; ++u) {
+        for (size_type k = upper_.indptr[u]; k < upper_.indptr[u + 1]; ++k) {
+            if (static_cast<size_type>(upper_.indices[k]) != u) ++lower->indptr[upper_.indices[k] + 1];
+        }
+    }
+    for (size_type v = 0; v < num_variables; ++v) {
+        lower->indptr[v + 1] += lower->indptr[v];
+    }
+
+    // visiting the rows in order fills each lower row in order
+    lower->indices.resize(lower->indptr[num_variables]);
+    lower->biases.resize(lower->indptr[num_variables]);
+    std::vector<size_type> next(lower->indptr.begin(), lower->indptr.end() - 1);
+    for (size_type u = 0; u < num_variables; ++u) {
+        for (size_type k = upper_.indptr[u]; k < upper_.indptr[u + 1]; ++k) {
+            index_type v = upper_.indices[k];
+            if (static_cast<size_type>(v) == u) continue;
+            lower->indices[next[v]] = u;
+            lower->biases[next[v]] = upper_.biases[k];
+            ++next[v];
+        }
+    }
+
+    lower_ptr_ = std::move(lower);
+}
+
+template <class bias_type, class index_type>
+template <class Iter>
+bias_type CompressedQuadraticModel<bias_type, index_type>::energy(Iter sample_start) const {
+    static_assert(std::is_same<std::random_access_iterator_tag,
+                               typename std::iterator_traits<Iter>::iterator_category>::value,
+                  "iterators must be random access");
+
+    using accumulator_type = accumulator_t<bias_type>;
+
+    accumulator_type en = offset_;
+
+    for (size_type u = 0; u < num_variables(); ++u) {
+        accumulator_type u_val = *(sample_start + u);
+
+        en += u_val * linear_biases_[u];
+
+        for (size_type k = upper_.indptr[u]; k < upper_.indptr[u + 1]; ++k) {
+            en += upper_.biases[k] * u_val * *(sample_start + upper_.indices[k]);
+        }
+    }
+
+    return en;
+}
+
+template <class bias_type, class index_type>
+bool CompressedQuadraticModel<bias_type, index_type>::has_transpose() const {
+    return static_cast<bool>(lower_ptr_);
+}
+
+template <class bias_type, class index_type>
+bool CompressedQuadraticModel<bias_type, index_type>::is_linear() const {
+    return upper_.indices.empty();
+}
+
+template <class bias_type, class index_type>
+bias_type CompressedQuadraticModel<bias_type, index_type>::linear(index_type v) const {
+    assert(0 <= v && static_cast<size_type>(v) < num_variables());
+    return linear_biases_[v];
+}
+
+template <class bias_type, class index_type>
+bias_type CompressedQuadraticModel<bias_type, index_type>::lower_bound(index_type v) const {
+    assert(0 <= v && static_cast<size_type>(v) < num_variables());
+    return lower_bounds_[v];
+}
+
+template <class bias_type, class index_type>
+std::size_t CompressedQuadraticModel<bias_type, index_type>::nbytes(bool capacity) const {
+    auto bytes = [capacity](const Triangle& triangle) {
+        if (capacity) {
+            return triangle.indptr.capacity() * sizeof(size_type) +
+                   triangle.indices.capacity() * sizeof(index_type) +
+                   triangle.biases.capacity() * sizeof(bias_type);
+        }
+        return triangle.indptr.size() * sizeof(size_type) +
+               triangle.indices.size() * sizeof(index_type) +
+               triangle.biases.size() * sizeof(bias_type);
+    };
+
+    size_type count = sizeof(bias_type);  // offset
+    if (capacity) {
+        count += linear_biases_.capacity() * sizeof(bias_type);
+        count += vartypes_.capacity() * sizeof(Vartype);
+        count += (lower_bounds_.capacity() + upper_bounds_.capacity()) * sizeof(bias_type);
+    } else {
+        count += linear_biases_.size() * sizeof(bias_type);
+        count += vartypes_.size() * sizeof(Vartype);
+        count += (lower_bounds_.size() + upper_bounds_.size()) * sizeof(bias_type);
+    }
+    count += bytes(upper_);
+    if (lower_ptr_) count += bytes(*lower_ptr_);
+    return count;
+}
+
+template <class bias_type, class index_type>
+std::vector<abc::OneVarTerm<bias_type, index_type>>
+CompressedQuadraticModel<bias_type, index_type>::neighborhood(index_type v) const {
+    assert(0 <= v && static_cast<size_type>(v) < num_variables());
+    assert(has_transpose());
+
+    const Triangle& lower = *lower_ptr_;
+
+    std::vector<abc::OneVarTerm<bias_type, index_type>> neighborhood;
+    neighborhood.reserve(lower.indptr[v + 1] - lower.indptr[v] + upper_.indptr[v + 1] -
+                         upper_.indptr[v]);
+
+    // the neighbors below v and then those from v up, so it is sorted
+    for (size_type k = lower.indptr[v]; k < lower.indptr[v + 1]; ++k) {
+        neighborhood.emplace_back(lower.indices[k], lower.biases[k]);
+    }
+    for (size_type k = upper_.indptr[v]; k < upper_.indptr[v + 1]; ++k) {
+        neighborhood.emplace_back(upper_.indices[k], upper_.biases[k]);
+    }
+
+    return neighborhood;
+}
+
+template <class bias_type, class index_type>
+std::size_t CompressedQuadraticModel<bias_type, index_type>::num_interactions() const {
+    return upper_.indices.size();
+}
+
+template <class bias_type, class index_type>
+std::size_t CompressedQuadraticModel<bias_type, index_type>::num_interactions(index_type v) const {
+    assert(0 <= v && static_cast<size_type>(v) < num_variables());
+    assert(has_transpose());
+
+    return lower_ptr_->indptr[v + 1] - lower_ptr_->indptr[v] + upper_.indptr[v + 1] -
+           upper_.indptr[v];
+}
+
+template <class bias_type, class index_type>
+std::size_t CompressedQuadraticModel<bias_type, index_type>::num_variables() const {
+    return linear_biases_.size();
+}
+
+template <class bias_type, class index_type>
+bias_type CompressedQuadraticModel<bias_type, index_type>::offset() const {
+    return offset_;
+}
+
+template <class bias_type, class index_type>
+bias_type CompressedQuadraticModel<bias_type, index_type>::quadratic(index_type u,
+                                                                     index_type v) const {
+    assert(0 <= u && static_cast<size_type>(u) < num_variables());
+    assert(0 <= v && static_cast<size_type>(v) < num_variables());
+
+    if (v < u) std::swap(u, v);
+
+    auto begin = upper_.indices.begin() + upper_.indptr[u];
+    auto end = upper_.indices.begin() + upper_.indptr[u + 1];
+    auto it = std::lower_bound(begin, end, v);
+    if (it == end || *it != v) return 0;
+
+    return upper_.biases[it - upper_.indices.begin()];
+}
+
+template <class bias_type, class index_type>
+QuadraticModel<bias_type, index_type> CompressedQuadraticModel<bias_type, index_type>::to_model()
+        const {
+    QuadraticModel<bias_type, index_type> qm;
+    for (size_type v = 0; v < num_variables(); ++v) {
+        qm.add_variable(vartypes_[v], lower_bounds_[v], upper_bounds_[v]);
+        qm.set_linear(v, linear_biases_[v]);
+    }
+    qm.set_offset(offset_);
+    qm.add_quadratic_from_csr(upper_.indptr.data(), upper_.indices.data(), upper_.biases.data(),
+                              num_variables());
+    return qm;
+}
+
+template <class bias_type, class index_type>
+bias_type CompressedQuadraticModel<bias_type, index_type>::upper_bound(index_type v) const {
+    assert(0 <= v && static_cast<size_type>(v) < num_variables());
+    return upper_bounds_[v];
+}
+
+template <class bias_type, class index_type>
+Vartype CompressedQuadraticModel<bias_type, index_type>::vartype(index_type v) const {
+    assert(0 <= v && static_cast<size_type>(v) < num_variables());
+    return vartypes_[v];
+}
+
+}  // namespace dimod
@@ -0,0 +1,278 @@
+// Copyright 2023 D-Wave Systems Inc.
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "dimod/abc.h"
+
+namespace dimod {
+
+/**
+ * Collect the biases of a quadratic model from many threads.
+ *
+ * The models derived from `abc::QuadraticModelBase` cannot be modified by
+ * more than one thread at a time. A builder accepts `add_linear()`,
+ * `add_quadratic()` and `add_offset()` from any number of threads and then
+ * adds everything it collected to a model with `finalize()`.
+ *
+ * The biases are buffered in shards, each guarded by its own lock. The
+ * interaction between `u` and `v` goes in the shard of `min(u, v)`, so the
+ * shards partition the rows of the upper triangle and `finalize()` can sort
+ * and merge the shards in parallel.
+ */
+template <class Bias, class Index = int>
+class ConcurrentModelBuilder {
+ public:
+    /// The first template parameter (`Bias`).
+    using bias_type = Bias;
+
+    /// The second template parameter (`Index`).
+    using index_type = Index;
+
+    /// Unsigned integer type that can represent non-negative values.
+    using size_type = std::size_t;
+
+    /// The default number of shards.
+    static constexpr size_type DEFAULT_NUM_SHARDS = 64;
+
+    /**
+     * Construct a builder for a model with `num_variables` variables.
+     *
+     * More shards mean less contention between the threads adding biases and
+     * more parallelism in `finalize()`.
+     */
+    explicit ConcurrentModelBuilder(index_type num_variables,
+                                    size_type num_shards = DEFAULT_NUM_SHARDS);
+
+    /// Add linear bias to variable `v`. Thread-safe.
+    void add_linear(index_type v, bias_type bias);
+
+    /// Add offset. Thread-safe.
+    void add_offset(bias_type bias);
+
+    /**
+     * Add quadratic bias for the given variables. Thread-safe.
+     *
+     * As with `abc::QuadraticModelBase::add_quadratic()`, a bias on the
+     * diagonal is treated according to the variable type of the model it
+     * is finalized into.
+     */
+    void add_quadratic(index_type u, index_type v, bias_type bias);
+
+    /**
+     * Add the collected biases to `model` and clear the builder.
+     *
+     * The shards are sorted and their duplicate interactions summed on
+     * `num_threads` threads, or on `std::thread::hardware_concurrency()`
+     * threads if `num_threads` is 0. The merged interactions are then added
+     * with `add_quadratic_from_csr()`, which builds the neighborhoods of a
+     * model with no interactions directly.
+     *
+     * Not thread-safe: no other thread may use the builder or the model
+     * until this method returns. The behavior of this method is undefined
+     * when `model` has fewer than `num_variables()` variables.
+     */
+    template <class Model>
+    void finalize(Model& model, size_type num_threads = 1);
+
+    /// Return the number of shards.
+    size_type num_shards() const;
+
+    /// Return the number of variables.
+    size_type num_variables() const;
+
+ private:
+    struct QuadraticTerm {
+        index_type u;
+        index_type v;
+        bias_type bias;
+
+        friend bool operator<(const QuadraticTerm& a, const QuadraticTerm& b) {
+            return a.u < b.u || (a.u == b.u && a.v < b.v);
+        }
+    };
+
+    struct Shard {
+        std::mutex mutex;
+        std::vector<abc::OneVarTerm<bias_type, index_type>> linear;
+        std::vector<QuadraticTerm> quadratic;
+        bias_type offset = 0;
+
+        // keep the locks of neighboring shards off the same cache line
+        char padding[64];
+    };
+
+    // apply f to each shard on num_threads threads
+    template <class F>
+    void for_each_shard(size_type num_threads, F f);
+
+    Shard& shard(index_type v) { return shards_[static_cast<size_type>(v) % shards_.size()]; }
+
+    index_type num_variables_;
+
+    std::vector<Shard> shards_;
+};
+
+template <class bias_type, class index_type>
+constexpr typename ConcurrentModelBuilder<bias_type, index_type>::size_type
+        ConcurrentModelBuilder<bias_type, index_type>::DEFAULT_NUM_SHARDS;
+
+template <class bias_type, class index_type>
+ConcurrentModelBuilder<bias_type, index_type>::ConcurrentModelBuilder(index_type num_variables,
+                                                                      size_type num_shards)
+        : num_variables_(num_variables), shards_(std::max<size_type>(num_shards, 1)) {
+    assert(num_variables >= 0);
+}
+
+template <class bias_type, class index_type>
+void ConcurrentModelBuilder<bias_type, index_type>::add_linear(index_type v, bias_type bias) {
+    assert(0 <= v && v < num_variables_);
+
+    Shard& s = shard(v);
+    std::lock_guard<std::mutex> lock(s.mutex);
+    s.linear.emplace_back(v, bias);
+}
+
+template <class bias_type, class index_type>
+void ConcurrentModelBuilder<bias_type, index_type>::add_offset(bias_type bias) {
+    // the offsets are summed on finalize(), so any shard will do
+    Shard& s = shards_.front();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    s.offset += bias;
+}
+
+template <class bias_type, class index_type>
+void ConcurrentModelBuilder<bias_type, index_type>::add_quadratic(index_type u, index_type v,
+                                                                  bias_type bias) {
+    assert(0 <= u && u < num_variables_);
+    assert(0 <= v && v < num_variables_);
+
+    if (v < u) std::swap(u, v);
+
+    Shard& s = shard(u);
+    std::lock_guard<std::mutex> lock(s.mutex);
+    s.quadratic.push_back(QuadraticTerm{u, v, bias});
+}
+
+template <class bias_type, class index_type>
+template <class Model>
+void ConcurrentModelBuilder<bias_type, index_type>::finalize(Model& model,
+                                                             size_type num_threads) {
+    assert(model.num_variables() >= num_variables());
+
+    const size_type n = num_variables();
+
+    // sort and merge each shard, and count the interactions in each row.
+    // Each row belongs to exactly one shard, so the counts don't race
+    std::vector<size_type> indptr(n + 1, 0);
+    for_each_shard(num_threads, [&indptr](Shard& shard) {
+        auto& terms = shard.quadratic;
+        if (terms.empty()) return;
+
+        std::sort(terms.begin(), terms.end());
+
+        auto out = terms.begin();
+        ++indptr[out->u + 1];
+        for (auto it = terms.begin() + 1; it != terms.end(); ++it) {
+            if (it->u == out->u && it->v == out->v) {
+                out->bias += it->bias;
+            } else {
+                *(++out) = *it;
+                ++indptr[out->u + 1];
+            }
+        }
+        terms.erase(out + 1, terms.end());
+    });
+
+    for (size_type u = 0; u < n; ++u) {
+        indptr[u + 1] += indptr[u];
+    }
+
+    // lay out the rows of the upper triangle. The terms of each shard are
+    // sorted so the terms of each row are contiguous
+    std::vector<index_type> indices(indptr[n]);
+    std::vector<bias_type> data(indptr[n]);
+    for_each_shard(num_threads, [&indptr, &indices, &data](Shard& shard) {
+        size_type pos = 0;
+        index_type row = -1;
+        for (const auto& term : shard.quadratic) {
+            if (term.u != row) {
+                row = term.u;
+                pos = indptr[row];
+            }
+            indices[pos] = term.v;
+            data[pos] = term.bias;
+            ++pos;
+        }
+        shard.quadratic.clear();
+        shard.quadratic.shrink_to_fit();
+    });
+
+    model.add_quadratic_from_csr(indptr.data(), indices.data(), data.data(), n);
+
+    for (auto& shard : shards_) {
+        for (const auto& term : shard.linear) {
+            model.add_linear(term.v, term.bias);
+        }
+        model.add_offset(shard.offset);
+
+        shard.linear.clear();
+        shard.linear.shrink_to_fit();
+        shard.offset = 0;
+    }
+}
+
+template <class bias_type, class index_type>
+template <class F>
+void ConcurrentModelBuilder<bias_type, index_type>::for_each_shard(size_type num_threads, F f) {
+    if (!num_threads) num_threads = std::max<size_type>(std::thread::hardware_concurrency(), 1);
+    num_threads = std::min(num_threads, shards_.size());
+
+    std::atomic<size_type> next(0);
+    auto worker = [this, &next, &f]() {
+        for (size_type s = next++; s < shards_.size(); s = next++) {
+            f(shards_[s]);
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(num_threads - 1);
+    for (size_type t = 1; t < num_threads; ++t) {
+        threads.emplace_back(worker);
+    }
+    worker();  // the calling thread does its share
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
+template <class bias_type, class index_type>
+std::size_t ConcurrentModelBuilder<bias_type, index_type>::num_shards() const {
+    return shards_.size();
+}
+
+template <class bias_type, class index_type>
+std::size_t ConcurrentModelBuilder<bias_type, index_type>::num_variables() const {
+    return num_variables_;
+}
+
+}  // namespace dimod
@@ -15,6 +15,7 @@
 #pragma once
 
 #include <memory>
+#include <stdexcept>
 #include <unordered_set>
 #include <utility>
 #include <vector>
@@ -23,6 +24,7 @@
 #include "dimod/constraint.h"
 #include "dimod/iterators.h"
 #include "dimod/expression.h"
+#include "dimod/transaction.h"
 #include "dimod/vartypes.h"
 
 namespace dimod {
@@ -123,6 +125,39 @@ class ConstrainedQuadraticModel {
                                      std::initializer_list<bias_type> biases, Sense sense,
                                      bias_type rhs);
 
+    /**
+     * Add `num_constraints` linear constraints given in Compressed Sparse Row
+     * format.
+     *
+     * The variables and coefficients of constraint `c` are
+     * `indices[indptr[c]:indptr[c+1]]` and `coefficients[indptr[c]:indptr[c+1]]`,
+     * its sense is `senses[c]` and its right-hand side is `rhs[c]`. Repeated
+     * variables within a constraint are summed. All of the variables must
+     * already be in the model.
+     *
+     * Returns the index of the first constraint added.
+     */
+    template <class Ptr, class Ind, class T>
+    index_type add_linear_constraints_from_arrays(index_type num_constraints, const Ptr indptr[],
+                                                  const Ind indices[], const T coefficients[],
+                                                  const Sense senses[], const bias_type rhs[]);
+
+    /**
+     * Add `num_constraints` quadratic constraints.
+     *
+     * The linear terms are given as in `add_linear_constraints_from_arrays()`.
+     * The quadratic terms of constraint `c` are in Coordinate format in
+     * `qrow[qindptr[c]:qindptr[c+1]]`, `qcol[qindptr[c]:qindptr[c+1]]` and
+     * `qcoefficients[qindptr[c]:qindptr[c+1]]`.
+     *
+     * Returns the index of the first constraint added.
+     */
+    template <class Ptr, class Ind, class T>
+    index_type add_quadratic_constraints_from_arrays(
+            index_type num_constraints, const Ptr indptr[], const Ind indices[],
+            const T coefficients[], const Ptr qindptr[], const Ind qrow[], const Ind qcol[],
+            const T qcoefficients[], const Sense senses[], const bias_type rhs[]);
+
     /// Add variable of type `vartype` with lower bound `lb` and upper bound `ub`.
     index_type add_variable(Vartype vartype, bias_type lb, bias_type ub);
 
@@ -135,11 +170,40 @@ class ConstrainedQuadraticModel {
     /// Add `n` variables of type `vartype` with lower bound `lb` and upper bound `ub`.
     index_type add_variables(Vartype vartype, index_type n, bias_type lb, bias_type ub);
 
+    /**
+     * Start a transaction. The changes made to the model from now on can be
+     * undone with `rollback()` or kept with `commit()`.
+     *
+     * The objective and each constraint start a transaction of their own, see
+     * `QuadraticModelBase::begin_transaction()`, so the cost of a change is
+     * proportional to the parts of the expressions it touches. The variable
+     * types and bounds are saved before they are first changed. Removing
+     * constraints saves the list of constraints, but not their contents.
+     *
+     * The transaction is not copied with the model, and assigning to the model
+     * discards it.
+     *
+     * @exception Throws std::logic_error If a transaction is already in progress
+     * for the model, its objective or any of its constraints.
+     * If an exception is thrown, there are no changes to the model.
+     */
+    void begin_transaction();
+
     /// Change the variable type of variable `v` to `vartype`, updating the biases appropriately.
     void change_vartype(Vartype vartype, index_type v);
 
+    /// Change the variable type of each of `variables` to `vartype`, updating the biases
+    /// appropriately. The objective and each constraint are updated in a single pass.
+    /// @exception Throws std::logic_error If any of the changes are not supported.
+    /// If an exception is thrown, there are no changes to the model.
+    void change_vartypes(Vartype vartype, const std::vector<index_type>& variables);
+
     void clear();
 
+    /// Keep the changes made since `begin_transaction()` and end the transaction.
+    /// @exception Throws std::logic_error If there is no transaction in progress.
+    void commit();
+
     /// Return a view over the constraints. The view can be iterated over.
     /// @code
     /// for (auto& constraint : cqm.constraints()) {}
@@ -155,6 +219,19 @@ class ConstrainedQuadraticModel {
     std::weak_ptr<Constraint<bias_type, index_type>> constraint_weak_ptr(index_type c);
     std::weak_ptr<const Constraint<bias_type, index_type>> constraint_weak_ptr(index_type c) const;
 
+    /**
+     * Return a 128-bit fingerprint of the content of the model.
+     *
+     * The hash covers the variable types and bounds, the objective, and the
+     * expression, sense, right-hand side and markers of each constraint,
+     * with the weight and penalty of soft constraints. It does not depend on
+     * the order of the constraints. See `QuadraticModelBase::content_hash()`
+     * for `keys` and `num_threads`, which are used for the objective and
+     * each constraint in turn.
+     */
+    ContentHash content_hash(const std::uint64_t keys[] = nullptr,
+                             size_type num_threads = 1) const;
+
     /// Fix variable `v` in the model to value `assignment`.
     template <class T>
     void fix_variable(index_type v, T assignment);
@@ -169,6 +246,27 @@ class ConstrainedQuadraticModel {
     ConstrainedQuadraticModel fix_variables(std::initializer_list<index_type> variables,
                                             std::initializer_list<T> assignments) const;
 
+    /// Return true if a transaction is in progress, see `begin_transaction()`.
+    bool in_transaction() const;
+
+    /**
+     * Return the journal of the changes made to the variables and constraints
+     * of the model since `start_journal()`, or `nullptr` if the model is not
+     * keeping one.
+     *
+     * The journal records changes to the variable types and bounds, along
+     * with the number of variables and constraints at the checkpoint. The
+     * objective and each constraint present at the checkpoint keep their own
+     * journal of their biases, indexed by their own variables. An expression
+     * without a valid journal must be considered changed as a whole.
+     * Clearing the model, permuting its variables or removing variables or
+     * constraints invalidates the journal.
+     */
+    Journal<index_type>* journal();
+
+    /// @copydoc ConstrainedQuadraticModel::journal()
+    const Journal<index_type>* journal() const;
+
     /// Return the lower bound on variable ``v``.
     bias_type lower_bound(index_type v) const;
 
@@ -181,6 +279,11 @@ class ConstrainedQuadraticModel {
     /// Return the number of variables in the model.
     size_type num_variables() const;
 
+    /// Permute the variables of the model so that variable `v` becomes
+    /// variable `permutation[v]`, see `QuadraticModelBase::permute()`.
+    /// The objective and constraints are updated to match.
+    void permute(const std::vector<index_type>& permutation);
+
     /// Remove a constraint from the model.
     void remove_constraint(index_type c);
 
@@ -193,6 +296,23 @@ class ConstrainedQuadraticModel {
     /// Remove variable `v` from the model.
     void remove_variable(index_type v);
 
+    /// Reserve capacity for at least `num_constraints` constraints.
+    void reserve_constraints(size_type num_constraints);
+
+    /// Reserve capacity for at least `num_variables` variables.
+    void reserve_variables(size_type num_variables);
+
+    /// Set all of the counts returned by `stats()` to zero.
+    void reset_stats();
+
+    /// Undo the changes made since `begin_transaction()` and end the transaction.
+    /// Variables and constraints added during the transaction are removed, and
+    /// constraints removed during the transaction are restored.
+    /// If the model is keeping a journal that was started during the
+    /// transaction, the journal is invalidated.
+    /// @exception Throws std::logic_error If there is no transaction in progress.
+    void rollback();
+
     /// Set a lower bound of `lb` on variable `v`.
     void set_lower_bound(index_type v, bias_type lb);
 
@@ -209,6 +329,27 @@ class ConstrainedQuadraticModel {
     void set_upper_bound(index_type v, bias_type ub);
     void set_vartype(index_type v, Vartype vartype);
 
+    /// Release any capacity reserved beyond the current size of the model,
+    /// its objective and its constraints.
+    void shrink_to_fit();
+
+    /// Start recording the changes made to the model, its objective and its
+    /// constraints, discarding any previous journals. See `journal()`.
+    void start_journal();
+
+    /**
+     * Return the counts of the events performed by the objective and the
+     * constraints, summed.
+     *
+     * All counts are zero unless dimod is compiled with DIMOD_INSTRUMENTATION
+     * defined.
+     */
+    Stats stats() const;
+
+    /// Stop recording the changes made to the model, its objective and its
+    /// constraints, and discard the journals.
+    void stop_journal();
+
     void substitute_variable(index_type v, bias_type multiplier, bias_type offset);
 
     /// Return the upper bound on variable ``v``.
@@ -245,6 +386,8 @@ class ConstrainedQuadraticModel {
         }
 
         swap(this->varinfo_, other.varinfo_);
+        swap(this->journal_ptr_, other.journal_ptr_);
+        swap(this->transaction_ptr_, other.transaction_ptr_);
     }
 
     static void fix_variables_expr(const Expression<bias_type, index_type>& src,
@@ -280,6 +423,44 @@ class ConstrainedQuadraticModel {
     };
 
     std::vector<varinfo_type> varinfo_;
+
+    // The changes since start_journal(), or null. Not copied with the model.
+    std::unique_ptr<Journal<index_type>> journal_ptr_;
+
+    void journal_invalidate() {
+        if (journal_ptr_) journal_ptr_->invalidate();
+    }
+    void journal_variable(index_type v) {
+        if (journal_ptr_) journal_ptr_->record_variable(v);
+    }
+
+    // The undo log of a transaction, see begin_transaction(). The objective
+    // and the constraints keep their own.
+    struct transaction_type {
+        UndoLog<varinfo_type, index_type> varinfo;
+        UndoLog<std::shared_ptr<Constraint<bias_type, index_type>>, index_type> constraints;
+
+        // whether start_journal() was called during the transaction
+        bool journal_started;
+
+        transaction_type(size_type num_variables, size_type num_constraints)
+                : varinfo(num_variables), constraints(num_constraints), journal_started(false) {}
+    };
+
+    // The transaction in progress, or null. Not copied with the model.
+    std::unique_ptr<transaction_type> transaction_ptr_;
+
+    // Save the parts of the model that are about to change, if there is a
+    // transaction in progress.
+    void undo_constraints() {
+        if (transaction_ptr_) transaction_ptr_->constraints.save_all(constraints_);
+    }
+    void undo_variable(index_type v) {
+        if (transaction_ptr_) transaction_ptr_->varinfo.save(varinfo_, v);
+    }
+    void undo_variables() {
+        if (transaction_ptr_) transaction_ptr_->varinfo.save_all(varinfo_);
+    }
 };
 
 template <class bias_type, class index_type>
@@ -413,6 +594,56 @@ index_type ConstrainedQuadraticModel<bias_type, index_type>::add_linear_constrai
     return constraints_.size() - 1;
 }
 
+template <class bias_type, class index_type>
+template <class Ptr, class Ind, class T>
+index_type ConstrainedQuadraticModel<bias_type, index_type>::add_linear_constraints_from_arrays(
+        index_type num_constraints, const Ptr indptr[], const Ind indices[],
+        const T coefficients[], const Sense senses[], const bias_type rhs[]) {
+    return add_quadratic_constraints_from_arrays<Ptr, Ind, T>(num_constraints, indptr, indices,
+                                                              coefficients, nullptr, nullptr,
+                                                              nullptr, nullptr, senses, rhs);
+}
+
+template <class bias_type, class index_type>
+template <class Ptr, class Ind, class T>
+index_type ConstrainedQuadraticModel<bias_type, index_type>::add_quadratic_constraints_from_arrays(
+        index_type num_constraints, const Ptr indptr[], const Ind indices[],
+        const T coefficients[], const Ptr qindptr[], const Ind qrow[], const Ind qcol[],
+        const T qcoefficients[], const Sense senses[], const bias_type rhs[]) {
+    assert(num_constraints >= 0);
+
+    index_type first = constraints_.size();
+    constraints_.reserve(constraints_.size() + num_constraints);
+
+    for (index_type c = 0; c < num_constraints; ++c) {
+        auto constraint = std::make_shared<Constraint<bias_type, index_type>>(this);
+
+        // allocate once, repeated variables make this an overestimate
+        size_type num_interactions = qindptr ? qindptr[c + 1] - qindptr[c] : 0;
+        constraint->reserve(indptr[c + 1] - indptr[c], num_interactions);
+
+        for (Ptr k = indptr[c]; k < indptr[c + 1]; ++k) {
+            assert(indices[k] >= 0 && static_cast<size_type>(indices[k]) < num_variables());
+            constraint->add_linear(indices[k], coefficients[k]);
+        }
+
+        if (qindptr) {
+            for (Ptr k = qindptr[c]; k < qindptr[c + 1]; ++k) {
+                assert(qrow[k] >= 0 && static_cast<size_type>(qrow[k]) < num_variables());
+                assert(qcol[k] >= 0 && static_cast<size_type>(qcol[k]) < num_variables());
+                constraint->add_quadratic(qrow[k], qcol[k], qcoefficients[k]);
+            }
+        }
+
+        constraint->set_sense(senses[c]);
+        constraint->set_rhs(rhs[c]);
+
+        constraints_.push_back(std::move(constraint));
+    }
+
+    return first;
+}
+
 template <class bias_type, class index_type>
 index_type ConstrainedQuadraticModel<bias_type, index_type>::add_variable(Vartype vartype) {
     index_type v = num_variables();
@@ -447,6 +678,25 @@ index_type ConstrainedQuadraticModel<bias_type, index_type>::add_variables(Varty
     return start;
 }
 
+template <class bias_type, class index_type>
+void ConstrainedQuadraticModel<bias_type, index_type>::begin_transaction() {
+    if (transaction_ptr_) throw std::logic_error("a transaction is already in progress");
+
+    // check everything first so that we don't start some of the transactions
+    if (objective.in_transaction()) {
+        throw std::logic_error("a transaction is already in progress for the objective");
+    }
+    for (const auto& c_ptr : constraints_) {
+        if (c_ptr->in_transaction()) {
+            throw std::logic_error("a transaction is already in progress for a constraint");
+        }
+    }
+
+    transaction_ptr_.reset(new transaction_type(num_variables(), num_constraints()));
+    objective.begin_transaction();
+    for (auto& c_ptr : constraints_) c_ptr->begin_transaction();
+}
+
 template <class bias_type, class index_type>
 void ConstrainedQuadraticModel<bias_type, index_type>::change_vartype(Vartype vartype,
                                                                       index_type v) {
@@ -455,9 +705,12 @@ void ConstrainedQuadraticModel<bias_type, index_type>::change_vartype(Vartype va
 
     // todo: just call this->substitute_variable
 
-    if (source == target) {
-        return;
-    } else if (source == Vartype::SPIN && target == Vartype::BINARY) {
+    if (source == target) return;
+
+    undo_variable(v);
+    journal_variable(v);
+
+    if (source == Vartype::SPIN && target == Vartype::BINARY) {
         objective.substitute_variable(v, 2, -1);
         for (auto& c_ptr : constraints_) {
             c_ptr->substitute_variable(v, 2, -1);
@@ -486,11 +739,78 @@ void ConstrainedQuadraticModel<bias_type, index_type>::change_vartype(Vartype va
     }
 }
 
+template <class bias_type, class index_type>
+void ConstrainedQuadraticModel<bias_type, index_type>::change_vartypes(
+        Vartype vartype, const std::vector<index_type>& variables) {
+    // each variable is substituted with multiplier * v + offset
+    std::vector<bias_type> multipliers(num_variables(), 1);
+    std::vector<bias_type> offsets(num_variables(), 0);
+
+    // check that all of the changes are supported before making any of them
+    bool substitute = false;
+    for (const auto& v : variables) {
+        const Vartype& source = this->vartype(v);
+
+        if (source == vartype) {
+            continue;
+        } else if (source == Vartype::SPIN &&
+                   (vartype == Vartype::BINARY || vartype == Vartype::INTEGER)) {
+            multipliers[v] = 2;
+            offsets[v] = -1;
+            substitute = true;
+        } else if (source == Vartype::BINARY && vartype == Vartype::SPIN) {
+            multipliers[v] = .5;
+            offsets[v] = .5;
+            substitute = true;
+        } else if (source == Vartype::BINARY && vartype == Vartype::INTEGER) {
+            // nothing need to change except the vartype itself
+        } else {
+            // todo: there are more we could support
+            throw std::logic_error("unsupported vartype change");
+        }
+    }
+
+    // one pass per expression, rather than one per variable per expression
+    if (substitute) {
+        objective.substitute_variables(multipliers, offsets);
+        for (auto& c_ptr : constraints_) {
+            c_ptr->substitute_variables(multipliers, offsets);
+        }
+    }
+
+    for (const auto& v : variables) {
+        if (varinfo_[v].vartype == vartype) continue;
+
+        // SPIN and BINARY both become {0, 1} when converted to INTEGER
+        undo_variable(v);
+        varinfo_[v].lb = (vartype == Vartype::SPIN) ? -1 : 0;
+        varinfo_[v].ub = +1;
+        varinfo_[v].vartype = vartype;
+        journal_variable(v);
+    }
+}
+
 template <class bias_type, class index_type>
 void ConstrainedQuadraticModel<bias_type, index_type>::clear() {
+    undo_constraints();
+    undo_variables();
     objective.clear();
     constraints_.clear();
     varinfo_.clear();
+    journal_invalidate();
+}
+
+template <class bias_type, class index_type>
+void ConstrainedQuadraticModel<bias_type, index_type>::commit() {
+    if (!transaction_ptr_) throw std::logic_error("no transaction in progress");
+
+    if (objective.in_transaction()) objective.commit();
+    for (auto& c_ptr : constraints_) {
+        // constraints added during the transaction are not in one
+        if (c_ptr->in_transaction()) c_ptr->commit();
+    }
+
+    transaction_ptr_.reset();
 }
 
 template <class bias_type, class index_type>
@@ -533,6 +853,41 @@ ConstrainedQuadraticModel<bias_type, index_type>::constraint_weak_ptr(index_type
     return constraints_[c];
 }
 
+template <class bias_type, class index_type>
+ContentHash ConstrainedQuadraticModel<bias_type, index_type>::content_hash(
+        const std::uint64_t keys[], size_type num_threads) const {
+    ContentHash hash;
+
+    for (size_type v = 0; v < num_variables(); ++v) {
+        std::uint64_t key = keys ? keys[v] : hashing::key(v);
+        hash += hashing::hash(hashing::VARIABLE, key, vartype(v), hashing::bits(lower_bound(v)),
+                              hashing::bits(upper_bound(v)));
+    }
+
+    ContentHash objective_hash = objective.content_hash(keys, num_threads);
+    hash += hashing::hash(hashing::OBJECTIVE, objective_hash.low, objective_hash.high);
+
+    for (const auto& c_ptr : constraints_) {
+        ContentHash lhs = c_ptr->content_hash(keys, num_threads);
+
+        std::uint64_t flags = c_ptr->sense();
+        flags |= static_cast<std::uint64_t>(c_ptr->marked_discrete()) << 8;
+        ContentHash constraint_hash =
+                hashing::hash(hashing::CONSTRAINT, lhs.low, lhs.high, flags,
+                              hashing::bits(c_ptr->rhs()));
+
+        if (c_ptr->is_soft()) {
+            constraint_hash = hashing::hash(hashing::CONSTRAINT, constraint_hash.low,
+                                            constraint_hash.high, c_ptr->penalty(),
+                                            hashing::bits(c_ptr->weight()));
+        }
+
+        hash += constraint_hash;
+    }
+
+    return hash;
+}
+
 template <class bias_type, class index_type>
 template <class T>
 void ConstrainedQuadraticModel<bias_type, index_type>::fix_variable(index_type v, T assignment) {
@@ -651,6 +1006,21 @@ ConstrainedQuadraticModel<bias_type, index_type>::fix_variables(
     return fix_variables(variables.begin(), variables.end(), assignments.begin());
 }
 
+template <class bias_type, class index_type>
+bool ConstrainedQuadraticModel<bias_type, index_type>::in_transaction() const {
+    return static_cast<bool>(transaction_ptr_);
+}
+
+template <class bias_type, class index_type>
+Journal<index_type>* ConstrainedQuadraticModel<bias_type, index_type>::journal() {
+    return journal_ptr_.get();
+}
+
+template <class bias_type, class index_type>
+const Journal<index_type>* ConstrainedQuadraticModel<bias_type, index_type>::journal() const {
+    return journal_ptr_.get();
+}
+
 template <class bias_type, class index_type>
 bias_type ConstrainedQuadraticModel<bias_type, index_type>::lower_bound(index_type v) const {
     return varinfo_[v].lb;
@@ -672,8 +1042,41 @@ std::size_t ConstrainedQuadraticModel<bias_type, index_type>::num_variables() co
     return varinfo_.size();
 }
 
+template <class bias_type, class index_type>
+void ConstrainedQuadraticModel<bias_type, index_type>::permute(
+        const std::vector<index_type>& permutation) {
+    assert(permutation.size() == num_variables());
+
+    // the expressions store the model's indices as labels, so only the labels
+    // need to change
+    auto relabel = [&permutation](Expression<bias_type, index_type>& expression) {
+        std::vector<index_type> labels;
+        labels.reserve(expression.num_variables());
+        for (const auto& v : expression.variables()) {
+            labels.push_back(permutation[v]);
+        }
+        expression.relabel_variables(std::move(labels));
+    };
+
+    journal_invalidate();  // the variables are relabeled
+    undo_variables();
+
+    relabel(objective);
+    for (auto& c_ptr : constraints_) {
+        relabel(*c_ptr);
+    }
+
+    std::vector<varinfo_type> varinfo(varinfo_);
+    for (size_type v = 0; v < permutation.size(); ++v) {
+        varinfo[permutation[v]] = varinfo_[v];
+    }
+    varinfo_.swap(varinfo);
+}
+
 template <class bias_type, class index_type>
 void ConstrainedQuadraticModel<bias_type, index_type>::remove_constraint(index_type c) {
+    journal_invalidate();  // the constraints above c are relabeled
+    undo_constraints();
     constraints_.erase(constraints_.begin() + c, constraints_.begin() + c + 1);
 }
 
@@ -685,21 +1088,70 @@ void ConstrainedQuadraticModel<bias_type, index_type>::remove_constraints_if(Una
         return p(*constraint_ptr);
     };
 
-    constraints_.erase(std::remove_if(constraints_.begin(), constraints_.end(), pred),
-                       constraints_.end());
+    undo_constraints();  // remove_if() moves the constraints that are kept
+
+    auto it = std::remove_if(constraints_.begin(), constraints_.end(), pred);
+    if (it != constraints_.end()) journal_invalidate();  // the constraints are relabeled
+    constraints_.erase(it, constraints_.end());
 }
 
 template <class bias_type, class index_type>
 void ConstrainedQuadraticModel<bias_type, index_type>::remove_variable(index_type v) {
     assert(v >= 0 && static_cast<size_type>(v) < num_variables());
+    journal_invalidate();  // the variables above v are relabeled
+    undo_variables();
     for (auto& c_ptr : constraints_) c_ptr->reindex_variables(v);
     objective.reindex_variables(v);
     varinfo_.erase(varinfo_.begin() + v);
 }
 
+template <class bias_type, class index_type>
+void ConstrainedQuadraticModel<bias_type, index_type>::reserve_constraints(
+        size_type num_constraints) {
+    constraints_.reserve(num_constraints);
+}
+
+template <class bias_type, class index_type>
+void ConstrainedQuadraticModel<bias_type, index_type>::reserve_variables(size_type num_variables) {
+    varinfo_.reserve(num_variables);
+}
+
+template <class bias_type, class index_type>
+void ConstrainedQuadraticModel<bias_type, index_type>::reset_stats() {
+    objective.reset_stats();
+    for (auto& c_ptr : constraints_) c_ptr->reset_stats();
+}
+
+template <class bias_type, class index_type>
+void ConstrainedQuadraticModel<bias_type, index_type>::rollback() {
+    if (!transaction_ptr_) throw std::logic_error("no transaction in progress");
+    transaction_type& transaction = *transaction_ptr_;
+
+    const size_type num_variables = this->num_variables();
+
+    // bring back any constraints that were removed, and drop the new ones,
+    // before undoing the changes to each constraint
+    transaction.constraints.restore(constraints_);
+    for (auto& c_ptr : constraints_) {
+        if (c_ptr->in_transaction()) c_ptr->rollback();
+    }
+    if (objective.in_transaction()) objective.rollback();
+
+    transaction.varinfo.restore(varinfo_);
+
+    // see QuadraticModelBase::rollback()
+    if (transaction.journal_started || this->num_variables() < num_variables) {
+        journal_invalidate();
+    }
+
+    transaction_ptr_.reset();
+}
+
 template <class bias_type, class index_type>
 void ConstrainedQuadraticModel<bias_type, index_type>::set_lower_bound(index_type v, bias_type lb) {
+    undo_variable(v);
     varinfo_[v].lb = lb;
+    journal_variable(v);
 }
 
 template <class bias_type, class index_type>
@@ -764,12 +1216,46 @@ void ConstrainedQuadraticModel<bias_type, index_type>::set_objective(
 
 template <class bias_type, class index_type>
 void ConstrainedQuadraticModel<bias_type, index_type>::set_upper_bound(index_type v, bias_type ub) {
+    undo_variable(v);
     varinfo_[v].ub = ub;
+    journal_variable(v);
 }
 
 template <class bias_type, class index_type>
 void ConstrainedQuadraticModel<bias_type, index_type>::set_vartype(index_type v, Vartype vartype) {
+    undo_variable(v);
     varinfo_[v].vartype = vartype;
+    journal_variable(v);
+}
+
+template <class bias_type, class index_type>
+void ConstrainedQuadraticModel<bias_type, index_type>::shrink_to_fit() {
+    objective.shrink_to_fit();
+    for (auto& c_ptr : constraints_) c_ptr->shrink_to_fit();
+    constraints_.shrink_to_fit();
+    varinfo_.shrink_to_fit();
+}
+
+template <class bias_type, class index_type>
+void ConstrainedQuadraticModel<bias_type, index_type>::start_journal() {
+    journal_ptr_.reset(new Journal<index_type>(num_variables(), num_constraints()));
+    if (transaction_ptr_) transaction_ptr_->journal_started = true;
+    objective.start_journal();
+    for (auto& c_ptr : constraints_) c_ptr->start_journal();
+}
+
+template <class bias_type, class index_type>
+Stats ConstrainedQuadraticModel<bias_type, index_type>::stats() const {
+    Stats stats = objective.stats();
+    for (const auto& c_ptr : constraints_) stats += c_ptr->stats();
+    return stats;
+}
+
+template <class bias_type, class index_type>
+void ConstrainedQuadraticModel<bias_type, index_type>::stop_journal() {
+    journal_ptr_.reset();
+    objective.stop_journal();
+    for (auto& c_ptr : constraints_) c_ptr->stop_journal();
 }
 
 template <class bias_type, class index_type>
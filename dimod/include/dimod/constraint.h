@@ -15,6 +15,7 @@
 #pragma once
 
 #include <limits>
+#include <memory>
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -49,10 +50,26 @@ class Constraint : public Expression<Bias, Index> {
     Constraint();
     explicit Constraint(const parent_type* parent);
 
+    Constraint(const Constraint& other);
+
+    Constraint(Constraint&& other) = default;
+
+    Constraint& operator=(const Constraint& other);
+
+    Constraint& operator=(Constraint&& other) = default;
+
+    /// Start a transaction, see `QuadraticModelBase::begin_transaction()`.
+    /// The sense, right-hand side, weight, penalty and discrete marker are
+    /// saved along with the expression.
+    void begin_transaction();
+
     /// Clear the constraint by changing it to a ``0 == 0`` constraint.
     /// The weight and/or discrete markers are also cleared if present.
     void clear();
 
+    /// Keep the changes made since `begin_transaction()`.
+    void commit();
+
     /// Return true for a one-hot constraint of discrete variables.
     bool is_onehot() const;
 
@@ -71,6 +88,10 @@ class Constraint : public Expression<Bias, Index> {
     /// Return a constraint's right-hand side.
     bias_type rhs() const;
 
+    /// Undo the changes made since `begin_transaction()`, including the
+    /// changes to the sense, right-hand side, weight, penalty and marker.
+    void rollback();
+
     // note: flips sign when negative
     /// Scale by multiplying by `scalar`.
     void scale(bias_type scalar);
@@ -101,6 +122,22 @@ class Constraint : public Expression<Bias, Index> {
 
     // marker(s) - these ar not enforced by code
     bool marked_discrete_ = false;
+
+    struct attributes_type {
+        Sense sense;
+        bias_type rhs;
+        bias_type weight;
+        Penalty penalty;
+        bool marked_discrete;
+    };
+
+    // The attributes at the start of a transaction, or null. Not copied with
+    // the constraint.
+    std::unique_ptr<attributes_type> transaction_attributes_ptr_;
+
+    void record_attributes() {
+        if (auto journal = this->journal()) journal->record_attributes();
+    }
 };
 
 template <class bias_type, class index_type>
@@ -114,6 +151,37 @@ Constraint<bias_type, index_type>::Constraint(const parent_type* parent)
           weight_(std::numeric_limits<bias_type>::infinity()),
           penalty_(Penalty::LINEAR) {}
 
+template <class bias_type, class index_type>
+Constraint<bias_type, index_type>::Constraint(const Constraint& other)
+        : base_type(other),
+          sense_(other.sense_),
+          rhs_(other.rhs_),
+          weight_(other.weight_),
+          penalty_(other.penalty_),
+          marked_discrete_(other.marked_discrete_) {}
+
+template <class bias_type, class index_type>
+Constraint<bias_type, index_type>& Constraint<bias_type, index_type>::operator=(
+        const Constraint& other) {
+    if (this != &other) {
+        base_type::operator=(other);
+        sense_ = other.sense_;
+        rhs_ = other.rhs_;
+        weight_ = other.weight_;
+        penalty_ = other.penalty_;
+        marked_discrete_ = other.marked_discrete_;
+        record_attributes();
+    }
+    return *this;
+}
+
+template <class bias_type, class index_type>
+void Constraint<bias_type, index_type>::begin_transaction() {
+    base_type::begin_transaction();
+    transaction_attributes_ptr_.reset(
+            new attributes_type{sense_, rhs_, weight_, penalty_, marked_discrete_});
+}
+
 template <class bias_type, class index_type>
 bool Constraint<bias_type, index_type>::is_onehot() const {
     // must be linear and must have at least two variables
@@ -143,11 +211,17 @@ bool Constraint<bias_type, index_type>::is_onehot() const {
 
 template <class bias_type, class index_type>
 void Constraint<bias_type, index_type>::clear() {
-    // Get a fresh empty constraint and swap its contents. This is more future-proof
-    // than clearing each value individually.
-    using std::swap;
-    auto other = Constraint<bias_type, index_type>(this->parent_);
-    swap(*this, other);
+    // Get a fresh empty constraint and copy its contents. This is more future-proof
+    // than clearing each value individually. We copy rather than swap so that
+    // a transaction in progress is kept and can undo the clear.
+    const Constraint<bias_type, index_type> other(this->parent_);
+    *this = other;
+}
+
+template <class bias_type, class index_type>
+void Constraint<bias_type, index_type>::commit() {
+    base_type::commit();
+    transaction_attributes_ptr_.reset();
 }
 
 template <class bias_type, class index_type>
@@ -159,6 +233,7 @@ bool Constraint<bias_type, index_type>::is_soft() const {
 template <class bias_type, class index_type>
 void Constraint<bias_type, index_type>::mark_discrete(bool marker) {
     marked_discrete_ = marker;
+    record_attributes();
 }
 
 template <class bias_type, class index_type>
@@ -176,6 +251,20 @@ bias_type Constraint<bias_type, index_type>::rhs() const {
     return rhs_;
 }
 
+template <class bias_type, class index_type>
+void Constraint<bias_type, index_type>::rollback() {
+    base_type::rollback();
+
+    const attributes_type& attributes = *transaction_attributes_ptr_;
+    sense_ = attributes.sense;
+    rhs_ = attributes.rhs;
+    weight_ = attributes.weight;
+    penalty_ = attributes.penalty;
+    marked_discrete_ = attributes.marked_discrete;
+
+    transaction_attributes_ptr_.reset();
+}
+
 template <class bias_type, class index_type>
 void Constraint<bias_type, index_type>::scale(bias_type scalar) {
     base_type::scale(scalar);
@@ -192,21 +281,25 @@ void Constraint<bias_type, index_type>::scale(bias_type scalar) {
 template <class bias_type, class index_type>
 void Constraint<bias_type, index_type>::set_penalty(Penalty penalty) {
     penalty_ = penalty;
+    record_attributes();
 }
 
 template <class bias_type, class index_type>
 void Constraint<bias_type, index_type>::set_rhs(bias_type rhs) {
     rhs_ = rhs;
+    record_attributes();
 }
 
 template <class bias_type, class index_type>
 void Constraint<bias_type, index_type>::set_sense(Sense sense) {
     sense_ = sense;
+    record_attributes();
 }
 
 template <class bias_type, class index_type>
 void Constraint<bias_type, index_type>::set_weight(bias_type weight) {
     weight_ = weight;
+    record_attributes();
 }
 
 template <class bias_type, class index_type>
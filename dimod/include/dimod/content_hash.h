@@ -0,0 +1,123 @@
+// Copyright 2023 D-Wave Systems Inc.
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <utility>
+
+namespace dimod {
+
+/**
+ * A 128-bit fingerprint of the content of a model.
+ *
+ * A content hash is the sum, modulo 2^128 in two independent 64-bit lanes,
+ * of the hashes of the terms of a model. Because addition commutes, the
+ * hash does not depend on the order in which the terms are visited, so
+ * models with the same terms have the same hash no matter how they were
+ * built or how their variables are ordered. Equal models always have equal
+ * hashes; models with equal hashes are equal with very high probability.
+ */
+struct ContentHash {
+    std::uint64_t low = 0;
+    std::uint64_t high = 0;
+
+    ContentHash() = default;
+    ContentHash(std::uint64_t low, std::uint64_t high) : low(low), high(high) {}
+
+    /// Add the hash of another term or model.
+    ContentHash& operator+=(const ContentHash& other) {
+        low += other.low;
+        high += other.high;
+        return *this;
+    }
+
+    /// Remove the hash of a term that was previously added.
+    ContentHash& operator-=(const ContentHash& other) {
+        low -= other.low;
+        high -= other.high;
+        return *this;
+    }
+
+    friend ContentHash operator+(ContentHash a, const ContentHash& b) { return a += b; }
+
+    friend bool operator==(const ContentHash& a, const ContentHash& b) {
+        return a.low == b.low && a.high == b.high;
+    }
+    friend bool operator!=(const ContentHash& a, const ContentHash& b) { return !(a == b); }
+};
+
+namespace hashing {
+
+// The finalizer of splitmix64, a bijection that mixes every input bit into
+// every output bit.
+inline std::uint64_t mix(std::uint64_t x) {
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ull;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebull;
+    x ^= x >> 31;
+    return x;
+}
+
+/// Return the bits of `value` as a double, so that equal values of any
+/// arithmetic type hash the same. -0.0 is treated as 0.0.
+template <class T>
+std::uint64_t bits(T value) {
+    double d = static_cast<double>(value);
+    if (d == 0) d = 0;  // -0.0 == 0.0
+    std::uint64_t out;
+    std::memcpy(&out, &d, sizeof(out));
+    return out;
+}
+
+/// Return the default key of variable `v`, used when a model's variables
+/// are identified by their indices.
+inline std::uint64_t key(std::uint64_t v) { return mix(v + 0x9e3779b97f4a7c15ull); }
+
+/// Hash a sequence of words. Each kind of term passes a different `tag` first
+/// so that, say, a linear bias never collides with the offset.
+inline ContentHash hash(std::uint64_t tag, std::uint64_t a, std::uint64_t b = 0,
+                        std::uint64_t c = 0, std::uint64_t d = 0) {
+    // the two lanes use the same words with different seeds
+    std::uint64_t low = mix(tag ^ 0x243f6a8885a308d3ull);
+    std::uint64_t high = mix(tag ^ 0x13198a2e03707344ull);
+    for (std::uint64_t word : {a, b, c, d}) {
+        low = mix(low ^ word);
+        high = mix(high + word);
+    }
+    return ContentHash(low, high);
+}
+
+/// Hash an interaction between the variables with keys `ku` and `kv`, which
+/// is the same for (u, v) and (v, u).
+inline ContentHash hash_interaction(std::uint64_t tag, std::uint64_t ku, std::uint64_t kv,
+                                    std::uint64_t bias) {
+    if (kv < ku) std::swap(ku, kv);
+    return hash(tag, ku, kv, bias);
+}
+
+// the tags of the kinds of terms
+enum Tag : std::uint64_t {
+    OFFSET = 1,
+    LINEAR,
+    QUADRATIC,
+    VARIABLE,
+    CONSTRAINT,
+    OBJECTIVE,
+};
+
+}  // namespace hashing
+}  // namespace dimod
@@ -0,0 +1,517 @@
+// Copyright 2023 D-Wave Systems Inc.
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "dimod/abc.h"
+#include "dimod/binary_quadratic_model.h"
+#include "dimod/precision.h"
+#include "dimod/vartypes.h"
+
+namespace dimod {
+
+/**
+ * A binary quadratic model that stores its quadratic biases in a dense matrix.
+ *
+ * `BinaryQuadraticModel` stores each interaction twice, once in the sorted
+ * neighborhood of each of its variables, as an (index, bias) pair. For
+ * fully-connected models the indices are redundant, so this model stores the
+ * quadratic biases as a symmetric `num_variables() x num_variables()`
+ * row-major matrix with a zero diagonal. Each row is then the neighborhood of
+ * its variable, and `energy()` is a matrix-vector product over the upper
+ * triangle that reads each bias once, in order. The number of nonzero
+ * quadratic biases is maintained as they are set, so `num_interactions()`
+ * and `is_linear()` do not scan the matrix.
+ *
+ * The matrix always takes `num_variables()^2` biases so for sparse models
+ * `BinaryQuadraticModel` should be preferred.
+ */
+template <class Bias, class Index = int>
+class DenseQuadraticModel {
+ public:
+    /// The first template parameter (`Bias`).
+    using bias_type = Bias;
+
+    /// The second template parameter (`Index`).
+    using index_type = Index;
+
+    /// Unsigned integer type that can represent non-negative values.
+    using size_type = std::size_t;
+
+    /// A random access iterator over the biases of one row of the matrix.
+    using const_row_iterator = typename std::vector<bias_type>::const_iterator;
+
+    /// Construct an empty BINARY-valued model.
+    DenseQuadraticModel();
+
+    /// Construct a model with no biases.
+    DenseQuadraticModel(index_type n, Vartype vartype);
+
+    /**
+     * Construct a model from a dense matrix.
+     *
+     * `dense` must be an array of length `num_variables^2`. As for
+     * `BinaryQuadraticModel`, values on the diagonal are added to the
+     * linear biases of BINARY-valued models and to the offset of SPIN-valued
+     * models.
+     */
+    template <class T>
+    DenseQuadraticModel(const T dense[], index_type num_variables, Vartype vartype);
+
+    /// Construct a model with the biases of the given binary quadratic model.
+    template <class B, class I>
+    explicit DenseQuadraticModel(const BinaryQuadraticModel<B, I>& bqm);
+
+    /// Add linear bias to variable `v`.
+    void add_linear(index_type v, bias_type bias);
+
+    /// Add offset.
+    void add_offset(bias_type bias);
+
+    /// Add quadratic bias for the given variables.
+    void add_quadratic(index_type u, index_type v, bias_type bias);
+
+    /// Return an iterator to the beginning of the row of `v`.
+    const_row_iterator cbegin_row(index_type v) const;
+
+    /// Return an iterator to the end of the row of `v`.
+    const_row_iterator cend_row(index_type v) const;
+
+    /**
+     * Return the energy of the given sample.
+     *
+     * The `sample_start` must be a random access iterator pointing to the
+     * beginning of the sample.
+     *
+     * The behavior of this function is undefined when the sample is not
+     * `num_variables()` long.
+     */
+    template <class Iter>
+    bias_type energy(Iter sample_start) const;
+
+    /// Test whether the model has no quadratic biases.
+    bool is_linear() const;
+
+    /// The linear bias of variable `v`.
+    bias_type linear(index_type v) const;
+
+    /// Return the lower bound on the variables.
+    bias_type lower_bound() const;
+
+    /// Return the lower bound on variable ``v``.
+    bias_type lower_bound(index_type v) const;
+
+    /**
+     * Total bytes consumed by the biases.
+     *
+     * If `capacity` is true, use the capacity of the underlying vectors rather
+     * than the size.
+     */
+    size_type nbytes(bool capacity = false) const;
+
+    /// Return the number of interactions, that is the nonzero quadratic biases.
+    size_type num_interactions() const;
+
+    /// Return the number of other variables that `v` interacts with.
+    /// Takes O(num_variables()) time, it counts the nonzeros in the row of `v`.
+    size_type num_interactions(index_type v) const;
+
+    /// Return the number of variables in the model.
+    size_type num_variables() const;
+
+    /// Return the offset.
+    bias_type offset() const;
+
+    /// Return the quadratic bias associated with `u` and `v`.
+    bias_type quadratic(index_type u, index_type v) const;
+
+    /// Set the linear bias of variable `v`.
+    void set_linear(index_type v, bias_type bias);
+
+    /// Set the offset.
+    void set_offset(bias_type offset);
+
+    /// Set the quadratic bias for the given variables.
+    void set_quadratic(index_type u, index_type v, bias_type bias);
+
+    /// Return a binary quadratic model with the same biases.
+    BinaryQuadraticModel<bias_type, index_type> to_bqm() const;
+
+    /// Return the upper bound on the variables.
+    bias_type upper_bound() const;
+
+    /// Return the upper bound on variable ``v``.
+    bias_type upper_bound(index_type v) const;
+
+    /// Return the vartype of the model.
+    Vartype vartype() const;
+
+    /// Return the vartype of `v`.
+    Vartype vartype(index_type v) const;
+
+ private:
+    // The number of rows of the upper triangle that energy() reads together,
+    // so each value of the sample is loaded once for the whole block.
+    static constexpr size_type ENERGY_ROW_BLOCK = 4;
+
+    size_type index(index_type u, index_type v) const;
+
+    // set both (u, v) and (v, u), keeping the count of nonzeros. u != v
+    void set_quadratic_(index_type u, index_type v, bias_type bias);
+
+    std::vector<bias_type> linear_biases_;
+
+    // row-major and symmetric, with a zero diagonal
+    std::vector<bias_type> quadratic_biases_;
+
+    // the number of nonzero biases in the upper triangle
+    size_type num_interactions_;
+
+    bias_type offset_;
+
+    Vartype vartype_;
+};
+
+template <class bias_type, class index_type>
+DenseQuadraticModel<bias_type, index_type>::DenseQuadraticModel()
+        : DenseQuadraticModel(0, Vartype::BINARY) {}
+
+template <class bias_type, class index_type>
+DenseQuadraticModel<bias_type, index_type>::DenseQuadraticModel(index_type n, Vartype vartype)
+        : linear_biases_(),
+          quadratic_biases_(),
+          num_interactions_(0),
+          offset_(0),
+          vartype_(vartype) {
+    assert(n >= 0);
+
+    if (vartype != Vartype::BINARY && vartype != Vartype::SPIN) {
+        throw std::logic_error("unsupported vartype");
+    }
+
+    const size_type num_variables = n;
+    if (num_variables && num_variables > quadratic_biases_.max_size() / num_variables) {
+        throw std::length_error("too many variables for a dense model");
+    }
+
+    linear_biases_.resize(num_variables);
+    quadratic_biases_.resize(num_variables * num_variables);
+}
+
+template <class bias_type, class index_type>
+template <class T>
+DenseQuadraticModel<bias_type, index_type>::DenseQuadraticModel(const T dense[],
+                                                                index_type num_variables,
+                                                                Vartype vartype)
+        : DenseQuadraticModel(num_variables, vartype) {
+    static_assert(std::is_arithmetic<T>::value, "T must be numeric");
+
+    for (index_type u = 0; u < num_variables; ++u) {
+        // diagonal
+        add_quadratic(u, u, dense[u * (num_variables + 1)]);
+
+        // off-diagonal
+        for (index_type v = u + 1; v < num_variables; ++v) {
+            bias_type qbias = static_cast<accumulator_t<bias_type>>(dense[u * num_variables + v]) +
+                              dense[v * num_variables + u];
+
+            set_quadratic_(u, v, qbias);
+        }
+    }
+}
+
+template <class bias_type, class index_type>
+template <class B, class I>
+DenseQuadraticModel<bias_type, index_type>::DenseQuadraticModel(
+        const BinaryQuadraticModel<B, I>& bqm)
+        : DenseQuadraticModel(bqm.num_variables(), bqm.vartype()) {
+    offset_ = bqm.offset();
+    for (size_type u = 0; u < bqm.num_variables(); ++u) {
+        linear_biases_[u] = bqm.linear(u);
+        for (auto it = bqm.cbegin_neighborhood(u); it != bqm.cend_neighborhood(u); ++it) {
+            if (static_cast<size_type>(it->v) > u) set_quadratic_(u, it->v, it->bias);
+        }
+    }
+}
+
+template <class bias_type, class index_type>
+void DenseQuadraticModel<bias_type, index_type>::add_linear(index_type v, bias_type bias) {
+    assert(0 <= v && static_cast<size_type>(v) < num_variables());
+    linear_biases_[v] += bias;
+}
+
+template <class bias_type, class index_type>
+void DenseQuadraticModel<bias_type, index_type>::add_offset(bias_type bias) {
+    offset_ += bias;
+}
+
+template <class bias_type, class index_type>
+void DenseQuadraticModel<bias_type, index_type>::add_quadratic(index_type u, index_type v,
+                                                               bias_type bias) {
+    if (u == v) {
+        assert(0 <= u && static_cast<size_type>(u) < num_variables());
+        if (vartype_ == Vartype::BINARY) {
+            // 1*1 == 1 and 0*0 == 0 so this is linear
+            linear_biases_[u] += bias;
+        } else {
+            // -1*-1 == +1*+1 == 1 so this is a constant offset
+            offset_ += bias;
+        }
+    } else {
+        set_quadratic_(u, v, quadratic_biases_[index(u, v)] + bias);
+    }
+}
+
+template <class bias_type, class index_type>
+typename DenseQuadraticModel<bias_type, index_type>::const_row_iterator
+DenseQuadraticModel<bias_type, index_type>::cbegin_row(index_type v) const {
+    return quadratic_biases_.cbegin() + index(v, 0);
+}
+
+template <class bias_type, class index_type>
+typename DenseQuadraticModel<bias_type, index_type>::const_row_iterator
+DenseQuadraticModel<bias_type, index_type>::cend_row(index_type v) const {
+    return cbegin_row(v) + num_variables();
+}
+
+template <class bias_type, class index_type>
+template <class Iter>
+bias_type DenseQuadraticModel<bias_type, index_type>::energy(Iter sample_start) const {
+    static_assert(std::is_same<std::random_access_iterator_tag,
+                               typename std::iterator_traits<Iter>::iterator_category>::value,
+                  "iterators must be random access");
+
+    using accumulator_type = accumulator_t<bias_type>;
+
+    constexpr size_type B = ENERGY_ROW_BLOCK;
+    static_assert(B == 4, "the loop over the rectangle is unrolled for four rows");
+
+    const size_type n = num_variables();
+
+    // a contiguous copy of the sample, so the inner loops are plain array
+    // arithmetic that the compiler can vectorize
+    std::vector<accumulator_type> x(sample_start, sample_start + n);
+
+    accumulator_type en = offset_;
+
+    // x^T Q x over the upper triangle, B rows at a time. Within a block the
+    // rows read the same run of x, so each value is loaded once per block
+    const bias_type* Q = quadratic_biases_.data();
+    size_type u0 = 0;
+    for (; u0 + B <= n; u0 += B) {
+        accumulator_type field[B];
+        for (size_type i = 0; i < B; ++i) {
+            field[i] = linear_biases_[u0 + i];
+
+            // the triangle inside the block
+            const bias_type* row = Q + (u0 + i) * n;
+            for (size_type v = u0 + i + 1; v < u0 + B; ++v) field[i] += row[v] * x[v];
+        }
+
+        // the rectangle to the right of the block
+        const bias_type* row0 = Q + u0 * n;
+        const bias_type* row1 = row0 + n;
+        const bias_type* row2 = row1 + n;
+        const bias_type* row3 = row2 + n;
+        accumulator_type f0 = 0, f1 = 0, f2 = 0, f3 = 0;
+        for (size_type v = u0 + B; v < n; ++v) {
+            f0 += row0[v] * x[v];
+            f1 += row1[v] * x[v];
+            f2 += row2[v] * x[v];
+            f3 += row3[v] * x[v];
+        }
+
+        en += x[u0] * (field[0] + f0) + x[u0 + 1] * (field[1] + f1) +
+              x[u0 + 2] * (field[2] + f2) + x[u0 + 3] * (field[3] + f3);
+    }
+
+    // the remaining rows, fewer than B of them
+    for (size_type u = u0; u < n; ++u) {
+        accumulator_type field = linear_biases_[u];
+        const bias_type* row = Q + u * n;
+        for (size_type v = u + 1; v < n; ++v) field += row[v] * x[v];
+        en += x[u] * field;
+    }
+
+    return en;
+}
+
+template <class bias_type, class index_type>
+size_t DenseQuadraticModel<bias_type, index_type>::index(index_type u, index_type v) const {
+    assert(0 <= u && static_cast<size_type>(u) < num_variables());
+    assert(0 <= v && static_cast<size_type>(v) < num_variables());
+    return static_cast<size_type>(u) * num_variables() + v;
+}
+
+template <class bias_type, class index_type>
+bool DenseQuadraticModel<bias_type, index_type>::is_linear() const {
+    return !num_interactions_;
+}
+
+template <class bias_type, class index_type>
+bias_type DenseQuadraticModel<bias_type, index_type>::linear(index_type v) const {
+    assert(0 <= v && static_cast<size_type>(v) < num_variables());
+    return linear_biases_[v];
+}
+
+template <class bias_type, class index_type>
+bias_type DenseQuadraticModel<bias_type, index_type>::lower_bound() const {
+    return vartype_info<bias_type>::default_min(vartype_);
+}
+
+template <class bias_type, class index_type>
+bias_type DenseQuadraticModel<bias_type, index_type>::lower_bound(index_type) const {
+    return lower_bound();
+}
+
+template <class bias_type, class index_type>
+size_t DenseQuadraticModel<bias_type, index_type>::nbytes(bool capacity) const {
+    size_type count = sizeof(bias_type);  // offset
+    if (capacity) {
+        count += linear_biases_.capacity() * sizeof(bias_type);
+        count += quadratic_biases_.capacity() * sizeof(bias_type);
+    } else {
+        count += linear_biases_.size() * sizeof(bias_type);
+        count += quadratic_biases_.size() * sizeof(bias_type);
+    }
+    return count;
+}
+
+template <class bias_type, class index_type>
+size_t DenseQuadraticModel<bias_type, index_type>::num_interactions() const {
+    return num_interactions_;
+}
+
+template <class bias_type, class index_type>
+size_t DenseQuadraticModel<bias_type, index_type>::num_interactions(index_type v) const {
+    // the diagonal is always zero so we don't need to skip it
+    return num_variables() - std::count(cbegin_row(v), cend_row(v), bias_type(0));
+}
+
+template <class bias_type, class index_type>
+size_t DenseQuadraticModel<bias_type, index_type>::num_variables() const {
+    return linear_biases_.size();
+}
+
+template <class bias_type, class index_type>
+bias_type DenseQuadraticModel<bias_type, index_type>::offset() const {
+    return offset_;
+}
+
+template <class bias_type, class index_type>
+bias_type DenseQuadraticModel<bias_type, index_type>::quadratic(index_type u, index_type v) const {
+    return quadratic_biases_[index(u, v)];
+}
+
+template <class bias_type, class index_type>
+void DenseQuadraticModel<bias_type, index_type>::set_linear(index_type v, bias_type bias) {
+    assert(0 <= v && static_cast<size_type>(v) < num_variables());
+    linear_biases_[v] = bias;
+}
+
+template <class bias_type, class index_type>
+void DenseQuadraticModel<bias_type, index_type>::set_offset(bias_type offset) {
+    offset_ = offset;
+}
+
+template <class bias_type, class index_type>
+void DenseQuadraticModel<bias_type, index_type>::set_quadratic(index_type u, index_type v,
+                                                               bias_type bias) {
+    if (u == v) {
+        if (vartype_ == Vartype::BINARY) {
+            throw std::domain_error(
+                    "Cannot set the quadratic bias of a binary variable with itself");
+        } else {
+            throw std::domain_error("Cannot set the quadratic bias of a spin variable with itself");
+        }
+    }
+    set_quadratic_(u, v, bias);
+}
+
+template <class bias_type, class index_type>
+void DenseQuadraticModel<bias_type, index_type>::set_quadratic_(index_type u, index_type v,
+                                                                bias_type bias) {
+    assert(u != v);
+
+    bias_type& uv = quadratic_biases_[index(u, v)];
+    if (!uv && bias) {
+        ++num_interactions_;
+    } else if (uv && !bias) {
+        --num_interactions_;
+    }
+
+    uv = bias;
+    quadratic_biases_[index(v, u)] = bias;
+}
+
+template <class bias_type, class index_type>
+BinaryQuadraticModel<bias_type, index_type> DenseQuadraticModel<bias_type, index_type>::to_bqm()
+        const {
+    const size_type n = num_variables();
+
+    BinaryQuadraticModel<bias_type, index_type> bqm(n, vartype_);
+    bqm.set_offset(offset_);
+    for (size_type u = 0; u < n; ++u) {
+        bqm.set_linear(u, linear_biases_[u]);
+    }
+
+    // the nonzeros of the upper triangle in CSR format
+    std::vector<size_type> indptr(n + 1, 0);
+    std::vector<index_type> indices;
+    std::vector<bias_type> data;
+    indices.reserve(num_interactions_);
+    data.reserve(num_interactions_);
+    for (size_type u = 0; u < n; ++u) {
+        for (size_type v = u + 1; v < n; ++v) {
+            bias_type bias = quadratic_biases_[index(u, v)];
+            if (bias) {
+                indices.push_back(v);
+                data.push_back(bias);
+            }
+        }
+        indptr[u + 1] = indices.size();
+    }
+
+    bqm.add_quadratic_from_csr(indptr.data(), indices.data(), data.data(), n);
+    return bqm;
+}
+
+template <class bias_type, class index_type>
+bias_type DenseQuadraticModel<bias_type, index_type>::upper_bound() const {
+    return vartype_info<bias_type>::default_max(vartype_);
+}
+
+template <class bias_type, class index_type>
+bias_type DenseQuadraticModel<bias_type, index_type>::upper_bound(index_type) const {
+    return upper_bound();
+}
+
+template <class bias_type, class index_type>
+Vartype DenseQuadraticModel<bias_type, index_type>::vartype() const {
+    return vartype_;
+}
+
+template <class bias_type, class index_type>
+Vartype DenseQuadraticModel<bias_type, index_type>::vartype(index_type v) const {
+    return vartype_;
+}
+
+}  // namespace dimod
@@ -16,12 +16,15 @@
 
 #include <algorithm>
 #include <limits>
+#include <memory>
+#include <stdexcept>
 #include <unordered_map>
 #include <unordered_set>
 #include <utility>
 #include <vector>
 
 #include "dimod/abc.h"
+#include "dimod/transaction.h"
 #include "dimod/utils.h"
 #include "dimod/vartypes.h"
 
@@ -169,9 +172,23 @@ class Expression : public abc::QuadraticModelBase<Bias, Index> {
 
     Expression(const parent_type* parent, base_type&& other);
 
+    Expression(const Expression& other);
+
+    Expression(Expression&& other) = default;
+
+    Expression& operator=(const Expression& other);
+
+    Expression& operator=(Expression&& other) = default;
+
     /// Add linear bias to variable ``v``.
     void add_linear(index_type v, bias_type bias);
 
+    /// Add the biases and offset of another quadratic model. `mapping` maps
+    /// the variables of `other` to the variables of the parent model.
+    template <class B, class I>
+    void add_model(const abc::QuadraticModelBase<B, I>& other,
+                   const std::vector<index_type>& mapping);
+
     void add_quadratic(index_type u, index_type v, bias_type bias);
 
     void add_quadratic(std::initializer_list<index_type> row, std::initializer_list<index_type> col,
@@ -186,6 +203,14 @@ class Expression : public abc::QuadraticModelBase<Bias, Index> {
     template <class T>
     void add_quadratic_from_dense(const T dense[], index_type num_variables);
 
+    template <class Ptr, class Ind, class T>
+    void add_quadratic_from_csr(const Ptr indptr[], const Ind indices[], const T data[],
+                                index_type num_rows);
+
+    /// Start a transaction, see `QuadraticModelBase::begin_transaction()`.
+    /// The variables of the expression are saved along with the biases.
+    void begin_transaction();
+
     const_neighborhood_iterator cbegin_neighborhood(index_type v) const;
 
     const_neighborhood_iterator cend_neighborhood(index_type v) const;
@@ -197,6 +222,19 @@ class Expression : public abc::QuadraticModelBase<Bias, Index> {
     /// Remove the offset and all variables and interactions from the model. Does not affect parent
     void clear();
 
+    /// Keep the changes made since `begin_transaction()`.
+    void commit();
+
+    /**
+     * Return a 128-bit fingerprint of the offset, linear biases and
+     * quadratic biases of the expression, see `ContentHash`.
+     *
+     * `keys` is indexed by the variables of the parent model. The variable
+     * types and bounds belong to the parent and are not included.
+     */
+    ContentHash content_hash(const std::uint64_t keys[] = nullptr,
+                             size_type num_threads = 1) const;
+
     /**
      * Return the energy of the given sample.
      *
@@ -212,6 +250,11 @@ class Expression : public abc::QuadraticModelBase<Bias, Index> {
     template <class T>
     void fix_variable(index_type v, T assignment);
 
+    /// Remove several of the parent's variables from the expression by
+    /// fixing their values. Variables not in the expression are ignored.
+    void fix_variables(const std::vector<index_type>& variables,
+                       const std::vector<bias_type>& assignments);
+
     /// Check whether u and v have an interaction
     bool has_interaction(index_type u,  index_type v) const;
 
@@ -241,6 +284,15 @@ class Expression : public abc::QuadraticModelBase<Bias, Index> {
     /// The number of other variables `v` interacts with.
     size_type num_interactions(index_type v) const;
 
+    /**
+     * Permute the variables of the expression so that its `v`th variable
+     * becomes its `permutation[v]`th.
+     *
+     * This changes how the expression's variables are stored, not the labels
+     * of the parent model.
+     */
+    void permute(const std::vector<index_type>& permutation);
+
     /**
      * Return the quadratic bias associated with `u`, `v`.
      *
@@ -278,6 +330,27 @@ class Expression : public abc::QuadraticModelBase<Bias, Index> {
         return remove_variables(variables.begin(), variables.end());
     }
 
+    /**
+     * Reserve capacity for at least `num_variables` variables in the
+     * expression, including the map from the parent's variables.
+     * See `QuadraticModelBase::reserve()`.
+     */
+    void reserve(index_type num_variables, size_type num_interactions_hint = 0);
+
+    /**
+     * Reserve capacity in the neighborhood of each of the expression's
+     * variables, see `QuadraticModelBase::reserve_interactions()`.
+     *
+     * Note that `degrees` is indexed by the parent's variables rather than the
+     * expression's. Variables not in the expression are skipped.
+     */
+    template <class T>
+    void reserve_interactions(const T degrees[], index_type num_variables);
+
+    /// Undo the changes made since `begin_transaction()`, including any
+    /// variables added to or removed from the expression.
+    void rollback();
+
     /// Set the linear bias of variable `v`.
     void set_linear(index_type v, bias_type bias);
 
@@ -289,8 +362,28 @@ class Expression : public abc::QuadraticModelBase<Bias, Index> {
 
     bool shares_variables(const Expression& other) const;
 
+    /// Release any capacity reserved beyond the current size of the expression.
+    void shrink_to_fit();
+
     void substitute_variable(index_type v, bias_type multiplier, bias_type offset);
 
+    using base_type::substitute_variables;
+
+    /**
+     * Substitute each variable `v` of the parent model with
+     * `multipliers[v] * v + offsets[v]`, see
+     * `QuadraticModelBase::substitute_variables()`.
+     *
+     * Note that `multipliers` and `offsets` are indexed by the parent's
+     * variables rather than the expression's.
+     */
+    void substitute_variables(const std::vector<bias_type>& multipliers,
+                              const std::vector<bias_type>& offsets);
+
+    /// Write the quadratic biases as CSR, indexed by position in `variables()`.
+    template <class Ptr, class Ind, class T>
+    void to_csr(Ptr indptr[], Ind indices[], T data[]) const;
+
     /// Return the upper bound on variable ``v``.
     bias_type upper_bound(index_type v) const;
 
@@ -316,9 +409,19 @@ class Expression : public abc::QuadraticModelBase<Bias, Index> {
     /// Map from parent's labels to the internal ones
     std::unordered_map<index_type, index_type> indices_;  // todo: consider Tessil
 
+    /// The undo log of variables_ during a transaction, or null. Variables
+    /// are only ever appended or reindexed, so the log saves all or nothing.
+    std::unique_ptr<UndoLog<index_type, index_type>> variables_undo_ptr_;
+
+    /// Save variables_ before it is reindexed, if there is a transaction
+    void undo_variables() {
+        if (variables_undo_ptr_) variables_undo_ptr_->save_all(variables_);
+    }
+
     /// Make sure ``v`` exists in the model and return the index in the underlying QM
     index_type enforce_variable(index_type v) {
         auto it = indices_.find(v);
+        DIMOD_STATS_INCREMENT(this->stats_, hash_lookups);
         if (it != indices_.end()) {
             // we're already tracking it
             return it->second;
@@ -346,11 +449,47 @@ Expression<bias_type, index_type>::Expression(const parent_type* parent, base_ty
     throw std::logic_error("not implemented - construction from other");
 }
 
+template <class bias_type, class index_type>
+Expression<bias_type, index_type>::Expression(const Expression& other)
+        : base_type(other),
+          parent_(other.parent_),
+          variables_(other.variables_),
+          indices_(other.indices_) {}
+
+template <class bias_type, class index_type>
+Expression<bias_type, index_type>& Expression<bias_type, index_type>::operator=(
+        const Expression& other) {
+    if (this != &other) {
+        base_type::operator=(other);
+        undo_variables();
+        parent_ = other.parent_;
+        variables_ = other.variables_;
+        indices_ = other.indices_;
+    }
+    return *this;
+}
+
 template <class bias_type, class index_type>
 void Expression<bias_type, index_type>::add_linear(index_type v, bias_type bias) {
     base_type::add_linear(enforce_variable(v), bias);
 }
 
+template <class bias_type, class index_type>
+template <class B, class I>
+void Expression<bias_type, index_type>::add_model(const abc::QuadraticModelBase<B, I>& other,
+                                                  const std::vector<index_type>& mapping) {
+    assert(mapping.size() == other.num_variables());
+
+    // translate the mapping to our internal indices
+    std::vector<index_type> indices;
+    indices.reserve(mapping.size());
+    for (const auto& v : mapping) {
+        indices.emplace_back(enforce_variable(v));
+    }
+
+    base_type::add_model(other, indices);
+}
+
 template <class bias_type, class index_type>
 void Expression<bias_type, index_type>::add_quadratic(index_type u, index_type v, bias_type bias) {
     base_type::add_quadratic(enforce_variable(u), enforce_variable(v), bias);
@@ -381,10 +520,26 @@ void Expression<bias_type, index_type>::add_quadratic_from_dense(const T dense[]
     throw std::logic_error("not implemented - add_quadratic_from_dense");
 }
 
+template <class bias_type, class index_type>
+template <class Ptr, class Ind, class T>
+void Expression<bias_type, index_type>::add_quadratic_from_csr(const Ptr indptr[],
+                                                               const Ind indices[],
+                                                               const T data[],
+                                                               index_type num_rows) {
+    throw std::logic_error("not implemented - add_quadratic_from_csr");
+}
+
+template <class bias_type, class index_type>
+void Expression<bias_type, index_type>::begin_transaction() {
+    base_type::begin_transaction();
+    variables_undo_ptr_.reset(new UndoLog<index_type, index_type>(variables_.size()));
+}
+
 template <class bias_type, class index_type>
 typename Expression<bias_type, index_type>::const_neighborhood_iterator
 Expression<bias_type, index_type>::cbegin_neighborhood(index_type v) const {
     auto it = indices_.find(v);
+    DIMOD_STATS_INCREMENT(this->stats_, hash_lookups);
     if (it == indices_.end()) {
         assert(v >= 0 && static_cast<size_type>(v) < parent_->num_variables());
         auto empty = base_type::empty_neighborhood();
@@ -398,6 +553,7 @@ template <class bias_type, class index_type>
 typename Expression<bias_type, index_type>::const_neighborhood_iterator
 Expression<bias_type, index_type>::cend_neighborhood(index_type v) const {
     auto it = indices_.find(v);
+    DIMOD_STATS_INCREMENT(this->stats_, hash_lookups);
     if (it == indices_.end()) {
         assert(v >= 0 && static_cast<size_type>(v) < parent_->num_variables());
         auto empty = base_type::empty_neighborhood();
@@ -423,22 +579,31 @@ Expression<bias_type, index_type>::cend_quadratic() const {
 template <class bias_type, class index_type>
 void Expression<bias_type, index_type>::clear() {
     base_type::clear();
+    undo_variables();
     indices_.clear();
     variables_.clear();
 }
 
+template <class bias_type, class index_type>
+void Expression<bias_type, index_type>::commit() {
+    base_type::commit();
+    variables_undo_ptr_.reset();
+}
+
 template <class bias_type, class index_type>
 template <class T>
 void Expression<bias_type, index_type>::fix_variable(index_type v, T assignment) {
     assert(v >= 0 && static_cast<size_type>(v) < parent_->num_variables());
 
     auto vit = indices_.find(v);
+    DIMOD_STATS_INCREMENT(this->stats_, hash_lookups);
     if (vit == indices_.end()) return;  // nothing to remove
 
     // remove the biases
     base_type::fix_variable(vit->second, assignment);
 
     // update the indices
+    undo_variables();
     auto it = variables_.erase(variables_.begin() + vit->second);
     indices_.erase(vit);
     for (; it != variables_.end(); ++it) {
@@ -446,10 +611,50 @@ void Expression<bias_type, index_type>::fix_variable(index_type v, T assignment)
     }
 }
 
+template <class bias_type, class index_type>
+void Expression<bias_type, index_type>::fix_variables(const std::vector<index_type>& variables,
+                                                      const std::vector<bias_type>& assignments) {
+    if (variables.size() != assignments.size()) {
+        throw std::invalid_argument("variables and assignments must be the same length");
+    }
+
+    // translate the parent's variables into ours, skipping any we don't have
+    std::vector<index_type> to_fix;
+    std::vector<bias_type> values;
+    for (size_type i = 0; i < variables.size(); ++i) {
+        auto search = indices_.find(variables[i]);
+        DIMOD_STATS_INCREMENT(this->stats_, hash_lookups);
+        if (search != indices_.end()) {
+            to_fix.emplace_back(search->second);
+            values.emplace_back(assignments[i]);
+        }
+    }
+    if (!to_fix.size()) return;
+
+    // fold in the biases
+    base_type::fix_variables(to_fix, values);
+
+    // remove the fixed variables from variables_
+    std::sort(to_fix.begin(), to_fix.end());
+    to_fix.erase(std::unique(to_fix.begin(), to_fix.end()), to_fix.end());
+    undo_variables();
+    variables_.erase(utils::remove_by_index(variables_.begin(), variables_.end(), to_fix.begin(),
+                                            to_fix.end()),
+                     variables_.end());
+
+    // finally fix the indices by rebuilding from scratch
+    indices_.clear();
+    for (size_type i = 0, end = variables_.size(); i < end; ++i) {
+        indices_[variables_[i]] = i;
+    }
+}
+
 template <class bias_type, class index_type>
 bool Expression<bias_type, index_type>::has_interaction(index_type u, index_type v) const {
     auto uit = indices_.find(u);
+    DIMOD_STATS_INCREMENT(this->stats_, hash_lookups);
     auto vit = indices_.find(v);
+    DIMOD_STATS_INCREMENT(this->stats_, hash_lookups);
     if (uit == indices_.end() || vit == indices_.end()) {
         assert(u >= 0 && static_cast<size_type>(u) < parent_->num_variables());
         assert(v >= 0 && static_cast<size_type>(v) < parent_->num_variables());
@@ -461,6 +666,7 @@ bool Expression<bias_type, index_type>::has_interaction(index_type u, index_type
 
 template <class bias_type, class index_type>
 bool Expression<bias_type, index_type>::has_variable(index_type v) const {
+    DIMOD_STATS_INCREMENT(this->stats_, hash_lookups);
     return indices_.count(v);
 }
 
@@ -472,6 +678,7 @@ bool Expression<bias_type, index_type>::is_disjoint(const Expression& other) con
     }
 
     for (const auto& v : variables_) {
+        DIMOD_STATS_INCREMENT(this->stats_, hash_lookups);
         if (other.indices_.count(v)) {
             return false;
         }
@@ -486,6 +693,19 @@ bool Expression<bias_type, index_type>:: is_equal(const abc::QuadraticModelBase<
     throw std::logic_error("not implemented - is_equal");
 }
 
+template <class bias_type, class index_type>
+ContentHash Expression<bias_type, index_type>::content_hash(const std::uint64_t keys[],
+                                                           size_type num_threads) const {
+    // translate the keys to our internal indices
+    std::vector<std::uint64_t> local_keys;
+    local_keys.reserve(variables_.size());
+    for (const auto& v : variables_) {
+        local_keys.emplace_back(keys ? keys[v] : hashing::key(v));
+    }
+
+    return base_type::biases_content_hash(local_keys.data(), num_threads);
+}
+
 template <class bias_type, class index_type>
 template <class Iter>
 bias_type Expression<bias_type, index_type>::energy(Iter sample_start) const {
@@ -507,6 +727,7 @@ bias_type Expression<bias_type, index_type>::energy(Iter sample_start) const {
 template <class bias_type, class index_type>
 bias_type Expression<bias_type, index_type>::linear(index_type v) const {
     auto it = indices_.find(v);
+    DIMOD_STATS_INCREMENT(this->stats_, hash_lookups);
     if (it == indices_.end()) {
         assert(v >= 0 && static_cast<size_type>(v) < parent_->num_variables());
         return 0;
@@ -522,7 +743,9 @@ bias_type Expression<bias_type, index_type>::lower_bound(index_type v) const {
 template <class bias_type, class index_type>
 bias_type Expression<bias_type, index_type>::quadratic(index_type u, index_type v) const {
     auto uit = indices_.find(u);
+    DIMOD_STATS_INCREMENT(this->stats_, hash_lookups);
     auto vit = indices_.find(v);
+    DIMOD_STATS_INCREMENT(this->stats_, hash_lookups);
     if (uit == indices_.end() || vit == indices_.end()) {
         assert(u >= 0 && static_cast<size_type>(u) < parent_->num_variables());
         assert(v >= 0 && static_cast<size_type>(v) < parent_->num_variables());
@@ -534,7 +757,9 @@ bias_type Expression<bias_type, index_type>::quadratic(index_type u, index_type
 template <class bias_type, class index_type>
 bias_type Expression<bias_type, index_type>::quadratic_at(index_type u, index_type v) const {
     auto uit = indices_.find(u);
+    DIMOD_STATS_INCREMENT(this->stats_, hash_lookups);
     auto vit = indices_.find(v);
+    DIMOD_STATS_INCREMENT(this->stats_, hash_lookups);
     if (uit == indices_.end() || vit == indices_.end()) {
         throw std::out_of_range("given variables have no interaction");
     }
@@ -551,6 +776,7 @@ template <class bias_type, class index_type>
 typename Expression<bias_type, index_type>::size_type
 Expression<bias_type, index_type>::num_interactions(index_type v) const {
     auto it = indices_.find(v);
+    DIMOD_STATS_INCREMENT(this->stats_, hash_lookups);
     if (it == indices_.end()) {
         assert(v >= 0 && static_cast<size_type>(v) < parent_->num_variables());
         return 0;
@@ -558,12 +784,33 @@ Expression<bias_type, index_type>::num_interactions(index_type v) const {
     return base_type::num_interactions(it->second);
 }
 
+template <class bias_type, class index_type>
+void Expression<bias_type, index_type>::permute(const std::vector<index_type>& permutation) {
+    base_type::permute(permutation);
+    undo_variables();
+
+    std::vector<index_type> variables(variables_.size());
+    for (size_type i = 0; i < permutation.size(); ++i) {
+        variables[permutation[i]] = variables_[i];
+    }
+    variables_.swap(variables);
+
+    for (size_type i = 0; i < variables_.size(); ++i) {
+        indices_[variables_[i]] = i;
+    }
+}
+
 template <class bias_type, class index_type>
 void Expression<bias_type, index_type>::reindex_variables(index_type v) {
+    // the labels of the variables above v change
+    if (auto journal = this->journal()) journal->invalidate();
+    undo_variables();
+
     size_type start = variables_.size();  // the start of the indices that need to change
 
     // see if v is present
     auto it = indices_.find(v);
+    DIMOD_STATS_INCREMENT(this->stats_, hash_lookups);
     if (it != indices_.end()) {
         start = it->second;
         base_type::remove_variable(it->second);
@@ -598,6 +845,7 @@ template <class bias_type, class index_type>
 void Expression<bias_type, index_type>::relabel_variables(std::vector<index_type> labels) {
     assert(labels.size() == base_type::num_variables());
 
+    undo_variables();
     variables_ = std::move(labels);
 
     indices_.clear();
@@ -610,7 +858,9 @@ void Expression<bias_type, index_type>::relabel_variables(std::vector<index_type
 template <class bias_type, class index_type>
 bool Expression<bias_type, index_type>::remove_interaction(index_type u, index_type v) {
     auto uit = indices_.find(u);
+    DIMOD_STATS_INCREMENT(this->stats_, hash_lookups);
     auto vit = indices_.find(v);
+    DIMOD_STATS_INCREMENT(this->stats_, hash_lookups);
     if (uit == indices_.end() || vit == indices_.end()) {
         return false;
     }
@@ -622,12 +872,14 @@ void Expression<bias_type, index_type>::remove_variable(index_type v) {
     assert(v >= 0 && static_cast<size_type>(v) < parent_->num_variables());
 
     auto vit = indices_.find(v);
+    DIMOD_STATS_INCREMENT(this->stats_, hash_lookups);
     if (vit == indices_.end()) return;  // nothing to remove
 
     // remove the biases
     base_type::remove_variable(vit->second);
 
     // update the indices
+    undo_variables();
     auto it = variables_.erase(variables_.begin() + vit->second);
     indices_.erase(vit);
     for (; it != variables_.end(); ++it) {
@@ -642,6 +894,7 @@ void Expression<bias_type, index_type>::remove_variables(Iter first, Iter last)
     std::vector<index_type> to_remove;
     for (auto it = first; it != last; ++it) {
         auto search = indices_.find(*it);
+        DIMOD_STATS_INCREMENT(this->stats_, hash_lookups);
         if (search != indices_.end()) {
             to_remove.emplace_back(search->second);
         }
@@ -649,6 +902,7 @@ void Expression<bias_type, index_type>::remove_variables(Iter first, Iter last)
     std::sort(to_remove.begin(), to_remove.end());
 
     // remove the indices from variables_ and the underlying
+    undo_variables();
     variables_.erase(utils::remove_by_index(variables_.begin(), variables_.end(), to_remove.begin(),
                                             to_remove.end()),
                      variables_.end());
@@ -663,6 +917,50 @@ void Expression<bias_type, index_type>::remove_variables(Iter first, Iter last)
     }
 }
 
+template <class bias_type, class index_type>
+void Expression<bias_type, index_type>::reserve(index_type num_variables,
+                                                size_type num_interactions_hint) {
+    base_type::reserve(num_variables, num_interactions_hint);
+    variables_.reserve(num_variables);
+    indices_.reserve(num_variables);
+}
+
+template <class bias_type, class index_type>
+template <class T>
+void Expression<bias_type, index_type>::reserve_interactions(const T degrees[],
+                                                             index_type num_variables) {
+    // translate the parent's degrees into ours
+    std::vector<T> local_degrees(variables_.size(), 0);
+    for (size_type i = 0; i < variables_.size(); ++i) {
+        if (variables_[i] < num_variables) local_degrees[i] = degrees[variables_[i]];
+    }
+    base_type::reserve_interactions(local_degrees.data(),
+                                    static_cast<index_type>(local_degrees.size()));
+}
+
+template <class bias_type, class index_type>
+void Expression<bias_type, index_type>::rollback() {
+    base_type::rollback();
+
+    auto& undo = *variables_undo_ptr_;
+    if (undo.saved_all()) {
+        undo.restore(variables_);
+
+        indices_.clear();
+        for (size_type i = 0, end = variables_.size(); i < end; ++i) {
+            indices_[variables_[i]] = i;
+        }
+    } else {
+        // only variables were added, so only they need to be forgotten
+        for (size_type i = undo.size(); i < variables_.size(); ++i) {
+            indices_.erase(variables_[i]);
+        }
+        undo.restore(variables_);
+    }
+
+    variables_undo_ptr_.reset();
+}
+
 template <class bias_type, class index_type>
 void Expression<bias_type, index_type>::set_linear(index_type v, bias_type bias) {
     base_type::set_linear(enforce_variable(v), bias);
@@ -681,10 +979,18 @@ bool Expression<bias_type, index_type>::shares_variables(const Expression& other
     return false;
 }
 
+template <class bias_type, class index_type>
+void Expression<bias_type, index_type>::shrink_to_fit() {
+    base_type::shrink_to_fit();
+    variables_.shrink_to_fit();
+    indices_.rehash(0);
+}
+
 template <class bias_type, class index_type>
 void Expression<bias_type, index_type>::substitute_variable(index_type v, bias_type multiplier,
                                                             bias_type offset) {
     auto it = indices_.find(v);
+    DIMOD_STATS_INCREMENT(this->stats_, hash_lookups);
     if (it == indices_.end()) {
         assert(v >= 0 && static_cast<size_type>(v) < parent_->num_variables());
         return;
@@ -692,6 +998,37 @@ void Expression<bias_type, index_type>::substitute_variable(index_type v, bias_t
     return base_type::substitute_variable(it->second, multiplier, offset);
 }
 
+template <class bias_type, class index_type>
+void Expression<bias_type, index_type>::substitute_variables(
+        const std::vector<bias_type>& multipliers, const std::vector<bias_type>& offsets) {
+    assert(multipliers.size() == parent_->num_variables());
+    assert(offsets.size() == parent_->num_variables());
+
+    std::vector<bias_type> local_multipliers;
+    std::vector<bias_type> local_offsets;
+    local_multipliers.reserve(variables_.size());
+    local_offsets.reserve(variables_.size());
+
+    bool identity = true;
+    for (const auto& v : variables_) {
+        local_multipliers.push_back(multipliers[v]);
+        local_offsets.push_back(offsets[v]);
+        identity = identity && multipliers[v] == 1 && offsets[v] == 0;
+    }
+
+    // don't bother walking the biases if none of our variables are affected
+    if (identity) return;
+
+    base_type::substitute_variables(local_multipliers, local_offsets);
+}
+
+template <class bias_type, class index_type>
+template <class Ptr, class Ind, class T>
+void Expression<bias_type, index_type>::to_csr(Ptr indptr[], Ind indices[], T data[]) const {
+    // the underlying model is already stored in terms of our variables
+    base_type::to_csr(indptr, indices, data);
+}
+
 template <class bias_type, class index_type>
 bias_type Expression<bias_type, index_type>::upper_bound(index_type v) const {
     return parent_->upper_bound(v);
@@ -0,0 +1,181 @@
+// Copyright 2023 D-Wave Systems Inc.
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace dimod {
+
+/**
+ * A record of which parts of a model have changed since a checkpoint.
+ *
+ * A journal records what was touched, not the values, so the changes since
+ * the checkpoint are the current values of the recorded terms. Together with
+ * the variables added after the checkpoint, this is enough to bring a copy of
+ * the model as it was at the checkpoint up to date.
+ *
+ * Changes that reindex or rewrite the whole model, like removing a variable
+ * or scaling the model, cannot be expressed this way. They invalidate the
+ * journal, after which nothing more is recorded.
+ *
+ * Each record takes constant amortized time. Variables are indexed as they
+ * are in the model at the time of the change, which is the same as in the
+ * current model because any reindexing invalidates the journal.
+ */
+template <class Index>
+class Journal {
+ public:
+    /// The template parameter (`Index`).
+    using index_type = Index;
+
+    /// Unsigned integer type that can represent non-negative values.
+    using size_type = std::size_t;
+
+    /// Start a journal of a model with `num_variables` variables and
+    /// `num_constraints` constraints.
+    explicit Journal(size_type num_variables = 0, size_type num_constraints = 0)
+            : num_variables_(num_variables),
+              num_constraints_(num_constraints),
+              valid_(true),
+              offset_(false),
+              attributes_(false),
+              quadratic_compacted_(0) {}
+
+    /// Return true if attributes other than the biases, such as the sense or
+    /// right-hand side of a constraint, have changed.
+    bool attributes_changed() const { return attributes_; }
+
+    /// Return true if anything may have changed since the checkpoint, that is
+    /// if a change was recorded or the journal is invalid.
+    bool changed() const {
+        return !valid_ || offset_ || attributes_ || !linear_.empty() || !quadratic_.empty() ||
+               !variables_.empty();
+    }
+
+    /// Stop recording and discard the records. The changes since the
+    /// checkpoint can no longer be determined.
+    void invalidate() {
+        valid_ = false;
+        linear_.clear();
+        linear_.shrink_to_fit();
+        linear_marks_.clear();
+        linear_marks_.shrink_to_fit();
+        quadratic_.clear();
+        quadratic_.shrink_to_fit();
+        variables_.clear();
+        variables_.shrink_to_fit();
+        variable_marks_.clear();
+        variable_marks_.shrink_to_fit();
+    }
+
+    /// Return the variables whose linear bias has changed, in ascending order.
+    std::vector<index_type> linear() const { return sorted(linear_); }
+
+    /// Return the number of constraints at the checkpoint.
+    size_type num_constraints() const { return num_constraints_; }
+
+    /// Return the number of variables at the checkpoint.
+    size_type num_variables() const { return num_variables_; }
+
+    /// Return true if the offset has changed.
+    bool offset_changed() const { return offset_; }
+
+    /// Return the interactions `(u, v)`, with `u <= v`, whose bias has
+    /// changed, in ascending order. Includes interactions that were added or
+    /// removed.
+    std::vector<std::pair<index_type, index_type>> quadratic() const {
+        auto quadratic = quadratic_;
+        std::sort(quadratic.begin(), quadratic.end());
+        quadratic.erase(std::unique(quadratic.begin(), quadratic.end()), quadratic.end());
+        return quadratic;
+    }
+
+    /// Record a change to an attribute other than the biases.
+    void record_attributes() { attributes_ = true; }
+
+    /// Record a change to the linear bias of `v`.
+    void record_linear(index_type v) { record(v, linear_, linear_marks_); }
+
+    /// Record a change to the offset.
+    void record_offset() { offset_ = true; }
+
+    /// Record a change to the bias of the interaction between `u` and `v`.
+    void record_quadratic(index_type u, index_type v) {
+        assert(u >= 0 && v >= 0);
+        if (!valid_) return;
+        if (v < u) std::swap(u, v);
+        quadratic_.emplace_back(u, v);
+
+        // the same interaction can be changed many times, so remove the
+        // duplicates whenever the records have doubled
+        if (quadratic_.size() >= 2 * quadratic_compacted_ + 1024) {
+            std::sort(quadratic_.begin(), quadratic_.end());
+            quadratic_.erase(std::unique(quadratic_.begin(), quadratic_.end()), quadratic_.end());
+            quadratic_compacted_ = quadratic_.size();
+        }
+    }
+
+    /// Record a change to the variable type or bounds of `v`.
+    void record_variable(index_type v) { record(v, variables_, variable_marks_); }
+
+    /// Return true if the journal has recorded every change since the checkpoint.
+    bool valid() const { return valid_; }
+
+    /// Return the variables whose variable type or bounds have changed, in
+    /// ascending order.
+    std::vector<index_type> variables() const { return sorted(variables_); }
+
+ private:
+    void record(index_type v, std::vector<index_type>& records, std::vector<bool>& marks) {
+        assert(v >= 0);
+        if (!valid_) return;
+        if (static_cast<size_type>(v) >= marks.size()) {
+            marks.resize(std::max<size_type>(v + 1, 2 * marks.size()));
+        }
+        if (!marks[v]) {
+            marks[v] = true;
+            records.push_back(v);
+        }
+    }
+
+    static std::vector<index_type> sorted(std::vector<index_type> records) {
+        std::sort(records.begin(), records.end());
+        return records;
+    }
+
+    size_type num_variables_;
+    size_type num_constraints_;
+
+    bool valid_;
+    bool offset_;
+    bool attributes_;
+
+    // each variable is recorded once, its mark prevents duplicates
+    std::vector<index_type> linear_;
+    std::vector<bool> linear_marks_;
+
+    std::vector<index_type> variables_;
+    std::vector<bool> variable_marks_;
+
+    // interactions can be recorded more than once, see record_quadratic()
+    std::vector<std::pair<index_type, index_type>> quadratic_;
+    size_type quadratic_compacted_;
+};
+
+}  // namespace dimod
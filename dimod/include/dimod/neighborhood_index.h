@@ -0,0 +1,156 @@
+// Copyright 2023 D-Wave Systems Inc.
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace dimod {
+
+/**
+ * A hash table mapping the neighbors of a variable to their positions in its
+ * neighborhood.
+ *
+ * The index is a snapshot of the neighborhood when it was built, kept up to
+ * date by `insert()` as neighbors are appended. Inserting or removing
+ * neighbors elsewhere shifts their positions without updating the index, so
+ * the position returned by `find()` must always be checked against the
+ * neighborhood before it is used. A position that does not check out means
+ * the index is stale and the caller should fall back to a binary search.
+ */
+template <class Index>
+class NeighborhoodIndex {
+ public:
+    /// The template parameter (`Index`).
+    using index_type = Index;
+
+    /// Unsigned integer type that can represent non-negative values.
+    using size_type = std::size_t;
+
+    /// Returned by `find()` for variables that are not in the index.
+    static constexpr size_type npos = std::numeric_limits<size_type>::max();
+
+    NeighborhoodIndex() : slots_(), mask_(0), size_(0), misses_(0) {}
+
+    /// Index the given neighborhood, which must be sorted and have unique neighbors.
+    template <class Neighborhood>
+    void build(const Neighborhood& neighborhood) {
+        // keep the load factor at or below 1/2 so the probe sequences are short
+        size_type capacity = 2;
+        while (capacity < 2 * neighborhood.size()) capacity *= 2;
+
+        slots_.assign(capacity, Slot{-1, 0});
+        mask_ = capacity - 1;
+        size_ = 0;
+        misses_ = 0;
+
+        for (size_type pos = 0; pos < neighborhood.size(); ++pos) {
+            place(neighborhood[pos].v, pos);
+        }
+    }
+
+    /// Discard the index, e.g. because it has gone stale. `find()` returns
+    /// `npos` until it is rebuilt.
+    void clear() {
+        slots_.clear();
+        mask_ = 0;
+        size_ = 0;
+        misses_ = 0;
+    }
+
+    /// Return true if the index is empty, either never built or cleared.
+    bool empty() const { return slots_.empty(); }
+
+    /// Return the position of `v` when the index was built, or `npos`.
+    size_type find(index_type v) const {
+        if (slots_.empty()) return npos;
+
+        for (size_type i = slot(v);; i = (i + 1) & mask_) {
+            if (slots_[i].v == v) return slots_[i].pos;
+            if (slots_[i].v < 0) return npos;
+        }
+    }
+
+    /**
+     * Add `v` at position `pos`, which must be the end of the neighborhood.
+     *
+     * The other positions are unaffected, so this keeps an up to date index
+     * up to date. Does nothing if the index is empty.
+     */
+    void insert(index_type v, size_type pos) {
+        if (slots_.empty()) return;
+
+        if (2 * (size_ + 1) > slots_.size()) {
+            // double the table to keep the load factor at or below 1/2
+            std::vector<Slot> old(2 * slots_.size(), Slot{-1, 0});
+            old.swap(slots_);
+            mask_ = slots_.size() - 1;
+            size_ = 0;
+            for (const Slot& s : old) {
+                if (s.v >= 0) place(s.v, s.pos);
+            }
+        }
+
+        place(v, pos);
+    }
+
+    /// Record a lookup that the index could not answer and return the total since it was built.
+    size_type miss() { return ++misses_; }
+
+    /// Total bytes consumed by the index.
+    size_type nbytes(bool capacity = false) const {
+        return (capacity ? slots_.capacity() : slots_.size()) * sizeof(Slot);
+    }
+
+ private:
+    struct Slot {
+        index_type v;  // negative for an empty slot
+        index_type pos;
+    };
+
+    // Fibonacci hashing, which spreads the runs of consecutive labels that
+    // are typical of a neighborhood
+    size_type slot(index_type v) const {
+        return static_cast<size_type>((static_cast<std::uint64_t>(v) * 11400714819323198485ull) >>
+                                      32) &
+               mask_;
+    }
+
+    // add `v` to the table, which must have an empty slot
+    void place(index_type v, size_type pos) {
+        assert(v >= 0);
+
+        size_type i = slot(v);
+        while (slots_[i].v >= 0) i = (i + 1) & mask_;
+        slots_[i] = Slot{v, static_cast<index_type>(pos)};
+        ++size_;
+    }
+
+    std::vector<Slot> slots_;
+    size_type mask_;
+
+    // the number of occupied slots
+    size_type size_;
+
+    size_type misses_;
+};
+
+template <class Index>
+constexpr typename NeighborhoodIndex<Index>::size_type NeighborhoodIndex<Index>::npos;
+
+}  // namespace dimod
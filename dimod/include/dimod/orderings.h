@@ -0,0 +1,113 @@
+// Copyright 2023 D-Wave Systems Inc.
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+
+#pragma once
+
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+#include "dimod/abc.h"
+
+namespace dimod {
+
+// Variable orderings for use with QuadraticModelBase::reorder().
+//
+// Each function returns a vector `order` such that `order[i]` is the
+// (current) index of the variable that should become variable `i`.
+
+/**
+ * Order the variables of `qm` by their degree.
+ *
+ * Ties are broken by the current index, so the ordering is deterministic.
+ */
+template <class bias_type, class index_type>
+std::vector<index_type> degree_order(const abc::QuadraticModelBase<bias_type, index_type>& qm,
+                                     bool descending = false) {
+    std::vector<index_type> order(qm.num_variables());
+    std::iota(order.begin(), order.end(), 0);
+
+    std::vector<std::size_t> degrees(qm.num_variables());
+    for (std::size_t v = 0; v < degrees.size(); ++v) {
+        degrees[v] = qm.num_interactions(v);
+    }
+
+    if (descending) {
+        std::stable_sort(order.begin(), order.end(), [&degrees](index_type u, index_type v) {
+            return degrees[u] > degrees[v];
+        });
+    } else {
+        std::stable_sort(order.begin(), order.end(), [&degrees](index_type u, index_type v) {
+            return degrees[u] < degrees[v];
+        });
+    }
+
+    return order;
+}
+
+/**
+ * Order the variables of `qm` using the reverse Cuthill-McKee algorithm.
+ *
+ * The resulting ordering reduces the bandwidth of the model's interaction
+ * matrix, so neighboring variables are more likely to be stored near each
+ * other. Each connected component is traversed breadth-first, starting from
+ * its lowest-degree variable and visiting neighbors in increasing degree.
+ */
+template <class bias_type, class index_type>
+std::vector<index_type> reverse_cuthill_mckee(
+        const abc::QuadraticModelBase<bias_type, index_type>& qm) {
+    std::vector<std::size_t> degrees(qm.num_variables());
+    for (std::size_t v = 0; v < degrees.size(); ++v) {
+        degrees[v] = qm.num_interactions(v);
+    }
+    auto by_degree = [&degrees](index_type u, index_type v) { return degrees[u] < degrees[v]; };
+
+    // candidate starting variables, one is used per connected component
+    std::vector<index_type> starts = degree_order(qm);
+
+    std::vector<bool> visited(qm.num_variables(), false);
+
+    // the order doubles as the queue for the breadth-first search
+    std::vector<index_type> order;
+    order.reserve(qm.num_variables());
+
+    std::size_t head = 0;
+    for (const auto& start : starts) {
+        if (visited[start]) continue;
+
+        visited[start] = true;
+        order.push_back(start);
+
+        for (; head < order.size(); ++head) {
+            auto first = order.size();
+
+            auto end = qm.cend_neighborhood(order[head]);
+            for (auto it = qm.cbegin_neighborhood(order[head]); it != end; ++it) {
+                if (!visited[it->v]) {
+                    visited[it->v] = true;
+                    order.push_back(it->v);
+                }
+            }
+
+            // neighborhoods are sorted by index so this also breaks ties by index
+            std::stable_sort(order.begin() + first, order.end(), by_degree);
+        }
+    }
+
+    std::reverse(order.begin(), order.end());
+
+    return order;
+}
+
+}  // namespace dimod
@@ -0,0 +1,50 @@
+// Copyright 2023 D-Wave Systems Inc.
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+
+#pragma once
+
+#include <type_traits>
+
+// Extended-precision accumulation.
+//
+// When dimod is compiled with DIMOD_EXTENDED_PRECISION defined, sums of biases
+// computed by the models (energies, substitutions and merges) are accumulated
+// in a wider floating point type and rounded to the bias type once, at the end.
+// This lets float models store their biases compactly without the sums
+// drifting. Otherwise sums are accumulated in the bias type.
+
+namespace dimod {
+
+/// The type used to accumulate sums of values of type `T`.
+template <class T>
+struct accumulator {
+    using type = T;
+};
+
+#ifdef DIMOD_EXTENDED_PRECISION
+template <>
+struct accumulator<float> {
+    using type = double;
+};
+
+template <>
+struct accumulator<double> {
+    using type = long double;
+};
+#endif
+
+template <class T>
+using accumulator_t = typename accumulator<T>::type;
+
+}  // namespace dimod
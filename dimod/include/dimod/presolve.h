@@ -0,0 +1,810 @@
+// Copyright 2023 D-Wave Systems Inc.
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <numeric>
+#include <tuple>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "dimod/constrained_quadratic_model.h"
+#include "dimod/vartypes.h"
+
+namespace dimod {
+namespace presolve {
+
+/**
+ * A constraint in a canonical form that is the same for all constraints that
+ * are positive or negative multiples of each other.
+ *
+ * The terms are sorted by variable and divided by the first nonzero bias,
+ * `scale`. The offset is moved to the right-hand side, which is divided by
+ * `scale` as well. If `scale` is negative, the sense is flipped.
+ */
+template <class Bias, class Index>
+struct NormalizedConstraint {
+    /// First template parameter (`Bias`).
+    using bias_type = Bias;
+
+    /// Second template parameter (`Index`).
+    using index_type = Index;
+
+    /// The `(u, v, bias / scale)` terms. Linear terms have `v == -1`.
+    std::vector<std::tuple<index_type, index_type, bias_type>> terms;
+
+    /// The first nonzero bias, or 0 if there are no nonzero biases.
+    bias_type scale;
+
+    /// The sense, flipped if `scale` is negative.
+    Sense sense;
+
+    /// `(rhs - offset) / scale`.
+    bias_type rhs;
+
+    /// A hash of the `terms`.
+    std::size_t hash;
+
+    explicit NormalizedConstraint(const Constraint<bias_type, index_type>& constraint);
+};
+
+/**
+ * Find the hard constraints that are positive or negative multiples of each
+ * other, ignoring their sense and right-hand side.
+ *
+ * Candidates are grouped by the hash of their `NormalizedConstraint` and then
+ * compared exactly. Returns the groups of two or more constraints, each
+ * sorted by index.
+ */
+template <class bias_type, class index_type>
+std::vector<std::vector<index_type>> find_parallel_constraints(
+        const ConstrainedQuadraticModel<bias_type, index_type>& cqm);
+
+/// Restores samples of a presolved model to samples of the original model.
+template <class Index, class Assignment>
+class PostSolver {
+ public:
+    /// Type of the variable indices.
+    using index_type = Index;
+
+    /// Type of the values the variables are fixed to.
+    using assignment_type = Assignment;
+
+    /// Unsigned integer type that can represent non-negative values.
+    using size_type = std::size_t;
+
+    /**
+     * Return the sample of the original model corresponding to `sample`, a
+     * sample of the presolved model.
+     *
+     * The behavior of this function is undefined when `sample` does not have
+     * one value for each variable of the presolved model.
+     */
+    template <class T>
+    std::vector<T> apply(std::vector<T> sample) const;
+
+    /**
+     * Record that `variables` were fixed to `values` and removed from a model
+     * with `num_variables` variables. `variables` must be sorted.
+     */
+    void fix_variables(size_type num_variables, std::vector<index_type> variables,
+                       std::vector<assignment_type> values);
+
+    /// Return the total number of variables that have been fixed.
+    size_type num_fixed() const;
+
+ private:
+    struct Fixing {
+        size_type num_variables;
+        std::vector<index_type> variables;
+        std::vector<assignment_type> values;
+    };
+
+    // applied in reverse order
+    std::vector<Fixing> stack_;
+};
+
+/**
+ * Reduce a constrained quadratic model.
+ *
+ * The presolver applies the following reductions until none of them changes
+ * the model:
+ *
+ * - Empty constraints are checked and removed.
+ * - Of each group of parallel hard constraints, as found by
+ *   `find_parallel_constraints()`, only the tightest ones are kept. Parallel
+ *   inequalities whose right-hand sides meet are merged into an equality.
+ * - The bounds of integer, binary and spin variables are tightened using the
+ *   minimum and maximum activity of the hard linear constraints they appear
+ *   in. This also fixes variables forced by singleton and one-hot constraints.
+ *   When a bound changes, the activities of the constraints containing the
+ *   variable are updated incrementally.
+ * - Linear constraints that are satisfied by any assignment within the
+ *   bounds are removed.
+ * - Variables that appear in no constraint and only linearly in the
+ *   objective are fixed to the bound that minimizes the objective.
+ * - Variables with equal lower and upper bounds are fixed and removed.
+ *
+ * Each fixing is recorded by the `postsolver()`, which restores samples of
+ * the presolved model to samples of the original model.
+ */
+template <class Bias, class Index = int, class Assignment = double>
+class Presolver {
+ public:
+    /// First template parameter (`Bias`).
+    using bias_type = Bias;
+
+    /// Second template parameter (`Index`).
+    using index_type = Index;
+
+    /// Third template parameter (`Assignment`).
+    using assignment_type = Assignment;
+
+    /// Unsigned integer type that can represent non-negative values.
+    using size_type = std::size_t;
+
+    /// Type of the model being presolved.
+    using model_type = ConstrainedQuadraticModel<bias_type, index_type>;
+
+    /// Tolerance used when comparing activities to right-hand sides.
+    static constexpr double FEASIBILITY_TOLERANCE = 1e-6;
+
+    /// Maximum number of times each constraint is propagated, on average, per round.
+    static constexpr size_type MAX_PROPAGATION_PASSES = 100;
+
+    Presolver();
+
+    /// Construct a presolver for `model`.
+    explicit Presolver(model_type model);
+
+    /**
+     * Apply the reductions until none of them changes the model. Return true
+     * if the model was changed.
+     *
+     * If the model is found to be infeasible, `infeasible()` is set and no
+     * further reductions are made.
+     */
+    bool apply();
+
+    /// Move the model out of the presolver, leaving it with an empty model.
+    model_type detach_model();
+
+    /// Return true if presolve has found the model to be infeasible.
+    bool infeasible() const;
+
+    /// Return the presolved model.
+    const model_type& model() const;
+
+    /// Return the index in the original model of each constraint of the presolved model.
+    const std::vector<index_type>& original_constraints() const;
+
+    /// Return the index in the original model of each variable of the presolved model.
+    const std::vector<index_type>& original_variables() const;
+
+    /// Return the postsolver, which restores samples of the presolved model.
+    const PostSolver<index_type, assignment_type>& postsolver() const;
+
+ private:
+    // The minimum and maximum activity of a linear expression, not counting
+    // the unbounded terms, and the number of unbounded terms on each side.
+    struct Activity {
+        bias_type min = 0;
+        bias_type max = 0;
+        size_type num_unbounded_min = 0;
+        size_type num_unbounded_max = 0;
+    };
+
+    // the working bounds of a variable, an unbounded side is at the limit
+    // of the vartype
+    struct Bounds {
+        bias_type lb;
+        bias_type ub;
+        bool lb_unbounded;
+        bool ub_unbounded;
+    };
+
+    // add the contribution of `bias * v` to `activity`, or remove it if
+    // `sign` is -1
+    static void contribute(Activity& activity, bias_type bias, const Bounds& bounds, int sign);
+
+    // whether `lhs (sense) rhs` holds within the tolerance
+    static bool satisfied(bias_type lhs, Sense sense, bias_type rhs);
+
+    // Tighten the bounds of the variables in hard linear constraint `c`.
+    // Returns false if the model is found to be infeasible.
+    bool propagate(index_type c, std::vector<Bounds>& bounds, std::vector<Activity>& activities,
+                   const std::vector<std::vector<std::pair<index_type, bias_type>>>& columns,
+                   std::vector<index_type>& queue, std::vector<bool>& queued) const;
+
+    // remove the constraints `c` with `remove[c]` set
+    void remove_constraints(const std::vector<bool>& remove);
+
+    // keep only the tightest constraint(s) of each group of parallel
+    // constraints, returns true if the model changed
+    bool remove_parallel_constraints();
+
+    // one pass of all of the reductions, returns true if the model changed
+    bool round();
+
+    model_type model_;
+    PostSolver<index_type, assignment_type> postsolver_;
+
+    std::vector<index_type> constraints_;
+    std::vector<index_type> variables_;
+
+    bool infeasible_;
+};
+
+template <class bias_type, class index_type>
+NormalizedConstraint<bias_type, index_type>::NormalizedConstraint(
+        const Constraint<bias_type, index_type>& constraint)
+        : terms(), scale(0), sense(constraint.sense()), rhs(0), hash(0) {
+    const abc::QuadraticModelBase<bias_type, index_type>& expression = constraint;
+
+    for (std::size_t i = 0; i < constraint.num_variables(); ++i) {
+        if (!expression.linear(i)) continue;
+        terms.emplace_back(constraint.variables()[i], -1, expression.linear(i));
+    }
+    for (auto it = constraint.cbegin_quadratic(); it != constraint.cend_quadratic(); ++it) {
+        if (!it->bias) continue;
+        terms.emplace_back(std::min(it->u, it->v), std::max(it->u, it->v), it->bias);
+    }
+    std::sort(terms.begin(), terms.end());
+
+    if (terms.empty()) return;
+
+    scale = std::get<2>(terms.front());
+    for (auto& term : terms) {
+        std::get<2>(term) /= scale;
+
+        // combine the hashes as boost::hash_combine does
+        hash ^= std::hash<index_type>()(std::get<0>(term)) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+        hash ^= std::hash<index_type>()(std::get<1>(term)) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+        hash ^= std::hash<bias_type>()(std::get<2>(term)) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+    }
+
+    rhs = (constraint.rhs() - constraint.offset()) / scale;
+
+    if (scale < 0) {
+        if (sense == Sense::LE) {
+            sense = Sense::GE;
+        } else if (sense == Sense::GE) {
+            sense = Sense::LE;
+        }
+    }
+}
+
+template <class bias_type, class index_type>
+std::vector<std::vector<index_type>> find_parallel_constraints(
+        const ConstrainedQuadraticModel<bias_type, index_type>& cqm) {
+    std::vector<NormalizedConstraint<bias_type, index_type>> normalized;
+    normalized.reserve(cqm.num_constraints());
+
+    // group the candidates by hash
+    std::unordered_map<std::size_t, std::vector<index_type>> buckets;
+    for (std::size_t c = 0; c < cqm.num_constraints(); ++c) {
+        normalized.emplace_back(cqm.constraint_ref(c));
+        if (cqm.constraint_ref(c).is_soft() || normalized.back().terms.empty()) continue;
+        buckets[normalized.back().hash].push_back(c);
+    }
+
+    // then split each bucket by the exact terms
+    std::vector<std::vector<index_type>> groups;
+    for (auto& bucket : buckets) {
+        auto& candidates = bucket.second;
+        while (candidates.size() > 1) {
+            const auto& terms = normalized[candidates.front()].terms;
+
+            auto split = std::stable_partition(
+                    candidates.begin(), candidates.end(),
+                    [&](index_type c) { return normalized[c].terms == terms; });
+
+            if (split - candidates.begin() > 1) groups.emplace_back(candidates.begin(), split);
+            candidates.erase(candidates.begin(), split);
+        }
+    }
+
+    // bucket order is unspecified, so sort the groups by their first constraint
+    std::sort(groups.begin(), groups.end());
+    return groups;
+}
+
+template <class index_type, class assignment_type>
+template <class T>
+std::vector<T> PostSolver<index_type, assignment_type>::apply(std::vector<T> sample) const {
+    std::vector<T> full;
+    for (auto it = stack_.rbegin(); it != stack_.rend(); ++it) {
+        assert(sample.size() + it->variables.size() == it->num_variables);
+
+        full.clear();
+        full.reserve(it->num_variables);
+
+        size_type f = 0;  // position in the fixed variables
+        size_type s = 0;  // position in the sample
+        for (size_type v = 0; v < it->num_variables; ++v) {
+            if (f < it->variables.size() && static_cast<size_type>(it->variables[f]) == v) {
+                full.push_back(it->values[f]);
+                ++f;
+            } else {
+                full.push_back(sample[s]);
+                ++s;
+            }
+        }
+
+        sample.swap(full);
+    }
+    return sample;
+}
+
+template <class index_type, class assignment_type>
+void PostSolver<index_type, assignment_type>::fix_variables(size_type num_variables,
+                                                            std::vector<index_type> variables,
+                                                            std::vector<assignment_type> values) {
+    assert(variables.size() == values.size());
+    assert(std::is_sorted(variables.begin(), variables.end()));
+    stack_.push_back(Fixing{num_variables, std::move(variables), std::move(values)});
+}
+
+template <class index_type, class assignment_type>
+std::size_t PostSolver<index_type, assignment_type>::num_fixed() const {
+    size_type count = 0;
+    for (const auto& fixing : stack_) count += fixing.variables.size();
+    return count;
+}
+
+template <class bias_type, class index_type, class assignment_type>
+constexpr double Presolver<bias_type, index_type, assignment_type>::FEASIBILITY_TOLERANCE;
+
+template <class bias_type, class index_type, class assignment_type>
+constexpr std::size_t Presolver<bias_type, index_type, assignment_type>::MAX_PROPAGATION_PASSES;
+
+template <class bias_type, class index_type, class assignment_type>
+Presolver<bias_type, index_type, assignment_type>::Presolver() : Presolver(model_type()) {}
+
+template <class bias_type, class index_type, class assignment_type>
+Presolver<bias_type, index_type, assignment_type>::Presolver(model_type model)
+        : model_(std::move(model)),
+          postsolver_(),
+          constraints_(model_.num_constraints()),
+          variables_(model_.num_variables()),
+          infeasible_(false) {
+    std::iota(constraints_.begin(), constraints_.end(), 0);
+    std::iota(variables_.begin(), variables_.end(), 0);
+}
+
+template <class bias_type, class index_type, class assignment_type>
+bool Presolver<bias_type, index_type, assignment_type>::apply() {
+    bool changed = false;
+    while (!infeasible_ && round()) changed = true;
+    return changed;
+}
+
+template <class bias_type, class index_type, class assignment_type>
+void Presolver<bias_type, index_type, assignment_type>::contribute(Activity& activity,
+                                                                   bias_type bias,
+                                                                   const Bounds& bounds,
+                                                                   int sign) {
+    if (bias == 0) return;
+
+    // the bounds that give the minimum and the maximum of bias * v
+    bias_type min_bound = bias > 0 ? bounds.lb : bounds.ub;
+    bias_type max_bound = bias > 0 ? bounds.ub : bounds.lb;
+    bool min_unbounded = bias > 0 ? bounds.lb_unbounded : bounds.ub_unbounded;
+    bool max_unbounded = bias > 0 ? bounds.ub_unbounded : bounds.lb_unbounded;
+
+    if (min_unbounded) {
+        activity.num_unbounded_min += sign;
+    } else {
+        activity.min += sign * bias * min_bound;
+    }
+
+    if (max_unbounded) {
+        activity.num_unbounded_max += sign;
+    } else {
+        activity.max += sign * bias * max_bound;
+    }
+}
+
+template <class bias_type, class index_type, class assignment_type>
+typename Presolver<bias_type, index_type, assignment_type>::model_type
+Presolver<bias_type, index_type, assignment_type>::detach_model() {
+    using std::swap;
+    model_type model;
+    swap(model, model_);
+    return model;
+}
+
+template <class bias_type, class index_type, class assignment_type>
+bool Presolver<bias_type, index_type, assignment_type>::infeasible() const {
+    return infeasible_;
+}
+
+template <class bias_type, class index_type, class assignment_type>
+const ConstrainedQuadraticModel<bias_type, index_type>&
+Presolver<bias_type, index_type, assignment_type>::model() const {
+    return model_;
+}
+
+template <class bias_type, class index_type, class assignment_type>
+const std::vector<index_type>&
+Presolver<bias_type, index_type, assignment_type>::original_constraints() const {
+    return constraints_;
+}
+
+template <class bias_type, class index_type, class assignment_type>
+const std::vector<index_type>& Presolver<bias_type, index_type, assignment_type>::original_variables()
+        const {
+    return variables_;
+}
+
+template <class bias_type, class index_type, class assignment_type>
+const PostSolver<index_type, assignment_type>&
+Presolver<bias_type, index_type, assignment_type>::postsolver() const {
+    return postsolver_;
+}
+
+template <class bias_type, class index_type, class assignment_type>
+bool Presolver<bias_type, index_type, assignment_type>::propagate(
+        index_type c, std::vector<Bounds>& bounds, std::vector<Activity>& activities,
+        const std::vector<std::vector<std::pair<index_type, bias_type>>>& columns,
+        std::vector<index_type>& queue, std::vector<bool>& queued) const {
+    const auto& constraint = model_.constraint_ref(c);
+    const abc::QuadraticModelBase<bias_type, index_type>& expression = constraint;
+
+    const bias_type rhs = constraint.rhs() - constraint.offset();
+    const Sense sense = constraint.sense();
+
+    for (size_type i = 0; i < constraint.num_variables(); ++i) {
+        const index_type v = constraint.variables()[i];
+        const bias_type bias = expression.linear(i);
+
+        const Vartype vartype = model_.vartype(v);
+        if (vartype == Vartype::REAL || bias == 0) continue;
+
+        const Activity& activity = activities[c];
+        Bounds& vbounds = bounds[v];
+
+        // the activity of the rest of the constraint
+        Activity rest = activity;
+        contribute(rest, bias, vbounds, -1);
+
+        bias_type lb = vbounds.lb;
+        bias_type ub = vbounds.ub;
+
+        if ((sense == Sense::LE || sense == Sense::EQ) && !rest.num_unbounded_min) {
+            // bias * v <= rhs - rest.min
+            bias_type limit = (rhs - rest.min) / bias;
+            if (bias > 0) {
+                ub = std::min(ub, static_cast<bias_type>(std::floor(limit + FEASIBILITY_TOLERANCE)));
+            } else {
+                lb = std::max(lb, static_cast<bias_type>(std::ceil(limit - FEASIBILITY_TOLERANCE)));
+            }
+        }
+        if ((sense == Sense::GE || sense == Sense::EQ) && !rest.num_unbounded_max) {
+            // bias * v >= rhs - rest.max
+            bias_type limit = (rhs - rest.max) / bias;
+            if (bias > 0) {
+                lb = std::max(lb, static_cast<bias_type>(std::ceil(limit - FEASIBILITY_TOLERANCE)));
+            } else {
+                ub = std::min(ub, static_cast<bias_type>(std::floor(limit + FEASIBILITY_TOLERANCE)));
+            }
+        }
+
+        if (vartype == Vartype::SPIN) {
+            // spin variables can only take the values -1 and +1
+            if (lb > -1) lb = +1;
+            if (ub < +1) ub = -1;
+        }
+
+        if (lb > ub) return false;
+
+        if (lb == vbounds.lb && ub == vbounds.ub) continue;
+
+        // update the activity of every constraint that v appears in
+        Bounds tightened{lb, ub, vbounds.lb_unbounded && lb == vbounds.lb,
+                         vbounds.ub_unbounded && ub == vbounds.ub};
+        for (const auto& term : columns[v]) {
+            contribute(activities[term.first], term.second, vbounds, -1);
+            contribute(activities[term.first], term.second, tightened, +1);
+
+            if (!queued[term.first]) {
+                queued[term.first] = true;
+                queue.push_back(term.first);
+            }
+        }
+        vbounds = tightened;
+    }
+
+    return true;
+}
+
+template <class bias_type, class index_type, class assignment_type>
+void Presolver<bias_type, index_type, assignment_type>::remove_constraints(
+        const std::vector<bool>& remove) {
+    assert(remove.size() == model_.num_constraints());
+
+    std::unordered_set<const Constraint<bias_type, index_type>*> removed;
+    std::vector<index_type> constraints;
+    for (size_type c = 0; c < remove.size(); ++c) {
+        if (remove[c]) {
+            removed.insert(&model_.constraint_ref(c));
+        } else {
+            constraints.push_back(constraints_[c]);
+        }
+    }
+    model_.remove_constraints_if([&removed](const Constraint<bias_type, index_type>& constraint) {
+        return removed.count(&constraint);
+    });
+    constraints_.swap(constraints);
+}
+
+template <class bias_type, class index_type, class assignment_type>
+bool Presolver<bias_type, index_type, assignment_type>::remove_parallel_constraints() {
+    auto groups = find_parallel_constraints(model_);
+    if (groups.empty()) return false;
+
+    bool changed = false;
+    std::vector<bool> remove(model_.num_constraints(), false);
+    for (const auto& group : groups) {
+        // the tightest upper (LE or EQ) and lower (GE or EQ) constraints,
+        // compared in the normalized form
+        index_type upper = -1;
+        index_type lower = -1;
+        bias_type upper_rhs = std::numeric_limits<bias_type>::infinity();
+        bias_type lower_rhs = -std::numeric_limits<bias_type>::infinity();
+
+        for (const index_type c : group) {
+            NormalizedConstraint<bias_type, index_type> normalized(model_.constraint_ref(c));
+            if (normalized.sense != Sense::GE && normalized.rhs < upper_rhs) {
+                upper = c;
+                upper_rhs = normalized.rhs;
+            }
+            if (normalized.sense != Sense::LE && normalized.rhs > lower_rhs) {
+                lower = c;
+                lower_rhs = normalized.rhs;
+            }
+        }
+
+        if (lower_rhs > upper_rhs + FEASIBILITY_TOLERANCE) {
+            infeasible_ = true;
+            return false;
+        }
+
+        // keep an equality constraint on its own, it implies the others. We
+        // only ever change the sense, never the right-hand side, so the
+        // biases of the kept constraints are unchanged
+        if (upper >= 0 && model_.constraint_ref(upper).sense() == Sense::EQ) {
+            lower = -1;
+        } else if (lower >= 0 && model_.constraint_ref(lower).sense() == Sense::EQ) {
+            upper = -1;
+        } else if (upper >= 0 && lower >= 0 && lower_rhs >= upper_rhs - FEASIBILITY_TOLERANCE) {
+            model_.constraint_ref(upper).set_sense(Sense::EQ);
+            lower = -1;
+            changed = true;
+        }
+
+        for (const index_type c : group) {
+            if (c != upper && c != lower) {
+                remove[c] = true;
+                changed = true;
+            }
+        }
+    }
+
+    if (changed) remove_constraints(remove);
+
+    return changed;
+}
+
+template <class bias_type, class index_type, class assignment_type>
+bool Presolver<bias_type, index_type, assignment_type>::round() {
+    bool changed = remove_parallel_constraints();
+    if (infeasible_) return false;
+
+    const size_type num_variables = model_.num_variables();
+    const size_type num_constraints = model_.num_constraints();
+
+    // the working bounds
+    std::vector<Bounds> bounds;
+    bounds.reserve(num_variables);
+    for (size_type v = 0; v < num_variables; ++v) {
+        const Vartype vartype = model_.vartype(v);
+        const bias_type lb = model_.lower_bound(v);
+        const bias_type ub = model_.upper_bound(v);
+        // binary and spin variables are always bounded, integer and real
+        // variables are unbounded at the limits of their vartype
+        const bool limited = vartype == Vartype::INTEGER || vartype == Vartype::REAL;
+        bounds.push_back(Bounds{lb, ub, limited && lb <= vartype_info<bias_type>::min(vartype),
+                                limited && ub >= vartype_info<bias_type>::max(vartype)});
+    }
+
+    // the hard linear constraints each variable appears in, with its bias
+    std::vector<std::vector<std::pair<index_type, bias_type>>> columns(num_variables);
+
+    // whether each variable appears in any constraint
+    std::vector<bool> constrained(num_variables, false);
+
+    std::vector<Activity> activities(num_constraints);
+    std::vector<bool> remove(num_constraints, false);
+
+    std::vector<index_type> queue;
+    std::vector<bool> queued(num_constraints, false);
+
+    for (size_type c = 0; c < num_constraints; ++c) {
+        const auto& constraint = model_.constraint_ref(c);
+
+        for (const auto& v : constraint.variables()) constrained[v] = true;
+
+        if (!constraint.num_variables()) {
+            // empty constraints are either always or never satisfied
+            if (satisfied(constraint.offset(), constraint.sense(), constraint.rhs())) {
+                remove[c] = true;
+            } else if (!constraint.is_soft()) {
+                infeasible_ = true;
+                return false;
+            }
+            continue;
+        }
+
+        if (!constraint.is_linear() || constraint.is_soft()) continue;
+
+        const abc::QuadraticModelBase<bias_type, index_type>& expression = constraint;
+        for (size_type i = 0; i < constraint.num_variables(); ++i) {
+            const index_type v = constraint.variables()[i];
+            columns[v].emplace_back(c, expression.linear(i));
+            contribute(activities[c], expression.linear(i), bounds[v], +1);
+        }
+
+        queued[c] = true;
+        queue.push_back(c);
+    }
+
+    // tighten the bounds until they no longer change. Bounds can converge
+    // slowly, so the work per round is limited and the next round continues
+    size_type budget = MAX_PROPAGATION_PASSES * num_constraints;
+    while (!queue.empty() && budget--) {
+        index_type c = queue.back();
+        queue.pop_back();
+        queued[c] = false;
+
+        if (!propagate(c, bounds, activities, columns, queue, queued)) {
+            infeasible_ = true;
+            return false;
+        }
+    }
+
+    // remove the linear constraints that are always satisfied, and check the
+    // hard ones for infeasibility
+    for (size_type c = 0; c < num_constraints; ++c) {
+        const auto& constraint = model_.constraint_ref(c);
+        if (!constraint.num_variables() || !constraint.is_linear()) continue;
+
+        Activity activity;
+        if (constraint.is_soft()) {
+            const abc::QuadraticModelBase<bias_type, index_type>& expression = constraint;
+            for (size_type i = 0; i < constraint.num_variables(); ++i) {
+                contribute(activity, expression.linear(i), bounds[constraint.variables()[i]], +1);
+            }
+        } else {
+            activity = activities[c];
+        }
+
+        const bias_type rhs = constraint.rhs() - constraint.offset();
+        const Sense sense = constraint.sense();
+
+        bool min_satisfied = !activity.num_unbounded_min &&
+                             activity.min >= rhs - FEASIBILITY_TOLERANCE;
+        bool max_satisfied = !activity.num_unbounded_max &&
+                             activity.max <= rhs + FEASIBILITY_TOLERANCE;
+
+        if ((sense == Sense::LE && max_satisfied) || (sense == Sense::GE && min_satisfied) ||
+            (sense == Sense::EQ && min_satisfied && max_satisfied)) {
+            remove[c] = true;
+        }
+
+        if (constraint.is_soft()) continue;
+
+        if ((sense != Sense::GE && !activity.num_unbounded_min &&
+             activity.min > rhs + FEASIBILITY_TOLERANCE) ||
+            (sense != Sense::LE && !activity.num_unbounded_max &&
+             activity.max < rhs - FEASIBILITY_TOLERANCE)) {
+            infeasible_ = true;
+            return false;
+        }
+    }
+
+    // variables that appear in no constraint and only linearly in the
+    // objective can be fixed to whichever bound minimizes the objective
+    for (size_type v = 0; v < num_variables; ++v) {
+        if (constrained[v] || model_.objective.num_interactions(v)) continue;
+
+        const bias_type bias = model_.objective.linear(v);
+        if (bias >= 0 && !bounds[v].lb_unbounded) {
+            bounds[v].ub = bounds[v].lb;
+        } else if (bias <= 0 && !bounds[v].ub_unbounded) {
+            bounds[v].lb = bounds[v].ub;
+        }
+    }
+
+    // apply the bounds, collecting the fixed variables
+    std::vector<index_type> fixed;
+    std::vector<assignment_type> values;
+    for (size_type v = 0; v < num_variables; ++v) {
+        if (bounds[v].lb == bounds[v].ub) {
+            fixed.push_back(v);
+            values.push_back(bounds[v].lb);
+        } else if (model_.vartype(v) == Vartype::INTEGER) {
+            if (bounds[v].lb != model_.lower_bound(v)) {
+                model_.set_lower_bound(v, bounds[v].lb);
+                changed = true;
+            }
+            if (bounds[v].ub != model_.upper_bound(v)) {
+                model_.set_upper_bound(v, bounds[v].ub);
+                changed = true;
+            }
+        }
+    }
+
+    // remove the constraints
+    if (std::find(remove.begin(), remove.end(), true) != remove.end()) {
+        remove_constraints(remove);
+        changed = true;
+    }
+
+    // fix the variables
+    if (fixed.size()) {
+        model_ = model_.fix_variables(fixed.begin(), fixed.end(), values.begin());
+
+        std::vector<index_type> variables;
+        variables.reserve(variables_.size() - fixed.size());
+        auto fit = fixed.begin();
+        for (size_type v = 0; v < num_variables; ++v) {
+            if (fit != fixed.end() && static_cast<size_type>(*fit) == v) {
+                ++fit;
+            } else {
+                variables.push_back(variables_[v]);
+            }
+        }
+        variables_.swap(variables);
+
+        postsolver_.fix_variables(num_variables, std::move(fixed), std::move(values));
+        changed = true;
+    }
+
+    return changed;
+}
+
+template <class bias_type, class index_type, class assignment_type>
+bool Presolver<bias_type, index_type, assignment_type>::satisfied(bias_type lhs, Sense sense,
+                                                                  bias_type rhs) {
+    switch (sense) {
+        case Sense::LE:
+            return lhs <= rhs + FEASIBILITY_TOLERANCE;
+        case Sense::GE:
+            return lhs >= rhs - FEASIBILITY_TOLERANCE;
+        case Sense::EQ:
+            return std::abs(lhs - rhs) <= FEASIBILITY_TOLERANCE;
+    }
+    return false;
+}
+
+}  // namespace presolve
+}  // namespace dimod
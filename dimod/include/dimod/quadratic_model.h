@@ -15,12 +15,14 @@
 #pragma once
 
 #include <algorithm>
+#include <memory>
 #include <stdexcept>
 #include <utility>
 #include <vector>
 
 #include "dimod/abc.h"
 #include "dimod/binary_quadratic_model.h"
+#include "dimod/transaction.h"
 #include "dimod/vartypes.h"
 
 namespace dimod {
@@ -43,11 +45,19 @@ class QuadraticModel : public abc::QuadraticModelBase<Bias, Index> {
 
     QuadraticModel();
 
+    QuadraticModel(const QuadraticModel& other);
+
+    QuadraticModel(QuadraticModel&& other) = default;
+
     explicit QuadraticModel(const BinaryQuadraticModel<bias_type, index_type>& bqm);
 
     template <class B, class I>
     explicit QuadraticModel(const BinaryQuadraticModel<B, I>& bqm);
 
+    QuadraticModel& operator=(const QuadraticModel& other);
+
+    QuadraticModel& operator=(QuadraticModel&& other) = default;
+
     /// Add variable of type `vartype`.
     index_type add_variable(Vartype vartype);
 
@@ -60,11 +70,31 @@ class QuadraticModel : public abc::QuadraticModelBase<Bias, Index> {
     /// Add `n` variables of type `vartype` with lower bound `lb` and upper bound `ub`.
     index_type add_variables(Vartype vartype, index_type n, bias_type lb, bias_type ub);
 
+    /// Start a transaction, see `QuadraticModelBase::begin_transaction()`.
+    /// The variable types and bounds are saved along with the biases.
+    void begin_transaction();
+
     void clear();
 
+    /// Keep the changes made since `begin_transaction()`.
+    void commit();
+
     /// Change the vartype of `v`, updating the biases appropriately.
     void change_vartype(Vartype vartype, index_type v);
 
+    /**
+     * Change the vartype of each of `variables` to `vartype`, updating the
+     * biases appropriately.
+     *
+     * The biases are updated in a single pass over the model, rather than
+     * once per variable as with repeated calls to `change_vartype()`.
+     *
+     * # Exceptions
+     * Throws a `std::logic_error` if any of the vartype changes are not
+     * supported, in which case the model is not modified.
+     */
+    void change_vartypes(Vartype vartype, const std::vector<index_type>& variables);
+
     /**
      * Remove variable `v` from the model by fixing its value.
      *
@@ -74,6 +104,11 @@ class QuadraticModel : public abc::QuadraticModelBase<Bias, Index> {
     template <class T>
     void fix_variable(index_type v, T assignment);
 
+    /// Remove several variables by fixing their values, see
+    /// `QuadraticModelBase::fix_variables()`.
+    void fix_variables(const std::vector<index_type>& variables,
+                       const std::vector<bias_type>& assignments);
+
     /// Return the lower bound on variable ``v``.
     bias_type lower_bound(index_type v) const;
 
@@ -85,12 +120,23 @@ class QuadraticModel : public abc::QuadraticModelBase<Bias, Index> {
      */
     size_type nbytes(bool capacity = false) const;
 
+    /// Permute the variables, see `QuadraticModelBase::permute()`.
+    void permute(const std::vector<index_type>& permutation);
+
     /// Remove variable `v`.
     void remove_variable(index_type v);
 
     /// Remove variables.
     void remove_variables(const std::vector<index_type>& variables);
 
+    /// Reserve capacity for at least `num_variables` variables, see
+    /// `QuadraticModelBase::reserve()`.
+    void reserve(index_type num_variables, size_type num_interactions_hint = 0);
+
+    /// Undo the changes made since `begin_transaction()`, including the
+    /// changes to the variable types and bounds.
+    void rollback();
+
     // Resize the model to contain `n` variables.
     void resize(index_type n);
 
@@ -118,6 +164,9 @@ class QuadraticModel : public abc::QuadraticModelBase<Bias, Index> {
     /// Set the variable type of variable `v`.
     void set_vartype(index_type v, Vartype vartype);
 
+    /// Release any capacity reserved beyond the current size of the model.
+    void shrink_to_fit();
+
     // todo: substitute_variable with vartype/bounds support
 
     /// Return the upper bound on variable ``v``.
@@ -153,11 +202,32 @@ class QuadraticModel : public abc::QuadraticModelBase<Bias, Index> {
     };
 
     std::vector<varinfo_type> varinfo_;
+
+    // The undo log of varinfo_ during a transaction, or null. Not copied
+    // with the model.
+    std::unique_ptr<UndoLog<varinfo_type, index_type>> varinfo_undo_ptr_;
+
+    // Record a change to the vartype or bounds of v, if there is a journal
+    void journal_variable(index_type v) {
+        if (auto journal = this->journal()) journal->record_variable(v);
+    }
+
+    // Save the vartype and bounds about to change, if there is a transaction
+    void undo_variable(index_type v) {
+        if (varinfo_undo_ptr_) varinfo_undo_ptr_->save(varinfo_, v);
+    }
+    void undo_variables() {
+        if (varinfo_undo_ptr_) varinfo_undo_ptr_->save_all(varinfo_);
+    }
 };
 
 template <class bias_type, class index_type>
 QuadraticModel<bias_type, index_type>::QuadraticModel() : base_type(), varinfo_() {}
 
+template <class bias_type, class index_type>
+QuadraticModel<bias_type, index_type>::QuadraticModel(const QuadraticModel& other)
+        : base_type(other), varinfo_(other.varinfo_) {}
+
 template <class bias_type, class index_type>
 QuadraticModel<bias_type, index_type>::QuadraticModel(
         const BinaryQuadraticModel<bias_type, index_type>& bqm)
@@ -180,6 +250,17 @@ QuadraticModel<bias_type, index_type>::QuadraticModel(const BinaryQuadraticModel
     this->set_offset(bqm.offset());
 }
 
+template <class bias_type, class index_type>
+QuadraticModel<bias_type, index_type>& QuadraticModel<bias_type, index_type>::operator=(
+        const QuadraticModel& other) {
+    if (this != &other) {
+        base_type::operator=(other);
+        undo_variables();
+        varinfo_ = other.varinfo_;
+    }
+    return *this;
+}
+
 template <class bias_type, class index_type>
 index_type QuadraticModel<bias_type, index_type>::add_variable(Vartype vartype) {
     varinfo_.emplace_back(vartype);
@@ -206,12 +287,25 @@ index_type QuadraticModel<bias_type, index_type>::add_variables(Vartype vartype,
     return base_type::add_variables(n);
 }
 
+template <class bias_type, class index_type>
+void QuadraticModel<bias_type, index_type>::begin_transaction() {
+    base_type::begin_transaction();
+    varinfo_undo_ptr_.reset(new UndoLog<varinfo_type, index_type>(varinfo_.size()));
+}
+
 template <class bias_type, class index_type>
 void QuadraticModel<bias_type, index_type>::clear() {
+    undo_variables();
     varinfo_.clear();
     base_type::clear();
 }
 
+template <class bias_type, class index_type>
+void QuadraticModel<bias_type, index_type>::commit() {
+    base_type::commit();
+    varinfo_undo_ptr_.reset();
+}
+
 template <class bias_type, class index_type>
 void QuadraticModel<bias_type, index_type>::change_vartype(Vartype vartype, index_type v) {
     const Vartype& source = this->vartype(v);
@@ -219,7 +313,12 @@ void QuadraticModel<bias_type, index_type>::change_vartype(Vartype vartype, inde
 
     if (source == target) {
         return;
-    } else if (source == Vartype::SPIN && target == Vartype::BINARY) {
+    }
+
+    undo_variable(v);
+    journal_variable(v);
+
+    if (source == Vartype::SPIN && target == Vartype::BINARY) {
         base_type::substitute_variable(v, 2, -1);
         this->varinfo_[v].lb = 0;
         this->varinfo_[v].ub = 1;
@@ -242,13 +341,77 @@ void QuadraticModel<bias_type, index_type>::change_vartype(Vartype vartype, inde
     }
 }
 
+template <class bias_type, class index_type>
+void QuadraticModel<bias_type, index_type>::change_vartypes(
+        Vartype vartype, const std::vector<index_type>& variables) {
+    // each variable is substituted with multiplier * v + offset
+    std::vector<bias_type> multipliers(this->num_variables(), 1);
+    std::vector<bias_type> offsets(this->num_variables(), 0);
+
+    // check that all of the changes are supported before making any of them
+    bool substitute = false;
+    for (const auto& v : variables) {
+        const Vartype& source = this->vartype(v);
+
+        if (source == vartype) {
+            continue;
+        } else if (source == Vartype::SPIN &&
+                   (vartype == Vartype::BINARY || vartype == Vartype::INTEGER)) {
+            multipliers[v] = 2;
+            offsets[v] = -1;
+            substitute = true;
+        } else if (source == Vartype::BINARY && vartype == Vartype::SPIN) {
+            multipliers[v] = .5;
+            offsets[v] = .5;
+            substitute = true;
+        } else if (source == Vartype::BINARY && vartype == Vartype::INTEGER) {
+            // nothing need to change except the vartype itself
+        } else {
+            // todo: there are more we could support
+            throw std::logic_error("unsupported vartype change");
+        }
+    }
+
+    if (substitute) base_type::substitute_variables(multipliers, offsets);
+
+    for (const auto& v : variables) {
+        if (varinfo_[v].vartype == vartype) continue;
+
+        undo_variable(v);
+        journal_variable(v);
+
+        // SPIN and BINARY both become {0, 1} when converted to INTEGER
+        varinfo_[v].lb = (vartype == Vartype::SPIN) ? -1 : 0;
+        varinfo_[v].ub = +1;
+        varinfo_[v].vartype = vartype;
+    }
+}
+
 template <class bias_type, class index_type>
 template <class T>
 void QuadraticModel<bias_type, index_type>::fix_variable(index_type v, T assignment) {
     base_type::fix_variable(v, assignment);
+    undo_variables();
     varinfo_.erase(varinfo_.begin() + v);
 }
 
+template <class bias_type, class index_type>
+void QuadraticModel<bias_type, index_type>::fix_variables(
+        const std::vector<index_type>& variables, const std::vector<bias_type>& assignments) {
+    base_type::fix_variables(variables, assignments);
+    if (!variables.size()) return;
+
+    std::vector<index_type> sorted_indices = variables;
+    std::sort(sorted_indices.begin(), sorted_indices.end());
+    sorted_indices.erase(std::unique(sorted_indices.begin(), sorted_indices.end()),
+                         sorted_indices.end());
+
+    undo_variables();
+    varinfo_.erase(utils::remove_by_index(varinfo_.begin(), varinfo_.end(), sorted_indices.begin(),
+                                          sorted_indices.end()),
+                   varinfo_.end());
+}
+
 template <class bias_type, class index_type>
 bias_type QuadraticModel<bias_type, index_type>::lower_bound(index_type v) const {
     // even though v is unused, we need this to conform the the QuadraticModelBase API
@@ -267,9 +430,22 @@ QuadraticModel<bias_type, index_type>::nbytes(bool capacity) const {
     return count;
 }
 
+template <class bias_type, class index_type>
+void QuadraticModel<bias_type, index_type>::permute(const std::vector<index_type>& permutation) {
+    base_type::permute(permutation);
+    undo_variables();
+
+    std::vector<varinfo_type> varinfo(varinfo_);
+    for (size_type v = 0; v < permutation.size(); ++v) {
+        varinfo[permutation[v]] = varinfo_[v];
+    }
+    varinfo_.swap(varinfo);
+}
+
 template <class bias_type, class index_type>
 void QuadraticModel<bias_type, index_type>::remove_variable(index_type v) {
     base_type::remove_variable(v);
+    undo_variables();
     varinfo_.erase(varinfo_.begin() + v);
 }
 
@@ -283,9 +459,24 @@ void QuadraticModel<bias_type, index_type>::remove_variables(const std::vector<i
         return;
     }
     base_type::remove_variables(variables);
+    undo_variables();
     varinfo_.erase(utils::remove_by_index(varinfo_.begin(), varinfo_.end(), variables.begin(), variables.end()), varinfo_.end());
 }
 
+template <class bias_type, class index_type>
+void QuadraticModel<bias_type, index_type>::reserve(index_type num_variables,
+                                                    size_type num_interactions_hint) {
+    base_type::reserve(num_variables, num_interactions_hint);
+    varinfo_.reserve(num_variables);
+}
+
+template <class bias_type, class index_type>
+void QuadraticModel<bias_type, index_type>::rollback() {
+    base_type::rollback();
+    varinfo_undo_ptr_->restore(varinfo_);
+    varinfo_undo_ptr_.reset();
+}
+
 template <class bias_type, class index_type>
 void QuadraticModel<bias_type, index_type>::resize(index_type n) {
     // we could do this as an assert, but let's be careful since
@@ -297,12 +488,14 @@ void QuadraticModel<bias_type, index_type>::resize(index_type n) {
     }
     // doesn't matter what vartype we specify since we're shrinking
     base_type::resize(n);
+    undo_variables();
     varinfo_.erase(varinfo_.begin() + n, varinfo_.end());
 }
 
 template <class bias_type, class index_type>
 void QuadraticModel<bias_type, index_type>::resize(index_type n, Vartype vartype) {
     base_type::resize(n);
+    if (static_cast<size_type>(n) < varinfo_.size()) undo_variables();
     varinfo_.resize(n, varinfo_type(vartype));
 }
 
@@ -310,23 +503,36 @@ template <class bias_type, class index_type>
 void QuadraticModel<bias_type, index_type>::resize(index_type n, Vartype vartype, bias_type lb,
                                                    bias_type ub) {
     assert(n > 0);
+    if (static_cast<size_type>(n) < varinfo_.size()) undo_variables();
     varinfo_.resize(n, varinfo_type(vartype, lb, ub));
     base_type::resize(n);
 }
 
 template <class bias_type, class index_type>
 void QuadraticModel<bias_type, index_type>::set_lower_bound(index_type v, bias_type lb) {
+    undo_variable(v);
     varinfo_[v].lb = lb;
+    journal_variable(v);
 }
 
 template <class bias_type, class index_type>
 void QuadraticModel<bias_type, index_type>::set_upper_bound(index_type v, bias_type ub) {
+    undo_variable(v);
     varinfo_[v].ub = ub;
+    journal_variable(v);
 }
 
 template <class bias_type, class index_type>
 void QuadraticModel<bias_type, index_type>::set_vartype(index_type v, Vartype vartype) {
+    undo_variable(v);
     varinfo_[v].vartype = vartype;
+    journal_variable(v);
+}
+
+template <class bias_type, class index_type>
+void QuadraticModel<bias_type, index_type>::shrink_to_fit() {
+    base_type::shrink_to_fit();
+    varinfo_.shrink_to_fit();
 }
 
 template <class bias_type, class index_type>
@@ -0,0 +1,108 @@
+// Copyright 2020 D-Wave Systems Inc.
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+
+// Hot-path instrumentation.
+//
+// When dimod is compiled with DIMOD_INSTRUMENTATION defined, each model counts
+// the events that dominate the cost of building and modifying it. Otherwise
+// the counters are not stored and the increments compile to nothing.
+//
+// Some of the events happen in const methods, which may be called from several
+// threads, so the counters are relaxed atomics.
+#ifdef DIMOD_INSTRUMENTATION
+#define DIMOD_STATS_INCREMENT(stats, event) \
+    ((void)(stats).event.fetch_add(1, std::memory_order_relaxed))
+#else
+#define DIMOD_STATS_INCREMENT(stats, event) ((void)0)
+#endif
+
+namespace dimod {
+
+/// Counts of the events performed by a model.
+///
+/// All counts are zero unless dimod is compiled with DIMOD_INSTRUMENTATION
+/// defined.
+struct Stats {
+    /// Binary searches of a variable's neighborhood.
+    std::size_t binary_searches = 0;
+
+    /// Insertions into a neighborhood other than at its end.
+    std::size_t mid_inserts = 0;
+
+    /// Insertions into a neighborhood that required it to reallocate.
+    std::size_t reallocations = 0;
+
+    /// Lookups of a variable in a hash index, either an expression's variable
+    /// index or the index of a high-degree neighborhood.
+    std::size_t hash_lookups = 0;
+
+    Stats& operator+=(const Stats& other) {
+        binary_searches += other.binary_searches;
+        mid_inserts += other.mid_inserts;
+        reallocations += other.reallocations;
+        hash_lookups += other.hash_lookups;
+        return *this;
+    }
+
+    /// Return true if dimod was compiled with instrumentation enabled.
+    static constexpr bool enabled() {
+#ifdef DIMOD_INSTRUMENTATION
+        return true;
+#else
+        return false;
+#endif
+    }
+};
+
+#ifdef DIMOD_INSTRUMENTATION
+/// The event counters stored by a model, see `Stats`.
+///
+/// Safe to increment concurrently. Copies start from zero, so the counts are
+/// not copied with the model.
+struct StatsCounters {
+    std::atomic<std::size_t> binary_searches{0};
+    std::atomic<std::size_t> mid_inserts{0};
+    std::atomic<std::size_t> reallocations{0};
+    std::atomic<std::size_t> hash_lookups{0};
+
+    StatsCounters() = default;
+    StatsCounters(const StatsCounters&) noexcept {}
+    StatsCounters& operator=(const StatsCounters&) noexcept { return *this; }
+
+    /// Return a snapshot of the counts.
+    Stats load() const {
+        Stats stats;
+        stats.binary_searches = binary_searches.load(std::memory_order_relaxed);
+        stats.mid_inserts = mid_inserts.load(std::memory_order_relaxed);
+        stats.reallocations = reallocations.load(std::memory_order_relaxed);
+        stats.hash_lookups = hash_lookups.load(std::memory_order_relaxed);
+        return stats;
+    }
+
+    /// Set all of the counts to zero.
+    void reset() {
+        binary_searches.store(0, std::memory_order_relaxed);
+        mid_inserts.store(0, std::memory_order_relaxed);
+        reallocations.store(0, std::memory_order_relaxed);
+        hash_lookups.store(0, std::memory_order_relaxed);
+    }
+};
+#endif
+
+}  // namespace dimod
@@ -0,0 +1,115 @@
+// Copyright 2023 D-Wave Systems Inc.
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace dimod {
+
+/**
+ * An undo log for the elements of a vector.
+ *
+ * The log is started with the size of the vector. Before an element that was
+ * present at the start is changed for the first time, its value is saved with
+ * `save()`. Before a change that reindexes or rewrites the whole vector, the
+ * vector is saved in full with `save_all()`, after which nothing more needs to
+ * be saved. Elements appended after the start do not need to be saved because
+ * `restore()` erases them.
+ *
+ * The cost of the log is proportional to the number of elements saved, or to
+ * the size of the vector once it has been saved in full.
+ */
+template <class T, class Index>
+class UndoLog {
+ public:
+    /// The type of the elements.
+    using value_type = T;
+
+    /// The second template parameter (`Index`).
+    using index_type = Index;
+
+    /// Unsigned integer type that can represent non-negative values.
+    using size_type = std::size_t;
+
+    /// Start an undo log of a vector with `size` elements.
+    explicit UndoLog(size_type size = 0) : size_(size), saved_all_(false) {}
+
+    /// Restore `values` to its state at the start of the log and clear the log.
+    void restore(std::vector<value_type>& values) {
+        if (saved_all_) {
+            values.swap(all_);
+            all_.clear();
+            saved_all_ = false;
+        }
+
+        // anything appended since the start, or since the vector was saved
+        assert(values.size() >= size_);
+        values.erase(values.begin() + size_, values.end());
+
+        // the elements saved before the vector was saved in full, if it was,
+        // are older than the full copy
+        for (auto& element : saved_) {
+            values[element.first] = std::move(element.second);
+        }
+        saved_.clear();
+        marks_.clear();
+    }
+
+    /// Save the value of `values[i]` if it has not been saved yet.
+    void save(const std::vector<value_type>& values, index_type i) {
+        assert(i >= 0);
+        if (saved_all_ || static_cast<size_type>(i) >= size_) return;
+        if (static_cast<size_type>(i) >= marks_.size()) {
+            marks_.resize(std::max<size_type>(i + 1, 2 * marks_.size()));
+        }
+        if (!marks_[i]) {
+            marks_[i] = true;
+            saved_.emplace_back(i, values[i]);
+        }
+    }
+
+    /// Save all of `values` if it has not been saved in full yet.
+    void save_all(const std::vector<value_type>& values) {
+        if (saved_all_) return;
+        saved_all_ = true;
+        all_ = values;
+
+        // we still need the elements already saved, but not their marks
+        marks_.clear();
+        marks_.shrink_to_fit();
+    }
+
+    /// Return true if the vector has been saved in full.
+    bool saved_all() const { return saved_all_; }
+
+    /// Return the size of the vector at the start of the log.
+    size_type size() const { return size_; }
+
+ private:
+    size_type size_;
+
+    // each element is saved once, its mark prevents duplicates
+    std::vector<std::pair<index_type, value_type>> saved_;
+    std::vector<bool> marks_;
+
+    bool saved_all_;
+    std::vector<value_type> all_;
+};
+
+}  // namespace dimod
@@ -14,5 +14,9 @@
 
 from dimod.libcpp.binary_quadratic_model cimport *
 from dimod.libcpp.constrained_quadratic_model cimport *
+from dimod.libcpp.content_hash cimport *
+from dimod.libcpp.journal cimport *
+from dimod.libcpp.orderings cimport *
 from dimod.libcpp.quadratic_model cimport *
+from dimod.libcpp.stats cimport *
 from dimod.libcpp.vartypes cimport *
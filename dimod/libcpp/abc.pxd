@@ -14,7 +14,12 @@
 #    See the License for the specific language governing permissions and
 #    limitations under the License.
 
+from libc.stdint cimport uint64_t
 from libcpp.utility cimport pair
+from libcpp.vector cimport vector
+from dimod.libcpp.content_hash cimport ContentHash
+from dimod.libcpp.journal cimport Journal
+from dimod.libcpp.stats cimport Stats
 from dimod.libcpp.vartypes cimport Vartype
 
 __all__ = ['BinaryQuadraticModelBase']
@@ -91,20 +96,26 @@ cdef extern from "dimod/abc.h" namespace "dimod::abc" nogil:
         # https://github.com/cython/cython/issues/1868
 
         void add_linear(index_type, bias_type)
+        void add_model[B, I](const QuadraticModelBase[B, I]&, const vector[Index]&)
         void add_offset(bias_type)
         void add_quadratic(index_type, index_type, bias_type)
         void add_quadratic_from_coo "add_quadratic" [ItRow, ItCol, ItBias](ItRow, ItCol, ItBias, index_type)
         void add_quadratic_back(index_type, index_type, bias_type)
         void add_quadratic_from_dense[T](const T dense[], index_type)
+        void add_quadratic_from_csr[Ptr, Ind, T](const Ptr[], const Ind[], const T[], index_type)
         const_neighborhood_iterator cbegin_neighborhood(index_type)
         const_neighborhood_iterator cend_neighborhood(index_type)
         const_quadratic_iterator cbegin_quadratic()
         const_quadratic_iterator cend_quadratic()
         void clear()
+        ContentHash content_hash(const uint64_t[], size_type)
         bias_type energy[Iter](Iter)
         void fix_variable[T](index_type, T)
+        void fix_variables(vector[Index], vector[Bias]) except+
         bint is_linear()
+        Journal[Index]* journal()
         bias_type linear(index_type)
+        void local_fields[T, Out](const T[], size_type, Out[], size_type)
         bias_type lower_bound(index_type)
         size_type nbytes()
         size_type nbytes(bint)
@@ -112,13 +123,23 @@ cdef extern from "dimod/abc.h" namespace "dimod::abc" nogil:
         size_type degree "num_interactions" (index_type)
         size_type num_variables()
         bias_type offset()
+        void permute(vector[Index])
         bias_type quadratic(index_type, index_type)
         bias_type quadratic_at(index_type, index_type) except+
         bint remove_interaction(index_type, index_type)
         void remove_variable(index_type)
+        void reorder(vector[Index])
+        void reserve(index_type, size_type)
+        void reserve_interactions[T](const T[], index_type)
+        void reset_stats()
         void scale(bias_type)
         void set_linear(index_type, bias_type)
         void set_offset(bias_type)
         void set_quadratic(index_type, index_type, bias_type) except+
+        void shrink_to_fit()
+        void start_journal()
+        Stats stats()
+        void stop_journal()
+        void to_csr[Ptr, Ind, T](Ptr[], Ind[], T[])
         bias_type upper_bound(index_type)
         Vartype vartype(index_type)
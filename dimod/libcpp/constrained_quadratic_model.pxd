@@ -14,12 +14,16 @@
 #    See the License for the specific language governing permissions and
 #    limitations under the License.
 
+from libc.stdint cimport uint64_t
 from libcpp.memory cimport weak_ptr
 from libcpp.vector cimport vector
 
 from dimod.libcpp.abc cimport QuadraticModelBase
 from dimod.libcpp.constraint cimport Constraint, Penalty, Sense
+from dimod.libcpp.content_hash cimport ContentHash
 from dimod.libcpp.expression cimport Expression
+from dimod.libcpp.journal cimport Journal
+from dimod.libcpp.stats cimport Stats
 from dimod.libcpp.vartypes cimport Vartype
 
 __all__ = ['ConstrainedQuadraticModel']
@@ -34,14 +38,19 @@ cdef extern from "dimod/constrained_quadratic_model.h" namespace "dimod" nogil:
         index_type add_constraint[B, I, T](QuadraticModelBase[B, I]&, Sense, bias_type, vector[T])
         index_type add_constraint(QuadraticModelBase[bias_type, index_type]&, Sense, bias_type, vector[index_type])
         index_type add_constraints(index_type)
+        index_type add_linear_constraints_from_arrays[Ptr, Ind, T](index_type, const Ptr[], const Ind[], const T[], const Sense[], const bias_type[])
+        index_type add_quadratic_constraints_from_arrays[Ptr, Ind, T, QPtr, QRow, QCol, QT](index_type, const Ptr[], const Ind[], const T[], const QPtr[], const QRow[], const QCol[], const QT[], const Sense[], const bias_type[])
         index_type add_variable(Vartype)
         index_type add_variable(Vartype, bias_type, bias_type)
         void change_vartype(Vartype, index_type) except+
+        void change_vartypes(Vartype, vector[index_type]) except+
         void clear()
         Constraint[bias_type, index_type]& constraint_ref(index_type)
         weak_ptr[Constraint[bias_type, index_type]] constraint_weak_ptr(index_type)
+        ContentHash content_hash(const uint64_t[], size_t)
         void fix_variable[T](index_type, T)
         ConstrainedQuadraticModel fix_variables[VarIter, AssignmentIter](VarIter, VarIter, AssignmentIter)
+        Journal[index_type]* journal()
         bias_type lower_bound(index_type)
         Constraint[bias_type, index_type] new_constraint()
         size_t num_constraints()
@@ -49,10 +58,18 @@ cdef extern from "dimod/constrained_quadratic_model.h" namespace "dimod" nogil:
         size_t num_variables()
         void remove_constraint(index_type)
         void remove_variable(index_type)
+        void reserve_constraints(size_t)
+        void reserve_variables(size_t)
+        void reset_stats()
         void set_lower_bound(index_type, bias_type)
         void set_objective[B, I](QuadraticModelBase[B, I]&)
         void set_objective[B, I, T](QuadraticModelBase[B, I]&, vector[T])
         void set_upper_bound(index_type, bias_type)
+        void set_vartype(index_type, Vartype)
+        void shrink_to_fit()
+        void start_journal()
+        Stats stats()
+        void stop_journal()
         void substitute_variable(index_type, bias_type, bias_type)
         bias_type upper_bound(index_type)
         Vartype vartype(index_type)
@@ -56,6 +56,7 @@ cdef extern from "dimod/expression.h" namespace "dimod" nogil:
             bint operator==(const_neighborhood_iterator)
             bint operator!=(const_neighborhood_iterator)
 
+        bint has_interaction(index_type, index_type)
         bint has_variable(index_type)
         bint is_disjoint(const Expression&)
         const vector[index_type]& variables()
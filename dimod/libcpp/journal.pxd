@@ -0,0 +1,37 @@
+# distutils: include_dirs = dimod/include/
+
+# Copyright 2023 D-Wave Systems Inc.
+#
+#    Licensed under the Apache License, Version 2.0 (the "License");
+#    you may not use this file except in compliance with the License.
+#    You may obtain a copy of the License at
+#
+#        http://www.apache.org/licenses/LICENSE-2.0
+#
+#    Unless required by applicable law or agreed to in writing, software
+#    distributed under the License is distributed on an "AS IS" BASIS,
+#    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+#    See the License for the specific language governing permissions and
+#    limitations under the License.
+
+from libcpp.utility cimport pair
+from libcpp.vector cimport vector
+
+__all__ = ['Journal']
+
+
+cdef extern from "dimod/journal.h" namespace "dimod" nogil:
+    cdef cppclass Journal[Index]:
+        ctypedef Index index_type
+        ctypedef size_t size_type
+
+        bint attributes_changed()
+        bint changed()
+        void invalidate()
+        vector[Index] linear()
+        size_type num_constraints()
+        size_type num_variables()
+        bint offset_changed()
+        vector[pair[Index, Index]] quadratic()
+        bint valid()
+        vector[Index] variables()
@@ -0,0 +1,26 @@
+# distutils: include_dirs = dimod/include/
+
+# Copyright 2023 D-Wave Systems Inc.
+#
+#    Licensed under the Apache License, Version 2.0 (the "License");
+#    you may not use this file except in compliance with the License.
+#    You may obtain a copy of the License at
+#
+#        http://www.apache.org/licenses/LICENSE-2.0
+#
+#    Unless required by applicable law or agreed to in writing, software
+#    distributed under the License is distributed on an "AS IS" BASIS,
+#    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+#    See the License for the specific language governing permissions and
+#    limitations under the License.
+
+from libcpp.vector cimport vector
+
+from dimod.libcpp.abc cimport QuadraticModelBase
+
+__all__ = ['degree_order', 'reverse_cuthill_mckee']
+
+
+cdef extern from "dimod/orderings.h" namespace "dimod" nogil:
+    vector[Index] degree_order[Bias, Index](const QuadraticModelBase[Bias, Index]&, bint)
+    vector[Index] reverse_cuthill_mckee[Bias, Index](const QuadraticModelBase[Bias, Index]&)
@@ -15,6 +15,7 @@
 #    limitations under the License.
 
 from libcpp.utility cimport pair
+from libcpp.vector cimport vector
 
 from dimod.libcpp.abc cimport QuadraticModelBase
 from dimod.libcpp.vartypes cimport Vartype
@@ -37,6 +38,7 @@ cdef extern from "dimod/quadratic_model.h" namespace "dimod" nogil:
         index_type add_variables(Vartype, index_type)
         index_type add_variables(Vartype, index_type, bias_type bias_type)
         void change_vartype(Vartype, index_type) except+
+        void change_vartypes(Vartype, vector[Index]) except+
         void resize(index_type) except+
         void resize(index_type, Vartype) except+
         void resize(index_type, Vartype, bias_type, bias_type)
@@ -0,0 +1,28 @@
+# distutils: include_dirs = dimod/include/
+
+# Copyright 2023 D-Wave Systems Inc.
+#
+#    Licensed under the Apache License, Version 2.0 (the "License");
+#    you may not use this file except in compliance with the License.
+#    You may obtain a copy of the License at
+#
+#        http://www.apache.org/licenses/LICENSE-2.0
+#
+#    Unless required by applicable law or agreed to in writing, software
+#    distributed under the License is distributed on an "AS IS" BASIS,
+#    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+#    See the License for the specific language governing permissions and
+#    limitations under the License.
+
+__all__ = ['Stats']
+
+
+cdef extern from "dimod/stats.h" namespace "dimod" nogil:
+    cdef cppclass Stats:
+        size_t binary_searches
+        size_t mid_inserts
+        size_t reallocations
+        size_t hash_lookups
+
+        @staticmethod
+        bint enabled()
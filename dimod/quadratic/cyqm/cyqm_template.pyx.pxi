@@ -106,6 +106,52 @@ cdef class cyQM_template(cyQMBase):
         while self.variables.size() < self.cppqm.num_variables():
             self.variables._append()
 
+    @cython.boundscheck(False)
+    @cython.wraparound(False)
+    def _ivarinfo_update(self, varinfo, labels=()):
+        """Set the vartype and bounds of variables, adding the new ones.
+
+        Args:
+            varinfo: A NumPy structured array with fields ``'v'``,
+                ``'vartype'``, ``'lb'`` and ``'ub'``, as returned by
+                :meth:`_idelta`. The records of the variables that are not
+                yet in the model must come last, in index order.
+            labels: The labels of the variables to add.
+
+        """
+        cdef const index_type[:] v_view = np.asarray(varinfo['v'], dtype=self.index_dtype)
+        cdef const np.int8_t[:] vartype_view = np.asarray(varinfo['vartype'], dtype=np.int8)
+        cdef const bias_type[:] lb_view = np.asarray(varinfo['lb'], dtype=self.dtype)
+        cdef const bias_type[:] ub_view = np.asarray(varinfo['ub'], dtype=self.dtype)
+
+        labels = list(labels)
+
+        # check everything before making any changes
+        cdef Py_ssize_t num_variables = self.num_variables()
+        cdef Py_ssize_t num_existing = v_view.shape[0] - len(labels)
+        cdef Py_ssize_t i
+        if num_existing < 0:
+            raise ValueError("there must be a record for each added variable")
+        for i in range(v_view.shape[0]):
+            if i < num_existing and not 0 <= v_view[i] < num_variables:
+                raise ValueError("varinfo refers to variables that are not in the model")
+            if i >= num_existing and v_view[i] != num_variables + i - num_existing:
+                raise ValueError("the added variables must be given in index order")
+            if not 0 <= vartype_view[i] <= <np.int8_t>cppVartype.REAL:
+                raise ValueError(f"unknown vartype: {vartype_view[i]}")
+        for v in labels:
+            if self.variables.count(v):
+                raise ValueError(f"variable {v!r} is already in the model")
+
+        for i in range(num_existing):
+            self.cppqm.set_vartype(v_view[i], <cppVartype>(vartype_view[i]))
+            self.cppqm.set_lower_bound(v_view[i], lb_view[i])
+            self.cppqm.set_upper_bound(v_view[i], ub_view[i])
+
+        for i in range(num_existing, v_view.shape[0]):
+            self.cppqm.add_variable(<cppVartype>(vartype_view[i]), lb_view[i], ub_view[i])
+            self.variables._append(labels[i - num_existing])
+
     def add_linear(self, v, bias_type bias, *,
                    default_vartype=None,
                    default_lower_bound=None,
@@ -274,6 +320,20 @@ cdef class cyQM_template(cyQMBase):
             raise TypeError(f"cannot change vartype {self.vartype(v).name!r} "
                             f"to {vartype.name!r}") from None
 
+    def change_vartypes(self, vartype, variables):
+        vartype = as_vartype(vartype, extended=True)
+
+        cdef vector[index_type] indices
+        for v in variables:
+            indices.push_back(self.variables.index(v))
+
+        try:
+            self.cppqm.change_vartypes(self.cppvartype(vartype), indices)
+        except RuntimeError:
+            # c++ logic_error, in which case the model is unchanged
+            raise TypeError("cannot change the vartypes of the given variables "
+                            f"to {vartype.name!r}") from None
+
     cdef cppVartype cppvartype(self, object vartype) except? cppVartype.SPIN:
         return cppvartype(vartype)
 
@@ -394,7 +454,7 @@ cdef class cyQM_template(cyQMBase):
 
     def update(self, cyBQM_and_QM other):
         # we'll need a mapping from the other's variables to ours
-        cdef vector[Py_ssize_t] mapping
+        cdef vector[index_type] mapping
         mapping.reserve(other.num_variables())
 
         cdef Py_ssize_t vi
@@ -435,23 +495,6 @@ cdef class cyQM_template(cyQMBase):
                               )
 
         # variables are in place!
-        
-        # the linear biases
-        for vi in range(mapping.size()):
-            self.cppqm.add_linear(mapping[vi], other.data().linear(vi))
-
-        # the quadratic biases
-        # dev note: for even more speed we could check that mapping is
-        # a range, and in that case can just add them without the indirection
-        # or the sorting.
-        it = other.data().cbegin_quadratic()
-        while it != other.data().cend_quadratic():
-            self.cppqm.add_quadratic(
-                mapping[deref(it).u],
-                mapping[deref(it).v],
-                deref(it).bias
-                )
-            inc(it)
 
-        # the offset
-        self.cppqm.add_offset(other.data().offset())
+        # the linear biases, quadratic biases and offset
+        self.cppqm.add_model(deref(other.base), mapping)
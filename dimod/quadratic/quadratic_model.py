@@ -50,6 +50,7 @@ except ImportError:
 
 from dimod.decorators import forwarding_method, unique_variable_labels
 from dimod.quadratic.cyqm import cyQM_float32, cyQM_float64
+from dimod.serialization.delta import apply_delta_biases, read_delta, write_delta
 from dimod.serialization.fileview import (
     SpooledTemporaryFile,
     _BytesIO,
@@ -584,6 +585,42 @@ class QuadraticModel(QuadraticViewsMixin):
                                   lower_bound=model.lower_bound(v),
                                   upper_bound=model.upper_bound(v))
 
+    def apply_delta(self, fp: Union[BinaryIO, ByteString]) -> None:
+        """Apply changes serialized by :meth:`to_delta`.
+
+        The quadratic model must be the same as the model the delta was made
+        from, as it was at its last :meth:`checkpoint`. After the delta is
+        applied, it is the same as the model when the delta was made.
+
+        Args:
+            fp: Bytes-like object or readable file-like object, as returned
+                by :meth:`to_delta`.
+
+        Raises:
+            ValueError: If the delta was made from a model of a different
+                type, or with a different number of variables at its
+                checkpoint, or if it adds variables that are already in the
+                model.
+
+        See :meth:`to_delta` for an example.
+
+        """
+        delta = read_delta(fp)
+
+        if delta.type != type(self).__name__:
+            raise ValueError(f"cannot apply a delta of a {delta.type} "
+                             f"to a {type(self).__name__}")
+        if delta.base_num_variables != self.num_variables:
+            raise ValueError(f"the delta was made from a model with "
+                             f"{delta.base_num_variables} variables, this model "
+                             f"has {self.num_variables}")
+
+        # the vartypes and bounds first, because they determine how the
+        # biases are stored
+        self.data._ivarinfo_update(delta.varinfo, delta.variables)
+
+        apply_delta_biases(self.data, delta)
+
     def change_vartype(self, vartype: VartypeLike, v: Variable) -> "QuadraticModel":
         """Change the variable type of the given variable, updating the biases.
 
@@ -616,10 +653,86 @@ class QuadraticModel(QuadraticViewsMixin):
         self.data.change_vartype(vartype, v)
         return self
 
+    def change_vartypes(self, vartype: VartypeLike, variables: Iterable[Variable]) -> "QuadraticModel":
+        """Change the variable type of the given variables, updating the biases.
+
+        The biases are updated in a single pass over the model, so this is
+        much faster than calling :meth:`.change_vartype` for each variable.
+
+        Args:
+            vartype: Variable type. One of:
+
+                * :class:`~dimod.Vartype.SPIN`, ``'SPIN'``, ``{-1, 1}``
+                * :class:`~dimod.Vartype.BINARY`, ``'BINARY'``, ``{0, 1}``
+                * :class:`~dimod.Vartype.INTEGER`, ``'INTEGER'``
+                * :class:`~dimod.Vartype.REAL`, ``'REAL'``
+
+            variables: Variables to change to the specified ``vartype``.
+
+        Raises:
+            TypeError: If any of the vartype changes are not supported. In this
+                case the model is not changed.
+
+        Example:
+            >>> qm = dimod.QuadraticModel({'a': 1, 'b': 2}, {}, 0, {'a': 'SPIN', 'b': 'SPIN'})
+            >>> qm.change_vartypes('BINARY', ['a', 'b'])
+            QuadraticModel({'a': 2.0, 'b': 4.0}, {}, -3.0, {'a': 'BINARY', 'b': 'BINARY'}, dtype='float64')
+
+        """
+        self.data.change_vartypes(vartype, variables)
+        return self
+
+    def checkpoint(self) -> None:
+        """Start recording the changes made to the quadratic model.
+
+        The changes made after the checkpoint can be serialized by
+        :meth:`to_delta` and applied to a copy of the model as it was at the
+        checkpoint by :meth:`apply_delta`. Calling this method again moves the
+        checkpoint to the current state of the model. The checkpoint is not
+        copied with the model.
+
+        Changes to individual biases, variable types and bounds, and adding
+        variables, are recorded. Changes that reindex or rewrite the whole
+        model, such as removing or relabeling variables or scaling the model,
+        cannot be expressed as a delta; after one of those, the model must be
+        sent in full and a new checkpoint made.
+
+        """
+        self.data.checkpoint()
+
     def clear(self) -> None:
         """Remove the offset and all variables and interactions from the model."""
         self.data.clear()
 
+    def content_hash(self, *, num_threads: int = 1) -> int:
+        """Return a 128-bit fingerprint of the content of the quadratic model.
+
+        The hash covers the offset, the linear and quadratic biases, and the
+        types and bounds of the variables. Models with the same content have the
+        same hash regardless of the order of their variables and
+        interactions, or of their :attr:`.dtype`. Models with different
+        content have different hashes with very high probability, so the
+        hash can be used as a cache key. Note that an interaction with a
+        bias of 0 counts as content.
+
+        Args:
+            num_threads:
+                Number of threads the variables are divided between.
+                If 0, uses one thread per core.
+
+        Returns:
+            A non-negative integer less than ``2**128``.
+
+        Examples:
+            >>> i, j = dimod.Integers('ij')
+            >>> (2*i*j + i).content_hash() == (j + 2*j*i - j + i).content_hash()
+            True
+            >>> (2*i*j + i).content_hash() == (2*i*j + j).content_hash()
+            False
+
+        """
+        return self.data.content_hash(num_threads=num_threads)
+
     def copy(self):
         """Return a copy."""
         return deepcopy(self)
@@ -697,6 +810,34 @@ class QuadraticModel(QuadraticViewsMixin):
         energy, = energies
         return energy
 
+    def fix_variables(self,
+                      fixed: Union[Mapping[Variable, float], Iterable[Tuple[Variable, float]]]):
+        """Fix the value of the variables and remove them.
+
+        The variables are removed together, so the model is reindexed once
+        rather than once per variable as with :meth:`.fix_variable`.
+
+        Args:
+            fixed: A dictionary or an iterable of 2-tuples of variable
+                assignments. If a variable is assigned more than once, the
+                last assignment is used.
+
+        Raises:
+            ValueError: If any of the variables is not in the model.
+
+        Examples:
+            >>> from dimod import QuadraticModel
+            >>> qm = QuadraticModel()
+            >>> qm.add_variables_from('INTEGER', ['i', 'j', 'k'])
+            >>> qm.add_quadratic('i', 'i', 1)
+            >>> qm.add_quadratic('i', 'j', -2)
+            >>> qm.fix_variables({'i': 3, 'k': 1})
+            >>> qm.linear
+            {'j': -6.0}
+
+        """
+        self.data.fix_variables(fixed)
+
     def flip_variable(self, v: Variable):
         """Flip the specified binary-valued variable.
 
@@ -960,6 +1101,43 @@ class QuadraticModel(QuadraticViewsMixin):
         """
         return self.data.iter_quadratic
 
+    def local_fields(self, samples_like, *, num_threads: int = 1) -> np.ndarray:
+        """Determine the local fields of the variables for the given samples-like.
+
+        The local field of a variable is the derivative of the energy with
+        respect to the variable's value, evaluated at the sample. For a
+        variable :math:`v` without a square term this is
+        :math:`a_v + \\sum_u b_{u,v} x_u`; a square term
+        :math:`b_{v,v} x_v^2` adds :math:`2 b_{v,v} x_v`.
+
+        Args:
+            samples_like (samples_like):
+                Raw samples. `samples_like` is an extension of
+                NumPy's `array_like`_ structure. See :func:`.as_samples`.
+
+            num_threads:
+                Number of threads the variables are divided between.
+                If 0, uses one thread per core.
+
+        Returns:
+            Array of shape ``(num_samples, num_variables)``, with the columns
+            in the order of :attr:`.variables`.
+
+        Examples:
+            >>> from dimod import QuadraticModel
+            >>> qm = QuadraticModel()
+            >>> qm.add_variables_from('INTEGER', ['i', 'j'])
+            >>> qm.add_linear('i', 3)
+            >>> qm.add_quadratic('i', 'i', 1)
+            >>> qm.add_quadratic('i', 'j', -2)
+            >>> qm.local_fields([{'i': 2, 'j': 1}])
+            array([[ 5., -4.]])
+
+        .. _`array_like`:  https://numpy.org/doc/stable/user/basics.creation.html
+
+        """
+        return self.data.local_fields(samples_like, num_threads=num_threads)
+
     @forwarding_method
     def lower_bound(self, v: Variable) -> Bias:
         """Return the lower bound on the specified variable.
@@ -1173,6 +1351,84 @@ class QuadraticModel(QuadraticViewsMixin):
         """
         return self.data.remove_variable
 
+    @forwarding_method
+    def reorder_variables(self, order: Union[str, Sequence[Variable]] = 'rcm') -> np.ndarray:
+        """Reorder the variables of the quadratic model in-place.
+
+        Reordering the variables does not change the quadratic model,
+        only the order of its variables and therefore how they are stored.
+        Orderings that place interacting variables near each other
+        improve the memory locality of methods that iterate over the
+        interactions, such as :meth:`.energies`.
+
+        Args:
+            order: Either the variables of the quadratic model in their new
+                order, or the name of an ordering to generate:
+
+                * ``'rcm'``: reverse Cuthill-McKee, which reduces the bandwidth
+                  of the interaction matrix.
+                * ``'degree'``: variables sorted by increasing degree.
+
+        Returns:
+            Array ``indices`` such that the variable at index ``i`` was at
+            index ``indices[i]`` before the reordering. For example, the
+            columns of a samples array can be reordered to match
+            with ``samples[:, indices]``.
+
+        Examples:
+            >>> qm = dimod.Integer('a') + dimod.Binary('b') + dimod.Spin('c')
+            >>> qm.reorder_variables(['c', 'a', 'b'])
+            array([2, 0, 1])
+            >>> list(qm.variables)
+            ['c', 'a', 'b']
+
+        """
+        return self.data.reorder_variables
+
+    @forwarding_method
+    def reserve(self, num_variables: int, num_interactions_hint: int = 0):
+        """Reserve memory for the given number of variables and interactions.
+
+        Reserving memory in advance avoids repeated reallocation as variables
+        and interactions are added. This does not change the model.
+
+        Args:
+            num_variables: Number of variables to reserve memory for.
+            num_interactions_hint: Total number of interactions the model is
+                expected to have. Memory is reserved in the neighborhood of each
+                variable currently in the model, assuming the interactions are
+                evenly distributed over ``num_variables`` variables.
+                Use :meth:`.reserve_interactions` when the degree of each
+                variable is known.
+
+        Examples:
+            >>> qm = dimod.QuadraticModel()
+            >>> qm.add_variables_from('INTEGER', range(100))
+            >>> qm.reserve(100, 1000)
+            >>> qm.nbytes(capacity=True) > qm.nbytes()
+            True
+
+        """
+        return self.data.reserve
+
+    @forwarding_method
+    def reserve_interactions(self, degrees: ArrayLike):
+        """Reserve memory for the interactions of each variable.
+
+        Args:
+            degrees: Expected number of neighbors of each variable, given in
+                the order of :attr:`.variables`. May be shorter than the number
+                of variables.
+
+        Examples:
+            >>> qm = dimod.QuadraticModel()
+            >>> qm.add_variables_from('INTEGER', range(3))
+            >>> qm.reserve_interactions([2, 1, 1])
+            >>> qm.add_quadratic_from({(0, 1): 1, (0, 2): 1})
+
+        """
+        return self.data.reserve_interactions
+
     @forwarding_method
     def scale(self, scalar: Bias):
         """Scale the biases by the given number.
@@ -1223,6 +1479,14 @@ class QuadraticModel(QuadraticViewsMixin):
         """
         return self.data.set_quadratic
 
+    @forwarding_method
+    def shrink_to_fit(self):
+        """Release any memory reserved beyond what is needed by the model.
+
+        See also :meth:`.reserve` and :meth:`.reserve_interactions`.
+        """
+        return self.data.shrink_to_fit
+
     def spin_to_binary(self, inplace: bool = False) -> 'QuadraticModel':
         """Convert any spin-valued variables to binary-valued.
 
@@ -1243,12 +1507,51 @@ class QuadraticModel(QuadraticViewsMixin):
         if not inplace:
             return self.copy().spin_to_binary(inplace=True)
 
-        for s in self.variables:
-            if self.vartype(s) is Vartype.SPIN:
-                self.change_vartype(Vartype.BINARY, s)
+        self.change_vartypes(Vartype.BINARY,
+                             [s for s in self.variables if self.vartype(s) is Vartype.SPIN])
 
         return self
 
+    def to_delta(self, *, spool_size: int = int(1e9)) -> SpooledTemporaryFile:
+        """Serialize the changes made since the last :meth:`checkpoint`.
+
+        A delta holds the current values of the biases, variable types and
+        bounds that changed since the checkpoint and the labels of the added
+        variables, so it is typically much smaller than the output of
+        :meth:`to_file`.
+        See :mod:`dimod.serialization.delta` for the format.
+
+        Args:
+            spool_size: Defines the ``max_size`` passed to the constructor of
+                :class:`tempfile.SpooledTemporaryFile`. Determines whether
+                the returned file-like's contents is kept on disk or in
+                memory.
+
+        Returns:
+            A file-like object that can be passed to :meth:`apply_delta`.
+
+        Raises:
+            ValueError: If the model has no checkpoint, or if it was changed
+                in a way that cannot be expressed as a delta, see
+                :meth:`checkpoint`.
+
+        Examples:
+            >>> qm = dimod.QuadraticModel()
+            >>> qm.add_variables_from('INTEGER', 'ij')
+            >>> qm.add_quadratic('i', 'j', 2)
+            >>> remote = qm.copy()
+            >>> qm.checkpoint()
+            >>> qm.set_upper_bound('i', 10)
+            >>> qm.add_linear('j', -1)
+            >>> remote.apply_delta(qm.to_delta())
+            >>> remote.is_equal(qm)
+            True
+            >>> print(remote.upper_bound('i'))
+            10.0
+
+        """
+        return write_delta(self, spool_size=spool_size)
+
     def to_file(self, *,
                 spool_size: int = int(1e9),
                 ) -> tempfile.SpooledTemporaryFile:
@@ -758,7 +758,7 @@ class SampleSet(abc.Iterable, abc.Sized):
     # todo: this works with DQM/BinaryPolynomial, should change the name and/or
     # update the docs.
     @classmethod
-    def from_samples_bqm(cls, samples_like, bqm, **kwargs):
+    def from_samples_bqm(cls, samples_like, bqm, *, lazy_energies=False, **kwargs):
         """Build a sample set from raw samples and a binary quadratic model.
 
         The binary quadratic model is used to calculate energies and set the
@@ -787,6 +787,10 @@ class SampleSet(abc.Iterable, abc.Sized):
                 Return :attr:`.SampleSet.variables` in sorted order. For mixed
                 (unsortable) types, the given order is maintained.
 
+            lazy_energies (bool, optional, default=False):
+                If True, the energies are calculated when they are first
+                needed rather than when the sample set is built.
+
             **vectors (array_like):
                 Other per-sample data.
 
@@ -798,6 +802,20 @@ class SampleSet(abc.Iterable, abc.Sized):
             >>> bqm = dimod.BinaryQuadraticModel.from_ising({}, {('a', 'b'): -1})
             >>> sampleset = dimod.SampleSet.from_samples_bqm({'a': -1, 'b': 1}, bqm)
 
+        Notes:
+            With ``lazy_energies=True``, the energies are calculated in chunks
+            of rows on the first read of :attr:`.SampleSet.record`.
+            :attr:`.SampleSet.first`, :meth:`.SampleSet.truncate` and
+            :meth:`.SampleSet.slice` select the lowest-energy rows as the
+            energies are calculated rather than sorting all of them, and
+            views that do not sort by energy, such as
+            ``truncate(n, sorted_by=None)``, leave the energies of the rows
+            they select to be calculated later. The sample set keeps a
+            reference to `bqm`, not a copy, until its energies are
+            calculated, so `bqm` must not be modified until then. The
+            energies of models without floating-point biases are always
+            calculated immediately.
+
         """
         if len(samples_like) == 0:
             return cls.from_samples(([], bqm.variables), energy=[], vartype=bqm.vartype, **kwargs)
@@ -806,6 +824,17 @@ class SampleSet(abc.Iterable, abc.Sized):
         # and in cls.from_samples
         samples_like = as_samples(samples_like)
 
+        if lazy_energies and np.issubdtype(getattr(bqm, 'dtype', object), np.floating):
+            # the energies are filled in by _iter_energies(), so the column
+            # gets the dtype that bqm.energies() gives it in the eager case
+            samples, labels = samples_like
+            dtype = bqm.energies((samples[:0], labels)).dtype
+            energy = np.full(samples.shape[0], np.nan, dtype=dtype)
+            sampleset = cls.from_samples(samples_like, energy=energy, vartype=bqm.vartype,
+                                         **kwargs)
+            sampleset._energy_model = bqm  # not copied, see the notes above
+            return sampleset
+
         energies = bqm.energies(samples_like)
 
         return cls.from_samples(samples_like, energy=energies, vartype=bqm.vartype, **kwargs)
@@ -978,7 +1007,8 @@ class SampleSet(abc.Iterable, abc.Sized):
 
     def __len__(self):
         """The number of rows in record."""
-        return self.record.__len__()
+        self.resolve()
+        return self._record.__len__()
 
     def __iter__(self):
         """Iterate over the samples, low energy to high."""
@@ -1016,8 +1046,10 @@ class SampleSet(abc.Iterable, abc.Sized):
         return (self.record.sample == other.record.sample[:, other_idx]).all()
 
     def __getstate__(self):
-        # Ensure that any futures are resolved before pickling.
+        # Ensure that any futures are resolved before pickling, and that the
+        # energies are calculated so the model is not pickled.
         self.resolve()
+        self._resolve_energies()
         # we'd prefer to do super().__getstate__ but unfortunately that's not
         # present, so instead we recreate the (documented) behaviour
         return self.__dict__
@@ -1076,6 +1108,11 @@ class SampleSet(abc.Iterable, abc.Sized):
             Sample(sample={'a': -1, 'b': 1}, energy=-2.0, num_occurrences=1)
 
         """
+        if hasattr(self, '_energy_model'):
+            # select the lowest-energy row as the energies are calculated
+            # rather than sorting all of them
+            return self.truncate(1).first
+
         try:
             return next(self.data(sorted_by='energy', name='Sample'))
         except StopIteration:
@@ -1119,6 +1156,7 @@ class SampleSet(abc.Iterable, abc.Sized):
 
         """
         self.resolve()
+        self._resolve_energies()
         return self._record
 
     @property
@@ -1321,10 +1359,14 @@ class SampleSet(abc.Iterable, abc.Sized):
 
     def copy(self):
         """Create a shallow copy."""
-        return self.__class__(self.record.copy(),
-                              self.variables,  # a new one is made in all cases
-                              self.info.copy(),
-                              self.vartype)
+        self.resolve()
+        new = self.__class__(self._record.copy(),
+                             self.variables,  # a new one is made in all cases
+                             self.info.copy(),
+                             self.vartype)
+        if hasattr(self, '_energy_model'):
+            new._energy_model = self._energy_model  # never changed, so can be shared
+        return new
 
     def change_vartype(self, vartype, energy_offset=0.0, inplace=True):
         """Return the :class:`SampleSet` with the given vartype.
@@ -1453,6 +1495,9 @@ class SampleSet(abc.Iterable, abc.Sized):
 
         if inplace and done:
             self.variables._relabel(mapping)
+            if hasattr(self, '_energy_model'):
+                # the deferred energies need the new labels too
+                self._energy_model = self._energy_model.relabel_variables(mapping, inplace=False)
             return self
 
         elif done:  # and not inplace
@@ -1487,6 +1532,70 @@ class SampleSet(abc.Iterable, abc.Sized):
             del self._future
             del self._result_hook
 
+    # the number of rows whose energies are calculated at once, see _iter_energies()
+    _ENERGY_CHUNK_SIZE = 1 << 14
+
+    def _iter_energies(self):
+        """Yield ``(start, energies)`` for consecutive chunks of the rows.
+
+        If the energies were deferred by :meth:`.from_samples_bqm`, each chunk
+        is calculated and stored in the record before it is yielded. Once all
+        of them are, the model is released.
+        """
+        record = self._record
+        model = getattr(self, '_energy_model', None)
+        size = self._ENERGY_CHUNK_SIZE
+
+        for start in range(0, len(record), size):
+            energies = record.energy[start:start + size]
+            if model is not None:
+                energies[:] = model.energies((record.sample[start:start + size], self._variables))
+            yield start, energies
+
+        if model is not None:
+            del self._energy_model
+
+    def _lowest_energy_indices(self, n):
+        """Return the indices of the `n` lowest-energy rows, sorted by energy.
+
+        Only the lowest `n` energies seen so far are kept as the chunks from
+        :meth:`._iter_energies` arrive, so all of the rows are never sorted.
+        Ties are broken by row.
+        """
+        if n <= 0:
+            return np.empty(0, dtype=np.intp)
+
+        if n >= self._ENERGY_CHUNK_SIZE:
+            # keeping that many candidates per chunk costs more than one sort
+            self._resolve_energies()
+            return np.argsort(self._record.energy, kind='stable')[:n]
+
+        # the candidates are kept in row order
+        indices = np.empty(0, dtype=np.intp)
+        energies = np.empty(0, dtype=self._record.energy.dtype)
+        for start, chunk in self._iter_energies():
+            indices = np.concatenate((indices, np.arange(start, start + len(chunk))))
+            energies = np.concatenate((energies, chunk))
+
+            if len(energies) > n:
+                # keep everything below the nth lowest energy, then the first
+                # of the rows tied with it
+                kth = np.partition(energies, n - 1)[n - 1]
+                keep = energies < kth
+                ties, = np.nonzero(energies == kth)
+                keep[ties[:n - np.count_nonzero(keep)]] = True
+
+                indices = indices[keep]
+                energies = energies[keep]
+
+        return indices[np.argsort(energies, kind='stable')]
+
+    def _resolve_energies(self):
+        # calculate any energies deferred by from_samples_bqm()
+        if hasattr(self, '_energy_model'):
+            for _ in self._iter_energies():
+                pass
+
     def aggregate(self):
         """Create a new SampleSet with repeated samples aggregated.
 
@@ -1731,14 +1840,30 @@ class SampleSet(abc.Iterable, abc.Sized):
         else:
             selector = slice(None)
 
+        self.resolve()
+        record = self._record
+
         if sorted_by is None:
-            record = self.record[selector]
+            indices = selector
+        elif (sorted_by == 'energy' and hasattr(self, '_energy_model')
+                and selector.stop is not None and selector.stop >= 0
+                and (selector.start is None or selector.start >= 0)
+                and (selector.step is None or selector.step > 0)):
+            # only the lowest energies are needed, so select them as they are
+            # calculated rather than sorting all of them
+            indices = self._lowest_energy_indices(selector.stop)[selector]
         else:
-            sort_indices = np.argsort(self.record[sorted_by])
-            record = self.record[sort_indices[selector]]
-
-        return type(self)(record, self.variables, copy.deepcopy(self.info),
-                          self.vartype)
+            if sorted_by == 'energy':
+                self._resolve_energies()
+            # stable, so that ties are broken by row as in the lazy path
+            indices = np.argsort(record[sorted_by], kind='stable')[selector]
+
+        sampleset = type(self)(record[indices], self.variables, copy.deepcopy(self.info),
+                               self.vartype)
+        if hasattr(self, '_energy_model'):
+            # the energies of the selected rows are still to be calculated
+            sampleset._energy_model = self._energy_model
+        return sampleset
 
 
     ###############################################################################################
@@ -0,0 +1,329 @@
+# Copyright 2023 D-Wave Systems Inc.
+#
+#    Licensed under the Apache License, Version 2.0 (the "License");
+#    you may not use this file except in compliance with the License.
+#    You may obtain a copy of the License at
+#
+#        http://www.apache.org/licenses/LICENSE-2.0
+#
+#    Unless required by applicable law or agreed to in writing, software
+#    distributed under the License is distributed on an "AS IS" BASIS,
+#    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+#    See the License for the specific language governing permissions and
+#    limitations under the License.
+
+"""Serialization of the changes made to a model since a checkpoint.
+
+A delta holds the current values of the biases, variable types and bounds
+that changed since the model's last checkpoint, along with the labels of the
+variables that were added. Applied to a copy of the model as it was at the
+checkpoint, it brings the copy up to date.
+
+Format Specification (Version 1.0):
+
+    The first 10 bytes are a magic string: exactly "DIMODDELTA".
+
+    The next 1 byte is an unsigned byte: the major version of the file
+    format.
+
+    The next 1 byte is an unsigned byte: the minor version of the file
+    format.
+
+    The next 4 bytes form a little-endian unsigned int, the length of
+    the header data HEADER_LEN.
+
+    The next HEADER_LEN bytes form the header data. This is a
+    json-serialized dictionary. The dictionary is exactly:
+
+    .. code-block:: python
+
+        dict(type=type(model).__name__,
+             dtype=model.dtype.name,
+             itype=model.data.index_dtype.name,
+             vartype=model.vartype.name,  # None for quadratic models
+             base_num_variables=num_variables_at_checkpoint,
+             num_variables=model.num_variables,
+             num_linear=len(linear),
+             num_quadratic=len(quadratic),
+             num_removed=len(removed),
+             num_varinfo=len(varinfo),
+             offset=model.offset,  # None if the offset did not change
+             )
+
+    it is terminated by a newline character and padded with spaces to
+    make the entire length of the entire header divisible by 64.
+
+    Then come five sections, each a 4-byte magic string, the length of the
+    data and the data itself, padded to a multiple of 64 bytes:
+
+    * ``DLIN``: the changed linear biases, as (variable, bias) pairs.
+    * ``DQUA``: the changed or added interactions, as (u, v, bias) triplets
+      with ``u <= v``.
+    * ``DREM``: the removed interactions, as (u, v) pairs.
+    * ``DVAR``: the variable type and bounds of the changed variables,
+      followed by the added variables, as (variable, vartype, lb, ub)
+      records.
+    * ``VARS``: the labels of the added variables.
+
+    Variables are identified by their index in the model. The pairs and
+    records are packed without alignment, using the ``dtype`` and ``itype``
+    given in the header.
+
+    The changes to the objective and constraints of a constrained quadratic
+    model are written in the same format by :func:`write_expression_delta`,
+    inside the archive described in
+    :meth:`~dimod.ConstrainedQuadraticModel.to_delta`. They have no variable
+    records or labels.
+
+"""
+
+from __future__ import annotations
+
+import typing
+
+from typing import BinaryIO, ByteString, Union
+
+import numpy as np
+
+from dimod.serialization.fileview import Section, SpooledTemporaryFile, VariablesSection, _BytesIO
+from dimod.serialization.fileview import read_header, write_header
+from dimod.vartypes import Vartype
+
+if typing.TYPE_CHECKING:
+    from dimod.quadratic import QuadraticModel
+    from dimod.binary import BinaryQuadraticModel
+
+__all__ = ['Delta', 'apply_delta_biases', 'read_delta', 'write_delta', 'write_expression_delta']
+
+DELTA_MAGIC_PREFIX = b'DIMODDELTA'
+DELTA_SERIALIZATION_VERSION = (1, 0)
+
+
+def _linear_dtype(dtype, itype) -> np.dtype:
+    return np.dtype([('v', itype), ('bias', dtype)], align=False)
+
+
+def _quadratic_dtype(dtype, itype) -> np.dtype:
+    return np.dtype([('u', itype), ('v', itype), ('bias', dtype)], align=False)
+
+
+def _removed_dtype(dtype, itype) -> np.dtype:
+    return np.dtype([('u', itype), ('v', itype)], align=False)
+
+
+def _varinfo_dtype(dtype, itype) -> np.dtype:
+    return np.dtype([('v', itype), ('vartype', np.int8), ('lb', dtype), ('ub', dtype)],
+                    align=False)
+
+
+class _ArraySection(Section):
+    NUM_LENGTH_BYTES = 8  # the changes can be as large as the model
+
+    def __init__(self, array: np.ndarray):
+        self.array = array
+
+    def dump_data(self):
+        return memoryview(np.ascontiguousarray(self.array)).cast('B')
+
+    @classmethod
+    def loads_data(cls, data, *, dtype: np.dtype, count: int) -> np.ndarray:
+        return np.frombuffer(data[:count*dtype.itemsize], dtype=dtype)
+
+
+class LinearDeltaSection(_ArraySection):
+    magic = b'DLIN'
+
+
+class QuadraticDeltaSection(_ArraySection):
+    magic = b'DQUA'
+
+
+class RemovedDeltaSection(_ArraySection):
+    magic = b'DREM'
+
+
+class VarinfoDeltaSection(_ArraySection):
+    magic = b'DVAR'
+
+
+class Delta(typing.NamedTuple):
+    """The changes made to a model since its checkpoint, see :func:`read_delta`."""
+    type: str
+    vartype: typing.Optional[str]
+    base_num_variables: int
+    num_variables: int
+    linear: np.ndarray
+    quadratic: np.ndarray
+    removed: np.ndarray
+    varinfo: np.ndarray
+    offset: typing.Optional[float]
+    variables: list
+
+
+def _write_delta(file: BinaryIO, delta: dict, *, type: str, dtype: np.dtype, itype: np.dtype,
+                 vartype: typing.Optional[Vartype], base_num_variables: int,
+                 num_variables: int, offset: typing.Optional[float], variables):
+    dtype = np.dtype(dtype)
+    itype = np.dtype(itype)
+    varinfo = delta.get('varinfo', np.empty(0, dtype=_varinfo_dtype(dtype, itype)))
+
+    data = dict(type=type,
+                dtype=dtype.name,
+                itype=itype.name,
+                vartype=vartype.name if vartype is not None else None,
+                base_num_variables=base_num_variables,
+                num_variables=num_variables,
+                num_linear=len(delta['linear']),
+                num_quadratic=len(delta['quadratic']),
+                num_removed=len(delta['removed']),
+                num_varinfo=len(varinfo),
+                offset=offset,
+                )
+
+    write_header(file, DELTA_MAGIC_PREFIX, data, version=DELTA_SERIALIZATION_VERSION)
+
+    file.write(LinearDeltaSection(delta['linear']).dumps())
+    file.write(QuadraticDeltaSection(delta['quadratic']).dumps())
+    file.write(RemovedDeltaSection(delta['removed']).dumps())
+    file.write(VarinfoDeltaSection(varinfo).dumps())
+    file.write(VariablesSection(variables).dumps())
+
+
+def write_delta(model: Union[BinaryQuadraticModel, QuadraticModel], *,
+                vartype: typing.Optional[Vartype] = None,
+                spool_size: int = int(1e9),
+                ) -> SpooledTemporaryFile:
+    """Serialize the changes made to a model since its checkpoint.
+
+    See the module documentation for the format.
+
+    Args:
+        model: A binary quadratic model or quadratic model.
+        vartype: The vartype of a binary quadratic model.
+        spool_size: Defines the `max_size` passed to the constructor of
+            :class:`tempfile.SpooledTemporaryFile`.
+
+    Raises:
+        ValueError: If the model has no checkpoint, or if the changes since
+            the checkpoint cannot be expressed as a delta.
+
+    """
+    delta = model.data._idelta()
+    if delta is None:
+        raise ValueError(
+            "the model has no checkpoint, or was changed in a way that cannot "
+            "be expressed as a delta (for instance by removing or relabeling "
+            "variables), call checkpoint() and send the full model instead")
+
+    base_num_variables = delta['num_variables']
+
+    file = SpooledTemporaryFile(max_size=spool_size)
+
+    _write_delta(file, delta,
+                 type=type(model).__name__,
+                 dtype=model.dtype,
+                 itype=model.data.index_dtype,
+                 vartype=vartype,
+                 base_num_variables=base_num_variables,
+                 num_variables=model.num_variables,
+                 offset=float(model.offset) if delta['offset_changed'] else None,
+                 variables=model.variables[base_num_variables:],
+                 )
+
+    file.seek(0)
+    return file
+
+
+def write_expression_delta(fp: BinaryIO, expression, delta: dict):
+    """Write the changes made to the objective or a constraint of a
+    constrained quadratic model since the model's checkpoint.
+
+    Args:
+        fp: A writeable file-like.
+        expression: The objective or the left-hand side of a constraint.
+        delta: The changes, as returned by the expression's ``_idelta()``.
+
+    The delta has the same format as the one written by
+    :func:`write_delta`, with the variables indexed as they are in the
+    model. It has no variable records or labels.
+
+    """
+    num_variables = expression.parent.num_variables()
+    _write_delta(fp, delta,
+                 type=type(expression).__name__,
+                 dtype=expression.dtype,
+                 itype=expression.index_dtype,
+                 vartype=None,
+                 base_num_variables=num_variables,
+                 num_variables=num_variables,
+                 offset=float(expression.offset) if delta['offset_changed'] else None,
+                 variables=(),
+                 )
+
+
+def read_delta(fp: Union[BinaryIO, ByteString]) -> Delta:
+    """Read a delta written by :func:`write_delta` or :func:`write_expression_delta`."""
+    if isinstance(fp, ByteString):
+        file_like: BinaryIO = _BytesIO(fp)  # type: ignore[assignment]
+    else:
+        file_like = fp
+
+    header_info = read_header(file_like, DELTA_MAGIC_PREFIX)
+
+    if header_info.version > DELTA_SERIALIZATION_VERSION:
+        raise ValueError("cannot load a delta serialized with version "
+                         f"{header_info.version!r}, try upgrading your dimod version")
+
+    data = header_info.data
+    dtype = np.dtype(data['dtype'])
+    itype = np.dtype(data['itype'])
+
+    linear = LinearDeltaSection.load(
+        file_like, dtype=_linear_dtype(dtype, itype), count=data['num_linear'])
+    quadratic = QuadraticDeltaSection.load(
+        file_like, dtype=_quadratic_dtype(dtype, itype), count=data['num_quadratic'])
+    removed = RemovedDeltaSection.load(
+        file_like, dtype=_removed_dtype(dtype, itype), count=data['num_removed'])
+    varinfo = VarinfoDeltaSection.load(
+        file_like, dtype=_varinfo_dtype(dtype, itype), count=data['num_varinfo'])
+    variables = list(VariablesSection.load(file_like))
+
+    if len(variables) != data['num_variables'] - data['base_num_variables']:
+        raise ValueError("the number of added variables does not match the header")
+
+    return Delta(type=data['type'],
+                 vartype=data['vartype'],
+                 base_num_variables=data['base_num_variables'],
+                 num_variables=data['num_variables'],
+                 linear=linear,
+                 quadratic=quadratic,
+                 removed=removed,
+                 varinfo=varinfo,
+                 offset=data['offset'],
+                 variables=variables,
+                 )
+
+
+def apply_delta_biases(data, delta: Delta):
+    """Set the biases of a model, which already has the delta's variables, from a delta.
+
+    Args:
+        data: The data object of a binary quadratic model or quadratic model,
+            or the objective or the left-hand side of a constraint of a
+            constrained quadratic model.
+        delta: A delta, as returned by :func:`read_delta`.
+
+    """
+    itype = data.index_dtype
+    dtype = data.dtype
+
+    def field(array, name, dtype):
+        return np.ascontiguousarray(array[name], dtype=dtype)
+
+    data._iapply_delta(
+        field(delta.linear, 'v', itype), field(delta.linear, 'bias', dtype),
+        field(delta.quadratic, 'u', itype), field(delta.quadratic, 'v', itype),
+        field(delta.quadratic, 'bias', dtype),
+        field(delta.removed, 'u', itype), field(delta.removed, 'v', itype),
+        offset=delta.offset,
+        )
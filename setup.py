@@ -44,6 +44,16 @@ class build_ext(_build_ext):
         for ext in self.extensions:
             ext.extra_compile_args.extend(link_args)
 
+        # opt-in hot-path instrumentation counters, see dimod/include/dimod/stats.h
+        if os.getenv('DIMOD_INSTRUMENTATION'):
+            for ext in self.extensions:
+                ext.define_macros.append(('DIMOD_INSTRUMENTATION', None))
+
+        # opt-in extended-precision accumulation, see dimod/include/dimod/precision.h
+        if os.getenv('DIMOD_EXTENDED_PRECISION'):
+            for ext in self.extensions:
+                ext.define_macros.append(('DIMOD_EXTENDED_PRECISION', None))
+
         super().build_extensions()
 
     def finalize_options(self):
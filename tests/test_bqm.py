@@ -39,6 +39,14 @@ from dimod.binary import Spin, Binary
 from dimod.testing import assert_consistent_bqm, assert_bqm_almost_equal
 
 
+try:
+    import scipy.sparse
+except ImportError:
+    _scipy_available = False
+else:
+    _scipy_available = True
+
+
 def cross_vartype_view(*args, **kwargs):
     bqm = BinaryQuadraticModel(*args, **kwargs)
     if bqm.vartype is dimod.SPIN:
@@ -690,6 +698,200 @@ class TestConstruction(unittest.TestCase):
             bqm.vartype = dimod.BINARY
 
 
+class TestCSR(unittest.TestCase):
+    # [[1, 2, 0, 3],
+    #  [0, 0, 4, 0],
+    #  [0, 0, 5, 0],
+    #  [0, 0, 0, 0]]
+    upper = ([1, 2, 3, 4, 5], [0, 1, 3, 2, 2], [0, 3, 4, 5, 5])
+
+    @parameterized.expand(BQMs.items())
+    def test_add_quadratic_from_csr_binary(self, name, BQM):
+        bqm = BQM('BINARY')
+        bqm.add_quadratic_from_csr(self.upper)
+        assert_consistent_bqm(bqm)
+        self.assertEqual(bqm, BQM({0: 1, 2: 5, 1: 0, 3: 0},
+                                  {(0, 1): 2, (0, 3): 3, (1, 2): 4}, 0, 'BINARY'))
+        self.assertEqual(bqm.num_variables, 4)
+
+    @parameterized.expand(BQMs.items())
+    def test_add_quadratic_from_csr_spin(self, name, BQM):
+        bqm = BQM({0: 1}, {(0, 1): 1}, 1.5, 'SPIN')
+        bqm.add_quadratic_from_csr(self.upper)
+        assert_consistent_bqm(bqm)
+        self.assertEqual(bqm, BQM({0: 1, 1: 0, 2: 0, 3: 0},
+                                  {(0, 1): 3, (0, 3): 3, (1, 2): 4}, 7.5, 'SPIN'))
+
+    @parameterized.expand(BQMs.items())
+    def test_add_quadratic_from_csr_labelled(self, name, BQM):
+        bqm = BQM({'a': 1}, {}, 0, 'BINARY')
+        bqm.add_quadratic_from_csr(([-1, 2], [0, 1], [0, 1, 2]))
+        self.assertEqual(bqm, BQM({'a': 1, 0: -1, 1: 2}, {}, 0, 'BINARY'))
+
+    @parameterized.expand(BQMs.items())
+    def test_symmetric_with_duplicates(self, name, BQM):
+        # [[0, 1, 2],
+        #  [1, 0, 0],
+        #  [2, 0, 0]] with (0, 2) given as 1.5 + .5
+        data = np.array([1.5, 1, .5, 1, 2])
+        indices = np.array([2, 1, 2, 0, 0], dtype=np.int64)
+        indptr = np.array([0, 3, 4, 5], dtype=np.int64)
+
+        bqm = BQM('SPIN')
+        bqm.add_quadratic_from_csr((data, indices, indptr))
+        assert_consistent_bqm(bqm)
+        self.assertEqual(bqm, BQM({0: 0, 1: 0, 2: 0}, {(0, 1): 2, (0, 2): 4}, 0, 'SPIN'))
+
+    @parameterized.expand(BQMs.items())
+    def test_csc(self, name, BQM):
+        # a CSC matrix describes the transpose, which gives the same biases
+        class CSC:
+            format = 'csc'
+            data, indices, indptr = self.upper
+
+        bqm = BQM('BINARY')
+        bqm.add_quadratic_from_csr(CSC())
+        new = BQM('BINARY')
+        new.add_quadratic_from_csr(self.upper)
+        self.assertEqual(bqm, new)
+
+    @parameterized.expand(BQMs.items())
+    def test_exceptions(self, name, BQM):
+        bqm = BQM('BINARY')
+        with self.assertRaises(ValueError):
+            bqm.add_quadratic_from_csr(([1], [0]))
+        with self.assertRaises(ValueError):
+            bqm.add_quadratic_from_csr(([1], [0], []))
+        with self.assertRaises(ValueError):
+            bqm.add_quadratic_from_csr(([1, 2], [0], [0, 1]))
+        with self.assertRaises(ValueError):
+            bqm.add_quadratic_from_csr(([1, 2], [0, 1], [0, 3]))
+        with self.assertRaises(ValueError):
+            bqm.add_quadratic_from_csr(([1, 2], [0, 1], [0, 2, 1]))
+        with self.assertRaises(ValueError):
+            bqm.add_quadratic_from_csr(([1], [-1], [0, 1]))
+        self.assertEqual(bqm.num_variables, 0)
+
+    @parameterized.expand(BQM_CLSs.items())
+    def test_from_csr(self, name, BQM):
+        bqm = BQM.from_csr(self.upper, 'BINARY')
+        self.assertIsInstance(bqm, BQM)
+        self.assertEqual(bqm, BQM({0: 1, 2: 5, 1: 0, 3: 0},
+                                  {(0, 1): 2, (0, 3): 3, (1, 2): 4}, 0, 'BINARY'))
+
+        bqm = BQM.from_csr(self.upper, 'SPIN', dtype=np.float32)
+        self.assertEqual(bqm.dtype, np.float32)
+        self.assertEqual(bqm.offset, 6)
+
+    @parameterized.expand(BQMs.items())
+    def test_to_csr(self, name, BQM):
+        bqm = BQM({'a': 1}, {'ab': -1, 'cb': 2, 'ac': .5, 'dd': 0}, 0, 'SPIN')
+
+        data, indices, indptr = bqm.to_csr()
+
+        variables = list(bqm.variables)
+        self.assertEqual(len(indptr), bqm.num_variables + 1)
+        self.assertEqual(len(indices), bqm.num_interactions)
+        for ui, u in enumerate(variables):
+            row = indices[indptr[ui]:indptr[ui + 1]]
+            np.testing.assert_array_equal(row, np.sort(row))
+            for vi, bias in zip(row, data[indptr[ui]:indptr[ui + 1]]):
+                self.assertLess(ui, vi)
+                self.assertEqual(bqm.get_quadratic(u, variables[vi]), bias)
+
+        # round trip
+        new = BQM(bqm.vartype)
+        new.add_quadratic_from_csr((data, indices, indptr))
+        new.relabel_variables(dict(enumerate(variables)))
+        self.assertEqual(new.quadratic, bqm.quadratic)
+
+    @parameterized.expand(BQMs.items())
+    def test_to_csr_empty(self, name, BQM):
+        data, indices, indptr = BQM('SPIN').to_csr()
+        self.assertEqual(indptr.tolist(), [0])
+        self.assertEqual(len(indices), 0)
+        self.assertEqual(len(data), 0)
+
+    @unittest.skipUnless(_scipy_available, "scipy is not installed")
+    def test_scipy(self):
+        import scipy.sparse
+
+        matrix = scipy.sparse.random(50, 50, density=.1, format='csr', random_state=42)
+
+        bqm = BinaryQuadraticModel.from_csr(matrix, 'BINARY')
+        dense = BinaryQuadraticModel(matrix.toarray(), 'BINARY')
+        assert_bqm_almost_equal(bqm, dense)
+
+        for fmt in ['csc', 'coo']:
+            with self.subTest(format=fmt):
+                new = BinaryQuadraticModel.from_csr(matrix.asformat(fmt), 'BINARY')
+                assert_bqm_almost_equal(new, dense)
+
+        upper = scipy.sparse.csr_matrix(bqm.to_csr(), shape=(50, 50))
+        np.testing.assert_array_almost_equal(
+            upper.toarray() + np.diag([bqm.linear[v] for v in range(50)]),
+            np.triu(matrix.toarray() + np.tril(matrix.toarray(), -1).T))
+
+
+class TestContentHash(unittest.TestCase):
+    @parameterized.expand(BQMs.items())
+    def test_order_independent(self, name, BQM):
+        bqm0 = BQM({'a': 1, 'b': -2}, {'ab': -1, 'bc': 2}, 1.5, 'SPIN')
+        bqm1 = BQM({'c': 0, 'b': -2, 'a': 1}, {'cb': 2, 'ba': -1}, 1.5, 'SPIN')
+
+        if name == 'DictBQM':
+            with self.assertRaises(TypeError):
+                bqm0.content_hash()
+            return
+
+        hash_ = bqm0.content_hash()
+        self.assertIsInstance(hash_, int)
+        self.assertTrue(0 <= hash_ < 2**128)
+        self.assertEqual(bqm1.content_hash(), hash_)
+        self.assertEqual(bqm0.content_hash(num_threads=0), hash_)
+
+    @parameterized.expand(BQM_CLSs.items())
+    def test_content(self, name, BQM):
+        if name == 'DictBQM':
+            return
+
+        bqm = BQM({'a': 1, 'b': -2}, {'ab': -1, 'bc': 2}, 1.5, 'SPIN')
+        hash_ = bqm.content_hash()
+
+        new = bqm.copy()
+        new.offset = 0
+        self.assertNotEqual(new.content_hash(), hash_)
+
+        new = bqm.copy()
+        new.add_quadratic('a', 'c', 0)
+        self.assertNotEqual(new.content_hash(), hash_)
+
+        new = bqm.copy()
+        new.relabel_variables({'a': 'x'})
+        self.assertNotEqual(new.content_hash(), hash_)
+
+        new = bqm.change_vartype('BINARY', inplace=False)
+        self.assertNotEqual(new.content_hash(), hash_)
+        self.assertEqual(bqm.binary.content_hash(), new.content_hash())
+
+    def test_dtype(self):
+        # integer biases are exactly representable in float32
+        bqm = dimod.generators.randint(100, 'BINARY', low=-5, high=5, seed=5)
+
+        self.assertEqual(BinaryQuadraticModel(bqm, dtype=np.float32).content_hash(),
+                         bqm.content_hash())
+
+    def test_numeric_labels(self):
+        self.assertEqual(BinaryQuadraticModel({1.0: 1}, {}, 0, 'SPIN').content_hash(),
+                         BinaryQuadraticModel({np.int8(1): 1}, {}, 0, 'SPIN').content_hash())
+        self.assertNotEqual(BinaryQuadraticModel({1: 1}, {}, 0, 'SPIN').content_hash(),
+                            BinaryQuadraticModel({'1': 1}, {}, 0, 'SPIN').content_hash())
+
+    def test_threads(self):
+        bqm = dimod.generators.gnp_random_bqm(1000, .01, 'SPIN', random_state=5)
+        self.assertEqual(bqm.content_hash(num_threads=4), bqm.content_hash())
+
+
 class TestContractVariables(unittest.TestCase):
     @parameterized.expand(BQMs.items())
     def test_binary(self, name, BQM):
@@ -917,6 +1119,82 @@ class TestDegree(unittest.TestCase):
         np.testing.assert_array_equal(bqm.degrees(array=True), [3, 2, 2, 1])
 
 
+class TestDelta(unittest.TestCase):
+    @parameterized.expand(BQM_CLSs.items())
+    def test_round_trip(self, name, BQM):
+        bqm = BQM({'a': 1, 'b': -2}, {'ab': -1, 'bc': 2}, 1.5, 'SPIN')
+
+        if name == 'DictBQM':
+            with self.assertRaises(TypeError):
+                bqm.checkpoint()
+            return
+
+        remote = bqm.copy()
+        bqm.checkpoint()
+
+        bqm.set_linear('a', 3)
+        bqm.add_quadratic('c', 'a', .5)
+        bqm.remove_interaction('b', 'c')
+        bqm.add_quadratic('d', 'e', -1)
+        bqm.offset = 2
+
+        remote.apply_delta(bqm.to_delta())
+        self.assertTrue(remote.is_equal(bqm))
+        self.assertEqual(list(remote.variables), list(bqm.variables))
+
+        # again from the new checkpoint, as bytes
+        bqm.checkpoint()
+        bqm.add_linear('e', 1)
+        remote.apply_delta(bqm.to_delta().read())
+        self.assertTrue(remote.is_equal(bqm))
+
+    def test_dtypes(self):
+        bqm = dimod.BQM({'a': 1}, {'ab': 1.5}, 0, 'BINARY', dtype=np.float64)
+        remote = dimod.BQM(bqm, dtype=np.float32)
+        bqm.checkpoint()
+        bqm.set_quadratic('a', 'b', -.25)
+        remote.apply_delta(bqm.to_delta())
+        self.assertTrue(remote.is_equal(bqm))
+
+    def test_invalid(self):
+        bqm = dimod.BQM({'a': 1}, {'ab': 1.5}, 0, 'BINARY')
+
+        with self.assertRaises(ValueError):
+            bqm.to_delta()  # no checkpoint
+
+        remote = bqm.copy()
+        bqm.checkpoint()
+        bqm.add_linear('c', 1)
+        delta = bqm.to_delta().read()
+
+        with self.assertRaises(ValueError):
+            dimod.BQM('BINARY').apply_delta(delta)  # different base
+        with self.assertRaises(ValueError):
+            dimod.BQM({'a': 1, 'b': 0}, {}, 0, 'SPIN').apply_delta(delta)
+        with self.assertRaises(ValueError):
+            dimod.QM.from_bqm(remote).apply_delta(delta)
+
+        bqm.relabel_variables({'a': 'x'})
+        with self.assertRaises(ValueError):
+            bqm.to_delta()
+
+        bqm.checkpoint()
+        bqm.remove_variable('x')
+        with self.assertRaises(ValueError):
+            bqm.to_delta()
+
+    def test_vartype_view(self):
+        bqm = dimod.BQM({'a': 1}, {'ab': 1.5}, 0, 'BINARY')
+
+        with self.assertRaises(TypeError):
+            bqm.spin.checkpoint()
+
+        bqm.checkpoint()
+        bqm.add_linear('a', 1)
+        with self.assertRaises(TypeError):
+            bqm.spin.to_delta()
+
+
 class TestDeprecation(unittest.TestCase):
     @parameterized.expand(BQM_CLSs.items())
     def test_shapeable(self, name, BQM):
@@ -1282,6 +1560,39 @@ class TestFixVariables(unittest.TestCase):
         self.assertEqual(bqm.quadratic, {})
         self.assertEqual(bqm.offset, -2)
 
+    @parameterized.expand(BQMs.items())
+    def test_matches_fix_variable(self, name, BQM):
+        bqm = BQM({'a': -1, 'b': 1, 'c': 3, 'd': .5},
+                  {'ab': 2, 'bc': -1, 'ac': 4, 'cd': 1.5}, 1.5, dimod.SPIN)
+
+        expected = BQM(bqm)
+        for v, value in [('c', -1), ('a', 1)]:
+            expected.fix_variable(v, value)
+
+        bqm.fix_variables([('a', 1), ('c', -1)])
+
+        self.assertEqual(bqm, expected)
+        self.assertEqual(list(bqm.variables), ['b', 'd'])
+
+    @parameterized.expand(BQMs.items())
+    def test_repeated(self, name, BQM):
+        bqm = BQM({'a': -1, 'b': 1}, {'ab': 2}, 0, dimod.BINARY)
+
+        bqm.fix_variables([('a', 0), ('a', 1)])
+
+        self.assertEqual(bqm.linear, {'b': 3})
+        self.assertEqual(bqm.offset, -1)
+
+    @parameterized.expand(BQMs.items())
+    def test_unknown_variable(self, name, BQM):
+        bqm = BQM({'a': -1, 'b': 1}, {'ab': 2}, 0, dimod.BINARY)
+        expected = BQM(bqm)
+
+        with self.assertRaises(ValueError):
+            bqm.fix_variables({'a': 1, 'c': 0})
+
+        self.assertEqual(bqm, expected)
+
 
 class TestFlipVariable(unittest.TestCase):
     @parameterized.expand(BQMs.items())
@@ -1617,6 +1928,54 @@ class TestLen(unittest.TestCase):
         self.assertEqual(len(bqm), 107)
 
 
+class TestLocalFields(unittest.TestCase):
+    @parameterized.expand(BQMs.items())
+    def test_energy_deltas(self, name, BQM):
+        bqm = BQM({'a': 1, 'b': -2}, {'ab': -1, 'bc': 2, 'ca': .5}, 1.5, 'SPIN')
+        samples = np.array([[-1, 1, 1], [1, 1, -1]])
+        labels = ['c', 'a', 'b']
+
+        fields = bqm.local_fields((samples, labels))
+        self.assertEqual(fields.shape, (2, 3))
+
+        # flipping a spin changes the energy by -2 * s[v] * field[v]
+        energies = bqm.energies((samples, labels))
+        for vi, v in enumerate(bqm.variables):
+            flipped = samples.copy()
+            si = labels.index(v)
+            flipped[:, si] *= -1
+            np.testing.assert_array_almost_equal(
+                bqm.energies((flipped, labels)) - energies,
+                -2 * samples[:, si] * fields[:, vi])
+
+    @parameterized.expand(BQMs.items())
+    def test_binary(self, name, BQM):
+        bqm = BQM({'a': 1, 'b': -2}, {'ab': -1, 'bc': 2}, 0, 'BINARY')
+
+        np.testing.assert_array_equal(
+            bqm.local_fields({'a': 1, 'b': 0, 'c': 1}),
+            [[1, -1, 0]])
+
+    @parameterized.expand([(np.float32,), (np.float64,)])
+    def test_threads(self, dtype):
+        bqm = dimod.generators.gnp_random_bqm(1000, .01, 'SPIN', random_state=5)
+        bqm = BinaryQuadraticModel(bqm, dtype=dtype)
+        samples = np.random.default_rng(42).choice([-1, 1], size=(5, 1000))
+
+        np.testing.assert_array_almost_equal(
+            bqm.local_fields(samples, num_threads=4),
+            bqm.local_fields(samples))
+
+    def test_empty(self):
+        bqm = BinaryQuadraticModel('SPIN')
+        self.assertEqual(bqm.local_fields([[], []]).shape, (2, 0))
+
+    def test_missing_variable(self):
+        bqm = BinaryQuadraticModel({'a': 1, 'b': -2}, {}, 0, 'SPIN')
+        with self.assertRaises(ValueError):
+            bqm.local_fields({'a': 1})
+
+
 class TestNBytes(unittest.TestCase):
     @parameterized.expand(BQMs.items())
     def test_small(self, name, BQM):
@@ -2250,6 +2609,91 @@ class TestRelabel(unittest.TestCase):
             self.assertAlmostEqual(newlinear[v], bqm.linear[v])
 
 
+class TestReorderVariables(unittest.TestCase):
+    @parameterized.expand(BQMs.items())
+    def test_labels(self, name, BQM):
+        bqm = BQM({'a': 1, 'b': 2, 'c': 3}, {'ab': -1, 'bc': 5}, 1.5, 'SPIN')
+        new = bqm.copy()
+
+        indices = bqm.reorder_variables(['c', 'a', 'b'])
+
+        np.testing.assert_array_equal(indices, [2, 0, 1])
+        self.assertEqual(list(bqm.variables), ['c', 'a', 'b'])
+        self.assertEqual(bqm, new)
+
+    @parameterized.expand(BQMs.items())
+    def test_orderings(self, name, BQM):
+        # a path with shuffled labels
+        path = [0, 5, 2, 7, 1, 6, 3, 4]
+        bqm = BQM({v: v for v in range(8)}, {(u, v): u + v for u, v in zip(path, path[1:])},
+                  0, 'BINARY')
+        samples = np.random.default_rng(42).integers(0, 2, size=(10, 8))
+        energies = bqm.energies((samples, bqm.variables))
+        variables = list(bqm.variables)
+
+        for order in ['degree', 'rcm']:
+            with self.subTest(order=order):
+                new = bqm.copy()
+                indices = new.reorder_variables(order)
+                self.assertEqual(new, bqm)
+                self.assertEqual(list(new.variables), [variables[i] for i in indices])
+                np.testing.assert_array_equal(
+                    new.energies((samples[:, indices], new.variables)), energies)
+
+        bqm.reorder_variables('rcm')
+        positions = {v: i for i, v in enumerate(bqm.variables)}
+        self.assertEqual(max(abs(positions[u] - positions[v]) for u, v in bqm.quadratic), 1)
+
+    @parameterized.expand(BQMs.items())
+    def test_exceptions(self, name, BQM):
+        bqm = BQM({'a': 1, 'b': 2}, {}, 0, 'SPIN')
+        with self.assertRaises(ValueError):
+            bqm.reorder_variables('alphabetical')
+        with self.assertRaises(ValueError):
+            bqm.reorder_variables(['a', 'a'])
+        with self.assertRaises(ValueError):
+            bqm.reorder_variables(['a'])
+        self.assertEqual(list(bqm.variables), ['a', 'b'])
+
+
+class TestReserve(unittest.TestCase):
+    @parameterized.expand(BQMs.items())
+    def test_reserve(self, name, BQM):
+        bqm = BQM({'a': 1, 'b': 2, 'c': 3}, {}, 0, 'SPIN')
+        new = bqm.copy()
+
+        bqm.reserve(10, 20)
+        bqm.reserve_interactions([2, 1, 1])
+        self.assertEqual(bqm, new)
+
+        bqm.add_quadratic_from({'ab': 1, 'ac': 2})
+        new.add_quadratic_from({'ab': 1, 'ac': 2})
+        self.assertEqual(bqm, new)
+
+        bqm.shrink_to_fit()
+        self.assertEqual(bqm, new)
+
+    @parameterized.expand([(np.float32,), (np.float64,)])
+    def test_capacity(self, dtype):
+        bqm = dimod.BinaryQuadraticModel(3, 'SPIN', dtype=dtype)
+        self.assertEqual(bqm.nbytes(capacity=True), bqm.nbytes())
+
+        bqm.reserve_interactions([2, 1, 1])
+        self.assertGreater(bqm.nbytes(capacity=True), bqm.nbytes())
+
+        bqm.shrink_to_fit()
+        self.assertEqual(bqm.nbytes(capacity=True), bqm.nbytes())
+
+    def test_exceptions(self):
+        bqm = dimod.BinaryQuadraticModel(3, 'SPIN')
+        with self.assertRaises(ValueError):
+            bqm.reserve(-1)
+        with self.assertRaises(ValueError):
+            bqm.reserve_interactions([1, 1, 1, 1])  # too many
+        with self.assertRaises(ValueError):
+            bqm.reserve_interactions([1, -1])
+
+
 class TestResize(unittest.TestCase):
     def test_do_nothing(self):
         bqm = dimod.BQM('BINARY')
@@ -2438,6 +2882,17 @@ class TestSpin(unittest.TestCase):
         json.dumps(bqm.variables.to_serializable())
 
 
+class TestStats(unittest.TestCase):
+    @parameterized.expand([(np.float32,), (np.float64,)])
+    def test_reset(self, dtype):
+        bqm = BinaryQuadraticModel({}, {'ab': 1, 'bc': 1}, 0, 'SPIN', dtype=dtype)
+
+        stats = bqm.data.stats(reset=True)
+        self.assertEqual(set(stats),
+                         {'binary_searches', 'mid_inserts', 'reallocations', 'hash_lookups'})
+        self.assertEqual(set(bqm.data.stats().values()), {0})
+
+
 class TestSymbolic(unittest.TestCase):
     @parameterized.expand(BQMs.items())
     def test_add_number(self, name, BQM):
@@ -3269,6 +3724,27 @@ class TestToNumpyVectors(unittest.TestCase):
         np.testing.assert_array_equal(j, [1, 3, 3])
         np.testing.assert_array_equal(values, [.5, 1.5, -1])
 
+    @parameterized.expand(BQM_CLSs.items())
+    def test_sort_indices_variable_order(self, name, BQM):
+        bqm = BQM.from_ising({'a': 1, 'b': 2, 'c': 3, 'd': 4},
+                             {'ab': .5, 'dc': -1, 'ad': 1.5})
+
+        h, (i, j, values), off = bqm.to_numpy_vectors('dcba', sort_indices=True)
+
+        np.testing.assert_array_equal(h, [4, 3, 2, 1])
+        np.testing.assert_array_equal(i, [0, 0, 2])
+        np.testing.assert_array_equal(j, [1, 3, 3])
+        np.testing.assert_array_equal(values, [-1, 1.5, .5])
+
+    @parameterized.expand(BQMs.items())
+    def test_variable_order_exceptions(self, name, BQM):
+        bqm = BQM({'a': 1, 'b': 2}, {'ab': 3}, 0, 'SPIN')
+
+        with self.assertRaises(ValueError):
+            bqm.to_numpy_vectors('a')
+        with self.assertRaises(ValueError):
+            bqm.to_numpy_vectors('abc')
+
 
 class TestToQUBO(unittest.TestCase):
     @parameterized.expand(BQMs.items())
@@ -3330,6 +3806,17 @@ class TestUpdate(unittest.TestCase):
 
         self.assertEqual(binary, target)
 
+    def test_cross_dtype(self):
+        bqm0 = dimod.BQM({'a': -1}, {'ab': 1}, 1.5, 'SPIN', dtype=np.float64)
+        bqm1 = dimod.BQM({'c': 3, 'a': -2}, {'ab': 5, 'cb': 1}, 1.5, 'SPIN', dtype=np.float32)
+
+        bqm0.update(bqm1)
+
+        target = dimod.BQM({'a': -3, 'c': 3}, {'ba': 6, 'cb': 1}, 3, 'SPIN')
+
+        self.assertEqual(bqm0, target)
+        self.assertEqual(bqm0.dtype, np.float64)
+
     @parameterized.expand(BQMs.items())
     def test_simple(self, name, BQM):
         bqm0 = BQM({'a': -1}, {'ab': 1}, 1.5, 'SPIN')
@@ -12,6 +12,7 @@
 #    See the License for the specific language governing permissions and
 #    limitations under the License.
 
+import copy
 import itertools
 import json
 import numbers
@@ -165,6 +166,73 @@ class TestAddConstraint(unittest.TestCase):
         self.assertEqual(cqm.constraints[label].lhs.upper_bound('i'), 5)
 
 
+class TestAddConstraintsFromArrays(unittest.TestCase):
+    def test_empty(self):
+        cqm = CQM()
+        cqm.add_variables('BINARY', 'ab')
+        self.assertEqual(cqm.add_linear_constraints_from_arrays([0], [], [], [], []), [])
+        self.assertEqual(cqm.num_constraints(), 0)
+
+    def test_invalid(self):
+        cqm = CQM()
+        cqm.add_variables('BINARY', 'ab')
+
+        with self.assertRaises(ValueError):
+            cqm.add_linear_constraints_from_arrays([0, 1], [2], [1], '<=', [1])  # unknown variable
+        with self.assertRaises(ValueError):
+            cqm.add_linear_constraints_from_arrays([0, 2, 1], [0, 1], [1, 1], '<=', [1, 1])
+        with self.assertRaises(ValueError):
+            cqm.add_linear_constraints_from_arrays([0, 1], [0], [1, 2], '<=', [1])
+        with self.assertRaises(ValueError):
+            cqm.add_linear_constraints_from_arrays([0, 1], [0], [1], ['<=', '=='], [1])
+        with self.assertRaises(ValueError):
+            cqm.add_linear_constraints_from_arrays([0, 1, 2], [0, 1], [1, 1], '<=', [1, 1],
+                                                   labels=['c', 'c'])
+
+        cqm.add_constraint([('a', 1)], '<=', label='c')
+        with self.assertRaises(ValueError):
+            cqm.add_linear_constraints_from_arrays([0, 1], [0], [1], '<=', [1], labels=['c'])
+
+        self.assertEqual(cqm.num_constraints(), 1)
+
+    def test_linear(self):
+        cqm = CQM()
+        cqm.add_variables('BINARY', 'xyz')
+        i = cqm.add_variable('INTEGER', 'i', lower_bound=-5, upper_bound=5)
+
+        labels = cqm.add_linear_constraints_from_arrays(
+            np.array([0, 2, 2, 6]), np.array([0, 3, 1, 2, 3, 1]), np.array([1.5, -2, 1, 1, 1, 1]),
+            ['<=', '==', Sense.Ge], [3, 0, 1])
+
+        self.assertEqual(len(labels), 3)
+        self.assertEqual(list(cqm.constraints), labels)
+
+        expected = CQM()
+        expected.add_variables('BINARY', 'xyz')
+        expected.add_variable('INTEGER', 'i', lower_bound=-5, upper_bound=5)
+        expected.add_constraint([('x', 1.5), ('i', -2)], '<=', 3, label=labels[0])
+        expected.add_constraint([], '==', 0, label=labels[1])
+        expected.add_constraint([('y', 2), ('z', 1), ('i', 1)], '>=', 1, label=labels[2])
+
+        self.assertTrue(cqm.is_equal(expected))
+
+    def test_quadratic(self):
+        cqm = CQM()
+        cqm.add_variables('INTEGER', 'ij')
+        cqm.add_variables('BINARY', 'x')
+
+        labels = cqm.add_quadratic_constraints_from_arrays(
+            [0, 1, 2], [0, 2], [2, 1],
+            [0, 2, 3], [0, 1, 2], [1, 1, 2], [3, -1, 2],
+            '<=', [5, 0], labels='ab')
+
+        self.assertEqual(labels, ['a', 'b'])
+        self.assertEqual(cqm.constraints['a'].lhs.to_polystring(), '2*i + 3*i*j - j*j')
+        self.assertEqual(cqm.constraints['a'].rhs, 5)
+        self.assertEqual(cqm.constraints['b'].lhs.to_polystring(), '3*x')
+        self.assertEqual(cqm.constraints['b'].sense, Sense.Le)
+
+
 class TestAddDiscrete(unittest.TestCase):
     def test_bqm(self):
         cqm = CQM()
@@ -408,6 +476,38 @@ class TestBounds(unittest.TestCase):
         self.assertEqual(cqm.constraints['c1'].lhs.upper_bound('i'), 1.5)
 
 
+class TestChangeVartypes(unittest.TestCase):
+    def test_matches_change_vartype(self):
+        s, t, u = dimod.Spins('stu')
+        x, = dimod.Binaries('x')
+
+        cqm = CQM()
+        cqm.set_objective(s*t + 2*t*x - u + 3)
+        cqm.add_constraint(s + t + s*t <= 5, label='c0')
+        cqm.add_constraint(u - x >= -1, label='c1')
+        cqm.add_constraint(2*x <= 1, label='c2')
+
+        new = copy.deepcopy(cqm)
+        new.change_vartypes('BINARY', 'stu')
+
+        for v in 'stu':
+            cqm.change_vartype('BINARY', v)
+
+        self.assertTrue(new.is_almost_equal(cqm))
+
+    def test_invalid(self):
+        s, = dimod.Spins('s')
+        i, = dimod.Integers('i')
+
+        cqm = CQM()
+        cqm.set_objective(s + i)
+        new = copy.deepcopy(cqm)
+
+        with self.assertRaises(TypeError):
+            cqm.change_vartypes('SPIN', 'si')
+        self.assertTrue(new.is_equal(cqm))
+
+
 class TestCheckFeasible(unittest.TestCase):
     def test_simple(self):
         x, y, z = dimod.Binaries('xyz')
@@ -444,6 +544,56 @@ class TestClear(unittest.TestCase):
         cqm.clear()
 
 
+class TestContentHash(unittest.TestCase):
+    def test_order_independent(self):
+        x, y = dimod.Binaries('xy')
+        i = Integer('i', upper_bound=5)
+
+        cqm0 = CQM()
+        cqm0.set_objective(x + 2*y*i)
+        cqm0.add_constraint(x + y <= 1, label='c0')
+        cqm0.add_constraint(i - 2*x >= 1, label='c1', weight=3)
+
+        cqm1 = CQM()
+        cqm1.add_variable('INTEGER', 'i', upper_bound=5)
+        cqm1.add_constraint(i - 2*x >= 1, label='a', weight=3)
+        cqm1.add_constraint(y + x <= 1, label='b')
+        cqm1.set_objective(2*i*y + x)
+
+        self.assertEqual(cqm0.content_hash(), cqm1.content_hash())
+        self.assertEqual(cqm0.content_hash(num_threads=0), cqm1.content_hash())
+
+    def test_content(self):
+        x, y = dimod.Binaries('xy')
+
+        def make_cqm(objective=x + y, constraint=x + y <= 1, weight=None):
+            cqm = CQM()
+            cqm.set_objective(objective)
+            cqm.add_constraint(constraint, label='c0', weight=weight)
+            return cqm
+
+        hash_ = make_cqm().content_hash()
+
+        self.assertEqual(make_cqm().content_hash(), hash_)
+        self.assertNotEqual(make_cqm(constraint=x + y <= 2).content_hash(), hash_)
+        self.assertNotEqual(make_cqm(constraint=x + y >= 1).content_hash(), hash_)
+        self.assertNotEqual(make_cqm(objective=x + y + 1).content_hash(), hash_)
+        self.assertNotEqual(make_cqm(weight=5).content_hash(), hash_)
+        self.assertNotEqual(make_cqm(weight=5).content_hash(),
+                            make_cqm(weight=6).content_hash())
+
+        # the same terms in the constraint rather than the objective
+        self.assertNotEqual(make_cqm(objective=x, constraint=x + 2*y <= 1).content_hash(),
+                            make_cqm(objective=x + y).content_hash())
+
+        cqm = make_cqm()
+        cqm.change_vartype('SPIN', 'x')
+        self.assertNotEqual(cqm.content_hash(), hash_)
+
+    def test_empty(self):
+        self.assertEqual(CQM().content_hash(), CQM().content_hash())
+
+
 class TestCopy(unittest.TestCase):
     def test_deepcopy(self):
         from copy import deepcopy
@@ -471,6 +621,83 @@ class TestCopy(unittest.TestCase):
         self.assertEqual(cqm.constraints[constraint].lhs.get_linear('i'), 10)
 
 
+class TestDelta(unittest.TestCase):
+    def make_cqm(self):
+        x, y, z = dimod.Binaries('xyz')
+        i = Integer('i', upper_bound=5)
+
+        cqm = CQM()
+        cqm.set_objective(x + 2*y + x*y + i)
+        cqm.add_constraint(x + y <= 1, label='c0')
+        cqm.add_constraint(x + y + z == 1, label='c1')
+        cqm.add_constraint(x*y + i >= 1, label='c2', weight=2)
+        return cqm
+
+    def test_round_trip(self):
+        cqm = self.make_cqm()
+        remote = copy.deepcopy(cqm)
+
+        cqm.checkpoint()
+        cqm.objective.set_linear('y', 3)
+        cqm.objective.add_quadratic('x', 'z', 1)
+        cqm.objective.offset = 4
+        cqm.set_upper_bound('i', 10)
+        cqm.constraints['c2'].lhs.set_weight(None)
+        cqm.constraints['c1'].lhs.mark_discrete()
+        cqm.add_constraint(Binary('y') + Binary('w') == 1, label='c3')
+
+        remote.apply_delta(cqm.to_delta())
+        self.assertTrue(remote.is_equal(cqm))
+        self.assertEqual(list(remote.variables), list(cqm.variables))
+        self.assertEqual(list(remote.constraints), list(cqm.constraints))
+        self.assertEqual(remote.upper_bound('i'), 10)
+        self.assertFalse(remote.constraints['c2'].lhs.is_soft())
+        self.assertTrue(remote.constraints['c1'].lhs.is_discrete())
+
+        # only what changed is sent
+        cqm.checkpoint()
+        cqm.constraints['c0'].lhs.set_linear('x', 5)
+        delta = cqm.to_delta().read()
+        self.assertLess(len(delta), len(cqm.to_file().read()))
+
+        remote.apply_delta(delta)
+        self.assertTrue(remote.is_equal(cqm))
+
+    def test_replaced_objective(self):
+        cqm = self.make_cqm()
+        remote = copy.deepcopy(cqm)
+
+        cqm.checkpoint()
+        cqm.set_objective(Binary('x') - Binary('z'))
+
+        remote.apply_delta(cqm.to_delta())
+        self.assertTrue(remote.is_equal(cqm))
+
+    def test_invalid(self):
+        cqm = self.make_cqm()
+
+        with self.assertRaises(ValueError):
+            cqm.to_delta()  # no checkpoint
+
+        remote = copy.deepcopy(cqm)
+        cqm.checkpoint()
+        cqm.add_constraint(Binary('x') + Binary('z') <= 1, label='c3')
+        delta = cqm.to_delta().read()
+
+        remote.remove_constraint('c0')
+        with self.assertRaises(ValueError):
+            remote.apply_delta(delta)
+
+        cqm.relabel_constraints({'c0': 'd0'})
+        with self.assertRaises(ValueError):
+            cqm.to_delta()
+
+        cqm.checkpoint()
+        cqm.remove_constraint('c1')
+        with self.assertRaises(ValueError):
+            cqm.to_delta()
+
+
 class TestFixVariable(unittest.TestCase):
     def test_typical(self):
         x, y, z = dimod.Binaries('xyz')
@@ -1169,6 +1396,48 @@ class TestSpinToBinary(unittest.TestCase):
         self.assertTrue(new.is_equal(cqm))
 
 
+class TestReserve(unittest.TestCase):
+    def test_reserve(self):
+        x, y = dimod.Binaries('xy')
+        cqm = CQM()
+        cqm.reserve_constraints(10)
+        cqm.reserve_variables(10)
+        self.assertEqual(cqm.num_constraints(), 0)
+        self.assertEqual(len(cqm.variables), 0)
+
+        cqm.set_objective(x*y)
+        cqm.add_constraint(x + y <= 1, label='c')
+        cqm.shrink_to_fit()
+
+        self.assertEqual(cqm.objective.quadratic, {('x', 'y'): 1})
+        self.assertEqual(cqm.constraints['c'].lhs.linear, {'x': 1, 'y': 1})
+
+    def test_exceptions(self):
+        cqm = CQM()
+        with self.assertRaises(ValueError):
+            cqm.reserve_constraints(-1)
+        with self.assertRaises(ValueError):
+            cqm.reserve_variables(-1)
+
+
+class TestStats(unittest.TestCase):
+    def test_keys(self):
+        x, y = dimod.Binaries('xy')
+        cqm = CQM()
+        cqm.set_objective(x*y)
+        cqm.add_constraint(x + y <= 1)
+
+        stats = cqm.stats(reset=True)
+        self.assertEqual(set(stats),
+                         {'binary_searches', 'mid_inserts', 'reallocations', 'hash_lookups'})
+        for count in stats.values():
+            self.assertIsInstance(count, int)
+            self.assertGreaterEqual(count, 0)
+
+        # everything was reset
+        self.assertEqual(set(cqm.stats().values()), {0})
+
+
 class TestSerialization(unittest.TestCase):
     @classmethod
     def setUpClass(cls):
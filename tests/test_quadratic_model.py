@@ -346,6 +346,39 @@ class TestChangeVartype(unittest.TestCase):
             qm.change_vartype('SPIN', a)
 
 
+class TestChangeVartypes(unittest.TestCase):
+    def test_matches_change_vartype(self):
+        qm = QM()
+        qm.add_variables_from('SPIN', 'abc')
+        qm.add_variable('BINARY', 'x')
+        qm.add_variable('INTEGER', 'i', upper_bound=5)
+        qm.add_linear_from({'a': 1, 'b': -2, 'c': 3, 'x': -4, 'i': 5})
+        qm.add_quadratic_from({'ab': 1.5, 'bc': -2.5, 'cx': 3.5, 'xi': 4.5, 'ai': -5.5, 'ii': 6})
+        qm.offset = 7
+
+        for vartype, variables in [('BINARY', 'abc'), ('INTEGER', 'axb'), ('SPIN', 'xa')]:
+            with self.subTest(vartype=vartype):
+                new = qm.copy()
+                new.change_vartypes(vartype, variables)
+
+                expected = qm.copy()
+                for v in variables:
+                    expected.change_vartype(vartype, v)
+
+                self.assertTrue(new.is_almost_equal(expected))
+
+    def test_invalid(self):
+        qm = QM()
+        qm.add_variable('SPIN', 's')
+        qm.add_variable('INTEGER', 'i')
+        qm.set_linear('s', 1)
+        new = qm.copy()
+
+        with self.assertRaises(TypeError):
+            qm.change_vartypes('SPIN', 'si')
+        self.assertTrue(qm.is_equal(new))
+
+
 class TestClear(unittest.TestCase):
     def test_clear(self):
         qm = QM()
@@ -367,6 +400,41 @@ class TestClear(unittest.TestCase):
         self.assertEqual(len(qm.variables), 0)
 
 
+class TestContentHash(unittest.TestCase):
+    def test_bqm(self):
+        bqm = dimod.BQM({'a': 1, 'b': -2}, {'ab': -1, 'bc': 2}, 1.5, 'SPIN')
+        self.assertEqual(QM.from_bqm(bqm).content_hash(), bqm.content_hash())
+
+    def test_bounds(self):
+        i = Integer('i', upper_bound=5)
+        j = Integer('j', upper_bound=5)
+        qm = 2*i*j + i - j + 1
+        hash_ = qm.content_hash()
+
+        self.assertEqual((1 - j + i + 2*j*i).content_hash(), hash_)
+
+        qm.set_upper_bound('i', 6)
+        self.assertNotEqual(qm.content_hash(), hash_)
+
+        qm.set_upper_bound('i', 5)
+        self.assertEqual(qm.content_hash(), hash_)
+
+        qm.set_lower_bound('j', -1)
+        self.assertNotEqual(qm.content_hash(), hash_)
+
+    @parameterized.expand([(np.float32,), (np.float64,)])
+    def test_self_loops(self, dtype):
+        qm = QM(dtype=dtype)
+        qm.add_variables_from('INTEGER', 'ijk')
+        qm.set_quadratic('i', 'i', 2)
+        qm.set_quadratic('i', 'j', 2)
+        hash_ = qm.content_hash()
+
+        qm.set_quadratic('i', 'i', 3)
+        self.assertNotEqual(qm.content_hash(), hash_)
+        self.assertEqual(qm.content_hash(num_threads=0), qm.content_hash())
+
+
 class TestConstruction(unittest.TestCase):
     def test_dtype(self):
         self.assertEqual(QM().dtype, np.float64)  # default
@@ -397,6 +465,75 @@ class TestDegree(unittest.TestCase):
         self.assertEqual(qm.degree(x), 1)
 
 
+class TestDelta(unittest.TestCase):
+    @parameterized.expand([(np.float32, np.float64), (np.float64, np.float32)])
+    def test_round_trip(self, dtype, remote_dtype):
+        qm = QM(dtype=dtype)
+        for v in 'ijk':
+            qm.add_variable('INTEGER', v, upper_bound=100)
+        qm.add_quadratic('i', 'j', 2)
+        qm.add_quadratic('j', 'k', -1)
+        remote = QM(dtype=remote_dtype)
+        remote.update(qm)
+
+        qm.checkpoint()
+        qm.set_upper_bound('i', 10)
+        qm.set_lower_bound('k', -5)
+        qm.set_quadratic('i', 'i', 1.5)
+        qm.remove_interaction('j', 'k')
+        qm.add_linear('x', 2, default_vartype='BINARY')
+        qm.add_variable('REAL', 'r', lower_bound=-1, upper_bound=1)
+        qm.add_quadratic('x', 'i', .5)
+        qm.add_linear('r', -1)
+        qm.offset = 3
+
+        remote.apply_delta(qm.to_delta())
+        self.assertTrue(remote.is_equal(qm))
+        self.assertEqual(list(remote.variables), list(qm.variables))
+        for v in qm.variables:
+            self.assertEqual(remote.vartype(v), qm.vartype(v))
+            self.assertEqual(remote.lower_bound(v), qm.lower_bound(v))
+            self.assertEqual(remote.upper_bound(v), qm.upper_bound(v))
+
+    def test_change_vartype(self):
+        qm = QM()
+        qm.add_variables_from('BINARY', 'ab')
+        qm.add_quadratic('a', 'b', 1)
+        remote = qm.copy()
+
+        qm.checkpoint()
+        qm.change_vartype('SPIN', 'a')
+
+        remote.apply_delta(qm.to_delta())
+        self.assertTrue(remote.is_equal(qm))
+        self.assertEqual(remote.vartype('a'), dimod.SPIN)
+
+    def test_invalid(self):
+        qm = QM()
+        qm.add_variables_from('INTEGER', 'ij')
+
+        with self.assertRaises(ValueError):
+            qm.to_delta()  # no checkpoint
+
+        qm.checkpoint()
+        qm.add_variable('INTEGER', 'k')
+        delta = qm.to_delta().read()
+
+        with self.assertRaises(ValueError):
+            QM().apply_delta(delta)
+
+        # the new variable is already there
+        remote = QM()
+        remote.add_variables_from('INTEGER', 'ik')
+        with self.assertRaises(ValueError):
+            remote.apply_delta(delta)
+        self.assertEqual(remote.num_variables, 2)
+
+        qm.relabel_variables_as_integers()
+        with self.assertRaises(ValueError):
+            qm.to_delta()
+
+
 class TestEnergies(unittest.TestCase):
     def test_bug982(self):
         # https://github.com/dwavesystems/dimod/issues/982
@@ -630,6 +767,24 @@ class TestFixVariables(unittest.TestCase):
         self.assertEqual(qm.num_variables, 1)
         self.assertEqual(qm.num_interactions, 0)
 
+    def test_matches_fix_variable(self):
+        qm = QM()
+        qm.add_variables_from('INTEGER', 'ijk')
+        qm.add_variable('BINARY', 'x')
+        qm.add_linear_from({'i': 1, 'j': -2, 'k': 3, 'x': 4})
+        qm.add_quadratic_from({'ij': 2, 'jk': -1, 'ik': 1.5, 'kx': 5, 'ii': 3})
+        qm.offset = 2
+
+        expected = qm.copy()
+        for v, value in [('i', 2), ('k', -1)]:
+            expected.fix_variable(v, value)
+
+        qm.fix_variables({'k': -1, 'i': 2})
+
+        self.assertTrue(qm.is_equal(expected))
+        self.assertEqual(list(qm.variables), ['j', 'x'])
+        self.assertEqual(qm.vartype('x'), dimod.BINARY)
+
 
 class TestFromBQM(unittest.TestCase):
     BQMs = dict(DictBQM=dimod.DictBQM,
@@ -757,6 +912,32 @@ class TestIsEqual(unittest.TestCase):
         self.assertTrue(qm.is_equal(bqm))
 
 
+class TestLocalFields(unittest.TestCase):
+    def test_square_terms(self):
+        qm = QM()
+        qm.add_variables_from('INTEGER', 'ij')
+        qm.add_variable('BINARY', 'x')
+        qm.add_linear_from({'i': 3, 'x': -1})
+        qm.add_quadratic('i', 'i', 1)
+        qm.add_quadratic('i', 'j', -2)
+        qm.add_quadratic('j', 'x', .5)
+
+        fields = qm.local_fields([{'i': 2, 'j': 1, 'x': 1}, {'i': -1, 'j': 3, 'x': 0}])
+
+        np.testing.assert_array_equal(fields, [[3 + 2 * 2 - 2, -2 * 2 + .5, -1 + .5],
+                                               [3 - 2 - 6, 2, -1 + 1.5]])
+
+    def test_threads(self):
+        qm = QM()
+        qm.add_variables_from('INTEGER', range(1000))
+        for v in range(1000):
+            qm.add_quadratic(v, (7 * v) % 1000, v % 3 - 1)
+        samples = np.random.default_rng(42).integers(-5, 5, size=(3, 1000))
+
+        np.testing.assert_array_equal(qm.local_fields(samples, num_threads=0),
+                                      qm.local_fields(samples))
+
+
 class TestNBytes(unittest.TestCase):
     @parameterized.expand([(np.float32,), (np.float64,)])
     def test_small(self, dtype):
@@ -881,6 +1062,53 @@ class TestRemoveVariable(unittest.TestCase):
         self.assertEqual(qm.vartype('k'), dimod.REAL)
 
 
+class TestReorderVariables(unittest.TestCase):
+    def test_labels(self):
+        qm = dimod.QuadraticModel()
+        qm.add_variable('INTEGER', 'i', lower_bound=-5, upper_bound=5)
+        qm.add_variable('INTEGER', 'x', lower_bound=-10, upper_bound=10)
+        qm.add_variable('BINARY', 'b')
+        qm.add_quadratic_from({'ix': 1, 'ii': 2, 'xb': 3})
+        new = qm.copy()
+
+        indices = qm.reorder_variables(['b', 'i', 'x'])
+
+        np.testing.assert_array_equal(indices, [2, 0, 1])
+        self.assertEqual(list(qm.variables), ['b', 'i', 'x'])
+        self.assertTrue(qm.is_equal(new))
+        self.assertEqual(qm.vartype('b'), dimod.BINARY)
+        self.assertEqual(qm.lower_bound('i'), -5)
+        self.assertEqual(qm.upper_bound('x'), 10)
+
+    def test_rcm(self):
+        qm = dimod.QuadraticModel()
+        qm.add_variables_from('INTEGER', range(6))
+        qm.add_quadratic_from({(0, 3): 1, (3, 5): 2, (5, 1): 3, (1, 4): 4, (4, 2): 5})
+        new = qm.copy()
+
+        qm.reorder_variables()
+
+        self.assertTrue(qm.is_equal(new))
+        positions = {v: i for i, v in enumerate(qm.variables)}
+        self.assertEqual(max(abs(positions[u] - positions[v]) for u, v in qm.quadratic), 1)
+
+
+class TestReserve(unittest.TestCase):
+    def test_reserve(self):
+        qm = dimod.QuadraticModel()
+        qm.add_variables_from('INTEGER', 'ijk')
+
+        qm.reserve(100, 1000)
+        qm.reserve_interactions([2, 1, 1])
+        self.assertEqual(qm.num_variables, 3)
+        self.assertGreater(qm.nbytes(capacity=True), qm.nbytes())
+
+        qm.add_quadratic_from({'ij': 1, 'ik': 2})
+        qm.shrink_to_fit()
+        self.assertEqual(qm.nbytes(capacity=True), qm.nbytes())
+        self.assertEqual(qm.quadratic, {('i', 'j'): 1, ('i', 'k'): 2})
+
+
 class TestSpinToBinary(unittest.TestCase):
     def test_triangle(self):
         qm = QM()
@@ -18,6 +18,7 @@ import fractions
 import json
 import pickle
 import unittest
+import unittest.mock
 
 from collections import OrderedDict
 
@@ -823,6 +824,110 @@ class TestKeepVariables(unittest.TestCase):
             dimod.keep_variables(sampleset, 'bcd')
 
 
+class TestLazyEnergies(unittest.TestCase):
+    def setUp(self):
+        rng = np.random.default_rng(42)
+        self.bqm = dimod.BQM({v: rng.uniform(-1, 1) for v in range(10)},
+                             {(u, v): rng.uniform(-1, 1)
+                              for u in range(10) for v in range(u + 1, 10)},
+                             .5, 'SPIN')
+        self.samples = 2 * rng.integers(0, 2, size=(100, 10), dtype=np.int8) - 1
+        self.eager = dimod.SampleSet.from_samples_bqm(self.samples, self.bqm)
+
+        # use small chunks so that there are several
+        patcher = unittest.mock.patch.object(dimod.SampleSet, '_ENERGY_CHUNK_SIZE', 7)
+        patcher.start()
+        self.addCleanup(patcher.stop)
+
+    def lazy(self, **kwargs):
+        return dimod.SampleSet.from_samples_bqm(self.samples, self.bqm,
+                                                lazy_energies=True, **kwargs)
+
+    def test_calculated_on_read(self):
+        energies = dimod.BQM.energies
+        with unittest.mock.patch.object(dimod.BQM, 'energies', autospec=True,
+                                        side_effect=energies) as mock:
+            sampleset = self.lazy()
+
+            self.assertEqual(len(sampleset), 100)
+            self.assertEqual(sampleset.variables, self.eager.variables)
+
+            # only called on no samples, to get the dtype of the energies
+            mock.assert_called_once()
+            self.assertEqual(len(mock.call_args.args[1][0]), 0)
+
+            sampleset.record
+            self.assertEqual(mock.call_count, 16)  # ceil(100 / 7) chunks
+
+            sampleset.record
+            self.assertEqual(mock.call_count, 16)
+
+        self.assertEqual(sampleset, self.eager)
+
+    def test_aggregate(self):
+        self.assertEqual(self.lazy(aggregate_samples=True),
+                         dimod.SampleSet.from_samples_bqm(self.samples, self.bqm,
+                                                          aggregate_samples=True))
+
+    def test_first(self):
+        self.assertEqual(self.lazy().first, self.eager.first)
+
+    def test_lowest(self):
+        self.assertEqual(self.lazy().lowest(), self.eager.lowest())
+
+    def test_dtype(self):
+        bqm = dimod.BQM(self.bqm, dtype=np.float32)
+        sampleset = dimod.SampleSet.from_samples_bqm(self.samples, bqm, lazy_energies=True)
+        eager = dimod.SampleSet.from_samples_bqm(self.samples, bqm)
+
+        # the placeholder column already has the dtype of the energies
+        self.assertEqual(sampleset._record.energy.dtype, eager.record.energy.dtype)
+        self.assertEqual(sampleset, eager)
+
+    def test_model_not_copied(self):
+        sampleset = self.lazy()
+        self.assertIs(sampleset._energy_model, self.bqm)
+
+    def test_pickle(self):
+        new = pickle.loads(pickle.dumps(self.lazy()))
+        self.assertEqual(new, self.eager)
+
+    def test_relabel(self):
+        sampleset = self.lazy()
+        sampleset.relabel_variables({0: 'a'})
+        self.assertEqual(sampleset, self.eager.relabel_variables({0: 'a'}, inplace=False))
+
+    def test_slice(self):
+        sampleset = self.lazy()
+        self.assertEqual(sampleset.slice(2, 6, 3), self.eager.slice(2, 6, 3))
+        self.assertEqual(sampleset.slice(-3, None), self.eager.slice(-3, None))
+
+    def test_truncate(self):
+        for n in [0, 1, 5, 50, 100, 200]:
+            with self.subTest(n=n):
+                self.assertEqual(self.lazy().truncate(n), self.eager.truncate(n))
+
+    def test_truncate_unsorted(self):
+        new = self.lazy().truncate(10, sorted_by=None)
+        self.assertEqual(new, self.eager.truncate(10, sorted_by=None))
+
+    def test_ties(self):
+        samples = np.ones((20, 3), dtype=np.int8)
+        samples[::4] = -1
+        bqm = dimod.BQM({0: 1, 1: 1, 2: 1}, {}, 0, 'SPIN')
+
+        sampleset = dimod.SampleSet.from_samples_bqm(samples, bqm, lazy_energies=True)
+        new = sampleset.truncate(6)
+
+        # the lowest rows, in row order among equal energies
+        np.testing.assert_array_equal(new.record.energy, [-3] * 5 + [3])
+        np.testing.assert_array_equal(new.record.sample, samples[[0, 4, 8, 12, 16, 1]])
+
+        # the same rows when the energies are calculated up front
+        eager = dimod.SampleSet.from_samples_bqm(samples, bqm)
+        self.assertEqual(eager.truncate(6), new)
+
+
 class TestLowest(unittest.TestCase):
     def test_all_equal(self):
         sampleset = dimod.ExactSolver().sample_ising({}, {'ab': 0})
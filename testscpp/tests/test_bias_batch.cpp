@@ -0,0 +1,128 @@
+// Copyright 2023 D-Wave Systems Inc.
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+
+#include <vector>
+
+#include "catch2/catch.hpp"
+#include "dimod/bias_batch.h"
+#include "dimod/binary_quadratic_model.h"
+#include "dimod/quadratic_model.h"
+
+namespace dimod {
+
+SCENARIO("a bias batch shares one structure between many variants") {
+    GIVEN("a BQM and a batch of three variants of it") {
+        auto bqm = BinaryQuadraticModel<double>(4, Vartype::BINARY);
+        bqm.set_linear(0, {1, -2, 3, -4});
+        bqm.add_quadratic(0, 1, 1);
+        bqm.add_quadratic(1, 2, -1);
+        bqm.add_quadratic(3, 0, 2);
+        bqm.set_offset(.5);
+
+        auto batch = BiasBatch<double>(bqm, 3);
+
+        THEN("it has the structure of the BQM") {
+            CHECK(batch.num_variants() == 3);
+            CHECK(batch.num_variables() == 4);
+            CHECK(batch.num_interactions() == 3);
+            CHECK(batch.num_biases() == 4 + 3 + 1);
+            CHECK(batch.vartype(2) == Vartype::BINARY);
+            CHECK(batch.upper_bound(2) == 1);
+        }
+
+        THEN("every variant has the biases of the BQM") {
+            for (size_t k = 0; k < 3; ++k) {
+                CHECK(batch.offset(k) == .5);
+                CHECK(batch.linear(k, 3) == -4);
+                CHECK(batch.quadratic(k, 0, 3) == 2);
+                CHECK(batch.quadratic(k, 3, 0) == 2);
+                CHECK(batch.quadratic(k, 2, 3) == 0);
+                CHECK(batch.to_model(k).is_equal(bqm));
+            }
+        }
+
+        WHEN("the variants are changed independently") {
+            batch.set_quadratic(1, 3, 0, 10);
+            batch.set_linear(1, 0, -1);
+            batch.set_offset(2, 0);
+            for (size_t i = 0; i < batch.num_biases(); ++i) batch.data(2)[i] *= 2;
+
+            THEN("each variant has its own biases") {
+                CHECK(batch.quadratic(0, 0, 3) == 2);
+                CHECK(batch.quadratic(1, 0, 3) == 10);
+                CHECK(batch.linear(1, 0) == -1);
+                CHECK(batch.quadratic(2, 1, 2) == -2);
+                CHECK(batch.offset(2) == 0);
+            }
+
+            THEN("the batched energies match the energies of the extracted models") {
+                std::vector<int> samples;
+                for (int s = 0; s < 16; ++s) {
+                    for (int v = 0; v < 4; ++v) samples.push_back((s >> v) & 1);
+                }
+
+                std::vector<double> energies(3 * 16);
+                batch.energies(samples.data(), 16, energies.data());
+
+                for (size_t k = 0; k < 3; ++k) {
+                    auto qm = batch.to_model(k);
+                    for (int s = 0; s < 16; ++s) {
+                        CHECK(energies[k * 16 + s] == qm.energy(samples.begin() + 4 * s));
+                        CHECK(batch.energy(k, samples.begin() + 4 * s) ==
+                              qm.energy(samples.begin() + 4 * s));
+                    }
+                }
+            }
+
+            AND_WHEN("we add a copy of a variant and drop the first two") {
+                auto k = batch.add_variant(1);
+                REQUIRE(k == 3);
+                batch.set_offset(k, 7);
+
+                CHECK(batch.quadratic(3, 0, 3) == 10);
+                CHECK(batch.offset(1) == .5);
+
+                batch.resize(2);
+                CHECK(batch.num_variants() == 2);
+            }
+        }
+
+        THEN("interactions outside of the structure cannot be set") {
+            CHECK_THROWS_AS(batch.set_quadratic(0, 2, 3, 1), std::out_of_range);
+        }
+    }
+
+    GIVEN("a quadratic model with a self-loop") {
+        auto qm = QuadraticModel<float>();
+        qm.add_variable(Vartype::INTEGER, -3, 3);
+        qm.add_variable(Vartype::REAL, 0, 10);
+        qm.add_quadratic(0, 0, 1.5);
+        qm.add_quadratic(0, 1, -1);
+
+        auto batch = BiasBatch<float>(qm, 2);
+        batch.set_quadratic(1, 0, 0, -.5);
+
+        THEN("the self-loop is part of the structure") {
+            CHECK(batch.num_interactions() == 2);
+            CHECK(batch.quadratic(0, 0, 0) == 1.5);
+            CHECK(batch.to_model(0).is_equal(qm));
+            CHECK(batch.to_model(1).lower_bound(0) == -3);
+
+            std::vector<float> sample = {-2, 2.5};
+            CHECK(batch.energy(1, sample.begin()) == Approx(-.5 * 4 + 5));
+        }
+    }
+}
+
+}  // namespace dimod
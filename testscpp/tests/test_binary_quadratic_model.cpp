@@ -12,6 +12,9 @@
 //    See the License for the specific language governing permissions and
 //    limitations under the License.
 
+#include <cstdint>
+#include <vector>
+
 #include "catch2/catch.hpp"
 #include "dimod/binary_quadratic_model.h"
 
@@ -64,6 +67,18 @@ TEST_CASE("BinaryQuadraticModel tests") {
             }
         }
 
+        WHEN("we use fix_variables()") {
+            bqm.fix_variables({3, 1}, {+1, -1});
+            THEN("the variables are removed, their biases distributed and the model is reindexed") {
+                REQUIRE(bqm.num_variables() == 3);
+                REQUIRE(bqm.num_interactions() == 0);
+                CHECK(bqm.offset() == 3);  // -3*+1 + -1*-1 was added to offset
+                CHECK(bqm.linear(0) == 0);
+                CHECK(bqm.linear(1) == 2);  // this was reindexed
+                CHECK(bqm.linear(2) == 4);  // this was reindexed twice
+            }
+        }
+
         WHEN("we use energy()") {
             auto sample = std::vector<int>{0, 1, 1, 0, 1};
             double energy = bqm.energy(sample.begin());
@@ -674,4 +689,270 @@ TEMPLATE_TEST_CASE_SIG("Scenario: BinaryQuadraticModel tests", "[qmbase][bqm]",
         }
     }
 }
+TEST_CASE("BinaryQuadraticModel add_model") {
+    GIVEN("two BQMs with overlapping interactions") {
+        auto bqm = BinaryQuadraticModel<double>(4, Vartype::BINARY);
+        bqm.set_linear(0, {1, 2, 3, 4});
+        bqm.set_quadratic(0, 1, 1);
+        bqm.set_quadratic(1, 3, 13);
+        bqm.set_offset(1);
+
+        auto other = BinaryQuadraticModel<float>(3, Vartype::BINARY);
+        other.set_linear(0, {-1, -2, -3});
+        other.set_quadratic(0, 1, 5);
+        other.set_quadratic(1, 2, 6);
+        other.set_quadratic(0, 2, 7);
+        other.set_offset(2);
+
+        WHEN("we add it with a monotonic mapping") {
+            bqm.add_model(other, std::vector<int>{1, 2, 3});
+
+            THEN("the biases are summed") {
+                REQUIRE(bqm.num_variables() == 4);
+                REQUIRE(bqm.num_interactions() == 4);
+                CHECK(bqm.linear(0) == 1);
+                CHECK(bqm.linear(1) == 1);
+                CHECK(bqm.linear(2) == 1);
+                CHECK(bqm.linear(3) == 1);
+                CHECK(bqm.quadratic(0, 1) == 1);
+                CHECK(bqm.quadratic(1, 2) == 5);
+                CHECK(bqm.quadratic(2, 3) == 6);
+                CHECK(bqm.quadratic(3, 2) == 6);
+                CHECK(bqm.quadratic(1, 3) == 20);
+                CHECK(bqm.quadratic(3, 1) == 20);
+                CHECK(bqm.offset() == 3);
+            }
+
+            THEN("the neighborhoods remain sorted") {
+                for (std::size_t v = 0; v < bqm.num_variables(); ++v) {
+                    CHECK(std::is_sorted(bqm.cbegin_neighborhood(v), bqm.cend_neighborhood(v)));
+                }
+            }
+        }
+
+        WHEN("we add it with an unordered mapping") {
+            bqm.add_model(other, std::vector<int>{3, 0, 1});
+
+            THEN("the biases are summed") {
+                REQUIRE(bqm.num_interactions() == 3);
+                CHECK(bqm.linear(0) == -1);
+                CHECK(bqm.linear(1) == -1);
+                CHECK(bqm.linear(2) == 3);
+                CHECK(bqm.linear(3) == 3);
+                CHECK(bqm.quadratic(0, 3) == 5);
+                CHECK(bqm.quadratic(0, 1) == 7);
+                CHECK(bqm.quadratic(1, 0) == 7);
+                CHECK(bqm.quadratic(1, 3) == 20);
+                CHECK(bqm.quadratic(3, 1) == 20);
+            }
+
+            THEN("the neighborhoods remain sorted") {
+                for (std::size_t v = 0; v < bqm.num_variables(); ++v) {
+                    CHECK(std::is_sorted(bqm.cbegin_neighborhood(v), bqm.cend_neighborhood(v)));
+                }
+            }
+        }
+
+        WHEN("we add it to an empty BQM with an identity mapping") {
+            auto bqm2 = BinaryQuadraticModel<float>(3, Vartype::BINARY);
+            bqm2.add_model(other, std::vector<int>{0, 1, 2});
+
+            THEN("we get a copy") { CHECK(bqm2.is_equal(other)); }
+        }
+    }
+}
+
+TEST_CASE("BinaryQuadraticModel reserve") {
+    GIVEN("a BQM with no interactions") {
+        auto bqm = BinaryQuadraticModel<double>(4, Vartype::SPIN);
+
+        WHEN("we reserve space for the degree of each variable") {
+            std::vector<int> degrees{3, 1, 1, 1};
+            bqm.reserve_interactions(degrees.data(), 4);
+
+            THEN("the model is unchanged but has the capacity") {
+                CHECK(bqm.num_variables() == 4);
+                CHECK(bqm.num_interactions() == 0);
+                CHECK(bqm.is_linear());
+                CHECK(bqm.nbytes(true) >= bqm.nbytes() + 6 * 2 * sizeof(int));
+            }
+
+            AND_WHEN("we add the interactions") {
+                auto before = bqm.nbytes(true);
+                bqm.add_quadratic(0, 1, 1);
+                bqm.add_quadratic(0, 2, 2);
+                bqm.add_quadratic(0, 3, 3);
+
+                THEN("the capacity is unchanged") {
+                    CHECK(bqm.num_interactions() == 3);
+                    CHECK(bqm.nbytes(true) == before);
+                    CHECK(bqm.nbytes(true) == bqm.nbytes());
+                }
+            }
+        }
+
+        WHEN("we reserve space for more variables and interactions") {
+            bqm.reserve(100, 500);
+
+            THEN("the model is unchanged") {
+                CHECK(bqm.num_variables() == 4);
+                CHECK(bqm.num_interactions() == 0);
+                CHECK(bqm.nbytes(true) > bqm.nbytes());
+            }
+
+            AND_WHEN("we shrink it") {
+                bqm.shrink_to_fit();
+
+                THEN("the extra capacity is released") {
+                    CHECK(bqm.nbytes(true) == bqm.nbytes());
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("BinaryQuadraticModel permute") {
+    GIVEN("a BQM with a chain of interactions") {
+        auto bqm = BinaryQuadraticModel<double>(5, Vartype::BINARY);
+        bqm.set_linear(0, {0, 1, 2, 3, 4});
+        bqm.add_quadratic(0, 1, 1);
+        bqm.add_quadratic(1, 2, 12);
+        bqm.add_quadratic(2, 3, 23);
+        bqm.add_quadratic(3, 4, 34);
+
+        WHEN("we reverse the variables") {
+            bqm.permute({4, 3, 2, 1, 0});
+
+            THEN("the biases follow the variables") {
+                CHECK(bqm.num_interactions() == 4);
+                CHECK(bqm.linear(0) == 4);
+                CHECK(bqm.linear(4) == 0);
+                CHECK(bqm.quadratic(4, 3) == 1);
+                CHECK(bqm.quadratic(3, 2) == 12);
+                CHECK(bqm.quadratic(2, 1) == 23);
+                CHECK(bqm.quadratic(1, 0) == 34);
+            }
+
+            THEN("the neighborhoods are sorted") {
+                for (std::size_t v = 0; v < bqm.num_variables(); ++v) {
+                    CHECK(std::is_sorted(bqm.cbegin_neighborhood(v), bqm.cend_neighborhood(v)));
+                }
+            }
+
+            AND_WHEN("we apply the same permutation again") {
+                bqm.permute({4, 3, 2, 1, 0});
+
+                THEN("we get the original model back") {
+                    CHECK(bqm.linear(1) == 1);
+                    CHECK(bqm.quadratic(0, 1) == 1);
+                    CHECK(bqm.quadratic(3, 4) == 34);
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("BinaryQuadraticModel CSR") {
+    GIVEN("an upper-triangular matrix in CSR format") {
+        // [[1, 2, 0, 3],
+        //  [0, 0, 4, 0],
+        //  [0, 0, 5, 0],
+        //  [0, 0, 0, 0]]
+        std::vector<int> indptr = {0, 3, 4, 5, 5};
+        std::vector<int> indices = {0, 1, 3, 2, 2};
+        std::vector<float> data = {1, 2, 3, 4, 5};
+
+        WHEN("it is added to an empty BINARY BQM") {
+            auto bqm = BinaryQuadraticModel<double>(4, Vartype::BINARY);
+            bqm.add_quadratic_from_csr(indptr.data(), indices.data(), data.data(), 4);
+
+            THEN("the diagonal is added to the linear biases") {
+                CHECK(bqm.num_interactions() == 3);
+                CHECK(bqm.quadratic(0, 1) == 2);
+                CHECK(bqm.quadratic(3, 0) == 3);
+                CHECK(bqm.quadratic(1, 2) == 4);
+                CHECK(bqm.linear(0) == 1);
+                CHECK(bqm.linear(2) == 5);
+                CHECK(bqm.offset() == 0);
+            }
+
+            AND_WHEN("it is written back out") {
+                std::vector<int> out_indptr(bqm.num_variables() + 1);
+                std::vector<int> out_indices(bqm.num_interactions());
+                std::vector<double> out_data(bqm.num_interactions());
+                bqm.to_csr(out_indptr.data(), out_indices.data(), out_data.data());
+
+                THEN("we get the off-diagonal entries") {
+                    CHECK(out_indptr == std::vector<int>{0, 2, 3, 3, 3});
+                    CHECK(out_indices == std::vector<int>{1, 3, 2});
+                    CHECK(out_data == std::vector<double>{2, 3, 4});
+                }
+            }
+        }
+
+        WHEN("it is added to an empty SPIN BQM") {
+            auto bqm = BinaryQuadraticModel<double>(4, Vartype::SPIN);
+            bqm.add_quadratic_from_csr(indptr.data(), indices.data(), data.data(), 4);
+
+            THEN("the diagonal is added to the offset") {
+                CHECK(bqm.num_interactions() == 3);
+                CHECK(bqm.linear(0) == 0);
+                CHECK(bqm.offset() == 6);
+            }
+        }
+
+        WHEN("it is added to a BQM that already has interactions") {
+            auto bqm = BinaryQuadraticModel<double>(4, Vartype::BINARY);
+            bqm.add_quadratic(0, 1, 10);
+            bqm.add_quadratic(2, 3, 20);
+            bqm.add_quadratic_from_csr(indptr.data(), indices.data(), data.data(), 4);
+
+            THEN("the biases are summed") {
+                CHECK(bqm.num_interactions() == 4);
+                CHECK(bqm.quadratic(0, 1) == 12);
+                CHECK(bqm.quadratic(2, 3) == 20);
+                CHECK(bqm.quadratic(0, 3) == 3);
+                CHECK(bqm.linear(0) == 1);
+            }
+        }
+
+        WHEN("only the first rows are given") {
+            auto bqm = BinaryQuadraticModel<double>(4, Vartype::BINARY);
+            bqm.add_quadratic_from_csr(indptr.data(), indices.data(), data.data(), 1);
+
+            THEN("only their entries are added") {
+                CHECK(bqm.num_interactions() == 2);
+                CHECK(bqm.quadratic(0, 1) == 2);
+                CHECK(bqm.quadratic(0, 3) == 3);
+            }
+        }
+    }
+
+    GIVEN("a symmetric matrix with unsorted indices and duplicates") {
+        // [[0, 1, 2],
+        //  [1, 0, 0],
+        //  [2, 0, 0]] with (0, 2) given as 1.5 + .5
+        std::vector<std::int64_t> indptr = {0, 3, 4, 5};
+        std::vector<std::int64_t> indices = {2, 1, 2, 0, 0};
+        std::vector<double> data = {1.5, 1, .5, 1, 2};
+
+        WHEN("it is added to an empty BQM") {
+            auto bqm = BinaryQuadraticModel<float>(3, Vartype::SPIN);
+            bqm.add_quadratic_from_csr(indptr.data(), indices.data(), data.data(), 3);
+
+            THEN("both triangles and the duplicates are summed") {
+                CHECK(bqm.num_interactions() == 2);
+                CHECK(bqm.quadratic(0, 1) == 2);
+                CHECK(bqm.quadratic(0, 2) == 4);
+                CHECK(bqm.num_interactions(1) == 1);
+            }
+
+            THEN("the neighborhoods are sorted") {
+                for (std::size_t v = 0; v < bqm.num_variables(); ++v) {
+                    CHECK(std::is_sorted(bqm.cbegin_neighborhood(v), bqm.cend_neighborhood(v)));
+                }
+            }
+        }
+    }
+}
 }  // namespace dimod
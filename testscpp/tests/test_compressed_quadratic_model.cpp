@@ -0,0 +1,168 @@
+// Copyright 2023 D-Wave Systems Inc.
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+
+#include <vector>
+
+#include "catch2/catch.hpp"
+#include "dimod/binary_quadratic_model.h"
+#include "dimod/compressed_quadratic_model.h"
+#include "dimod/quadratic_model.h"
+
+namespace dimod {
+
+SCENARIO("a compressed quadratic model stores each interaction once") {
+    GIVEN("a binary quadratic model") {
+        auto bqm = BinaryQuadraticModel<double>(5, Vartype::SPIN);
+        bqm.set_offset(1.5);
+        bqm.set_linear(0, {0, -1, +2, -3, +4});
+        bqm.set_quadratic(0, 3, 1);
+        bqm.set_quadratic(4, 1, -2);
+        bqm.set_quadratic(1, 3, 3);
+        bqm.set_quadratic(2, 4, -4);
+
+        WHEN("we compress it") {
+            auto cqm = CompressedQuadraticModel<double>(bqm);
+
+            THEN("the model information is preserved") {
+                REQUIRE(cqm.num_variables() == 5);
+                REQUIRE(cqm.num_interactions() == 4);
+                REQUIRE(cqm.offset() == 1.5);
+                for (int v = 0; v < 5; ++v) {
+                    CHECK(cqm.linear(v) == bqm.linear(v));
+                    CHECK(cqm.vartype(v) == Vartype::SPIN);
+                    CHECK(cqm.lower_bound(v) == -1);
+                    CHECK(cqm.upper_bound(v) == +1);
+                    for (int u = 0; u < 5; ++u) {
+                        CHECK(cqm.quadratic(u, v) == bqm.quadratic(u, v));
+                    }
+                }
+            }
+
+            THEN("the energies match") {
+                std::vector<std::vector<int>> samples = {{-1, -1, -1, -1, -1},
+                                                         {+1, -1, +1, -1, +1},
+                                                         {+1, +1, -1, +1, -1},
+                                                         {+1, +1, +1, +1, +1}};
+                for (auto& sample : samples) {
+                    CHECK(cqm.energy(sample.begin()) == bqm.energy(sample.begin()));
+                }
+            }
+
+            THEN("the neighborhoods can be queried once the transpose is built") {
+                CHECK(!cqm.has_transpose());
+                cqm.build_transpose();
+                CHECK(cqm.has_transpose());
+
+                for (int v = 0; v < 5; ++v) {
+                    auto neighborhood = cqm.neighborhood(v);
+                    REQUIRE(neighborhood.size() == bqm.num_interactions(v));
+                    CHECK(cqm.num_interactions(v) == bqm.num_interactions(v));
+
+                    auto it = bqm.cbegin_neighborhood(v);
+                    for (auto& term : neighborhood) {
+                        CHECK(term.v == it->v);
+                        CHECK(term.bias == it->bias);
+                        ++it;
+                    }
+                }
+
+                cqm.build_transpose();  // a second call does nothing
+                CHECK(cqm.neighborhood(1).size() == 2);
+
+                AND_THEN("copies rebuild them") {
+                    auto copy = cqm;
+                    CHECK(!copy.has_transpose());
+                    copy.build_transpose();
+                    CHECK(copy.neighborhood(1).size() == 2);
+                }
+            }
+
+            THEN("we can recover an equivalent quadratic model") {
+                auto qm = cqm.to_model();
+                CHECK(qm.is_equal(QuadraticModel<double>(bqm)));
+            }
+        }
+    }
+
+    GIVEN("a quadratic model with a self-loop") {
+        auto qm = QuadraticModel<double>();
+        qm.add_variable(Vartype::INTEGER, -5, 5);
+        qm.add_variable(Vartype::BINARY);
+        qm.add_variable(Vartype::REAL, -2, 10);
+        qm.set_linear(0, {1, -2, 3});
+        qm.add_quadratic(0, 0, 1.5);
+        qm.add_quadratic(2, 0, -1);
+        qm.add_quadratic(1, 2, 2);
+
+        WHEN("we compress it") {
+            auto cqm = CompressedQuadraticModel<double>(qm);
+
+            THEN("the self-loop is stored once") {
+                CHECK(cqm.num_interactions() == 3);
+                CHECK(cqm.quadratic(0, 0) == 1.5);
+                cqm.build_transpose();
+                CHECK(cqm.num_interactions(0) == 2);
+                CHECK(cqm.neighborhood(0).front().v == 0);
+            }
+
+            THEN("the vartypes and bounds are preserved") {
+                CHECK(cqm.vartype(0) == Vartype::INTEGER);
+                CHECK(cqm.lower_bound(0) == -5);
+                CHECK(cqm.upper_bound(2) == 10);
+            }
+
+            THEN("the energies match") {
+                std::vector<double> sample = {-3, 1, 2.5};
+                CHECK(cqm.energy(sample.begin()) == Approx(qm.energy(sample.begin())));
+            }
+
+            THEN("we can recover the quadratic model") {
+                CHECK(cqm.to_model().is_equal(qm));
+            }
+        }
+    }
+
+    GIVEN("a fully connected quadratic model") {
+        auto qm = QuadraticModel<double>();
+        qm.add_variables(Vartype::BINARY, 10);
+        for (int u = 0; u < 10; ++u) {
+            for (int v = u + 1; v < 10; ++v) {
+                qm.add_quadratic(u, v, u - v);
+            }
+        }
+
+        WHEN("we compress it") {
+            auto cqm = CompressedQuadraticModel<double>(qm);
+
+            THEN("it uses less memory, more once the neighborhoods are needed") {
+                auto nbytes = cqm.nbytes();
+                CHECK(nbytes < qm.nbytes());
+                cqm.build_transpose();
+                CHECK(cqm.nbytes() > nbytes);
+            }
+        }
+    }
+
+    GIVEN("an empty model") {
+        auto cqm = CompressedQuadraticModel<float>();
+
+        THEN("it has no variables or interactions") {
+            CHECK(cqm.num_variables() == 0);
+            CHECK(cqm.is_linear());
+            CHECK(cqm.to_model().num_variables() == 0);
+        }
+    }
+}
+
+}  // namespace dimod
@@ -0,0 +1,139 @@
+// Copyright 2023 D-Wave Systems Inc.
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+
+#include <functional>
+#include <thread>
+#include <vector>
+
+#include "catch2/catch.hpp"
+#include "dimod/binary_quadratic_model.h"
+#include "dimod/concurrent_model_builder.h"
+#include "dimod/quadratic_model.h"
+
+namespace dimod {
+
+SCENARIO("models can be built from many threads") {
+    GIVEN("a builder and a BQM built serially") {
+        const int num_variables = 100;
+        const int num_threads = 8;
+
+        auto builder = ConcurrentModelBuilder<double>(num_variables, 16);
+        auto expected = BinaryQuadraticModel<double>(num_variables, Vartype::SPIN);
+
+        // every thread touches every variable so the shards are contended
+        auto generate = [num_variables](int t, std::function<void(int, int, double)> add) {
+            for (int u = 0; u < num_variables; ++u) {
+                add(u, u, t);  // linear
+                add(u, (u * 7 + t) % num_variables, 1);
+                add((u * 3 + t) % num_variables, u, -.5);
+            }
+        };
+
+        for (int t = 0; t < num_threads; ++t) {
+            generate(t, [&expected](int u, int v, double bias) {
+                if (u == v) {
+                    expected.add_linear(u, bias);
+                } else {
+                    expected.add_quadratic(u, v, bias);
+                }
+            });
+            expected.add_offset(1);
+        }
+
+        WHEN("the threads add their biases concurrently") {
+            std::vector<std::thread> threads;
+            for (int t = 0; t < num_threads; ++t) {
+                threads.emplace_back([&builder, &generate, t]() {
+                    generate(t, [&builder](int u, int v, double bias) {
+                        if (u == v) {
+                            builder.add_linear(u, bias);
+                        } else {
+                            builder.add_quadratic(u, v, bias);
+                        }
+                    });
+                    builder.add_offset(1);
+                });
+            }
+            for (auto& thread : threads) thread.join();
+
+            AND_WHEN("we finalize on one thread") {
+                auto bqm = BinaryQuadraticModel<double>(num_variables, Vartype::SPIN);
+                builder.finalize(bqm);
+
+                THEN("the BQM matches") { CHECK(bqm.is_equal(expected)); }
+            }
+
+            AND_WHEN("we finalize on several threads") {
+                auto bqm = BinaryQuadraticModel<double>(num_variables, Vartype::SPIN);
+                builder.finalize(bqm, 4);
+
+                THEN("the BQM matches") { CHECK(bqm.is_equal(expected)); }
+
+                AND_WHEN("we finalize again") {
+                    auto empty = BinaryQuadraticModel<double>(num_variables, Vartype::SPIN);
+                    builder.finalize(empty, 0);
+
+                    THEN("the builder was cleared") {
+                        CHECK(empty.is_linear());
+                        CHECK(empty.offset() == 0);
+                    }
+                }
+            }
+
+            AND_WHEN("we finalize into a BQM that already has interactions") {
+                auto bqm = BinaryQuadraticModel<double>(num_variables, Vartype::SPIN);
+                bqm.add_quadratic(0, 1, 10);
+                builder.finalize(bqm, 2);
+
+                THEN("the biases are added") {
+                    expected.add_quadratic(0, 1, 10);
+                    CHECK(bqm.is_equal(expected));
+                }
+            }
+        }
+    }
+
+    GIVEN("a builder with terms on the diagonal") {
+        auto builder = ConcurrentModelBuilder<double>(3);
+        builder.add_quadratic(1, 1, 2);
+        builder.add_quadratic(2, 0, 1.5);
+        builder.add_quadratic(0, 2, 1.5);
+
+        WHEN("we finalize into a quadratic model") {
+            auto qm = QuadraticModel<double>();
+            qm.add_variable(Vartype::BINARY);
+            qm.add_variable(Vartype::INTEGER, -5, 5);
+            qm.add_variable(Vartype::SPIN);
+            builder.finalize(qm);
+
+            THEN("the diagonal is handled according to the vartypes") {
+                CHECK(qm.quadratic(1, 1) == 2);
+                CHECK(qm.quadratic(0, 2) == 3);
+                CHECK(qm.num_interactions() == 2);
+            }
+        }
+
+        WHEN("we finalize into a BINARY-valued BQM") {
+            auto bqm = BinaryQuadraticModel<double>(3, Vartype::BINARY);
+            builder.finalize(bqm);
+
+            THEN("the diagonal becomes linear") {
+                CHECK(bqm.linear(1) == 2);
+                CHECK(bqm.num_interactions() == 1);
+            }
+        }
+    }
+}
+
+}  // namespace dimod
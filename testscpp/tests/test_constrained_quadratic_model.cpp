@@ -524,6 +524,33 @@ SCENARIO("ConstrainedQuadraticModel  tests") {
                 CHECK(const0.quadratic(i, j) == 5);
             }
         }
+
+        WHEN("we fix several variables, some of which are used in the expression") {
+            const0.fix_variables({y, x, j}, {2, 2, -1});
+
+            THEN("only the variables in the expression are fixed") {
+                REQUIRE(const0.num_variables() == 1);
+                CHECK(const0.has_variable(i));
+                CHECK(const0.linear(i) == -2);  // 3 + 5*-1
+                CHECK(const0.num_interactions() == 0);
+                CHECK(const0.offset() == -4);  // 2*-1*2
+                CHECK(const0.variables() == std::vector<int>{i});
+            }
+        }
+
+        WHEN("we export the constraint to CSR") {
+            std::vector<int> indptr(const0.num_variables() + 1);
+            std::vector<int> indices(const0.num_interactions());
+            std::vector<double> data(const0.num_interactions());
+            const0.to_csr(indptr.data(), indices.data(), data.data());
+
+            THEN("the rows and indices are the constraint's variables in its order") {
+                REQUIRE(const0.variables() == std::vector<int>{i, j, x});
+                CHECK(indptr == std::vector<int>{0, 1, 2, 2});
+                CHECK(indices == std::vector<int>{1, 2});  // (i, j) and (j, x)
+                CHECK(data == std::vector<double>{5, 2});
+            }
+        }
     }
 
     GIVEN("A discrete constraint") {
@@ -1016,4 +1043,264 @@ TEST_CASE("Test Expression::remove_variables()") {
     }
 }
 
+TEST_CASE("Test Expression::add_model()") {
+    GIVEN("a CQM with an objective and a BQM") {
+        auto cqm = ConstrainedQuadraticModel<double>();
+        cqm.add_variables(Vartype::BINARY, 5);
+        cqm.objective.add_quadratic(4, 1, 1.5);
+
+        auto bqm = BinaryQuadraticModel<double>(3, Vartype::BINARY);
+        bqm.set_linear(0, {1, 2, 3});
+        bqm.set_quadratic(0, 1, 4);
+        bqm.set_quadratic(1, 2, 5);
+        bqm.set_offset(6);
+
+        WHEN("the BQM is added to the objective") {
+            cqm.objective.add_model(bqm, std::vector<int>{4, 2, 1});
+
+            THEN("the biases are added using the parent's labels") {
+                CHECK(cqm.objective.num_variables() == 3);
+                CHECK(cqm.objective.linear(4) == 1);
+                CHECK(cqm.objective.linear(2) == 2);
+                CHECK(cqm.objective.linear(1) == 3);
+                CHECK(cqm.objective.quadratic(4, 2) == 4);
+                CHECK(cqm.objective.quadratic(2, 1) == 5);
+                CHECK(cqm.objective.quadratic(4, 1) == 1.5);
+                CHECK(cqm.objective.offset() == 6);
+            }
+        }
+    }
+}
+
+TEST_CASE("Test ConstrainedQuadraticModel reserve") {
+    GIVEN("an empty CQM") {
+        auto cqm = ConstrainedQuadraticModel<double>();
+
+        WHEN("we reserve space for constraints and variables") {
+            cqm.reserve_constraints(10);
+            cqm.reserve_variables(100);
+
+            THEN("the model is still empty") {
+                CHECK(cqm.num_constraints() == 0);
+                CHECK(cqm.num_variables() == 0);
+            }
+
+            AND_WHEN("we add variables and reserve space in a constraint") {
+                cqm.add_variables(Vartype::BINARY, 100);
+                auto& constraint = cqm.constraint_ref(cqm.add_constraint());
+                constraint.reserve(50);
+                for (int v = 0; v < 100; v += 2) constraint.add_linear(v, v);
+
+                THEN("the constraint is correct") {
+                    CHECK(constraint.num_variables() == 50);
+                    CHECK(constraint.linear(10) == 10);
+                    CHECK(constraint.linear(11) == 0);
+                }
+
+                AND_WHEN("we reserve interactions by the CQM's variables") {
+                    std::vector<int> degrees(100, 1);
+                    degrees[0] = 3;
+                    constraint.reserve_interactions(degrees.data(), 100);
+                    constraint.reset_stats();
+
+                    constraint.add_quadratic(0, 2, 1);
+                    constraint.add_quadratic(0, 4, 1);
+                    constraint.add_quadratic(0, 6, 1);
+
+                    THEN("the interactions are added without reallocating") {
+                        CHECK(constraint.num_variables() == 50);
+                        CHECK(constraint.num_interactions() == 3);
+                        CHECK(constraint.quadratic(4, 0) == 1);
+                        CHECK(constraint.stats().reallocations == 0);
+                    }
+                }
+
+                THEN("we can shrink the model") {
+                    cqm.shrink_to_fit();
+                    CHECK(cqm.num_variables() == 100);
+                    CHECK(constraint.linear(10) == 10);
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("Test ConstrainedQuadraticModel::permute()") {
+    GIVEN("a CQM with an objective and a constraint") {
+        auto cqm = ConstrainedQuadraticModel<double>();
+        cqm.add_variable(Vartype::BINARY);
+        cqm.add_variable(Vartype::INTEGER, -5, 5);
+        cqm.add_variable(Vartype::SPIN);
+
+        cqm.objective.add_linear(0, 1);
+        cqm.objective.add_quadratic(0, 1, 2);
+        auto c = cqm.add_linear_constraint({1, 2}, {3, 4}, Sense::LE, 5);
+
+        WHEN("we permute the variables") {
+            cqm.permute({2, 0, 1});
+
+            THEN("the variable information follows the variables") {
+                CHECK(cqm.vartype(0) == Vartype::INTEGER);
+                CHECK(cqm.lower_bound(0) == -5);
+                CHECK(cqm.vartype(1) == Vartype::SPIN);
+                CHECK(cqm.vartype(2) == Vartype::BINARY);
+            }
+
+            THEN("the objective and constraint follow the variables") {
+                CHECK(cqm.objective.linear(2) == 1);
+                CHECK(cqm.objective.quadratic(2, 0) == 2);
+                CHECK(!cqm.objective.has_variable(1));
+
+                const auto& constraint = cqm.constraint_ref(c);
+                CHECK(constraint.linear(0) == 3);
+                CHECK(constraint.linear(1) == 4);
+                CHECK(!constraint.has_variable(2));
+                CHECK(constraint.rhs() == 5);
+            }
+        }
+    }
+}
+
+TEST_CASE("Test ConstrainedQuadraticModel::change_vartypes()") {
+    GIVEN("a CQM with spin variables in the objective and several constraints") {
+        auto cqm = ConstrainedQuadraticModel<double>();
+        cqm.add_variables(Vartype::SPIN, 4);
+        cqm.add_variable(Vartype::BINARY);
+
+        cqm.objective.set_linear(0, 1);
+        cqm.objective.add_quadratic(0, 1, 2);
+        cqm.objective.add_quadratic(1, 4, 3);
+        cqm.objective.set_offset(4);
+
+        cqm.add_linear_constraint({0, 2}, {1, 2}, Sense::LE, 5);
+        auto c1 = cqm.add_linear_constraint({3, 4}, {3, 4}, Sense::GE, 6);
+        cqm.constraint_ref(c1).add_quadratic(2, 3, 5);
+        cqm.add_linear_constraint({4}, {7}, Sense::EQ, 1);  // unaffected
+
+        auto expected = cqm;
+
+        WHEN("we change all of the spin variables to binary") {
+            cqm.change_vartypes(Vartype::BINARY, {0, 1, 2, 3});
+            for (int v : {0, 1, 2, 3}) expected.change_vartype(Vartype::BINARY, v);
+
+            THEN("the model matches changing them one at a time") {
+                for (int v = 0; v < 5; ++v) {
+                    CHECK(cqm.vartype(v) == Vartype::BINARY);
+                    CHECK(cqm.objective.linear(v) == expected.objective.linear(v));
+                    for (int u = 0; u < 5; ++u) {
+                        CHECK(cqm.objective.quadratic(u, v) == expected.objective.quadratic(u, v));
+                    }
+                }
+                CHECK(cqm.objective.offset() == expected.objective.offset());
+
+                for (std::size_t c = 0; c < cqm.num_constraints(); ++c) {
+                    const auto& lhs = cqm.constraint_ref(c);
+                    const auto& rhs = expected.constraint_ref(c);
+
+                    CHECK(lhs.variables() == rhs.variables());
+                    CHECK(lhs.offset() == rhs.offset());
+                    for (int v = 0; v < 5; ++v) {
+                        CHECK(lhs.linear(v) == rhs.linear(v));
+                        for (int u = 0; u < 5; ++u) {
+                            CHECK(lhs.quadratic(u, v) == rhs.quadratic(u, v));
+                        }
+                    }
+                }
+            }
+        }
+
+        WHEN("an unsupported change is requested") {
+            cqm.add_variable(Vartype::INTEGER, -5, 5);
+
+            THEN("an exception is thrown and the model is unchanged") {
+                CHECK_THROWS_AS(cqm.change_vartypes(Vartype::SPIN, {4, 5}), std::logic_error);
+                CHECK(cqm.vartype(4) == Vartype::BINARY);
+                CHECK(cqm.constraint_ref(2).linear(4) == 7);
+            }
+        }
+    }
+}
+
+TEST_CASE("Test ConstrainedQuadraticModel::add_linear_constraints_from_arrays()") {
+    auto cqm = ConstrainedQuadraticModel<double>();
+    cqm.add_variables(Vartype::BINARY, 4);
+    cqm.add_variable(Vartype::INTEGER, -5, 5);
+    cqm.add_linear_constraint({0}, {1}, Sense::LE, 1);
+
+    GIVEN("three linear constraints in CSR format") {
+        std::vector<int> indptr{0, 2, 2, 6};
+        std::vector<int> indices{0, 4, 1, 2, 3, 1};
+        std::vector<float> coefficients{1.5, -2, 1, 1, 1, 1};
+        std::vector<Sense> senses{Sense::LE, Sense::EQ, Sense::GE};
+        std::vector<double> rhs{3, 0, 1};
+
+        WHEN("they are added to the model") {
+            auto c = cqm.add_linear_constraints_from_arrays(3, indptr.data(), indices.data(),
+                                                            coefficients.data(), senses.data(),
+                                                            rhs.data());
+
+            THEN("the constraints match those added one at a time") {
+                CHECK(c == 1);
+                REQUIRE(cqm.num_constraints() == 4);
+
+                auto& c0 = cqm.constraint_ref(1);
+                CHECK(c0.variables() == std::vector<int>{0, 4});
+                CHECK(c0.linear(0) == 1.5);
+                CHECK(c0.linear(4) == -2);
+                CHECK(c0.sense() == Sense::LE);
+                CHECK(c0.rhs() == 3);
+
+                auto& c1 = cqm.constraint_ref(2);
+                CHECK(c1.num_variables() == 0);
+                CHECK(c1.sense() == Sense::EQ);
+
+                auto& c2 = cqm.constraint_ref(3);
+                CHECK(c2.variables() == std::vector<int>{1, 2, 3});
+                CHECK(c2.linear(1) == 2);  // repeated variables are summed
+                CHECK(c2.linear(2) == 1);
+                CHECK(c2.is_linear());
+                CHECK(c2.sense() == Sense::GE);
+                CHECK(c2.rhs() == 1);
+            }
+        }
+    }
+
+    GIVEN("two quadratic constraints") {
+        std::vector<int> indptr{0, 1, 3};
+        std::vector<int> indices{4, 0, 1};
+        std::vector<double> coefficients{1, 2, 3};
+        std::vector<int> qindptr{0, 2, 3};
+        std::vector<int> qrow{0, 4, 1};
+        std::vector<int> qcol{4, 1, 1};
+        std::vector<double> qcoefficients{-1, 5, 4};
+        std::vector<Sense> senses{Sense::GE, Sense::LE};
+        std::vector<double> rhs{-3, 2};
+
+        WHEN("they are added to the model") {
+            auto c = cqm.add_quadratic_constraints_from_arrays(
+                    2, indptr.data(), indices.data(), coefficients.data(), qindptr.data(),
+                    qrow.data(), qcol.data(), qcoefficients.data(), senses.data(), rhs.data());
+
+            THEN("the constraints have the linear and quadratic terms") {
+                CHECK(c == 1);
+                REQUIRE(cqm.num_constraints() == 3);
+
+                auto& c0 = cqm.constraint_ref(1);
+                CHECK(c0.num_variables() == 3);
+                CHECK(c0.linear(4) == 1);
+                CHECK(c0.quadratic(0, 4) == -1);
+                CHECK(c0.quadratic(1, 4) == 5);
+                CHECK(c0.sense() == Sense::GE);
+                CHECK(c0.rhs() == -3);
+
+                // x*x == x for binary variables
+                auto& c1 = cqm.constraint_ref(2);
+                CHECK(c1.variables() == std::vector<int>{0, 1});
+                CHECK(c1.linear(1) == 7);
+                CHECK(c1.is_linear());
+                CHECK(c1.sense() == Sense::LE);
+            }
+        }
+    }
+}
 }  // namespace dimod
@@ -0,0 +1,183 @@
+// Copyright 2023 D-Wave Systems Inc.
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+
+#include <cstdint>
+#include <vector>
+
+#include "catch2/catch.hpp"
+#include "dimod/binary_quadratic_model.h"
+#include "dimod/constrained_quadratic_model.h"
+#include "dimod/quadratic_model.h"
+
+namespace dimod {
+
+SCENARIO("the content hash of a quadratic model depends only on its content") {
+    GIVEN("a BQM") {
+        auto bqm = BinaryQuadraticModel<double>(4, Vartype::SPIN);
+        bqm.set_linear(0, {1, -2, 3, 0});
+        bqm.add_quadratic(0, 1, 1.5);
+        bqm.add_quadratic(1, 2, -1);
+        bqm.add_quadratic(3, 0, 2);
+        bqm.set_offset(.5);
+
+        auto hash = bqm.content_hash();
+
+        THEN("the same BQM built in a different order has the same hash") {
+            auto other = BinaryQuadraticModel<float>(4, Vartype::SPIN);
+            other.set_offset(.5);
+            other.add_quadratic(0, 3, 2);
+            other.add_quadratic(2, 1, -1);
+            other.add_quadratic(1, 0, 1.5);
+            other.set_linear(2, 3);
+            other.set_linear(1, -2);
+            other.set_linear(0, 1);
+
+            CHECK(other.content_hash() == hash);
+        }
+
+        THEN("an equivalent QM has the same hash") {
+            auto qm = QuadraticModel<double>(bqm);
+            CHECK(qm.content_hash() == hash);
+        }
+
+        THEN("the hash does not depend on the number of threads") {
+            CHECK(bqm.content_hash(nullptr, 0) == hash);
+            CHECK(bqm.content_hash(nullptr, 3) == hash);
+        }
+
+        THEN("changing a bias, the offset or the vartype changes the hash") {
+            auto other = bqm;
+
+            other.add_quadratic(0, 1, 1e-9);
+            CHECK(other.content_hash() != hash);
+            other.add_quadratic(0, 1, -1e-9);
+
+            other.set_offset(0);
+            CHECK(other.content_hash() != hash);
+            other.set_offset(.5);
+
+            REQUIRE(other.content_hash() == hash);
+
+            other.change_vartype(Vartype::BINARY);
+            CHECK(other.content_hash() != hash);
+        }
+
+        THEN("a zero bias is different from a missing interaction") {
+            auto other = bqm;
+            other.add_quadratic(2, 3, 0);
+            CHECK(other.content_hash() != hash);
+        }
+
+        WHEN("the variables are permuted along with their keys") {
+            std::vector<std::uint64_t> keys = {11, 22, 33, 44};
+            auto keyed = bqm.content_hash(keys.data());
+
+            std::vector<int> permutation = {2, 0, 3, 1};
+            std::vector<std::uint64_t> permuted_keys(4);
+            for (int v = 0; v < 4; ++v) permuted_keys[permutation[v]] = keys[v];
+
+            auto other = bqm;
+            other.permute(permutation);
+
+            THEN("the hash is the same") {
+                CHECK(other.content_hash(permuted_keys.data()) == keyed);
+                CHECK(other.content_hash() != hash);
+            }
+        }
+    }
+
+    GIVEN("a large QM with self-loops") {
+        auto qm = QuadraticModel<double>();
+        qm.add_variables(Vartype::INTEGER, 1000, -3, 3);
+        for (int u = 0; u < 1000; ++u) {
+            qm.set_linear(u, u % 7);
+            for (int v = u; v < 1000; v += 37) qm.add_quadratic(u, v, u - v + .25);
+        }
+
+        THEN("the hash does not depend on the number of threads") {
+            auto hash = qm.content_hash();
+            CHECK(qm.content_hash(nullptr, 4) == hash);
+            CHECK(qm.content_hash(nullptr, 0) == hash);
+        }
+
+        THEN("changing a bound changes the hash") {
+            auto hash = qm.content_hash();
+            qm.set_upper_bound(500, 4);
+            CHECK(qm.content_hash() != hash);
+        }
+    }
+}
+
+SCENARIO("the content hash of a CQM depends only on its content") {
+    GIVEN("a CQM with an objective and two constraints") {
+        auto cqm = ConstrainedQuadraticModel<double>();
+        cqm.add_variables(Vartype::BINARY, 3);
+        cqm.add_variable(Vartype::INTEGER, -5, 5);
+        cqm.objective.add_linear(0, 1);
+        cqm.objective.add_quadratic(1, 3, -2);
+        auto c0 = cqm.add_linear_constraint({0, 1, 2}, {1, 1, 1}, Sense::EQ, 1);
+        auto c1 = cqm.add_linear_constraint({2, 3}, {2, -1}, Sense::LE, 4);
+
+        auto hash = cqm.content_hash();
+
+        THEN("the same CQM with its constraints in a different order has the same hash") {
+            auto other = ConstrainedQuadraticModel<double>();
+            other.add_variables(Vartype::BINARY, 3);
+            other.add_variable(Vartype::INTEGER, -5, 5);
+            other.objective.add_quadratic(3, 1, -2);
+            other.objective.add_linear(0, 1);
+            other.add_linear_constraint({3, 2}, {-1, 2}, Sense::LE, 4);
+            other.add_linear_constraint({2, 1, 0}, {1, 1, 1}, Sense::EQ, 1);
+
+            CHECK(other.content_hash() == hash);
+            CHECK(other.content_hash(nullptr, 2) == hash);
+        }
+
+        THEN("moving a bias from the objective to a constraint changes the hash") {
+            auto other = cqm;
+            other.objective.add_linear(0, -1);
+            other.constraint_ref(c1).add_linear(0, 1);
+            CHECK(other.content_hash() != hash);
+        }
+
+        THEN("changing the sense, right-hand side or weight of a constraint changes the hash") {
+            auto other = cqm;
+
+            other.constraint_ref(c0).set_sense(Sense::GE);
+            CHECK(other.content_hash() != hash);
+            other.constraint_ref(c0).set_sense(Sense::EQ);
+
+            other.constraint_ref(c1).set_rhs(5);
+            CHECK(other.content_hash() != hash);
+            other.constraint_ref(c1).set_rhs(4);
+
+            REQUIRE(other.content_hash() == hash);
+
+            other.constraint_ref(c1).set_weight(5);
+            auto soft = other.content_hash();
+            CHECK(soft != hash);
+
+            other.constraint_ref(c1).set_weight(6);
+            CHECK(other.content_hash() != soft);
+        }
+
+        THEN("changing the bounds of a variable changes the hash") {
+            auto other = cqm;
+            other.set_lower_bound(3, -4);
+            CHECK(other.content_hash() != hash);
+        }
+    }
+}
+
+}  // namespace dimod
@@ -0,0 +1,182 @@
+// Copyright 2023 D-Wave Systems Inc.
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+
+#include <vector>
+
+#include "catch2/catch.hpp"
+#include "dimod/binary_quadratic_model.h"
+#include "dimod/dense_quadratic_model.h"
+
+namespace dimod {
+
+SCENARIO("a dense quadratic model stores its quadratic biases in a matrix") {
+    GIVEN("a dense matrix") {
+        float Q[9] = {1, 0, 3, 2, 1, 0, 1, 0, 0};
+
+        WHEN("we construct a BINARY-valued dense model and BQM from it") {
+            auto dqm = DenseQuadraticModel<double>(Q, 3, Vartype::BINARY);
+            auto bqm = BinaryQuadraticModel<double>(Q, 3, Vartype::BINARY);
+
+            THEN("they have the same biases") {
+                REQUIRE(dqm.num_variables() == 3);
+                CHECK(dqm.num_interactions() == bqm.num_interactions());
+                CHECK(dqm.offset() == bqm.offset());
+                for (int u = 0; u < 3; ++u) {
+                    CHECK(dqm.linear(u) == bqm.linear(u));
+                    CHECK(dqm.num_interactions(u) == bqm.num_interactions(u));
+                    for (int v = 0; v < 3; ++v) {
+                        CHECK(dqm.quadratic(u, v) == bqm.quadratic(u, v));
+                    }
+                }
+            }
+
+            THEN("they have the same energies") {
+                for (int s = 0; s < 8; ++s) {
+                    std::vector<int> sample = {s & 1, (s >> 1) & 1, (s >> 2) & 1};
+                    CHECK(dqm.energy(sample.begin()) == bqm.energy(sample.begin()));
+                }
+            }
+
+            THEN("the rows are the neighborhoods") {
+                std::vector<double> row(dqm.cbegin_row(0), dqm.cend_row(0));
+                CHECK(row == std::vector<double>{0, 2, 4});
+            }
+
+            THEN("we can convert it back to a BQM") {
+                CHECK(dqm.to_bqm().is_equal(bqm));
+            }
+        }
+
+        WHEN("we construct a SPIN-valued dense model from it") {
+            auto dqm = DenseQuadraticModel<double>(Q, 3, Vartype::SPIN);
+
+            THEN("the diagonal is added to the offset") {
+                CHECK(dqm.offset() == 2);
+                CHECK(dqm.linear(0) == 0);
+                CHECK(dqm.lower_bound(0) == -1);
+                CHECK(dqm.upper_bound(0) == +1);
+            }
+        }
+    }
+
+    GIVEN("a fully connected BQM") {
+        const int n = 20;
+        auto bqm = BinaryQuadraticModel<double>(n, Vartype::SPIN);
+        bqm.set_offset(-3);
+        for (int u = 0; u < n; ++u) {
+            bqm.set_linear(u, u % 3 - 1);
+            for (int v = u + 1; v < n; ++v) {
+                bqm.add_quadratic_back(u, v, (u * v) % 5 - 2.5);
+            }
+        }
+
+        WHEN("we make a dense copy") {
+            auto dqm = DenseQuadraticModel<double>(bqm);
+
+            THEN("it uses less memory") { CHECK(dqm.nbytes() < bqm.nbytes()); }
+
+            THEN("the energies match") {
+                std::vector<int> sample(n);
+                for (int s = 0; s < 10; ++s) {
+                    for (int v = 0; v < n; ++v) sample[v] = ((v * 7 + s) % 3) ? +1 : -1;
+                    CHECK(dqm.energy(sample.begin()) == Approx(bqm.energy(sample.begin())));
+                }
+            }
+
+            THEN("we can convert it back to a BQM") { CHECK(dqm.to_bqm().is_equal(bqm)); }
+
+            AND_WHEN("we modify the biases") {
+                dqm.set_quadratic(3, 1, 10);
+                dqm.add_quadratic(1, 3, 1);
+                dqm.add_linear(2, 1.5);
+                dqm.add_offset(3);
+
+                bqm.set_quadratic(3, 1, 10);
+                bqm.add_quadratic(1, 3, 1);
+                bqm.add_linear(2, 1.5);
+                bqm.add_offset(3);
+
+                THEN("the models are still equal") {
+                    CHECK(dqm.quadratic(1, 3) == 11);
+                    CHECK(dqm.quadratic(3, 1) == 11);
+                    CHECK(dqm.to_bqm().is_equal(bqm));
+                }
+            }
+
+            THEN("setting a bias on the diagonal throws") {
+                CHECK_THROWS_AS(dqm.set_quadratic(1, 1, 1), std::domain_error);
+            }
+        }
+    }
+
+    GIVEN("a fully connected BQM whose size is not a multiple of the row block") {
+        const int n = 23;
+        auto bqm = BinaryQuadraticModel<double>(n, Vartype::BINARY);
+        for (int u = 0; u < n; ++u) {
+            bqm.set_linear(u, (u % 4) - 1.5);
+            for (int v = u + 1; v < n; ++v) {
+                bqm.add_quadratic_back(u, v, (u + 2 * v) % 7 - 3);
+            }
+        }
+        auto dqm = DenseQuadraticModel<double>(bqm);
+
+        THEN("the energies match") {
+            std::vector<double> sample(n);
+            for (int s = 0; s < 10; ++s) {
+                for (int v = 0; v < n; ++v) sample[v] = (v * 5 + s) % 3 == 0;
+                CHECK(dqm.energy(sample.begin()) == Approx(bqm.energy(sample.begin())));
+            }
+        }
+
+        THEN("the interactions are counted as they are set") {
+            // some of the biases of the BQM are zero
+            std::size_t nonzero = 0;
+            for (int u = 0; u < n; ++u) {
+                for (int v = u + 1; v < n; ++v) nonzero += bqm.quadratic(u, v) != 0;
+            }
+            REQUIRE(nonzero < bqm.num_interactions());
+            CHECK(dqm.num_interactions() == nonzero);
+            CHECK(!dqm.is_linear());
+
+            REQUIRE(dqm.quadratic(0, 1) != 0);
+            dqm.set_quadratic(0, 1, 0);
+            dqm.set_quadratic(0, 1, 0);
+            CHECK(dqm.num_interactions() == nonzero - 1);
+
+            auto dqm2 = DenseQuadraticModel<double>(3, Vartype::SPIN);
+            CHECK(dqm2.is_linear());
+            dqm2.add_quadratic(0, 2, 1);
+            dqm2.add_quadratic(2, 1, 1);
+            CHECK(dqm2.num_interactions() == 2);
+            dqm2.add_quadratic(2, 0, -1);
+            CHECK(dqm2.num_interactions() == 1);
+            dqm2.set_quadratic(1, 2, 0);
+            CHECK(dqm2.is_linear());
+        }
+    }
+
+    GIVEN("an empty dense model") {
+        auto dqm = DenseQuadraticModel<float>();
+
+        THEN("it has no variables") {
+            CHECK(dqm.num_variables() == 0);
+            CHECK(dqm.is_linear());
+            CHECK(dqm.vartype() == Vartype::BINARY);
+            std::vector<int> sample;
+            CHECK(dqm.energy(sample.begin()) == 0);
+        }
+    }
+}
+
+}  // namespace dimod
@@ -0,0 +1,215 @@
+// Copyright 2023 D-Wave Systems Inc.
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+
+#include <utility>
+#include <vector>
+
+#include "catch2/catch.hpp"
+#include "dimod/binary_quadratic_model.h"
+#include "dimod/constrained_quadratic_model.h"
+#include "dimod/quadratic_model.h"
+
+namespace dimod {
+
+using Pairs = std::vector<std::pair<int, int>>;
+
+SCENARIO("a journal records the changes made to a quadratic model") {
+    GIVEN("a BQM that is not keeping a journal") {
+        auto bqm = BinaryQuadraticModel<double>(5, Vartype::SPIN);
+        bqm.add_quadratic(0, 1, 1);
+        bqm.add_quadratic(2, 3, -1);
+
+        THEN("it has no journal") { CHECK(bqm.journal() == nullptr); }
+
+        WHEN("a journal is started and some biases are changed") {
+            bqm.start_journal();
+            REQUIRE(bqm.journal());
+
+            bqm.set_linear(3, 2);
+            bqm.add_linear(1, .5);
+            bqm.add_linear(3, .5);
+            bqm.add_quadratic(1, 0, 2);
+            bqm.set_quadratic(4, 2, -3);
+            bqm.remove_interaction(3, 2);
+
+            THEN("the journal records which biases changed") {
+                const auto& journal = *bqm.journal();
+                CHECK(journal.valid());
+                CHECK(journal.num_variables() == 5);
+                CHECK(journal.linear() == std::vector<int>{1, 3});
+                CHECK(journal.quadratic() == Pairs{{0, 1}, {2, 3}, {2, 4}});
+                CHECK(!journal.offset_changed());
+                CHECK(journal.variables().empty());
+            }
+
+            AND_WHEN("the offset is set and variables are added") {
+                bqm.set_offset(1);
+                auto v = bqm.add_variable();
+                bqm.add_quadratic(v, 0, 1.5);
+
+                THEN("the journal records them") {
+                    const auto& journal = *bqm.journal();
+                    CHECK(journal.offset_changed());
+                    CHECK(journal.num_variables() == 5);
+                    CHECK(journal.quadratic() == Pairs{{0, 1}, {0, 5}, {2, 3}, {2, 4}});
+                }
+            }
+
+            AND_WHEN("a SPIN self-loop is added") {
+                bqm.add_quadratic(2, 2, 1);
+
+                THEN("only the offset is recorded") {
+                    CHECK(bqm.journal()->offset_changed());
+                    CHECK(bqm.journal()->quadratic() == Pairs{{0, 1}, {2, 3}, {2, 4}});
+                }
+            }
+
+            AND_WHEN("a variable is removed") {
+                bqm.remove_variable(0);
+
+                THEN("the journal is invalidated and stays invalid") {
+                    CHECK(!bqm.journal()->valid());
+                    bqm.set_linear(0, 4);
+                    CHECK(!bqm.journal()->valid());
+                    CHECK(bqm.journal()->linear().empty());
+                }
+            }
+
+            AND_WHEN("the model is scaled") {
+                bqm.scale(2);
+                THEN("the journal is invalidated") { CHECK(!bqm.journal()->valid()); }
+            }
+
+            AND_WHEN("the model is copied") {
+                auto other = bqm;
+                THEN("the journal is not copied") { CHECK(other.journal() == nullptr); }
+            }
+
+            AND_WHEN("the model is moved") {
+                auto other = std::move(bqm);
+                THEN("the journal moves with it") {
+                    REQUIRE(other.journal());
+                    CHECK(other.journal()->linear() == std::vector<int>{1, 3});
+                }
+            }
+
+            AND_WHEN("the journal is restarted") {
+                bqm.start_journal();
+                THEN("the records are cleared") {
+                    CHECK(bqm.journal()->linear().empty());
+                    CHECK(bqm.journal()->quadratic().empty());
+                }
+            }
+
+            AND_WHEN("the journal is stopped") {
+                bqm.stop_journal();
+                THEN("there is no journal") { CHECK(bqm.journal() == nullptr); }
+            }
+        }
+    }
+
+    GIVEN("a QM with a journal") {
+        auto qm = QuadraticModel<double>();
+        qm.add_variables(Vartype::INTEGER, 3, -5, 5);
+        qm.add_variable(Vartype::BINARY);
+        qm.start_journal();
+
+        WHEN("bounds and vartypes are changed") {
+            qm.set_upper_bound(1, 6);
+            qm.change_vartype(Vartype::SPIN, 3);
+            qm.add_quadratic(0, 0, 2);
+
+            THEN("the journal records the variables and the biases") {
+                const auto& journal = *qm.journal();
+                CHECK(journal.variables() == std::vector<int>{1, 3});
+                CHECK(journal.quadratic() == Pairs{{0, 0}});
+                CHECK(journal.offset_changed());  // from the substitution
+            }
+        }
+
+        WHEN("the same interaction is changed many times") {
+            for (int i = 0; i < 5000; ++i) qm.add_quadratic(i % 3, 2, 1);
+
+            THEN("it is reported once") {
+                CHECK(qm.journal()->quadratic() == Pairs{{0, 2}, {1, 2}, {2, 2}});
+            }
+        }
+    }
+}
+
+SCENARIO("a journal records the changes made to a CQM") {
+    GIVEN("a CQM with a journal") {
+        auto cqm = ConstrainedQuadraticModel<double>();
+        cqm.add_variables(Vartype::BINARY, 3);
+        cqm.add_variable(Vartype::INTEGER, -5, 5);
+        cqm.objective.add_linear(0, 1);
+        auto c0 = cqm.add_linear_constraint({1, 2}, {1, 1}, Sense::EQ, 1);
+        auto c1 = cqm.add_linear_constraint({3, 2}, {2, -1}, Sense::LE, 4);
+
+        cqm.start_journal();
+        REQUIRE(cqm.journal());
+        REQUIRE(cqm.objective.journal());
+        REQUIRE(cqm.constraint_ref(c0).journal());
+
+        WHEN("the variables and constraints are changed") {
+            cqm.set_lower_bound(3, -4);
+            cqm.objective.add_quadratic(0, 3, 1);
+            cqm.constraint_ref(c1).set_rhs(3);
+            cqm.constraint_ref(c1).add_linear(2, 1);
+            cqm.add_variable(Vartype::BINARY);
+            cqm.add_constraint();
+
+            THEN("each journal records its own changes") {
+                CHECK(cqm.journal()->num_variables() == 4);
+                CHECK(cqm.journal()->num_constraints() == 2);
+                CHECK(cqm.journal()->variables() == std::vector<int>{3});
+
+                // the objective's journal uses its own indices
+                CHECK(cqm.objective.journal()->quadratic() == Pairs{{0, 1}});
+
+                CHECK(!cqm.constraint_ref(c0).journal()->changed());
+                CHECK(cqm.constraint_ref(c1).journal()->changed());
+
+                const auto& journal = *cqm.constraint_ref(c1).journal();
+                CHECK(journal.attributes_changed());
+                CHECK(journal.linear() == std::vector<int>{1});
+            }
+        }
+
+        WHEN("a constraint is removed") {
+            cqm.remove_constraint(c0);
+            THEN("the journal is invalidated") { CHECK(!cqm.journal()->valid()); }
+        }
+
+        WHEN("a variable is removed") {
+            cqm.remove_variable(0);
+            THEN("the journals are invalidated") {
+                CHECK(!cqm.journal()->valid());
+                CHECK(!cqm.objective.journal()->valid());
+                CHECK(!cqm.constraint_ref(c1).journal()->valid());
+            }
+        }
+
+        WHEN("the journal is stopped") {
+            cqm.stop_journal();
+            THEN("there are no journals") {
+                CHECK(cqm.journal() == nullptr);
+                CHECK(cqm.objective.journal() == nullptr);
+                CHECK(cqm.constraint_ref(c1).journal() == nullptr);
+            }
+        }
+    }
+}
+
+}  // namespace dimod
@@ -0,0 +1,179 @@
+// Copyright 2023 D-Wave Systems Inc.
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+
+#include <algorithm>
+#include <vector>
+
+#include "catch2/catch.hpp"
+#include "dimod/binary_quadratic_model.h"
+#include "dimod/constrained_quadratic_model.h"
+#include "dimod/orderings.h"
+#include "dimod/quadratic_model.h"
+
+namespace dimod {
+
+// the largest |u - v| over all interactions
+template <class bias_type, class index_type>
+index_type bandwidth(const abc::QuadraticModelBase<bias_type, index_type>& qm) {
+    index_type bw = 0;
+    for (auto it = qm.cbegin_quadratic(); it != qm.cend_quadratic(); ++it) {
+        bw = std::max<index_type>(bw, it->u - it->v);
+    }
+    return bw;
+}
+
+SCENARIO("reordering the variables of a model", "[orderings]") {
+    GIVEN("a BQM with linear and quadratic biases") {
+        auto bqm = BinaryQuadraticModel<double>(4, Vartype::SPIN);
+        bqm.set_linear(0, {0, 1, 2, 3});
+        bqm.add_quadratic(0, 1, 1.5);
+        bqm.add_quadratic(0, 3, -2);
+        bqm.add_quadratic(2, 3, 3);
+        bqm.set_offset(5);
+
+        WHEN("the variables are reordered") {
+            bqm.reorder({3, 1, 0, 2});
+
+            THEN("the biases follow the variables") {
+                CHECK(bqm.num_variables() == 4);
+                CHECK(bqm.num_interactions() == 3);
+                CHECK(bqm.linear(0) == 3);
+                CHECK(bqm.linear(1) == 1);
+                CHECK(bqm.linear(2) == 0);
+                CHECK(bqm.linear(3) == 2);
+                CHECK(bqm.quadratic(2, 1) == 1.5);
+                CHECK(bqm.quadratic(2, 0) == -2);
+                CHECK(bqm.quadratic(3, 0) == 3);
+                CHECK(bqm.offset() == 5);
+            }
+
+            THEN("the neighborhoods are still sorted") {
+                for (std::size_t v = 0; v < bqm.num_variables(); ++v) {
+                    CHECK(std::is_sorted(bqm.cbegin_neighborhood(v), bqm.cend_neighborhood(v)));
+                }
+            }
+        }
+    }
+
+    GIVEN("a QM with mixed vartypes") {
+        auto qm = QuadraticModel<double>();
+        qm.add_variable(Vartype::BINARY);
+        qm.add_variable(Vartype::INTEGER, -5, 5);
+        qm.add_variable(Vartype::SPIN);
+        qm.add_quadratic(0, 1, 2);
+        qm.add_quadratic(1, 1, 3);
+
+        WHEN("the variables are reordered") {
+            qm.reorder({1, 2, 0});
+
+            THEN("the vartypes and bounds follow the variables") {
+                CHECK(qm.vartype(0) == Vartype::INTEGER);
+                CHECK(qm.lower_bound(0) == -5);
+                CHECK(qm.upper_bound(0) == 5);
+                CHECK(qm.vartype(1) == Vartype::SPIN);
+                CHECK(qm.vartype(2) == Vartype::BINARY);
+                CHECK(qm.quadratic(0, 2) == 2);
+                CHECK(qm.quadratic(0, 0) == 3);
+            }
+        }
+    }
+
+    GIVEN("a CQM with a constraint") {
+        auto cqm = ConstrainedQuadraticModel<double>();
+        cqm.add_variables(Vartype::BINARY, 5);
+        auto c = cqm.add_linear_constraint({4, 1}, {1, 2}, Sense::LE, 1);
+        cqm.constraint_ref(c).add_quadratic(4, 1, 3);
+
+        WHEN("the constraint's variables are reordered") {
+            auto& constraint = cqm.constraint_ref(c);
+            constraint.reorder({1, 0});
+
+            THEN("the constraint is unchanged by label") {
+                CHECK(constraint.variables() == std::vector<int>{1, 4});
+                CHECK(constraint.linear(4) == 1);
+                CHECK(constraint.linear(1) == 2);
+                CHECK(constraint.quadratic(1, 4) == 3);
+                CHECK(constraint.has_variable(1));
+                CHECK(constraint.has_variable(4));
+            }
+        }
+    }
+}
+
+SCENARIO("variable orderings", "[orderings]") {
+    GIVEN("a BQM over a path with scrambled labels") {
+        // the path 0 - 5 - 2 - 7 - 1 - 6 - 3 - 4
+        std::vector<int> path = {0, 5, 2, 7, 1, 6, 3, 4};
+        auto bqm = BinaryQuadraticModel<double>(8, Vartype::BINARY);
+        for (std::size_t i = 1; i < path.size(); ++i) {
+            bqm.add_quadratic(path[i - 1], path[i], i);
+        }
+        bqm.add_variable();  // an isolated variable
+
+        WHEN("we compute the degree ordering") {
+            auto order = degree_order(bqm);
+
+            THEN("the variables are sorted by degree, then by index") {
+                CHECK(order == std::vector<int>{8, 0, 4, 1, 2, 3, 5, 6, 7});
+            }
+        }
+
+        WHEN("we compute the descending degree ordering") {
+            auto order = degree_order(bqm, true);
+
+            THEN("the variables are sorted by decreasing degree, then by index") {
+                CHECK(order == std::vector<int>{1, 2, 3, 5, 6, 7, 0, 4, 8});
+            }
+        }
+
+        WHEN("we reorder using reverse Cuthill-McKee") {
+            auto order = reverse_cuthill_mckee(bqm);
+
+            THEN("the ordering is a permutation") {
+                auto sorted = order;
+                std::sort(sorted.begin(), sorted.end());
+                CHECK(sorted == std::vector<int>{0, 1, 2, 3, 4, 5, 6, 7, 8});
+            }
+
+            bqm.reorder(order);
+
+            THEN("the bandwidth is minimal") {
+                CHECK(bandwidth(bqm) == 1);
+                CHECK(bqm.num_interactions() == 7);
+            }
+        }
+    }
+
+    GIVEN("a BQM with no interactions") {
+        auto bqm = BinaryQuadraticModel<double>(3, Vartype::BINARY);
+
+        THEN("the orderings are valid") {
+            CHECK(degree_order(bqm) == std::vector<int>{0, 1, 2});
+            CHECK(reverse_cuthill_mckee(bqm) == std::vector<int>{2, 1, 0});
+        }
+
+        AND_WHEN("it is reordered") {
+            bqm.set_linear(0, {1, 2, 3});
+            bqm.reorder({2, 1, 0});
+
+            THEN("only the linear biases move") {
+                CHECK(bqm.linear(0) == 3);
+                CHECK(bqm.linear(2) == 1);
+                CHECK(bqm.num_interactions() == 0);
+            }
+        }
+    }
+}
+
+}  // namespace dimod
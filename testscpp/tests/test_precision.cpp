@@ -0,0 +1,104 @@
+// Copyright 2023 D-Wave Systems Inc.
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+
+#include <type_traits>
+#include <vector>
+
+#include "catch2/catch.hpp"
+#include "dimod/binary_quadratic_model.h"
+#include "dimod/precision.h"
+
+namespace dimod {
+
+// These tests are compiled both with and without DIMOD_EXTENDED_PRECISION
+// defined, see the Makefile.
+
+constexpr bool extended_precision = std::is_same<accumulator_t<float>, double>::value;
+
+TEST_CASE("accumulator types", "[precision]") {
+    if (extended_precision) {
+        CHECK(std::is_same<accumulator_t<double>, long double>::value);
+    } else {
+        CHECK(std::is_same<accumulator_t<float>, float>::value);
+        CHECK(std::is_same<accumulator_t<double>, double>::value);
+    }
+    CHECK(std::is_same<accumulator_t<int>, int>::value);
+}
+
+SCENARIO("float models accumulate their sums", "[precision]") {
+    GIVEN("a float BQM and a double BQM with many small biases") {
+        const int num_variables = 1000;
+
+        // both models get exactly the same biases
+        auto fbqm = BinaryQuadraticModel<float>(num_variables, Vartype::SPIN);
+        auto dbqm = BinaryQuadraticModel<double>(num_variables, Vartype::SPIN);
+        for (int v = 0; v < num_variables; ++v) {
+            fbqm.set_linear(v, .1f);
+            dbqm.set_linear(v, .1f);
+            for (int u = v + 1; u < num_variables && u < v + 100; ++u) {
+                fbqm.add_quadratic(u, v, (u + v) % 2 ? .1f : -.3f);
+                dbqm.add_quadratic(u, v, (u + v) % 2 ? .1f : -.3f);
+            }
+        }
+        fbqm.set_offset(.7f);
+        dbqm.set_offset(.7f);
+
+        std::vector<int> sample(num_variables, +1);
+        for (int v = 0; v < num_variables; v += 3) sample[v] = -1;
+
+        THEN("the energies match to within the precision of the accumulator") {
+            double reference = dbqm.energy(sample.begin());
+            if (extended_precision) {
+                CHECK(fbqm.energy(sample.begin()) == static_cast<float>(reference));
+            } else {
+                CHECK(fbqm.energy(sample.begin()) == Approx(reference).epsilon(1e-3));
+            }
+        }
+
+        WHEN("both are changed to BINARY and back several times") {
+            for (int i = 0; i < 5; ++i) {
+                fbqm.change_vartype(Vartype::BINARY);
+                fbqm.change_vartype(Vartype::SPIN);
+                dbqm.change_vartype(Vartype::BINARY);
+                dbqm.change_vartype(Vartype::SPIN);
+            }
+
+            THEN("the float model has not drifted when using extended precision") {
+                // accumulating in float, the offset drifts by two orders of
+                // magnitude over these round trips
+                CHECK(dbqm.offset() == Approx(.7));
+                if (extended_precision) {
+                    double reference = dbqm.energy(sample.begin());
+                    CHECK(fbqm.offset() == Approx(dbqm.offset()).margin(1e-3));
+                    CHECK(fbqm.energy(sample.begin()) == Approx(reference).epsilon(1e-5));
+                }
+            }
+        }
+    }
+
+    GIVEN("a dense float matrix with biases split across both triangles") {
+        std::vector<double> dense = {0, 1e-8, 1, 0};
+
+        WHEN("it is added to a float BQM") {
+            auto bqm = BinaryQuadraticModel<float>(2, Vartype::SPIN);
+            bqm.add_quadratic_from_dense(dense.data(), 2);
+
+            THEN("the two triangles are summed before being rounded") {
+                CHECK(bqm.quadratic(0, 1) == static_cast<float>(1 + 1e-8));
+            }
+        }
+    }
+}
+
+}  // namespace dimod
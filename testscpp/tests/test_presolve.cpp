@@ -0,0 +1,289 @@
+// Copyright 2023 D-Wave Systems Inc.
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+
+#include <vector>
+
+#include "catch2/catch.hpp"
+#include "dimod/constrained_quadratic_model.h"
+#include "dimod/presolve.h"
+
+namespace dimod {
+
+SCENARIO("constrained quadratic models can be presolved") {
+    GIVEN("a CQM with a singleton constraint") {
+        auto cqm = ConstrainedQuadraticModel<double>();
+        cqm.add_variables(Vartype::BINARY, 3);
+        cqm.objective.add_quadratic(0, 1, 1);
+        cqm.objective.add_quadratic(1, 2, 1);
+        cqm.objective.add_quadratic(0, 2, -1);
+        cqm.add_linear_constraint({1}, {2}, Sense::GE, 1);
+
+        WHEN("it is presolved") {
+            auto presolver = presolve::Presolver<double>(cqm);
+            REQUIRE(presolver.apply());
+
+            THEN("the variable is fixed and the constraint removed") {
+                CHECK(!presolver.infeasible());
+                CHECK(presolver.model().num_variables() == 2);
+                CHECK(presolver.model().num_constraints() == 0);
+                CHECK(presolver.original_variables() == std::vector<int>{0, 2});
+                CHECK(presolver.model().objective.linear(0) == 1);
+                CHECK(presolver.model().objective.linear(1) == 1);
+                CHECK(presolver.model().objective.num_interactions() == 1);
+            }
+
+            THEN("samples can be restored") {
+                auto sample = presolver.postsolver().apply(std::vector<int>{0, 1});
+                CHECK(sample == std::vector<int>{0, 1, 1});
+            }
+        }
+    }
+
+    GIVEN("a CQM with a one-hot constraint with one variable forced to 1") {
+        auto cqm = ConstrainedQuadraticModel<double>();
+        cqm.add_variables(Vartype::BINARY, 5);
+        for (int v = 0; v < 5; ++v) cqm.objective.set_linear(v, v - 2);
+        cqm.objective.add_quadratic(3, 4, 1.5);
+        cqm.add_linear_constraint({0, 1, 2, 3}, {1, 1, 1, 1}, Sense::EQ, 1);
+        cqm.add_linear_constraint({2}, {1}, Sense::GE, 1);
+        cqm.add_variable(Vartype::INTEGER, -3, 3);
+        cqm.objective.add_quadratic(4, 5, 1);
+
+        WHEN("it is presolved") {
+            auto presolver = presolve::Presolver<double>(cqm);
+            REQUIRE(presolver.apply());
+
+            THEN("all of the one-hot variables are fixed") {
+                CHECK(!presolver.infeasible());
+                CHECK(presolver.model().num_constraints() == 0);
+                CHECK(presolver.original_variables() == std::vector<int>{4, 5});
+                CHECK(presolver.postsolver().num_fixed() == 4);
+            }
+
+            THEN("the restored samples have the original energies") {
+                std::vector<double> sample{1, -2};
+                auto full = presolver.postsolver().apply(sample);
+                REQUIRE(full.size() == 6);
+                CHECK(full == std::vector<double>{0, 0, 1, 0, 1, -2});
+                CHECK(presolver.model().objective.energy(sample.begin()) ==
+                      Approx(cqm.objective.energy(full.begin())));
+            }
+        }
+    }
+
+    GIVEN("a CQM with linear constraints over integer variables") {
+        auto cqm = ConstrainedQuadraticModel<double>();
+        cqm.add_variables(Vartype::INTEGER, 3);  // default bounds
+        cqm.objective.add_quadratic(0, 1, 1);
+        cqm.objective.add_quadratic(1, 2, 1);
+        cqm.objective.add_quadratic(0, 2, 1);
+        cqm.add_linear_constraint({0, 1}, {2, 3}, Sense::LE, 12);
+        cqm.add_linear_constraint({1, 2}, {1, -1}, Sense::GE, 0);
+
+        WHEN("it is presolved") {
+            auto presolver = presolve::Presolver<double>(cqm);
+            REQUIRE(presolver.apply());
+
+            THEN("the bounds are tightened") {
+                CHECK(!presolver.infeasible());
+                REQUIRE(presolver.model().num_variables() == 3);
+                CHECK(presolver.model().upper_bound(0) == 6);
+                CHECK(presolver.model().upper_bound(1) == 4);
+                CHECK(presolver.model().upper_bound(2) == 4);
+                CHECK(presolver.model().lower_bound(0) == 0);
+                CHECK(presolver.model().num_constraints() == 2);
+            }
+
+            THEN("applying it again does nothing") { CHECK(!presolver.apply()); }
+        }
+    }
+
+    GIVEN("a CQM with empty and redundant constraints") {
+        auto cqm = ConstrainedQuadraticModel<double>();
+        cqm.add_variables(Vartype::BINARY, 3);
+        cqm.objective.add_quadratic(0, 1, 1);
+        cqm.objective.add_quadratic(1, 2, 1);
+        cqm.add_linear_constraint({0, 1}, {1, 1}, Sense::LE, 2);   // redundant
+        cqm.add_linear_constraint({0, 1}, {1, 1}, Sense::LE, 1);   // kept
+        cqm.add_linear_constraint({1, 2}, {1, 1}, Sense::GE, -1);  // redundant
+        auto c = cqm.add_linear_constraint({0}, {1}, Sense::LE, 1);
+        cqm.constraint_ref(c).remove_variable(0);                  // empty and satisfied
+        cqm.add_linear_constraint({1, 2}, {1, -1}, Sense::EQ, 0);  // kept
+
+        WHEN("it is presolved") {
+            auto presolver = presolve::Presolver<double>(cqm);
+            REQUIRE(presolver.apply());
+
+            THEN("the redundant constraints are removed") {
+                CHECK(!presolver.infeasible());
+                CHECK(presolver.model().num_variables() == 3);
+                CHECK(presolver.model().num_constraints() == 2);
+                CHECK(presolver.original_constraints() == std::vector<int>{1, 4});
+            }
+        }
+    }
+
+    GIVEN("a CQM with variables that are in no constraint") {
+        auto cqm = ConstrainedQuadraticModel<double>();
+        cqm.add_variable(Vartype::INTEGER, -5, 5);
+        cqm.add_variable(Vartype::REAL, -1.5, 2.5);
+        cqm.add_variable(Vartype::SPIN);
+        cqm.add_variable(Vartype::INTEGER);  // unbounded above
+        cqm.add_variables(Vartype::BINARY, 2);
+        cqm.objective.set_linear(0, 1);
+        cqm.objective.set_linear(1, -2);
+        cqm.objective.set_linear(2, -1);
+        cqm.objective.set_linear(3, -1);
+        cqm.objective.add_quadratic(4, 5, 1);
+
+        WHEN("it is presolved") {
+            auto presolver = presolve::Presolver<double>(cqm);
+            REQUIRE(presolver.apply());
+
+            THEN("the variables that appear linearly are fixed to their best bound") {
+                CHECK(presolver.original_variables() == std::vector<int>{3, 4, 5});
+                auto full = presolver.postsolver().apply(std::vector<double>{0, 0, 0});
+                CHECK(full == std::vector<double>{-5, 2.5, 1, 0, 0, 0});
+                CHECK(presolver.model().objective.offset() == -5 - 5 - 1);
+            }
+        }
+    }
+
+    GIVEN("an infeasible CQM") {
+        auto cqm = ConstrainedQuadraticModel<double>();
+        cqm.add_variables(Vartype::BINARY, 3);
+        cqm.add_variable(Vartype::INTEGER, 0, 2);
+        cqm.add_linear_constraint({0, 1, 2}, {1, 1, 1}, Sense::GE, 2);
+        cqm.add_linear_constraint({0, 1, 3}, {1, 1, 1}, Sense::LE, 0);
+
+        WHEN("it is presolved") {
+            auto presolver = presolve::Presolver<double>(cqm);
+            presolver.apply();
+
+            THEN("the infeasibility is detected") { CHECK(presolver.infeasible()); }
+        }
+    }
+
+    GIVEN("a CQM with a violated soft constraint") {
+        auto cqm = ConstrainedQuadraticModel<double>();
+        cqm.add_variables(Vartype::BINARY, 2);
+        cqm.objective.add_quadratic(0, 1, 1);
+        auto c = cqm.add_linear_constraint({0, 1}, {1, 1}, Sense::GE, 3);
+        cqm.constraint_ref(c).set_weight(5);
+
+        WHEN("it is presolved") {
+            auto presolver = presolve::Presolver<double>(cqm);
+            presolver.apply();
+
+            THEN("the model is not infeasible and the constraint is kept") {
+                CHECK(!presolver.infeasible());
+                CHECK(presolver.model().num_constraints() == 1);
+                CHECK(presolver.model().num_variables() == 2);
+            }
+        }
+    }
+
+    GIVEN("a CQM with spin variables in a linear constraint") {
+        auto cqm = ConstrainedQuadraticModel<double>();
+        cqm.add_variables(Vartype::SPIN, 3);
+        cqm.objective.add_quadratic(0, 1, 1);
+        cqm.objective.add_quadratic(1, 2, 1);
+        cqm.objective.add_quadratic(0, 2, 1);
+        cqm.add_linear_constraint({0, 1}, {1, 1}, Sense::GE, 1);
+
+        WHEN("it is presolved") {
+            auto presolver = presolve::Presolver<double>(cqm);
+            REQUIRE(presolver.apply());
+
+            THEN("both variables are fixed to +1, and then the free variable to -1") {
+                CHECK(presolver.model().num_variables() == 0);
+                CHECK(presolver.model().objective.offset() == 1 - 2);
+                CHECK(presolver.postsolver().apply(std::vector<int>{}) ==
+                      std::vector<int>{1, 1, -1});
+            }
+        }
+    }
+
+    GIVEN("a CQM with parallel constraints") {
+        auto cqm = ConstrainedQuadraticModel<double>();
+        cqm.add_variables(Vartype::INTEGER, 3);
+        cqm.add_linear_constraint({0, 1}, {1, -1}, Sense::LE, 5);    // 0
+        cqm.add_linear_constraint({1, 0}, {-2, 2}, Sense::LE, 8);    // 1, tighter
+        cqm.add_linear_constraint({0, 1}, {-1, 1}, Sense::LE, 1);    // 2, x - y >= -1
+        cqm.add_linear_constraint({0, 2}, {1, -1}, Sense::EQ, 0);    // 3
+        cqm.add_linear_constraint({0, 2}, {3, -3}, Sense::EQ, 0);    // 4
+        cqm.add_linear_constraint({0, 1, 2}, {1, -1, 1}, Sense::LE, 10);  // 5
+        auto c = cqm.add_linear_constraint({0, 1}, {1, -1}, Sense::LE, 0);
+        cqm.constraint_ref(c).set_weight(2);  // 6, soft
+        c = cqm.add_linear_constraint({0, 2}, {2, -2}, Sense::GE, -10);
+        cqm.constraint_ref(c).add_offset(1);  // 7, implied by 3
+        c = cqm.add_constraint();
+        cqm.constraint_ref(c).add_quadratic(0, 1, 2);
+        cqm.constraint_ref(c).set_sense(Sense::LE);
+        cqm.constraint_ref(c).set_rhs(4);  // 8
+        c = cqm.add_constraint();
+        cqm.constraint_ref(c).add_quadratic(1, 0, 1);
+        cqm.constraint_ref(c).set_sense(Sense::LE);
+        cqm.constraint_ref(c).set_rhs(1);  // 9, tighter
+
+        THEN("they can be found") {
+            auto groups = presolve::find_parallel_constraints(cqm);
+            REQUIRE(groups.size() == 3);
+            CHECK(groups[0] == std::vector<int>{0, 1, 2});
+            CHECK(groups[1] == std::vector<int>{3, 4, 7});
+            CHECK(groups[2] == std::vector<int>{8, 9});
+        }
+
+        WHEN("it is presolved") {
+            auto presolver = presolve::Presolver<double>(cqm);
+            REQUIRE(presolver.apply());
+
+            THEN("only the tightest constraints are kept") {
+                CHECK(!presolver.infeasible());
+                CHECK(presolver.original_constraints() == std::vector<int>{1, 2, 3, 5, 6, 9});
+                CHECK(presolver.model().constraint_ref(0).sense() == Sense::LE);
+                CHECK(presolver.model().constraint_ref(0).rhs() == 8);
+                CHECK(presolver.model().constraint_ref(1).sense() == Sense::LE);
+                CHECK(presolver.model().constraint_ref(1).rhs() == 1);
+                CHECK(presolver.model().constraint_ref(5).rhs() == 1);
+                CHECK(presolver.model().constraint_ref(3).rhs() == 10);
+            }
+        }
+
+        AND_WHEN("parallel inequalities meet") {
+            cqm.constraint_ref(2).set_rhs(-4);  // x - y >= 4
+
+            auto presolver = presolve::Presolver<double>(cqm);
+            REQUIRE(presolver.apply());
+
+            THEN("they are merged into an equality") {
+                CHECK(!presolver.infeasible());
+                CHECK(presolver.original_constraints() == std::vector<int>{1, 3, 5, 6, 9});
+                CHECK(presolver.model().constraint_ref(0).sense() == Sense::EQ);
+                CHECK(presolver.model().constraint_ref(0).rhs() == 8);
+            }
+        }
+
+        AND_WHEN("parallel inequalities contradict each other") {
+            cqm.constraint_ref(2).set_rhs(-5);  // x - y >= 5
+
+            auto presolver = presolve::Presolver<double>(cqm);
+            presolver.apply();
+
+            THEN("the infeasibility is detected") { CHECK(presolver.infeasible()); }
+        }
+    }
+}
+
+}  // namespace dimod
@@ -12,7 +12,11 @@
 //    See the License for the specific language governing permissions and
 //    limitations under the License.
 
+#include <algorithm>
 #include <iostream>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
 
 #include "catch2/catch.hpp"
 #include "dimod/quadratic_model.h"
@@ -433,6 +437,90 @@ SCENARIO("The variables of a quadratic model can have their vartypes changed", "
     }
 }
 
+SCENARIO("The vartypes of many variables can be changed at once", "[qm]") {
+    GIVEN("a quadratic model with spin, binary and integer variables") {
+        auto qm = QuadraticModel<double>();
+        qm.add_variables(Vartype::SPIN, 3);
+        qm.add_variables(Vartype::BINARY, 2);
+        auto i = qm.add_variable(Vartype::INTEGER, -5, 5);
+
+        qm.set_linear(0, {1, -2, 3, -4, 5, -6});
+        qm.add_quadratic(0, 1, 1.5);
+        qm.add_quadratic(1, 2, -2.5);
+        qm.add_quadratic(2, 3, 3.5);
+        qm.add_quadratic(3, 4, -4.5);
+        qm.add_quadratic(4, i, 5.5);
+        qm.add_quadratic(0, i, -6.5);
+        qm.add_quadratic(i, i, 7.5);
+        qm.set_offset(8);
+
+        auto expected = qm;
+
+        // compare against the one-at-a-time method
+        auto check = [&]() {
+            CHECK(qm.offset() == Approx(expected.offset()));
+            for (std::size_t v = 0; v < qm.num_variables(); ++v) {
+                CHECK(qm.vartype(v) == expected.vartype(v));
+                CHECK(qm.lower_bound(v) == expected.lower_bound(v));
+                CHECK(qm.upper_bound(v) == expected.upper_bound(v));
+                CHECK(qm.linear(v) == Approx(expected.linear(v)));
+                for (std::size_t u = 0; u < qm.num_variables(); ++u) {
+                    CHECK(qm.quadratic(u, v) == Approx(expected.quadratic(u, v)));
+                }
+            }
+        };
+
+        WHEN("the spin variables are changed to binary") {
+            qm.change_vartypes(Vartype::BINARY, {0, 1, 2});
+            for (int v : {0, 1, 2}) expected.change_vartype(Vartype::BINARY, v);
+
+            THEN("the model matches changing them one at a time") { check(); }
+        }
+
+        WHEN("the spin and binary variables are changed to integer") {
+            qm.change_vartypes(Vartype::INTEGER, {4, 0, 3, 2, 1});
+            for (int v : {4, 0, 3, 2, 1}) expected.change_vartype(Vartype::INTEGER, v);
+
+            THEN("the model matches changing them one at a time") { check(); }
+        }
+
+        WHEN("the binary variables are changed to spin") {
+            qm.change_vartypes(Vartype::SPIN, {3, 4, 0});
+            for (int v : {3, 4, 0}) expected.change_vartype(Vartype::SPIN, v);
+
+            THEN("the model matches changing them one at a time") { check(); }
+        }
+
+        WHEN("an unsupported change is requested") {
+            THEN("an exception is thrown and the model is unchanged") {
+                CHECK_THROWS_AS(qm.change_vartypes(Vartype::SPIN, {0, 3, i}), std::logic_error);
+                check();
+            }
+        }
+
+        WHEN("we substitute every variable at once") {
+            std::vector<double> multipliers = {2, .5, -1, 3, 1, -2};
+            std::vector<double> offsets = {-1, .5, 2, 0, 1, 3};
+            qm.substitute_variables(multipliers, offsets);
+
+            THEN("the energies are consistent with the substitution") {
+                std::vector<double> y = {1, -1, 1, 0, 1, 4};
+                std::vector<double> x(y.size());
+                for (std::size_t v = 0; v < y.size(); ++v) {
+                    x[v] = multipliers[v] * y[v] + offsets[v];
+                }
+                CHECK(qm.energy(y.begin()) == Approx(expected.energy(x.begin())));
+
+                y = {-1, 0, 2, 1, 0, -3};
+                for (std::size_t v = 0; v < y.size(); ++v) {
+                    x[v] = multipliers[v] * y[v] + offsets[v];
+                }
+                CHECK(qm.energy(y.begin()) == Approx(expected.energy(x.begin())));
+            }
+        }
+    }
+}
+
 TEMPLATE_TEST_CASE("Scenario: the size of quadratic models in bytes can be determined", "[qm]",
                    double, float) {
     GIVEN("a binary quadratic model") {
@@ -498,6 +586,39 @@ SCENARIO("quadratic models with square terms") {
     }
 }
 
+SCENARIO("quadratic models with square terms can be built from CSR", "[qm]") {
+    GIVEN("a QM with an integer variable and a binary variable") {
+        auto qm = QuadraticModel<double>();
+        qm.add_variable(Vartype::INTEGER, -5, 5);
+        qm.add_variable(Vartype::BINARY);
+
+        WHEN("a matrix with a full diagonal is added") {
+            std::vector<int> indptr = {0, 2, 3};
+            std::vector<int> indices = {0, 1, 1};
+            std::vector<double> data = {3, 2, 7};
+            qm.add_quadratic_from_csr(indptr.data(), indices.data(), data.data(), 2);
+
+            THEN("the diagonal is treated according to the vartypes") {
+                CHECK(qm.quadratic(0, 0) == 3);
+                CHECK(qm.quadratic(0, 1) == 2);
+                CHECK(qm.linear(1) == 7);
+                CHECK(qm.num_interactions() == 2);
+            }
+
+            AND_THEN("the self-loop is written back out") {
+                std::vector<int> out_indptr(3);
+                std::vector<int> out_indices(2);
+                std::vector<double> out_data(2);
+                qm.to_csr(out_indptr.data(), out_indices.data(), out_data.data());
+
+                CHECK(out_indptr == std::vector<int>{0, 2, 2});
+                CHECK(out_indices == std::vector<int>{0, 1});
+                CHECK(out_data == std::vector<double>{3, 2});
+            }
+        }
+    }
+}
+
 SCENARIO("quadratic models can be swapped", "[qm]") {
     GIVEN("two quadratic models") {
         auto qm0 = dimod::QuadraticModel<double>();
@@ -546,4 +667,422 @@ SCENARIO("quadratic models can be swapped", "[qm]") {
         }
     }
 }
+SCENARIO("quadratic models can be added together", "[qm]") {
+    GIVEN("a quadratic model and another with a self-loop") {
+        auto qm0 = dimod::QuadraticModel<double>();
+        auto s = qm0.add_variable(Vartype::SPIN);
+        auto i = qm0.add_variable(Vartype::INTEGER, -5, 5);
+        qm0.add_quadratic(s, i, 1);
+        qm0.add_quadratic(i, i, 2);
+
+        auto qm1 = dimod::QuadraticModel<double>();
+        auto j = qm1.add_variable(Vartype::INTEGER, -5, 5);
+        auto x = qm1.add_variable(Vartype::BINARY);
+        qm1.set_linear(x, 3);
+        qm1.add_quadratic(j, j, 4);
+        qm1.add_quadratic(j, x, 5);
+        qm1.set_offset(6);
+
+        WHEN("the second is added to the first") {
+            auto y = qm0.add_variable(Vartype::BINARY);
+            qm0.add_model(qm1, std::vector<int>{i, y});
+
+            THEN("the self-loops and interactions are merged") {
+                REQUIRE(qm0.num_variables() == 3);
+                CHECK(qm0.num_interactions() == 3);
+                CHECK(qm0.quadratic(s, i) == 1);
+                CHECK(qm0.quadratic(i, i) == 6);
+                CHECK(qm0.quadratic(i, y) == 5);
+                CHECK(qm0.linear(y) == 3);
+                CHECK(qm0.offset() == 6);
+            }
+        }
+    }
+}
+
+// Count the interactions of `qm` by scanning its neighborhoods, to check the
+// count it maintains.
+template <class Model>
+std::size_t count_interactions(const Model& qm) {
+    std::size_t count = 0;
+    for (std::size_t u = 0; u < qm.num_variables(); ++u) {
+        for (auto it = qm.cbegin_neighborhood(u); it != qm.cend_neighborhood(u); ++it) {
+            if (static_cast<std::size_t>(it->v) >= u) ++count;
+        }
+    }
+    return count;
+}
+
+SCENARIO("the number of interactions is maintained as the model changes", "[qm]") {
+    GIVEN("a quadratic model with a self-loop") {
+        auto qm = QuadraticModel<double>();
+        qm.add_variables(Vartype::INTEGER, 5);
+        qm.add_quadratic(0, 0, 1);
+        qm.add_quadratic({0, 1, 2, 3}, {1, 2, 3, 4}, {1, 2, 3, 4});
+
+        REQUIRE(qm.num_interactions() == 5);
+        REQUIRE(!qm.is_linear());
+
+        WHEN("an existing interaction is added to or set") {
+            qm.add_quadratic(1, 0, 1);
+            qm.set_quadratic(0, 0, 5);
+
+            THEN("the count is unchanged") {
+                CHECK(qm.num_interactions() == 5);
+                CHECK(qm.num_interactions() == count_interactions(qm));
+            }
+        }
+
+        WHEN("interactions are removed") {
+            CHECK(qm.remove_interaction(0, 0));
+            CHECK(qm.remove_interaction(2, 1));
+            CHECK(!qm.remove_interaction(2, 1));
+
+            THEN("the count goes down") {
+                CHECK(qm.num_interactions() == 3);
+                CHECK(qm.num_interactions() == count_interactions(qm));
+            }
+        }
+
+        WHEN("variables are removed or fixed") {
+            qm.remove_variable(0);
+            CHECK(qm.num_interactions() == 3);
+            CHECK(qm.num_interactions() == count_interactions(qm));
+            qm.fix_variable(3, 2);
+            CHECK(qm.num_interactions() == 2);
+            CHECK(qm.num_interactions() == count_interactions(qm));
+            qm.remove_variables({0, 2});
+            CHECK(qm.num_interactions() == 0);
+            CHECK(qm.is_linear());
+        }
+
+        WHEN("another model is added") {
+            auto other = QuadraticModel<double>();
+            other.add_variables(Vartype::INTEGER, 3);
+            other.add_quadratic({0, 1, 2}, {1, 2, 2}, {1, 1, 1});
+            qm.add_model(other, {1, 2, 4});
+
+            THEN("only the new interactions are counted") {
+                CHECK(qm.num_interactions() == 7);
+                CHECK(qm.num_interactions() == count_interactions(qm));
+            }
+        }
+
+        WHEN("the model is moved") {
+            auto moved = std::move(qm);
+
+            THEN("the count moves with it") {
+                CHECK(moved.num_interactions() == 5);
+                CHECK(moved.num_interactions() == count_interactions(moved));
+                CHECK(qm.num_interactions() == 0);
+                CHECK(qm.is_linear());
+            }
+        }
+
+        WHEN("the model is copied and cleared") {
+            auto copy = qm;
+            qm.clear();
+
+            THEN("the copy keeps its count") {
+                CHECK(copy.num_interactions() == 5);
+                CHECK(copy.num_interactions() == count_interactions(copy));
+                CHECK(qm.num_interactions() == 0);
+            }
+        }
+
+        WHEN("the variables are permuted and resized") {
+            qm.permute({4, 3, 2, 1, 0});
+            CHECK(qm.num_interactions() == 5);
+            CHECK(qm.num_interactions() == count_interactions(qm));
+            qm.resize(3);
+            CHECK(qm.num_interactions() == count_interactions(qm));
+        }
+    }
+}
+
+SCENARIO("the neighborhoods of high-degree variables are indexed", "[qm]") {
+    GIVEN("a BQM with a hub variable") {
+        const int n = 1001;
+        auto bqm = BinaryQuadraticModel<double>(n, Vartype::BINARY);
+        for (int v = 1; v < n; ++v) bqm.add_quadratic_back(0, v, v);
+
+        WHEN("the existing interactions of the hub are added to") {
+            for (int v = 1; v < n; ++v) bqm.add_quadratic(0, v, 1);
+
+            THEN("the biases are found") {
+                for (int v = 1; v < n; ++v) {
+                    REQUIRE(bqm.quadratic(0, v) == v + 1);
+                    REQUIRE(bqm.quadratic(v, 0) == v + 1);
+                    REQUIRE(bqm.has_interaction(0, v));
+                }
+                CHECK(bqm.num_interactions() == n - 1);
+            }
+
+            AND_WHEN("interactions are removed and added in the middle of the neighborhood") {
+                CHECK(bqm.remove_interaction(0, 10));
+                CHECK(bqm.remove_interaction(500, 0));
+                bqm.add_quadratic(0, 10, -1);
+                for (int v = 1; v < n; ++v) bqm.add_quadratic(0, v, 1);
+
+                THEN("the stale index is not trusted") {
+                    CHECK(bqm.quadratic(0, 10) == 0);
+                    CHECK(bqm.quadratic(0, 500) == 1);
+                    CHECK(bqm.quadratic_at(0, 11) == 13);
+                    CHECK(bqm.num_interactions() == n - 1);
+                    for (int v = 1; v < n; ++v) {
+                        if (v == 10 || v == 500) continue;
+                        REQUIRE(bqm.quadratic(0, v) == v + 2);
+                    }
+                }
+            }
+
+            AND_WHEN("a variable is removed") {
+                bqm.remove_variable(1);
+
+                THEN("the hub's neighbors are relabeled") {
+                    CHECK(bqm.quadratic(0, 1) == 3);
+                    bqm.add_quadratic(0, 1, 1);
+                    CHECK(bqm.quadratic(0, 1) == 4);
+                    CHECK(bqm.num_interactions(0) == n - 2);
+                }
+            }
+
+            AND_WHEN("the BQM is copied") {
+                auto copy = bqm;
+
+                THEN("the copy has the same biases") {
+                    CHECK(copy.is_equal(bqm));
+                    CHECK(copy.nbytes() < bqm.nbytes());  // without the index
+                }
+            }
+        }
+    }
+
+    GIVEN("a hub built by adding its interactions in order and then only read") {
+        const int n = 1001;
+        auto bqm = BinaryQuadraticModel<double>(n, Vartype::BINARY);
+        for (int v = 1; v < n; ++v) bqm.add_quadratic(0, v, v);
+        bqm.reset_stats();
+
+        THEN("the const lookups use the index built as it grew") {
+            for (int v = 1; v < n; ++v) REQUIRE(bqm.quadratic(0, v) == v);
+            CHECK(!bqm.has_interaction(0, 0));
+            if (Stats::enabled()) {
+                CHECK(bqm.stats().binary_searches == 1);  // the failed lookup of 0
+                CHECK(bqm.stats().hash_lookups == n);
+            }
+        }
+    }
+
+    GIVEN("a hub built by inserting its interactions out of order") {
+        const int n = 1001;
+        auto bqm = BinaryQuadraticModel<double>(n, Vartype::BINARY);
+        for (int v = n - 1; v > 0; --v) bqm.add_quadratic(0, v, v);
+
+        THEN("the biases are found") {
+            for (int v = 1; v < n; ++v) REQUIRE(bqm.quadratic(0, v) == v);
+        }
+
+        WHEN("the neighborhoods are indexed explicitly") {
+            bqm.index_neighborhoods();
+            bqm.reset_stats();
+
+            THEN("the const lookups use the index") {
+                for (int v = 1; v < n; ++v) REQUIRE(bqm.quadratic_at(0, v) == v);
+                if (Stats::enabled()) {
+                    CHECK(bqm.stats().binary_searches == 0);
+                    CHECK(bqm.stats().hash_lookups == n - 1);
+                }
+            }
+        }
+    }
+
+    GIVEN("a model with a hub variable") {
+        const int n = 1001;
+        auto hub = BinaryQuadraticModel<double>(n, Vartype::BINARY);
+        for (int v = 1; v < n; ++v) hub.add_quadratic_back(0, v, v);
+
+        std::vector<int> mapping(n);
+        std::iota(mapping.begin(), mapping.end(), 0);
+
+        auto bqm = BinaryQuadraticModel<double>(n, Vartype::BINARY);
+
+        WHEN("it is added to an empty BQM") {
+            bqm.add_model(hub, mapping);
+            bqm.reset_stats();
+
+            THEN("the appended neighborhood is indexed") {
+                auto copy = bqm;
+                CHECK(copy.nbytes() < bqm.nbytes());  // without the index
+                for (int v = 1; v < n; ++v) REQUIRE(bqm.quadratic_at(0, v) == v);
+                if (Stats::enabled()) {
+                    CHECK(bqm.stats().binary_searches == 0);
+                    CHECK(bqm.stats().hash_lookups == n - 1);
+                }
+            }
+        }
+
+        WHEN("it is merged into a BQM that already has some of its interactions") {
+            bqm.add_quadratic(0, 500, 1);
+            bqm.add_model(hub, mapping);
+            bqm.reset_stats();
+
+            THEN("the merged neighborhood is indexed") {
+                auto copy = bqm;
+                CHECK(copy.nbytes() < bqm.nbytes());  // without the index
+                for (int v = 1; v < n; ++v) REQUIRE(bqm.quadratic_at(0, v) == v + (v == 500));
+                if (Stats::enabled()) {
+                    CHECK(bqm.stats().binary_searches == 0);
+                    CHECK(bqm.stats().hash_lookups == n - 1);
+                }
+            }
+        }
+
+        WHEN("it is built from CSR") {
+            std::vector<int> indptr(n + 1), indices(hub.num_interactions());
+            std::vector<double> data(hub.num_interactions());
+            hub.to_csr(indptr.data(), indices.data(), data.data());
+            bqm.add_quadratic_from_csr(indptr.data(), indices.data(), data.data(), n);
+            bqm.reset_stats();
+
+            THEN("the neighborhood is indexed") {
+                auto copy = bqm;
+                CHECK(copy.nbytes() < bqm.nbytes());  // without the index
+                for (int v = 1; v < n; ++v) REQUIRE(bqm.quadratic_at(0, v) == v);
+                if (Stats::enabled()) {
+                    CHECK(bqm.stats().binary_searches == 0);
+                    CHECK(bqm.stats().hash_lookups == n - 1);
+                }
+            }
+        }
+    }
+}
+
+SCENARIO("local fields can be computed for a batch of samples", "[qm]") {
+    GIVEN("a quadratic model with a self-loop") {
+        auto qm = QuadraticModel<double>();
+        qm.add_variables(Vartype::INTEGER, 3);
+        qm.set_linear(0, {1, -2, 3});
+        qm.add_quadratic(0, 1, 2);
+        qm.add_quadratic(1, 2, -1);
+        qm.add_quadratic(2, 2, 1.5);
+
+        WHEN("we compute the local fields of two samples") {
+            std::vector<int> samples = {1, 2, 3, -1, 0, 2};
+            std::vector<double> fields(6);
+            qm.local_fields(samples.data(), 2, fields.data());
+
+            THEN("they are the derivatives of the energy") {
+                CHECK(fields == std::vector<double>{1 + 2 * 2, -2 + 2 * 1 - 3, 3 - 2 + 2 * 1.5 * 3,
+                                                    1 + 0, -2 - 2 - 2, 3 - 0 + 2 * 1.5 * 2});
+            }
+        }
+    }
+
+    GIVEN("a larger binary quadratic model") {
+        const int n = 1000;
+        auto bqm = BinaryQuadraticModel<float>(n, Vartype::SPIN);
+        for (int u = 0; u < n; ++u) {
+            bqm.set_linear(u, u % 5 - 2);
+            bqm.add_quadratic(u, (u + 1) % n, 1);
+            bqm.add_quadratic(u, (u * 17 + 3) % n, -.5);
+        }
+
+        std::vector<int8_t> samples(3 * n);
+        for (int i = 0; i < 3 * n; ++i) samples[i] = (i % 7 < 3) ? -1 : +1;
+
+        WHEN("we compute the local fields on several threads") {
+            std::vector<float> expected(3 * n);
+            bqm.local_fields(samples.data(), 3, expected.data());
+
+            std::vector<float> fields(3 * n);
+            bqm.local_fields(samples.data(), 3, fields.data(), 3);
+
+            THEN("they match the fields computed on one thread") {
+                CHECK(fields == expected);
+
+                // flipping a spin changes the energy by -2 x[v] h[v]
+                for (int v : {0, 123, 999}) {
+                    std::vector<int8_t> flipped(samples.begin() + n, samples.begin() + 2 * n);
+                    flipped[v] *= -1;
+                    CHECK(bqm.energy(flipped.begin()) - bqm.energy(samples.begin() + n) ==
+                          Approx(-2 * samples[n + v] * fields[n + v]));
+                }
+            }
+        }
+    }
+}
+
+SCENARIO("several variables can be fixed at once", "[qm]") {
+    GIVEN("a QM with integer variables, self-loops and interactions") {
+        auto qm = QuadraticModel<double>();
+        qm.add_variables(Vartype::INTEGER, 10, -5, 5);
+        qm.add_variable(Vartype::BINARY);
+        for (int u = 0; u < 11; ++u) {
+            qm.set_linear(u, u - 4);
+            qm.add_quadratic(u, (u * 3 + 1) % 11, .5 * u - 1);
+            qm.add_quadratic(u, (u * 7 + 2) % 11, 2);
+        }
+        qm.set_offset(1.5);
+
+        std::vector<int> variables{7, 0, 3, 10, 4};
+        std::vector<double> assignments{2, -3, 5, 1, 0};
+
+        WHEN("we fix them with fix_variables()") {
+            auto expected = qm;
+            for (int v : {10, 7, 4, 3, 0}) {  // in descending order so the indices stay put
+                auto it = std::find(variables.begin(), variables.end(), v);
+                expected.fix_variable(v, assignments[it - variables.begin()]);
+            }
+
+            qm.fix_variables(variables, assignments);
+
+            THEN("the model is the same as fixing them one at a time") {
+                REQUIRE(qm.num_variables() == 6);
+                CHECK(qm.num_interactions() == expected.num_interactions());
+                CHECK(qm.offset() == Approx(expected.offset()));
+                for (int v = 0; v < 6; ++v) {
+                    CHECK(qm.linear(v) == Approx(expected.linear(v)));
+                    CHECK(qm.vartype(v) == expected.vartype(v));
+                    for (int u = 0; u < 6; ++u) {
+                        CHECK(qm.quadratic(u, v) == expected.quadratic(u, v));
+                    }
+                }
+            }
+        }
+
+        WHEN("a variable is given twice") {
+            auto expected = qm;
+            expected.fix_variables({2}, {4});
+
+            qm.fix_variables({2, 2}, {-1, 4});
+
+            THEN("its last assignment is used") {
+                REQUIRE(qm.num_variables() == 10);
+                CHECK(qm.is_equal(expected));
+            }
+        }
+
+        WHEN("the variables and assignments are different lengths") {
+            THEN("an exception is thrown and the model is unchanged") {
+                auto expected = qm;
+                CHECK_THROWS_AS(qm.fix_variables({1, 2}, {0}), std::invalid_argument);
+                CHECK(qm.is_equal(expected));
+            }
+        }
+
+        WHEN("they are fixed in a transaction that is rolled back") {
+            auto expected = qm;
+            qm.begin_transaction();
+            qm.fix_variables(variables, assignments);
+            qm.rollback();
+
+            THEN("the model is restored") {
+                CHECK(qm.is_equal(expected));
+                CHECK(qm.vartype(10) == Vartype::BINARY);
+            }
+        }
+    }
+}
+
 }  // namespace dimod
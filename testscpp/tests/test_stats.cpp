@@ -0,0 +1,203 @@
+// Copyright 2023 D-Wave Systems Inc.
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+
+#include <thread>
+#include <vector>
+
+#include "catch2/catch.hpp"
+#include "dimod/binary_quadratic_model.h"
+#include "dimod/constrained_quadratic_model.h"
+
+namespace dimod {
+
+// These tests are compiled both with and without DIMOD_INSTRUMENTATION
+// defined, see the Makefile.
+
+SCENARIO("models count their hot-path events") {
+    GIVEN("a BQM with interactions added in increasing order") {
+        auto bqm = BinaryQuadraticModel<double>(5, Vartype::BINARY);
+        bqm.add_quadratic(0, 1, 1);
+        bqm.add_quadratic(0, 2, 1);
+        bqm.add_quadratic(0, 4, 1);
+
+        THEN("each insertion was an append, without a binary search") {
+            auto stats = bqm.stats();
+            CHECK(stats.binary_searches == 0);
+            if (Stats::enabled()) {
+                CHECK(stats.reallocations > 0);
+            } else {
+                CHECK(stats.reallocations == 0);
+            }
+            CHECK(stats.mid_inserts == 0);
+            CHECK(stats.hash_lookups == 0);
+        }
+
+        WHEN("the stats are reset and an interaction is inserted mid-neighborhood") {
+            bqm.reset_stats();
+            bqm.add_quadratic(0, 3, 1);
+
+            THEN("it is counted") {
+                auto stats = bqm.stats();
+                if (Stats::enabled()) {
+                    CHECK(stats.binary_searches == 1);  // 0 is appended to the neighborhood of 3
+                    CHECK(stats.mid_inserts == 1);
+                } else {
+                    CHECK(stats.binary_searches == 0);
+                    CHECK(stats.mid_inserts == 0);
+                }
+            }
+        }
+
+        WHEN("the BQM is copied") {
+            auto bqm2 = bqm;
+
+            THEN("the stats are not") {
+                CHECK(bqm2.stats().binary_searches == 0);
+                CHECK(bqm2.stats().reallocations == 0);
+            }
+        }
+    }
+
+    GIVEN("a BQM with reserved neighborhoods") {
+        auto bqm = BinaryQuadraticModel<double>(4, Vartype::BINARY);
+        std::vector<int> degrees{3, 1, 1, 1};
+        bqm.reserve_interactions(degrees.data(), 4);
+
+        WHEN("the interactions are added") {
+            bqm.add_quadratic(0, 3, 1);
+            bqm.add_quadratic(0, 2, 1);
+            bqm.add_quadratic(0, 1, 1);
+
+            THEN("no neighborhood reallocated") {
+                CHECK(bqm.stats().reallocations == 0);
+                if (Stats::enabled()) CHECK(bqm.stats().mid_inserts == 2);
+            }
+        }
+    }
+
+    GIVEN("a BQM and another with interactions to merge in") {
+        auto bqm = BinaryQuadraticModel<double>(4, Vartype::BINARY);
+        bqm.add_quadratic(0, 3, 1);
+
+        auto other = BinaryQuadraticModel<double>(4, Vartype::BINARY);
+        other.add_quadratic(0, 1, 1);
+        other.add_quadratic(0, 2, 1);
+        other.add_quadratic(2, 3, 1);
+
+        bqm.reset_stats();
+
+        WHEN("the other is added") {
+            bqm.add_model(other, {0, 1, 2, 3});
+
+            THEN("the insertions before existing neighbors and the reallocations are counted") {
+                auto stats = bqm.stats();
+                if (Stats::enabled()) {
+                    CHECK(stats.mid_inserts == 2);  // 1 and 2 before 3 in the neighborhood of 0
+                    CHECK(stats.reallocations > 0);
+                } else {
+                    CHECK(stats.mid_inserts == 0);
+                    CHECK(stats.reallocations == 0);
+                }
+            }
+        }
+    }
+
+    GIVEN("a BQM built from CSR") {
+        std::vector<int> indptr{0, 2, 3, 3}, indices{1, 2, 2};
+        std::vector<double> data{1, 1, 1};
+
+        auto bqm = BinaryQuadraticModel<double>(3, Vartype::BINARY);
+        bqm.add_quadratic_from_csr(indptr.data(), indices.data(), data.data(), 3);
+
+        THEN("each neighborhood is allocated once") {
+            if (Stats::enabled()) {
+                CHECK(bqm.stats().reallocations == 3);
+            } else {
+                CHECK(bqm.stats().reallocations == 0);
+            }
+            CHECK(bqm.stats().mid_inserts == 0);
+        }
+    }
+
+    GIVEN("a CQM with a constraint") {
+        auto cqm = ConstrainedQuadraticModel<double>();
+        cqm.add_variables(Vartype::BINARY, 5);
+        cqm.objective.add_linear(0, 1);
+
+        auto& constraint = cqm.constraint_ref(cqm.add_constraint());
+        constraint.add_linear(1, 1);
+        constraint.add_quadratic(1, 2, 1);
+
+        THEN("the hash lookups of the expressions are counted") {
+            if (Stats::enabled()) {
+                CHECK(cqm.objective.stats().hash_lookups == 1);
+                CHECK(constraint.stats().hash_lookups == 3);
+                CHECK(cqm.stats().hash_lookups == 4);
+                CHECK(cqm.stats().binary_searches == 0);  // both neighbors were appended
+            } else {
+                CHECK(cqm.stats().hash_lookups == 0);
+                CHECK(cqm.stats().binary_searches == 0);
+            }
+
+            cqm.reset_stats();
+            CHECK(cqm.stats().hash_lookups == 0);
+        }
+    }
+
+    GIVEN("a BQM with a high-degree variable") {
+        auto bqm = BinaryQuadraticModel<double>(1000, Vartype::BINARY);
+        for (int v = 1; v < 1000; ++v) bqm.add_quadratic_back(0, v, 1);
+
+        WHEN("its existing interactions are set repeatedly") {
+            for (int v = 1; v < 1000; ++v) bqm.set_quadratic(0, v, 2);
+            bqm.reset_stats();
+            for (int v = 1; v < 1000; ++v) bqm.set_quadratic(0, v, 3);
+
+            THEN("the index of its neighborhood is used instead of a binary search") {
+                auto stats = bqm.stats();
+                if (Stats::enabled()) {
+                    CHECK(stats.hash_lookups == 999);
+                    CHECK(stats.binary_searches == 999);  // the low-degree neighborhoods
+                } else {
+                    CHECK(stats.hash_lookups == 0);
+                }
+            }
+        }
+    }
+
+    GIVEN("a BQM read from several threads") {
+        auto bqm = BinaryQuadraticModel<double>(10, Vartype::BINARY);
+        for (int v = 1; v < 10; ++v) bqm.add_quadratic_back(0, v, 1);
+        bqm.reset_stats();
+
+        const int num_threads = 4;
+        std::vector<std::thread> threads;
+        for (int t = 0; t < num_threads; ++t) {
+            threads.emplace_back([&bqm]() {
+                for (int v = 1; v < 10; ++v) bqm.quadratic(0, v);
+            });
+        }
+        for (auto& thread : threads) thread.join();
+
+        THEN("every lookup is counted") {
+            if (Stats::enabled()) {
+                CHECK(bqm.stats().binary_searches == num_threads * 9);
+            } else {
+                CHECK(bqm.stats().binary_searches == 0);
+            }
+        }
+    }
+}
+
+}  // namespace dimod
@@ -0,0 +1,373 @@
+// Copyright 2023 D-Wave Systems Inc.
+//
+//    Licensed under the Apache License, Version 2.0 (the "License");
+//    you may not use this file except in compliance with the License.
+//    You may obtain a copy of the License at
+//
+//        http://www.apache.org/licenses/LICENSE-2.0
+//
+//    Unless required by applicable law or agreed to in writing, software
+//    distributed under the License is distributed on an "AS IS" BASIS,
+//    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//    See the License for the specific language governing permissions and
+//    limitations under the License.
+
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "catch2/catch.hpp"
+#include "dimod/binary_quadratic_model.h"
+#include "dimod/constrained_quadratic_model.h"
+#include "dimod/quadratic_model.h"
+#include "dimod/transaction.h"
+
+namespace dimod {
+
+SCENARIO("an undo log restores a vector") {
+    GIVEN("a vector and an undo log") {
+        std::vector<int> values{0, 1, 2, 3};
+        UndoLog<int, int> undo(values.size());
+
+        WHEN("elements are changed and appended") {
+            undo.save(values, 2);
+            values[2] = 20;
+            undo.save(values, 2);
+            values[2] = 200;
+            values.push_back(4);
+            undo.save(values, 4);  // appended, nothing to save
+            values[4] = 40;
+
+            THEN("the vector can be restored") {
+                undo.restore(values);
+                CHECK(values == std::vector<int>{0, 1, 2, 3});
+            }
+        }
+
+        WHEN("an element is changed and then the vector is rewritten") {
+            undo.save(values, 1);
+            values[1] = 10;
+            values.push_back(4);
+            undo.save_all(values);
+            CHECK(undo.saved_all());
+            values.erase(values.begin());
+
+            THEN("the vector can be restored") {
+                undo.restore(values);
+                CHECK(values == std::vector<int>{0, 1, 2, 3});
+            }
+        }
+    }
+}
+
+SCENARIO("transactions on quadratic models") {
+    GIVEN("a BQM") {
+        auto bqm = BinaryQuadraticModel<double>(5, Vartype::SPIN);
+        bqm.set_linear(0, {1, -2, 3, -4, 5});
+        bqm.add_quadratic(0, 1, 1.5);
+        bqm.add_quadratic(1, 2, -1);
+        bqm.add_quadratic(3, 4, 2);
+        bqm.set_offset(1.5);
+
+        const auto original = bqm;
+
+        THEN("it is not in a transaction") {
+            CHECK(!bqm.in_transaction());
+            CHECK_THROWS_AS(bqm.commit(), std::logic_error);
+            CHECK_THROWS_AS(bqm.rollback(), std::logic_error);
+        }
+
+        WHEN("a transaction is started") {
+            bqm.begin_transaction();
+            REQUIRE(bqm.in_transaction());
+
+            THEN("another cannot be started") {
+                CHECK_THROWS_AS(bqm.begin_transaction(), std::logic_error);
+            }
+
+            AND_WHEN("biases and interactions are changed") {
+                bqm.add_linear(1, 3);
+                bqm.set_linear(4, 0);
+                bqm.set_quadratic(0, 1, 5);
+                bqm.add_quadratic(0, 4, -2);
+                bqm.remove_interaction(1, 2);
+                bqm.add_offset(-1);
+                auto v = bqm.add_variable();
+                bqm.add_quadratic(v, 2, 7);
+
+                AND_WHEN("the transaction is rolled back") {
+                    bqm.rollback();
+
+                    THEN("the model is restored") {
+                        CHECK(!bqm.in_transaction());
+                        CHECK(bqm.is_equal(original));
+                        CHECK(bqm.num_variables() == 5);
+                        CHECK(bqm.num_interactions() == 3);
+                        CHECK(bqm.quadratic(0, 1) == 1.5);
+                        CHECK(!bqm.has_interaction(0, 4));
+                    }
+                }
+
+                AND_WHEN("the transaction is committed") {
+                    bqm.commit();
+
+                    THEN("the changes are kept") {
+                        CHECK(!bqm.in_transaction());
+                        CHECK(bqm.num_variables() == 6);
+                        CHECK(bqm.quadratic(0, 1) == 5);
+                        CHECK(bqm.quadratic(5, 2) == 7);
+                        CHECK(!bqm.has_interaction(1, 2));
+                    }
+                }
+            }
+
+            AND_WHEN("variables are fixed and removed") {
+                bqm.set_linear(2, 10);
+                bqm.fix_variable(1, -1);
+                bqm.remove_variable(0);
+                bqm.add_quadratic(0, 2, 1);
+                bqm.rollback();
+
+                THEN("the model is restored") { CHECK(bqm.is_equal(original)); }
+            }
+
+            AND_WHEN("the whole model is rewritten") {
+                bqm.scale(3);
+                bqm.change_vartype(Vartype::BINARY);
+                bqm.resize(2);
+                bqm.clear();
+                bqm.add_variable();
+                bqm.rollback();
+
+                THEN("the model is restored") {
+                    CHECK(bqm.vartype() == Vartype::SPIN);
+                    CHECK(bqm.is_equal(original));
+                }
+            }
+
+            AND_WHEN("the model is permuted") {
+                bqm.reorder({4, 3, 2, 1, 0});
+                bqm.add_linear(0, 1);
+                bqm.rollback();
+
+                THEN("the model is restored") { CHECK(bqm.is_equal(original)); }
+            }
+
+            AND_WHEN("another model is assigned to it") {
+                bqm = BinaryQuadraticModel<double>(2, Vartype::SPIN);
+                THEN("the transaction moves with the other model") {
+                    CHECK(!bqm.in_transaction());
+                }
+            }
+
+            AND_WHEN("another model is copied into it") {
+                const auto other = BinaryQuadraticModel<double>(2, Vartype::SPIN);
+                bqm = other;
+                bqm.rollback();
+
+                THEN("the model is restored") { CHECK(bqm.is_equal(original)); }
+            }
+
+            AND_WHEN("the model is copied") {
+                auto copy = bqm;
+                THEN("the transaction is not copied") { CHECK(!copy.in_transaction()); }
+            }
+        }
+    }
+
+    GIVEN("a linear BQM") {
+        auto bqm = BinaryQuadraticModel<double>(3, Vartype::BINARY);
+        bqm.set_linear(0, {1, 2, 3});
+        const auto original = bqm;
+
+        WHEN("interactions are added in a transaction and rolled back") {
+            bqm.begin_transaction();
+            bqm.add_quadratic(0, 2, 1);
+            bqm.add_quadratic(2, 2, 5);  // becomes linear
+            bqm.rollback();
+
+            THEN("the model is linear again") {
+                CHECK(bqm.is_linear());
+                CHECK(bqm.is_equal(original));
+            }
+        }
+    }
+
+    GIVEN("a QM with a journal") {
+        auto qm = QuadraticModel<double>();
+        qm.add_variables(Vartype::INTEGER, 3, -5, 5);
+        qm.add_variable(Vartype::SPIN);
+        qm.add_quadratic(0, 1, 2);
+        qm.add_quadratic(1, 3, -1);
+        qm.add_linear(3, 4);
+        const auto original = qm;
+
+        qm.start_journal();
+
+        WHEN("the variables are changed in a transaction and rolled back") {
+            qm.begin_transaction();
+            qm.set_upper_bound(1, 6);
+            qm.change_vartype(Vartype::BINARY, 3);
+            qm.add_variable(Vartype::BINARY);
+            qm.add_quadratic(0, 0, 3);
+            qm.rollback();
+
+            THEN("the biases, variable types and bounds are restored") {
+                CHECK(qm.is_equal(original));
+                CHECK(qm.upper_bound(1) == 5);
+                CHECK(qm.vartype(3) == Vartype::SPIN);
+                CHECK(qm.lower_bound(3) == -1);
+                CHECK(qm.content_hash() == original.content_hash());
+            }
+
+            THEN("the journal is invalidated because a variable was added and removed") {
+                CHECK(!qm.journal()->valid());
+            }
+        }
+
+        WHEN("biases are changed in a transaction and rolled back") {
+            qm.begin_transaction();
+            qm.add_linear(0, 1);
+            qm.rollback();
+
+            THEN("the journal still holds the changes") {
+                REQUIRE(qm.journal()->valid());
+                CHECK(qm.journal()->linear() == std::vector<int>{0});
+            }
+        }
+
+        WHEN("variables are removed in a transaction and rolled back") {
+            qm.begin_transaction();
+            qm.remove_variables({0, 2});
+            qm.fix_variable(0, 2);
+            qm.rollback();
+
+            THEN("the model is restored") {
+                CHECK(qm.is_equal(original));
+                CHECK(qm.content_hash() == original.content_hash());
+            }
+        }
+    }
+}
+
+SCENARIO("transactions on constrained quadratic models") {
+    GIVEN("a CQM") {
+        auto cqm = ConstrainedQuadraticModel<double>();
+        cqm.add_variables(Vartype::BINARY, 3);
+        cqm.add_variable(Vartype::INTEGER, -5, 5);
+        cqm.objective.add_linear(0, 1);
+        cqm.objective.add_quadratic(1, 3, 2);
+        auto c0 = cqm.add_linear_constraint({0, 1, 2}, {1, 1, 1}, Sense::EQ, 1);
+        auto c1 = cqm.add_linear_constraint({3, 2}, {2, -1}, Sense::LE, 4);
+        cqm.constraint_ref(c0).mark_discrete();
+
+        const auto hash = cqm.content_hash();
+
+        WHEN("a transaction is started") {
+            cqm.begin_transaction();
+            REQUIRE(cqm.in_transaction());
+            CHECK(cqm.objective.in_transaction());
+            CHECK(cqm.constraint_ref(c1).in_transaction());
+            CHECK_THROWS_AS(cqm.begin_transaction(), std::logic_error);
+
+            AND_WHEN("the objective, constraints and variables are changed") {
+                cqm.set_upper_bound(3, 2);
+                cqm.objective.add_linear(2, 5);
+                cqm.constraint_ref(c1).set_rhs(3);
+                cqm.constraint_ref(c1).add_quadratic(0, 3, 1);
+                cqm.constraint_ref(c0).scale(-2);
+                auto v = cqm.add_variable(Vartype::BINARY);
+                auto c2 = cqm.add_linear_constraint({v, 0}, {1, 1}, Sense::GE, 1);
+                cqm.constraint_ref(c2).set_weight(3);
+
+                AND_WHEN("the transaction is rolled back") {
+                    cqm.rollback();
+
+                    THEN("the model is restored") {
+                        CHECK(!cqm.in_transaction());
+                        CHECK(!cqm.objective.in_transaction());
+                        CHECK(cqm.num_variables() == 4);
+                        CHECK(cqm.num_constraints() == 2);
+                        CHECK(cqm.upper_bound(3) == 5);
+                        CHECK(cqm.objective.linear(2) == 0);
+                        CHECK(!cqm.objective.has_variable(2));
+                        CHECK(cqm.constraint_ref(c1).rhs() == 4);
+                        CHECK(cqm.constraint_ref(c1).is_linear());
+                        CHECK(cqm.constraint_ref(c0).sense() == Sense::EQ);
+                        CHECK(cqm.constraint_ref(c0).linear(1) == 1);
+                        CHECK(cqm.content_hash() == hash);
+                    }
+                }
+
+                AND_WHEN("the transaction is committed") {
+                    cqm.commit();
+
+                    THEN("the changes are kept") {
+                        CHECK(!cqm.in_transaction());
+                        CHECK(!cqm.constraint_ref(c1).in_transaction());
+                        CHECK(cqm.num_variables() == 5);
+                        CHECK(cqm.num_constraints() == 3);
+                        CHECK(cqm.constraint_ref(c1).rhs() == 3);
+                        CHECK(cqm.content_hash() != hash);
+                    }
+                }
+            }
+
+            AND_WHEN("variables and constraints are removed") {
+                cqm.fix_variable(1, 1);
+                cqm.remove_constraint(c0);
+                cqm.constraint_ref(0).clear();
+                cqm.remove_constraints_if([](const Constraint<double, int>&) { return true; });
+                cqm.remove_variable(0);
+                cqm.rollback();
+
+                THEN("the model is restored") {
+                    CHECK(cqm.num_variables() == 4);
+                    CHECK(cqm.num_constraints() == 2);
+                    CHECK(cqm.objective.quadratic(1, 3) == 2);
+                    CHECK(cqm.constraint_ref(c0).marked_discrete());
+                    CHECK(cqm.constraint_ref(c1).linear(3) == 2);
+                    CHECK(cqm.content_hash() == hash);
+                }
+            }
+
+            AND_WHEN("the model is cleared and permuted") {
+                cqm.permute({3, 2, 1, 0});
+                cqm.change_vartypes(Vartype::SPIN, {1, 2});
+                cqm.clear();
+                cqm.add_variable(Vartype::INTEGER);
+                cqm.rollback();
+
+                THEN("the model is restored") {
+                    CHECK(cqm.vartype(1) == Vartype::BINARY);
+                    CHECK(cqm.content_hash() == hash);
+                }
+            }
+        }
+
+        WHEN("a constraint is already in a transaction") {
+            cqm.constraint_ref(c1).begin_transaction();
+
+            THEN("the model cannot start one") {
+                CHECK_THROWS_AS(cqm.begin_transaction(), std::logic_error);
+                CHECK(!cqm.in_transaction());
+                CHECK(!cqm.objective.in_transaction());
+                CHECK(!cqm.constraint_ref(c0).in_transaction());
+            }
+        }
+
+        WHEN("a journal is started during a transaction") {
+            cqm.begin_transaction();
+            cqm.objective.add_linear(0, 1);
+            cqm.start_journal();
+            cqm.rollback();
+
+            THEN("the journals are invalidated") {
+                CHECK(!cqm.journal()->valid());
+                CHECK(!cqm.objective.journal()->valid());
+            }
+        }
+    }
+}
+
+}  // namespace dimod